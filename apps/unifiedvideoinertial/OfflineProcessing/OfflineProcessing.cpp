@@ -30,10 +30,12 @@
 #include "unifiedvideoinertial/CSV.h"
 #include "unifiedvideoinertial/ConfigParams.h"
 #include "unifiedvideoinertial/ConfigurationParser.h"
+#include "unifiedvideoinertial/ImageSources/VideoFileImageSource.h"
 #include "unifiedvideoinertial/MakeHDKTrackingSystem.h"
 #include "unifiedvideoinertial/MiniArgsHandling.h"
-#include "unifiedvideoinertial/TimeValue.h"
+#include "unifiedvideoinertial/Timestamp.h"
 #include "unifiedvideoinertial/TrackedBodyTarget.h"
+#include "unifiedvideoinertial/TrackingMetrics.h"
 #include "videotrackershared/CameraParameters.h"
 #include "videotrackershared/EdgeHoleBasedLedExtractor.h"
 #include "videotrackershared/UndistortMeasurements.h"
@@ -88,7 +90,8 @@ namespace uvbi {
             target_ = body_->getTarget(targetIdOfInterest);
         }
 
-        void processFrame(cv::Mat const &frame);
+        /// Processes a frame captured at the given time.
+        void processFrame(cv::Mat const &frame, util::Timestamp const &tv);
 
         bool everHadPose() const { return everHadPose_; }
         bool hasPose() const { return hasPose_; }
@@ -97,6 +100,10 @@ namespace uvbi {
 
         void outputCSV(std::ostream &os) { csv_.output(os); }
 
+        TrackingMetricsSnapshot getMetrics() const {
+            return system_->getMetrics().snapshot();
+        }
+
         /// To get a time that matches the timestamp
         std::size_t getFrameCount() const { return frame_ + 1; }
 
@@ -138,7 +145,7 @@ namespace uvbi {
         std::unique_ptr<TrackingSystem> system_;
         TrackedBody *body_ = nullptr;
         TrackedBodyTarget *target_ = nullptr;
-        util::TimeValue currentTime_ = {};
+        util::Timestamp currentTime_ = {};
         LedMeasurementVec rawMeasurements_;
         LedMeasurementVec undistortedMeasurements_;
         cv::Mat lastFrame_;
@@ -148,13 +155,13 @@ namespace uvbi {
         bool everHadPose_ = false;
     };
 
-    void TrackerOfflineProcessing::processFrame(cv::Mat const &frame) {
+    void TrackerOfflineProcessing::processFrame(cv::Mat const &frame,
+                                                util::Timestamp const &tv) {
         if ((frame_ % 100) == 0) {
             std::cout << "Processing frame " << frame_ << std::endl;
         }
         /// Advance the clock
-        currentTime_.microseconds += frameTime_.count();
-        uvbiTimeValueNormalize(&currentTime_);
+        currentTime_ = tv;
 
         /// Image processing.
         auto imageData = imageProc(frame);
@@ -201,7 +208,7 @@ namespace uvbi {
         lastFrame_ = frame.clone();
         ImageOutputDataPtr ret(new ImageProcessingOutput);
         ret->tv = currentTime_;
-        ret->frame = frame;
+        ret->frame = LazyColorFrame::fromColor(frame);
         cv::Mat gray;
         cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
         ret->frameGray = gray;
@@ -218,7 +225,7 @@ namespace uvbi {
         auto row = csv_.row();
 #if 0
         // time as the two-part time value
-        row << cellGroup(currentTime_);
+        row << cellGroup(currentTime_.toTimeValue());
 #endif
 
         // time as a pristinely-formatted decimal number of seconds
@@ -322,16 +329,22 @@ namespace uvbi {
     static bool g_saveFramesLostFix = false;
 
     bool processAVI(std::string const &fn, TrackerOfflineProcessing &app) {
-        cv::VideoCapture capture;
-        capture.open(fn);
-        if (!capture.isOpened()) {
-            std::cerr << "Could not open video file " << fn << std::endl;
+        /// Decoded ahead on another thread, with capture timestamps from the
+        /// sidecar file if there is one, otherwise made up at the file's
+        /// frame rate.
+        ReplayOptions opts;
+        opts.pacing = ReplayPacing::MaxSpeed;
+        auto video = openVideoFile(fn, opts);
+        if (!video) {
             return false;
         }
         cv::Mat frame;
-        capture >> frame;
-        while (capture.read(frame)) {
-            app.processFrame(frame);
+        util::Timestamp tv;
+        // Skip the first frame, as this has always done.
+        video->grab();
+        while (video->grab()) {
+            video->retrieveColor(frame, tv);
+            app.processFrame(frame, tv);
             if (g_saveFramesLostFix && !app.hasPose() && app.everHadPose()) {
                 // we had pose but lost it
                 std::ostringstream os;
@@ -340,6 +353,29 @@ namespace uvbi {
                 cv::imwrite(os.str(), image);
             }
         }
+        auto stats = video->getDecodeStats();
+        std::cout << "Decoder waited for the tracker " << stats.decoderWaits
+                  << " times; tracker waited for the decoder "
+                  << stats.consumerWaits << " times ("
+                  << std::chrono::duration<double>(stats.consumerWaitTime)
+                         .count()
+                  << " s)" << std::endl;
+
+        /// To compare runs with and without poseAssistedIdentification.
+        auto metrics = app.getMetrics();
+        auto identified = metrics.get(MetricCounter::BeaconIdentifications);
+        if (identified > 0) {
+            std::cout << "Identified " << identified << " blobs, in "
+                      << static_cast<double>(metrics.get(
+                             MetricCounter::BeaconIdentificationFrames)) /
+                             identified
+                      << " frames on average; "
+                      << metrics.get(MetricCounter::ProvisionalBeaconIds)
+                      << " provisional IDs, "
+                      << metrics.get(
+                             MetricCounter::ProvisionalBeaconIdsRefuted)
+                      << " of them refuted" << std::endl;
+        }
         return true;
     }
 
@@ -32,7 +32,7 @@
 #include "videotrackershared/LedMeasurement.h"
 
 #include "unifiedvideoinertial/Finally.h"
-#include "unifiedvideoinertial/TimeValue.h"
+#include "unifiedvideoinertial/Timestamp.h"
 
 // Library/third-party includes
 #include <Eigen/Core>
@@ -58,11 +58,6 @@ namespace uvbi {
         return instance;
     }
 
-    inline cv::Mat const &getColor() {
-        static const cv::Mat instance = cv::Mat(IMAGE_SIZE, CV_8UC3);
-        return instance;
-    }
-
     class LoadRow {
       public:
         LoadRow(csvtools::FieldParserHelper &helper,
@@ -200,11 +195,12 @@ namespace uvbi {
     makeImageOutputDataFromRow(TimestampedMeasurements const &row,
                                CameraParameters const &camParams) {
         ImageOutputDataPtr ret(new ImageProcessingOutput);
-        ret->tv = row.tv;
+        ret->tv =
+            util::Timestamp::fromTimeValue(row.tv, util::ClockDomain::Offline);
         ret->ledMeasurements = row.measurements;
         ret->camParams = camParams;
-        ret->frame = getColor();
         ret->frameGray = getGray();
+        ret->frame = LazyColorFrame{ret->frameGray};
         return ret;
     }
 
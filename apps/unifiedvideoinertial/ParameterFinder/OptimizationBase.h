@@ -30,6 +30,7 @@
 #include "unifiedvideoinertial/ConfigParams.h"
 #include "unifiedvideoinertial/MakeHDKTrackingSystem.h"
 #include "unifiedvideoinertial/TrackedBodyTarget.h"
+#include "unifiedvideoinertial/TrackingSystem.h"
 
 // Library/third-party includes
 #include "unifiedvideoinertial/EigenFilters.h"
@@ -37,6 +38,7 @@
 #include <Eigen/Geometry>
 
 // Standard includes
+#include <cstddef>
 #include <memory>
 #include <utility>
 
@@ -117,12 +119,35 @@ namespace uvbi {
         void operator()(OptimData &optim, TimestampedMeasurements const &row) {
             auto inputData =
                 makeImageOutputDataFromRow(row, optim.getCamParams());
-            auto indices = optim.getSystem().updateBodiesFromVideoData(
-                std::move(inputData));
-            gotPose = optim.getBody().hasPoseEstimate();
-            if (gotPose) {
-                pose = optim.getBody().getState().getIsometry();
-            }
+            optim.getSystem().updateBodiesFromVideoData(std::move(inputData));
+            updatePose(optim);
+        }
+
+        /// Same, but also records the LEDs stage 2 left, for later runs to
+        /// replay().
+        void operator()(OptimData &optim, TimestampedMeasurements const &row,
+                        LedStateRecording &recording) {
+            auto inputData =
+                makeImageOutputDataFromRow(row, optim.getCamParams());
+            optim.getSystem().updateBodiesFromVideoData(std::move(inputData),
+                                                        recording);
+            updatePose(optim);
+        }
+
+        /// Use in place of the call operator for a row whose stage 2 was
+        /// recorded in an earlier run with the same stage-1 and stage-2
+        /// parameters: only runs stage 3.
+        ///
+        /// @return false if the replay has parted ways with the recorded run,
+        /// so the rows that follow need the call operator instead.
+        bool replay(OptimData &optim, TimestampedMeasurements const &row,
+                    LedStateRecording const &recording, std::size_t rowIndex) {
+            auto inputData =
+                makeImageOutputDataFromRow(row, optim.getCamParams());
+            auto inSync = optim.getSystem().replayBodiesFromVideoData(
+                std::move(inputData), recording, rowIndex);
+            updatePose(optim);
+            return inSync;
         }
         bool havePose() const { return gotPose; }
         Eigen::Isometry3d const &getPose() const { return pose; }
@@ -131,6 +156,12 @@ namespace uvbi {
         }
 
       private:
+        void updatePose(OptimData &optim) {
+            gotPose = optim.getBody().hasPoseEstimate();
+            if (gotPose) {
+                pose = optim.getBody().getState().getIsometry();
+            }
+        }
         bool gotPose = false;
         Eigen::Isometry3d pose;
     };
@@ -57,6 +57,12 @@ namespace uvbi {
                   << ParamSet::getVecElementNames() << "\n";
         std::cout << "Initial vector:\n"
                   << x.format(getFullFormat()) << std::endl;
+        /// Most parameter sets only vary parameters that pose estimation
+        /// (stage 3) reads, so the LEDs stage 2 leaves for each row are
+        /// recorded once and replayed by later evaluations with the same
+        /// stage-1 and stage-2 parameters, rather than redone every time.
+        LedStateRecording ledRecording;
+        ConfigParams recordedParams;
         auto functor = [&](ParamVec const &paramVec) -> double {
             ConfigParams params = commonData.initialParams;
 
@@ -70,9 +76,35 @@ namespace uvbi {
             std::size_t samples = 0;
             double accum = 0;
 
+            auto replaying =
+                !ledRecording.empty() &&
+                haveSameLedIdentificationParams(params, recordedParams);
+            /// With pose-assisted identification, stage 2 depends on the
+            /// poses, so there's no point recording it.
+            auto recording =
+                !replaying && !params.poseAssistedIdentification;
+            if (recording) {
+                ledRecording.clear();
+                recordedParams = params;
+            }
+            std::size_t rowIndex = 0;
+            std::size_t replayedRows = 0;
+
             /// Main algorithm loop
             for (auto const &rowPtr : data) {
-                mainAlgo(optim, *rowPtr);
+                if (replaying) {
+                    /// Stop replaying once the replay parts ways with the
+                    /// recorded run: from then on, only running stage 2
+                    /// again gives the right LEDs.
+                    replaying =
+                        mainAlgo.replay(optim, *rowPtr, ledRecording, rowIndex);
+                    replayedRows++;
+                } else if (recording) {
+                    mainAlgo(optim, *rowPtr, ledRecording);
+                } else {
+                    mainAlgo(optim, *rowPtr);
+                }
+                rowIndex++;
                 ref(optim, *rowPtr);
                 if (ref.havePose() && mainAlgo.havePose()) {
                     auto cost =
@@ -97,7 +129,8 @@ namespace uvbi {
                           << " effective cost (average cost of " << std::setw(9)
                           << avgCost << " over " << std::setw(4) << samples
                           << " eligible frames with " << std::setw(2)
-                          << numResets << " resets)\n";
+                          << numResets << " resets, " << std::setw(4)
+                          << replayedRows << " rows replayed)\n";
                 return effectiveCost;
             }
             std::cout << "No samples with pose for both algorithms?"
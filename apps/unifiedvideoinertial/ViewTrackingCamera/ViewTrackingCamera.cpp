@@ -25,6 +25,7 @@
 // Internal Includes
 #include "unifiedvideoinertial/ImageSources/ImageSource.h"
 #include "unifiedvideoinertial/ImageSources/ImageSourceFactories.h"
+#include "unifiedvideoinertial/ImageSources/RawFrameFile.h"
 
 // Library/third-party includes
 #include <opencv2/highgui/highgui.hpp>
@@ -106,6 +107,28 @@ int main(int argc, char *argv[]) {
         }
     }
 
+    /// Raw recordings keep every gray frame as the tracker sees it, with its
+    /// timestamp, for replaying through the tracker later.
+    std::unique_ptr<videotracker::uvbi::RawFrameWriter> rawRecording;
+    if (argc > 2) {
+        std::string rawFilename = argv[2];
+        if (!videotracker::uvbi::isRawFrameFileName(rawFilename)) {
+            std::cerr << "Second command-line argument '" << rawFilename
+                      << "' should be a file name ending in "
+                      << videotracker::uvbi::RAW_FRAME_FILE_EXTENSION
+                      << " to record to." << std::endl;
+            return -1;
+        }
+        try {
+            rawRecording.reset(
+                new videotracker::uvbi::RawFrameWriter{rawFilename});
+        } catch (std::exception &e) {
+            std::cerr << e.what() << std::endl;
+            return -1;
+        }
+        std::cout << "Recording all frames to " << rawFilename << std::endl;
+    }
+
     cam->grab();
 
     std::cout << "Will display 1 out of every " << FRAME_DISPLAY_STRIDE
@@ -115,6 +138,7 @@ int main(int argc, char *argv[]) {
 
     auto frame = cv::Mat{};
     auto grayFrame = cv::Mat{};
+    auto timestamp = videotracker::util::Timestamp{};
 
     auto savedFrame = false;
     static const auto FILENAME = "capture.png";
@@ -140,7 +164,10 @@ int main(int argc, char *argv[]) {
     cv::namedWindow(windowNameAndInstructions);
     auto frameCount = std::size_t{0};
     do {
-        cam->retrieve(frame, grayFrame);
+        cam->retrieve(frame, grayFrame, timestamp);
+        if (rawRecording) {
+            rawRecording->write(grayFrame, timestamp.toTimeValue());
+        }
 
 #ifdef UVBI_ENABLE_RECORDING
         outputVideo.write(frame);
@@ -170,5 +197,9 @@ int main(int argc, char *argv[]) {
             }
         }
     } while (cam->grab());
+    if (rawRecording) {
+        std::cout << "Recorded " << rawRecording->getFrameCount()
+                  << " frames." << std::endl;
+    }
     return 0;
 }
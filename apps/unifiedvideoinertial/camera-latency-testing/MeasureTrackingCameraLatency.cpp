@@ -347,8 +347,8 @@ int main(int argc, char *argv[]) {
 
     enum class State { StartedTrigger, SawFlash, AwaitingNewTrigger };
 
-    using videotracker::util::TimeValue;
-    TimeValue triggerTime = {};
+    using videotracker::util::Timestamp;
+    Timestamp triggerTime;
     double peakVal = 0.;
 
     State s = State::AwaitingNewTrigger;
@@ -363,7 +363,7 @@ int main(int argc, char *argv[]) {
     std::uint32_t samples = 0;
     std::ofstream os("latency.csv");
     do {
-        TimeValue tv;
+        Timestamp tv;
         cam->retrieve(frame, grayFrame, tv);
         switch (s) {
         case State::AwaitingNewTrigger: {
@@ -372,31 +372,35 @@ int main(int argc, char *argv[]) {
                 s = State::StartedTrigger;
                 peakVal = 0.;
                 LEDController->trigger();
-                triggerTime = videotracker::util::time::getNow();
+                triggerTime = videotracker::util::time::getSteadyNow();
             } else {
                 countdownToTrigger--;
             }
             break;
         }
         case State::StartedTrigger: {
-            auto now = videotracker::util::time::getNow();
+            auto now = videotracker::util::time::getSteadyNow();
             double minVal, maxVal;
             cv::minMaxIdx(grayFrame, &minVal, &maxVal);
             // if (maxVal < peakVal) {
             if (maxVal > CUTOFF_VALUE) {
-                uvbiTimeValueDifference(&now, &triggerTime);
-                uvbiTimeValueDifference(&tv, &triggerTime);
-                if (tv.microseconds > 0) {
+                using std::chrono::duration_cast;
+                using std::chrono::microseconds;
+                auto sampleLatency =
+                    duration_cast<microseconds>(tv - triggerTime).count();
+                auto retrievalLatency =
+                    duration_cast<microseconds>(now - triggerTime).count();
+                if (sampleLatency > 0) {
                     // we got it
                     s = State::SawFlash;
                     std::cout << "   Current: " << maxVal << "\n";
                     std::cout << "Latency from trigger to sample time: "
-                              << tv.microseconds << "us\n";
+                              << sampleLatency << "us\n";
                     std::cout << "Latency from trigger to retrieval time: "
-                              << now.microseconds << "us\n";
+                              << retrievalLatency << "us\n";
                     cv::imwrite("triggered.png", frame);
                     samples++;
-                    os << tv.microseconds << std::endl;
+                    os << sampleLatency << std::endl;
                 } else {
                     std::cout << "Got a spurious flash, negative trigger to "
                                  "sample duration"
@@ -23,6 +23,7 @@
 // limitations under the License.
 
 // Internal Includes
+#include "ExtractorBenchmark.h"
 #include "videotrackershared/BlobExtractor.h"
 #include "videotrackershared/BlobParams.h"
 #include "videotrackershared/EdgeHoleBasedLedExtractor.h"
@@ -44,6 +45,9 @@
 #include <iostream>
 #include <random>
 #include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace videotracker {
 static bool g_showAllRejects = false;
@@ -242,9 +246,94 @@ void tryLoadingConfigFile() {
     getOptionalParameter(g_showAllRejects, root, "showAllRejects");
 }
 
+static const char BENCH_USAGE[] =
+    "Usage: blob_extraction_demo --bench [--iterations N]\n"
+    "           [--backends a,b,...] [--reference NAME]\n"
+    "           [--match-distance PX] [--coarse-tile N]\n"
+    "           <images, directories of images, or .avi recordings>...\n\n"
+    "Runs each blob extractor backend over all the frames, without\n"
+    "displaying or writing anything, and reports its speed, the blobs it\n"
+    "finds, and how well they agree with the reference backend's.\n"
+    "Uses the blob and extractor params from blobDemoConfig.json, if any.\n";
+
+static std::vector<std::string> splitList(std::string const &arg) {
+    std::vector<std::string> ret;
+    std::istringstream is(arg);
+    std::string item;
+    while (std::getline(is, item, ',')) {
+        if (!item.empty()) {
+            ret.push_back(item);
+        }
+    }
+    return ret;
+}
+
+template <typename T> static T parseValue(std::string const &arg) {
+    std::istringstream is(arg);
+    T val;
+    if (!(is >> val)) {
+        throw std::invalid_argument("Could not parse argument " + arg);
+    }
+    return val;
+}
+
+static int runBench(int argc, char *argv[]) {
+    using namespace videotracker;
+    ExtractorBenchmarkOptions opts;
+    opts.blobParams = g_blobParams;
+    opts.extractParams = g_holeExtractorParams;
+    std::vector<std::string> inputs;
+    try {
+        for (int arg = 2; arg < argc; ++arg) {
+            auto a = std::string{argv[arg]};
+            if (a == "-h" || a == "--help") {
+                std::cout << BENCH_USAGE;
+                std::cout << "\nBackends:";
+                for (auto const &name : getExtractorBackendNames()) {
+                    std::cout << " " << name;
+                }
+                std::cout << std::endl;
+                return 0;
+            }
+            if (a.compare(0, 2, "--") != 0) {
+                inputs.push_back(a);
+                continue;
+            }
+            if (arg + 1 >= argc) {
+                throw std::invalid_argument("Missing value for " + a);
+            }
+            auto val = std::string{argv[++arg]};
+            if (a == "--iterations") {
+                opts.iterations = parseValue<std::size_t>(val);
+            } else if (a == "--backends") {
+                opts.backends = splitList(val);
+            } else if (a == "--reference") {
+                opts.reference = val;
+            } else if (a == "--match-distance") {
+                opts.matchDistance = parseValue<double>(val);
+            } else if (a == "--coarse-tile") {
+                opts.coarseTileSize = parseValue<int>(val);
+            } else {
+                throw std::invalid_argument("Unrecognized argument " + a);
+            }
+        }
+        if (inputs.empty()) {
+            throw std::invalid_argument("Nothing to benchmark with!");
+        }
+        runExtractorBenchmark(inputs, opts, std::cout);
+    } catch (std::exception &e) {
+        std::cerr << e.what() << "\n\n" << BENCH_USAGE;
+        return -1;
+    }
+    return 0;
+}
+
 int main(int argc, char *argv[]) {
     /// Look for a config file (optional)
     tryLoadingConfigFile();
+    if (argc >= 2 && std::string{argv[1]} == "--bench") {
+        return runBench(argc, argv);
+    }
     /// Don't stop before exiting if we've got multiple to process.
     if (argc == 2) {
         auto fn = std::string{argv[1]};
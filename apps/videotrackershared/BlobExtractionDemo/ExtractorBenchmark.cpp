@@ -0,0 +1,429 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "ExtractorBenchmark.h"
+#include "videotrackershared/EdgeHoleBlobExtractor.h"
+#include "videotrackershared/GenericBlobExtractor.h"
+#include "videotrackershared/LedMeasurement.h"
+#include "videotrackershared/SBDBlobExtractor.h"
+
+// Library/third-party includes
+#include <opencv2/core/core.hpp>
+#include <opencv2/highgui/highgui.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+
+namespace videotracker {
+namespace {
+    using clock = std::chrono::steady_clock;
+
+    /// The edge-hole extractor is what the tracker uses, so it's the
+    /// reference by default, and listed first. The "sbd" backends use
+    /// cv::SimpleBlobDetector, the "sbd-multi-threshold" ones
+    /// MultiThresholdBlobDetector; the "sbd-extractor" ones go through the
+    /// older SBDBlobExtractor instead of SBDGenericBlobExtractor.
+    const char *const BACKEND_NAMES[] = {"edge-hole",
+                                         "edge-hole-single-pass",
+                                         "edge-hole-coarse",
+                                         "sbd",
+                                         "sbd-coarse",
+                                         "sbd-multi-threshold",
+                                         "sbd-multi-threshold-coarse",
+                                         "sbd-extractor",
+                                         "sbd-extractor-multi-threshold"};
+
+    const std::string COARSE_SUFFIX = "-coarse";
+    const std::string MULTI_THRESHOLD_SUFFIX = "-multi-threshold";
+
+    struct Frame {
+        cv::Mat gray;
+    };
+
+    struct LoadedFrames {
+        std::vector<Frame> frames;
+        std::size_t inputs = 0;
+        clock::duration decodeTime = clock::duration::zero();
+        clock::duration grayTime = clock::duration::zero();
+    };
+
+    struct Agreement {
+        std::size_t referenceBlobs = 0;
+        std::size_t blobs = 0;
+        std::size_t matched = 0;
+        double distanceSum = 0;
+    };
+
+    struct BackendResult {
+        std::string name;
+        /// Time for each frame of each timed pass.
+        std::vector<double> extractMicroseconds;
+        clock::duration totalTime = clock::duration::zero();
+        /// The blobs found in each frame by the untimed pass.
+        std::vector<LedMeasurementVec> blobs;
+        std::size_t blobCount = 0;
+        Agreement agreement;
+    };
+
+    inline bool endsWith(std::string const &s, std::string const &suffix) {
+        return s.size() >= suffix.size() &&
+               s.compare(s.size() - suffix.size(), suffix.size(), suffix) ==
+                   0;
+    }
+
+    /// If s ends with suffix, removes it and returns true.
+    inline bool removeSuffix(std::string &s, std::string const &suffix) {
+        if (!endsWith(s, suffix)) {
+            return false;
+        }
+        s.resize(s.size() - suffix.size());
+        return true;
+    }
+
+    /// Lets SBDBlobExtractor, which predates the GenericBlobExtractor
+    /// interface, be benchmarked alongside the others.
+    class SBDBlobExtractorBackend : public GenericBlobExtractor {
+      public:
+        explicit SBDBlobExtractorBackend(BlobParams const &blobParams)
+            : m_extractor(blobParams) {}
+
+      protected:
+        cv::Mat generateDebugThresholdImage_() const override {
+            return m_extractor.getDebugThresholdImage();
+        }
+        cv::Mat generateDebugBlobImage_() const override {
+            return m_extractor.getDebugBlobImage();
+        }
+        void extractBlobs_(LedMeasurementVec &measurements) override {
+            measurements = m_extractor.extractBlobs(getLatestGrayImage());
+        }
+
+      private:
+        /// Its debug images are generated lazily, by non-const methods.
+        mutable SBDBlobExtractor m_extractor;
+    };
+
+    /// Recordings are told apart by extension, as in the interactive mode.
+    inline bool isVideo(std::string const &fn) { return endsWith(fn, ".avi"); }
+
+    inline double toMicroseconds(clock::duration d) {
+        return std::chrono::duration<double, std::micro>(d).count();
+    }
+
+    inline double percentile(std::vector<double> values, double p) {
+        if (values.empty()) {
+            return 0;
+        }
+        std::sort(values.begin(), values.end());
+        auto idx =
+            static_cast<std::size_t>(std::ceil(p / 100. * values.size()));
+        return values[std::max<std::size_t>(idx, 1) - 1];
+    }
+
+    void addFrame(LoadedFrames &loaded, cv::Mat const &color) {
+        Frame frame;
+        auto start = clock::now();
+        cv::cvtColor(color, frame.gray, cv::COLOR_BGR2GRAY);
+        loaded.grayTime += clock::now() - start;
+        loaded.frames.push_back(std::move(frame));
+    }
+
+    bool loadImage(LoadedFrames &loaded, std::string const &fn) {
+        auto start = clock::now();
+        cv::Mat color = cv::imread(fn, cv::IMREAD_COLOR);
+        loaded.decodeTime += clock::now() - start;
+        if (!color.data) {
+            return false;
+        }
+        addFrame(loaded, color);
+        return true;
+    }
+
+    bool loadVideo(LoadedFrames &loaded, std::string const &fn) {
+        cv::VideoCapture capture;
+        capture.open(fn);
+        if (!capture.isOpened()) {
+            return false;
+        }
+        cv::Mat color;
+        while (true) {
+            auto start = clock::now();
+            auto gotFrame = capture.read(color);
+            loaded.decodeTime += clock::now() - start;
+            if (!gotFrame) {
+                break;
+            }
+            addFrame(loaded, color);
+        }
+        return true;
+    }
+
+    /// Anything that isn't a video or an image is taken to be a directory,
+    /// or a wildcard pattern, of images.
+    void loadInput(LoadedFrames &loaded, std::string const &input) {
+        if (isVideo(input)) {
+            if (!loadVideo(loaded, input)) {
+                std::cerr << "Could not open video file " << input
+                          << std::endl;
+                return;
+            }
+            loaded.inputs++;
+            return;
+        }
+        if (loadImage(loaded, input)) {
+            loaded.inputs++;
+            return;
+        }
+        std::vector<cv::String> files;
+        try {
+            cv::glob(input, files, false);
+        } catch (cv::Exception &) {
+            files.clear();
+        }
+        files.erase(std::remove(files.begin(), files.end(), input),
+                    files.end());
+        std::size_t found = 0;
+        for (auto const &fn : files) {
+            /// Skipping anything else in the directory that isn't an image,
+            /// like the debug images the interactive mode writes next to
+            /// them.
+            if (endsWith(fn, ".edge.png") || endsWith(fn, ".binarized.png") ||
+                endsWith(fn, ".contours.png")) {
+                continue;
+            }
+            if (loadImage(loaded, fn)) {
+                found++;
+            }
+        }
+        if (found == 0) {
+            std::cerr << "Could not load any images from " << input
+                      << std::endl;
+            return;
+        }
+        loaded.inputs++;
+    }
+
+    BlobExtractorPtr makeBackend(std::string const &name,
+                                 ExtractorBenchmarkOptions const &opts) {
+        auto blobParams = opts.blobParams;
+        auto extParams = opts.extractParams;
+        auto base = name;
+        const auto coarse = removeSuffix(base, COARSE_SUFFIX);
+        const auto multiThreshold = removeSuffix(base, MULTI_THRESHOLD_SUFFIX);
+        blobParams.coarseTileSize = 0;
+        if (coarse) {
+            blobParams.coarseTileSize = opts.blobParams.coarseTileSize > 0
+                                            ? opts.blobParams.coarseTileSize
+                                            : opts.coarseTileSize;
+        }
+        blobParams.multiThresholdDetector = multiThreshold;
+        if (base == "sbd") {
+            return makeBlobExtractor(blobParams);
+        }
+        if (base == "sbd-extractor") {
+            return std::make_shared<SBDBlobExtractorBackend>(blobParams);
+        }
+        if (!multiThreshold &&
+            (base == "edge-hole" || base == "edge-hole-single-pass")) {
+            extParams.singlePassHoleLabelling =
+                (base == "edge-hole-single-pass");
+            return makeEdgeHoleBlobExtractor(blobParams, extParams);
+        }
+        throw std::invalid_argument("Unknown blob extractor backend: " +
+                                    name);
+    }
+
+    BackendResult runBackend(std::string const &name,
+                             ExtractorBenchmarkOptions const &opts,
+                             std::vector<Frame> const &frames) {
+        BackendResult ret;
+        ret.name = name;
+        auto extractor = makeBackend(name, opts);
+
+        /// Untimed pass: warms up the extractor's buffers and collects the
+        /// blobs.
+        ret.blobs.reserve(frames.size());
+        for (auto const &frame : frames) {
+            ret.blobs.push_back(extractor->extractBlobs(frame.gray));
+            ret.blobCount += ret.blobs.back().size();
+        }
+
+        ret.extractMicroseconds.reserve(frames.size() * opts.iterations);
+        for (std::size_t i = 0; i < opts.iterations; ++i) {
+            for (auto const &frame : frames) {
+                auto start = clock::now();
+                extractor->extractBlobs(frame.gray);
+                auto elapsed = clock::now() - start;
+                ret.totalTime += elapsed;
+                ret.extractMicroseconds.push_back(toMicroseconds(elapsed));
+            }
+        }
+        return ret;
+    }
+
+    /// Pairs each blob with the nearest reference blob within the match
+    /// distance, nearest pairs first, each blob used at most once.
+    void accumulateAgreement(LedMeasurementVec const &reference,
+                             LedMeasurementVec const &blobs,
+                             double matchDistance, Agreement &agreement) {
+        agreement.referenceBlobs += reference.size();
+        agreement.blobs += blobs.size();
+        using Pair = std::tuple<double, std::size_t, std::size_t>;
+        std::vector<Pair> pairs;
+        for (std::size_t r = 0; r < reference.size(); ++r) {
+            for (std::size_t b = 0; b < blobs.size(); ++b) {
+                auto d = cv::norm(reference[r].loc - blobs[b].loc);
+                if (d <= matchDistance) {
+                    pairs.emplace_back(d, r, b);
+                }
+            }
+        }
+        std::sort(pairs.begin(), pairs.end());
+        std::vector<bool> referenceUsed(reference.size(), false);
+        std::vector<bool> blobUsed(blobs.size(), false);
+        for (auto const &pair : pairs) {
+            double d;
+            std::size_t r;
+            std::size_t b;
+            std::tie(d, r, b) = pair;
+            if (referenceUsed[r] || blobUsed[b]) {
+                continue;
+            }
+            referenceUsed[r] = blobUsed[b] = true;
+            agreement.matched++;
+            agreement.distanceSum += d;
+        }
+    }
+
+    void printReport(std::ostream &os, LoadedFrames const &loaded,
+                     std::vector<BackendResult> const &results,
+                     ExtractorBenchmarkOptions const &opts) {
+        const auto numFrames = loaded.frames.size();
+        double megapixels = 0;
+        for (auto const &frame : loaded.frames) {
+            megapixels += frame.gray.total() / 1.e6;
+        }
+        os << std::fixed << std::setprecision(1);
+        os << "\n"
+           << numFrames << " frames from " << loaded.inputs
+           << " inputs, timed over " << opts.iterations
+           << " passes. Loading took " << std::setw(8)
+           << toMicroseconds(loaded.decodeTime) / numFrames
+           << " us/frame to decode and " << std::setw(6)
+           << toMicroseconds(loaded.grayTime) / numFrames
+           << " us/frame to convert to gray.\n\n";
+        os << std::setw(24) << std::left << "backend" << std::right
+           << std::setw(9) << "fps" << std::setw(9) << "MP/s"
+           << std::setw(10) << "mean_us" << std::setw(10) << "p50_us"
+           << std::setw(10) << "p99_us" << std::setw(9) << "blobs"
+           << std::setw(9) << "recall" << std::setw(11) << "precision"
+           << std::setw(9) << "err_px"
+           << "\n";
+        for (auto const &r : results) {
+            auto seconds = std::chrono::duration<double>(r.totalTime).count();
+            auto passes = static_cast<double>(opts.iterations);
+            auto fps = seconds > 0 ? numFrames * passes / seconds : 0.;
+            auto mpps = seconds > 0 ? megapixels * passes / seconds : 0.;
+            auto mean = r.extractMicroseconds.empty()
+                            ? 0.
+                            : toMicroseconds(r.totalTime) /
+                                  r.extractMicroseconds.size();
+            auto const &a = r.agreement;
+            auto recall = a.referenceBlobs > 0
+                              ? 100. * a.matched / a.referenceBlobs
+                              : 100.;
+            auto precision = a.blobs > 0 ? 100. * a.matched / a.blobs : 100.;
+            auto err = a.matched > 0 ? a.distanceSum / a.matched : 0.;
+            os << std::setw(24) << std::left
+               << (r.name == opts.reference ? r.name + " (ref)" : r.name)
+               << std::right << std::setw(9) << fps << std::setw(9) << mpps
+               << std::setw(10) << mean << std::setw(10)
+               << percentile(r.extractMicroseconds, 50) << std::setw(10)
+               << percentile(r.extractMicroseconds, 99) << std::setw(9)
+               << static_cast<double>(r.blobCount) / numFrames
+               << std::setw(8) << recall << "%" << std::setw(10)
+               << precision << "%" << std::setprecision(3) << std::setw(9)
+               << err << std::setprecision(1) << "\n";
+        }
+        os << "\nblobs is the mean per frame. recall and precision are the "
+              "shares of the\nreference's blobs, and of the backend's own, "
+              "that have a counterpart within "
+           << opts.matchDistance << " px\nin the other; err_px is the mean "
+                                    "distance between counterparts."
+           << std::endl;
+        os.unsetf(std::ios_base::floatfield);
+    }
+} // namespace
+
+std::vector<std::string> getExtractorBackendNames() {
+    return std::vector<std::string>(std::begin(BACKEND_NAMES),
+                                    std::end(BACKEND_NAMES));
+}
+
+void runExtractorBenchmark(std::vector<std::string> const &inputs,
+                           ExtractorBenchmarkOptions const &opts,
+                           std::ostream &os) {
+    auto names = opts.backends.empty() ? getExtractorBackendNames()
+                                       : opts.backends;
+    /// The reference runs first, so it's always there to compare against.
+    names.erase(std::remove(names.begin(), names.end(), opts.reference),
+                names.end());
+    names.insert(names.begin(), opts.reference);
+    for (auto const &name : names) {
+        /// Fail on a bad name before spending time loading frames.
+        makeBackend(name, opts);
+    }
+
+    LoadedFrames loaded;
+    for (auto const &input : inputs) {
+        loadInput(loaded, input);
+    }
+    if (loaded.frames.empty()) {
+        throw std::invalid_argument("No frames to benchmark with!");
+    }
+    os << "Loaded " << loaded.frames.size() << " frames." << std::endl;
+
+    std::vector<BackendResult> results;
+    for (auto const &name : names) {
+        os << "Running " << name << "..." << std::endl;
+        results.push_back(runBackend(name, opts, loaded.frames));
+    }
+    auto const &reference = results.front();
+    for (auto &result : results) {
+        for (std::size_t i = 0; i < loaded.frames.size(); ++i) {
+            accumulateAgreement(reference.blobs[i], result.blobs[i],
+                                opts.matchDistance, result.agreement);
+        }
+    }
+    printReport(os, loaded, results, opts);
+}
+} // namespace videotracker
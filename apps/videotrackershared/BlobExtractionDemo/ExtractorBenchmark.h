@@ -0,0 +1,68 @@
+/** @file
+    @brief Header for the headless benchmark mode of the blob extraction demo:
+    runs each blob extractor backend over the same frames, reporting its
+    speed, the blobs it finds, and how well they agree with a reference
+    backend's.
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+// Internal Includes
+#include "videotrackershared/BlobParams.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace videotracker {
+struct ExtractorBenchmarkOptions {
+    BlobParams blobParams;
+    EdgeHoleParams extractParams;
+    /// Timed passes over the frames for each backend, after an untimed one
+    /// that warms it up and collects its blobs for the agreement figures.
+    std::size_t iterations = 10;
+    /// Names of the backends to run: all of them if empty.
+    std::vector<std::string> backends;
+    /// Name of the backend the others' blobs are compared against.
+    std::string reference = "edge-hole";
+    /// Tile size for the coarse-to-fine variants, if the blob params don't
+    /// set one.
+    int coarseTileSize = 16;
+    /// Furthest, in pixels, a blob may be from a reference blob to count as
+    /// the same one.
+    double matchDistance = 1.5;
+};
+
+/// Names of the backends the benchmark can run, reference first.
+std::vector<std::string> getExtractorBackendNames();
+
+/// Loads the frames of the inputs - image files, directories of them, or
+/// videos - then runs each backend over all of them, and writes a report.
+///
+/// @throws std::invalid_argument if a backend name is unknown or no frames
+/// could be loaded.
+void runExtractorBenchmark(std::vector<std::string> const &inputs,
+                           ExtractorBenchmarkOptions const &opts,
+                           std::ostream &os);
+} // namespace videotracker
@@ -0,0 +1,76 @@
+/** @file
+    @brief Header for opt-in counting of the heap allocations made by each
+    thread, which the tracking metrics use to report allocations per stage.
+
+    Nothing is counted unless the allocation hooks are linked into the
+    executable: add `$<TARGET_OBJECTS:uvbi-allocation-hooks>` to its sources
+    (configuring with UVBI_COUNT_ALLOCATIONS does so for uvbi-bench). They
+    replace the global operator new and delete. An application with an
+    allocator of its own can instead call noteAllocation() from it, and
+    enableAllocationCounting() at startup.
+
+    Only allocations made through operator new are seen: OpenCV images and
+    dynamic-size Eigen matrices get their memory from malloc directly.
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>
+#include <cstdint>
+
+namespace videotracker {
+namespace uvbi {
+    /// Number and total size of heap allocations.
+    struct AllocationCount {
+        std::uint64_t allocations = 0;
+        std::uint64_t bytes = 0;
+    };
+
+    inline AllocationCount operator-(AllocationCount const &a,
+                                     AllocationCount const &b) {
+        AllocationCount ret;
+        ret.allocations = a.allocations - b.allocations;
+        ret.bytes = a.bytes - b.bytes;
+        return ret;
+    }
+
+    /// Adds an allocation of the given size to the calling thread's count.
+    /// Called by the allocator hooks: must not allocate itself.
+    void noteAllocation(std::size_t bytes) noexcept;
+
+    /// Allocations the calling thread has made since it started: only the
+    /// difference between two calls is meaningful.
+    AllocationCount getThreadAllocationCount();
+
+    /// Turns on collection of per-stage allocation counts in the tracking
+    /// metrics. Called by the allocator hooks during static initialization.
+    void enableAllocationCounting();
+
+    /// Whether allocations are being counted, and so whether the counts in
+    /// the tracking metrics mean anything.
+    bool allocationCountingEnabled();
+} // namespace uvbi
+} // namespace videotracker
@@ -33,6 +33,7 @@
 // Standard includes
 #include <cstdint>
 #include <string>
+#include <vector>
 
 namespace videotracker {
 namespace uvbi {
@@ -62,6 +63,14 @@ namespace uvbi {
         double angularVelocityVariance = 1.0e-1;
 
         std::int32_t angularVelocityMicrosecondsOffset = 0;
+
+        /// Seconds of IMU reports to accumulate into a single Kalman
+        /// correction (one each for orientation and angular velocity),
+        /// both as they arrive and when replaying them after a video update.
+        /// 0 applies each report as its own correction. The body state only
+        /// reflects the reports once a window's worth has built up, so keep
+        /// this to a few milliseconds.
+        double preintegrationSeconds = 0.;
     };
 
     struct TuningParams {
@@ -114,9 +123,37 @@ namespace uvbi {
         /// Should we open the camera in high-gain mode?
         bool highGain = true;
 
+        /// If not empty, replay this recording (a video file, a raw frame
+        /// file, or a directory of images) instead of opening the camera.
+        /// Record raw frame files with uvbi-view-camera. IMU reports are
+        /// ignored while replaying, since they don't describe the recorded
+        /// motion.
+        std::string replayPath = "";
+
+        /// Speed to replay at, if replaying: 1 for real time, 0 for as fast
+        /// as possible, or any other positive multiplier.
+        double replaySpeed = 1.;
+
         /// Seconds beyond the current time to predict, using the Kalman state.
         double additionalPrediction = 0.;
 
+        /// Should only the newest state of each body be handed to the
+        /// reporting thread (in constant time, never dropping the newest),
+        /// instead of queueing every state for it to drain? Off by default,
+        /// keeping the bounded queue existing deployments use.
+        bool latestPoseReporting = false;
+
+        /// Should a video update just mark where in the body's history the
+        /// IMU reports since the frame need replaying, leaving the replay to
+        /// be done a batch at a time while the tracker thread is idle and
+        /// holding back the body's reports until it catches up, instead of
+        /// replaying them all before finishing the frame?
+        bool lazyReplay = false;
+
+        /// IMU reports per body to replay at a time when the tracker thread
+        /// is otherwise idle, in lazy replay mode.
+        int lazyReplayBatch = 16;
+
         /// Max residual, in meters at the expected XY plane of the beacon in
         /// space, for a beacon before applying a variance penalty.
         double maxResidual = 0.03631354168383816;
@@ -135,6 +172,18 @@ namespace uvbi {
         /// Whether to show the debug windows and debug messages.
         bool debug = false;
 
+        /// Show only every this many frames in the debug window.
+        int debugStride = 11;
+
+        /// Whether to draw and show the debug window on a thread of its own,
+        /// so turning it on doesn't change the tracker's timing: the tracker
+        /// just copies what's needed from every debugStride-th frame.
+        bool debugAsync = true;
+
+        /// Frames waiting to be drawn by the asynchronous debug window beyond
+        /// which the oldest are dropped.
+        int debugQueueSize = 2;
+
         /// How many threads to let OpenCV use. Set to 0 or less to let OpenCV
         /// decide (that is, not set an explicit preference)
         int numThreads = 1;
@@ -242,6 +291,25 @@ namespace uvbi {
         /// Defaulting to off because it adds some jitter for some reason.
         bool blobsKeepIdentity = false;
 
+        /// @name Pose-assisted identification
+        /// While a target is tracking in Kalman mode, give blobs that don't
+        /// yet have enough frames for their blink code a provisional ID: that
+        /// of the beacon whose projection, from the pose predicted for the
+        /// frame, lands nearest. The blink code confirms or replaces it once
+        /// it has been seen in full. Cuts the time to re-acquire beacons
+        /// coming back into view, at the risk of a few frames with a wrong
+        /// ID (tempered by the usual new-identification variance penalty).
+        /// @{
+        bool poseAssistedIdentification = false;
+        /// Furthest, in pixels, a blob may be from the predicted projection
+        /// of a beacon to be given its ID.
+        double poseAssistedIdMaxDistance = 4.;
+        /// How many times further than the nearest the next-nearest beacon
+        /// projection (or, for a beacon, the next-nearest blob) must be for
+        /// the match to count as unambiguous.
+        double poseAssistedIdAmbiguityRatio = 2.;
+        /// @}
+
         /// Extra verbose developer debugging messages
         bool extraVerbose = false;
 
@@ -249,6 +317,25 @@ namespace uvbi {
         /// Only make sense for a single target.
         std::string calibrationFile = "";
 
+        /// If non-empty, the file to save the beacon autocalibration and room
+        /// calibration to (once room calibration completes, then
+        /// periodically and on shutdown) and to restore them from at
+        /// startup, for each target and the room whose setup and camera still
+        /// match. The room calibration is only restored if
+        /// warmStartRoomCalibration is set.
+        std::string warmStartFile = "";
+
+        /// Seconds between saves of the warm start file while tracking: 0 or
+        /// less to save only on shutdown.
+        double warmStartSaveInterval = 60.;
+
+        /// Should the room calibration (camera pose and IMU yaw) be restored
+        /// from the warm start file too, not just the beacons? Off by
+        /// default: it's only valid if the IMU's own yaw reference survives
+        /// between runs, so only turn this on if it does (as with a
+        /// magnetometer), not if it restarts with the IMU.
+        bool warmStartRoomCalibration = false;
+
         /// IMU input-related parameters.
         IMUInputParams imu;
 
@@ -268,6 +355,24 @@ namespace uvbi {
         /// Default is measured on Windows 10 version 1511.
         std::int32_t cameraMicrosecondsOffset = -27000;
 
+        /// Should the remaining offset of the camera timestamps from the
+        /// IMU's (after cameraMicrosecondsOffset), and its drift, be
+        /// estimated from the beacon residuals of bodies with an IMU while
+        /// they turn, and video frames stamped with the estimate applied?
+        bool estimateCameraClockOffset = false;
+
+        /// Largest correction either way the online estimate may apply to the
+        /// camera timestamps, in microseconds.
+        std::int32_t maxCameraClockCorrectionMicroseconds = 20000;
+
+        /// If not empty, also publish each body's pose, as it's reported, to
+        /// the shared memory region of this name, for other processes to read
+        /// with the reader in PoseSharedMemoryC.h.
+        std::string poseSharedMemoryName = "";
+
+        /// Poses kept per body in the shared memory region's history ring.
+        int poseSharedMemoryHistory = 64;
+
         /// Should we permit a reset to be "soft" (blended by a Kalman) rather
         /// than a hard state setting, in certain conditions? Only available in
         /// the Unified tracker.
@@ -280,7 +385,86 @@ namespace uvbi {
         /// Soft reset data incorporation parameter: Orientation variance
         double softResetOrientationVariance = 1.e0;
 
+        /// Should RANSAC pose estimation (used to acquire and re-acquire
+        /// tracking) use the built-in P3P-based RANSAC, which samples the
+        /// beacons most likely to be right first and tries the last pose
+        /// before sampling at all, instead of OpenCV's solvePnPRansac? Off
+        /// until its reacquisition has been compared against OpenCV's on
+        /// recorded data.
+        bool guidedRansac = false;
+
+        /// Upper bound on the P3P samples the guided RANSAC draws per
+        /// estimate: it usually stops well before.
+        int ransacMaxSamples = 64;
+
+        /// Confidence at which the guided RANSAC stops sampling.
+        double ransacConfidence = 0.99;
+
+        /// Should the guided RANSAC score its pose hypotheses in parallel?
+        /// Only worthwhile with many beacons in view.
+        bool ransacParallelScoring = false;
+
+        /// @name Thread scheduling
+        /// Placement and priority of the tracker and image processing
+        /// threads, to keep frame times steady on a busy machine. Settings
+        /// the OS refuses (for lack of privileges, usually) are warned about
+        /// and otherwise ignored.
+        /// @{
+        /// CPUs the tracker thread may run on: empty for any.
+        std::vector<int> trackerThreadCpus;
+
+        /// CPUs the image processing thread may run on: empty for any.
+        /// OpenCV's worker threads (see numThreads) are restarted from that
+        /// thread, so they run on these CPUs too.
+        std::vector<int> imageThreadCpus;
+
+        /// If positive, run both threads with this real-time (SCHED_FIFO)
+        /// priority, from 1 to 99, instead of the usual time-sharing. On
+        /// Windows, any positive value means time-critical priority.
+        int realtimePriority = 0;
+
+        /// If not using real-time priority, nice value to run both threads
+        /// at: negative for more CPU time than other processes get.
+        int threadNiceness = 0;
+
+        /// Should all the process's memory be locked into RAM, so the
+        /// threads never wait on a page fault? Later allocations fail once
+        /// the locked-memory limit (ulimit -l) is reached.
+        bool lockMemory = false;
+
+        /// Should each frame's scheduling delays be measured? These are the
+        /// time from the tracker thread asking for a frame to the image
+        /// processing thread waking up to get it, and from that finishing to
+        /// the tracker thread picking it up. They're recorded in the metrics,
+        /// summarized when tracking stops, and logged for every frame to
+        /// scheduling.csv.
+        bool measureSchedulingJitter = false;
+        /// @}
+
         ConfigParams();
     };
+
+    /// @name Pipeline stages of the parameters
+    /// Tracking a frame goes through three stages: extracting blobs from the
+    /// image (stage 1), matching the blobs to LEDs and identifying those by
+    /// their blink codes (stage 2), and estimating poses from the identified
+    /// LEDs (stage 3). These compare the parameters read by the first two:
+    /// every other parameter is read only by pose estimation, or doesn't
+    /// affect the tracking results at all.
+    /// @{
+    /// Whether blob extraction finds the same blobs in a frame under both sets
+    /// of parameters.
+    bool haveSameBlobExtractionParams(ConfigParams const &a,
+                                      ConfigParams const &b);
+
+    /// Whether the parameters read by blob extraction and LED identification
+    /// are the same in both sets, so that those stages, given the same frame
+    /// and the same LEDs from the frame before, leave the same LEDs.
+    ///
+    /// Always false if either has pose-assisted identification on: that makes
+    /// identification depend on the pose estimates, and so on every parameter.
+    bool haveSameLedIdentificationParams(ConfigParams const &a,
+                                         ConfigParams const &b);
+    /// @}
 } // namespace uvbi
 } // namespace videotracker
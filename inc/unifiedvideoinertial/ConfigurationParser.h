@@ -87,6 +87,9 @@ namespace uvbi {
     inline ConfigParams parseConfigParams(Json::Value const &root) {
         ConfigParams config;
         config.debug = root.get("showDebug", false).asBool();
+        getOptionalParameter(config.debugStride, root, "debugStride");
+        getOptionalParameter(config.debugAsync, root, "debugAsync");
+        getOptionalParameter(config.debugQueueSize, root, "debugQueueSize");
 
         // Target set, first and foremost.
         auto targetSet = getEnumFromStringParameter(root, "targetSet",
@@ -145,10 +148,21 @@ namespace uvbi {
                              "continuousReporting");
         getOptionalParameter(config.extraVerbose, root, "extraVerbose");
         getOptionalParameter(config.highGain, root, "highGain");
+        getOptionalParameter(config.replayPath, root, "replayPath");
+        getOptionalParameter(config.replaySpeed, root, "replaySpeed");
         getOptionalParameter(config.calibrationFile, root, "calibrationFile");
+        getOptionalParameter(config.warmStartFile, root, "warmStartFile");
+        getOptionalParameter(config.warmStartSaveInterval, root,
+                             "warmStartSaveInterval");
+        getOptionalParameter(config.warmStartRoomCalibration, root,
+                             "warmStartRoomCalibration");
 
         getOptionalParameter(config.additionalPrediction, root,
                              "additionalPrediction");
+        getOptionalParameter(config.latestPoseReporting, root,
+                             "latestPoseReporting");
+        getOptionalParameter(config.lazyReplay, root, "lazyReplay");
+        getOptionalParameter(config.lazyReplayBatch, root, "lazyReplayBatch");
         getOptionalParameter(config.maxResidual, root, "maxResidual");
         getOptionalParameter(config.initialBeaconError, root,
                              "initialBeaconError");
@@ -156,9 +170,23 @@ namespace uvbi {
                              "blobMoveThreshold");
         getOptionalParameter(config.blobsKeepIdentity, root,
                              "blobsKeepIdentity");
+        getOptionalParameter(config.poseAssistedIdentification, root,
+                             "poseAssistedIdentification");
+        getOptionalParameter(config.poseAssistedIdMaxDistance, root,
+                             "poseAssistedIdMaxDistance");
+        getOptionalParameter(config.poseAssistedIdAmbiguityRatio, root,
+                             "poseAssistedIdAmbiguityRatio");
         getOptionalParameter(config.numThreads, root, "numThreads");
         getOptionalParameter(config.cameraMicrosecondsOffset, root,
                              "cameraMicrosecondsOffset");
+        getOptionalParameter(config.estimateCameraClockOffset, root,
+                             "estimateCameraClockOffset");
+        getOptionalParameter(config.maxCameraClockCorrectionMicroseconds, root,
+                             "maxCameraClockCorrectionMicroseconds");
+        getOptionalParameter(config.poseSharedMemoryName, root,
+                             "poseSharedMemoryName");
+        getOptionalParameter(config.poseSharedMemoryHistory, root,
+                             "poseSharedMemoryHistory");
         getOptionalParameter(config.streamBeaconDebugInfo, root,
                              "streamBeaconDebugInfo");
 
@@ -213,6 +241,25 @@ namespace uvbi {
         getOptionalParameter(config.softResetOrientationVariance, root,
                              "softResetOrientationVariance");
 
+        /// RANSAC parameters
+        getOptionalParameter(config.guidedRansac, root, "guidedRansac");
+        getOptionalParameter(config.ransacMaxSamples, root,
+                             "ransacMaxSamples");
+        getOptionalParameter(config.ransacConfidence, root,
+                             "ransacConfidence");
+        getOptionalParameter(config.ransacParallelScoring, root,
+                             "ransacParallelScoring");
+
+        /// Thread scheduling parameters
+        getOptionalParameter(config.trackerThreadCpus, root,
+                             "trackerThreadCpus");
+        getOptionalParameter(config.imageThreadCpus, root, "imageThreadCpus");
+        getOptionalParameter(config.realtimePriority, root, "realtimePriority");
+        getOptionalParameter(config.threadNiceness, root, "threadNiceness");
+        getOptionalParameter(config.lockMemory, root, "lockMemory");
+        getOptionalParameter(config.measureSchedulingJitter, root,
+                             "measureSchedulingJitter");
+
         /// Blob-detection parameters
         if (root.isMember("blobParams")) {
             parseBlobParams(root["blobParams"], config.blobParams);
@@ -240,6 +287,8 @@ namespace uvbi {
                                  "angularVelocityVariance");
             getOptionalParameter(config.imu.angularVelocityMicrosecondsOffset,
                                  imu, "angularVelocityMicrosecondsOffset");
+            getOptionalParameter(config.imu.preintegrationSeconds, imu,
+                                 "preintegrationSeconds");
         }
 
         return config;
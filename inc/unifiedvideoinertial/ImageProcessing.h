@@ -25,25 +25,81 @@
 #pragma once
 
 // Internal Includes
+#include "LazyColorFrame.h"
 #include "videotrackershared/CameraParameters.h"
 #include "videotrackershared/LedMeasurement.h"
 
 // Library/third-party includes
-#include "TimeValue.h"
+#include "Timestamp.h"
 #include <opencv2/core/core.hpp>
 
 // Standard includes
+#include <cstddef>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 namespace videotracker {
 namespace uvbi {
     struct ImageProcessingOutput {
-        util::TimeValue tv;
+        util::Timestamp tv;
         LedMeasurementVec ledMeasurements;
-        cv::Mat frame;
+        /// Only made from frameGray if the debug display asks for it.
+        LazyColorFrame frame;
         cv::Mat frameGray;
         CameraParameters camParams;
     };
-    using ImageOutputDataPtr = std::unique_ptr<ImageProcessingOutput>;
+
+    class ImageProcessingOutputPool;
+
+    /// Deleter for ImageProcessingOutput: hands it back to the pool it came
+    /// from, if any, once its frame is done with.
+    class ImageProcessingOutputRecycler {
+      public:
+        /// Just deletes: for outputs made with plain new.
+        ImageProcessingOutputRecycler() = default;
+        explicit ImageProcessingOutputRecycler(
+            std::shared_ptr<ImageProcessingOutputPool> const &pool)
+            : m_pool(pool) {}
+        void operator()(ImageProcessingOutput *output) const;
+
+      private:
+        std::shared_ptr<ImageProcessingOutputPool> m_pool;
+    };
+
+    using ImageOutputDataPtr =
+        std::unique_ptr<ImageProcessingOutput, ImageProcessingOutputRecycler>;
+
+    /// Recycles the image processing outputs of retired frames, so the
+    /// containers in them keep their capacity for the next frames instead of
+    /// being allocated afresh each time.
+    ///
+    /// Outputs are usually made on one thread and retired on another, so
+    /// this locks. Outputs hold the pool alive until they retire.
+    class ImageProcessingOutputPool
+        : public std::enable_shared_from_this<ImageProcessingOutputPool> {
+      public:
+        /// Outputs kept for reuse beyond this many are deleted instead: a
+        /// frame is rarely further along than the image processing thread,
+        /// the tracker thread, and the replay of a recording.
+        static const std::size_t MaxIdleOutputs = 4;
+
+        static std::shared_ptr<ImageProcessingOutputPool> create();
+
+        /// An output with no measurements and no frame, allocated only if
+        /// there are none idle.
+        ImageOutputDataPtr acquire();
+
+        /// Outputs waiting in the pool to be reused.
+        std::size_t idle() const;
+
+      private:
+        ImageProcessingOutputPool();
+        friend class ImageProcessingOutputRecycler;
+        void release(ImageProcessingOutput *output);
+
+        mutable std::mutex m_mutex;
+        std::vector<std::unique_ptr<ImageProcessingOutput>> m_idle;
+    };
 } // namespace uvbi
 } // namespace videotracker
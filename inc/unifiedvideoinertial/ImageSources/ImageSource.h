@@ -28,7 +28,7 @@
 // - none
 
 // Library/third-party includes
-#include "../TimeValue.h"
+#include "../Timestamp.h"
 #include <opencv2/core/core.hpp>
 
 // Standard includes
@@ -56,15 +56,21 @@ namespace uvbi {
 
         /// Call after grab() to get the actual image data.
         virtual void retrieve(cv::Mat &color, cv::Mat &gray,
-                              util::TimeValue &timestamp);
+                              util::Timestamp &timestamp);
 
         /// @overload
         /// discards timestamp.
         inline void retrieve(cv::Mat &color, cv::Mat &gray) {
-            util::TimeValue ts;
+            util::Timestamp ts;
             retrieve(color, gray, ts);
         }
 
+        /// Call after grab() to get just the grayscale image, for consumers
+        /// that don't need color. The default implementation goes through
+        /// retrieve(); sources whose native format isn't color should
+        /// override it to skip making a color image at all.
+        virtual void retrieveGray(cv::Mat &gray, util::Timestamp &timestamp);
+
         /// Get resolution of the images from this source.
         virtual cv::Size resolution() const = 0;
 
@@ -72,11 +78,11 @@ namespace uvbi {
         /// overriding just this method will let the default implementation of
         /// retrieve() do the RGB to Gray for you.
         virtual void retrieveColor(cv::Mat &color,
-                                   util::TimeValue &timestamp) = 0;
+                                   util::Timestamp &timestamp) = 0;
         /// @overload
         /// discards timestamp.
         inline void retrieveColor(cv::Mat &color) {
-            util::TimeValue ts;
+            util::Timestamp ts;
             retrieveColor(color, ts);
         }
 
@@ -31,7 +31,8 @@
 // - none
 
 // Standard includes
-// - none
+#include <cstddef>
+#include <string>
 
 namespace videotracker {
 namespace uvbi {
@@ -55,8 +56,65 @@ namespace uvbi {
     /// onward as an image source (looping)
     ImageSourcePtr openImageFileSequence(std::string const &dir);
 
+    /// How a replay image source paces the frames it delivers from grab().
+    enum class ReplayPacing {
+        /// Frames are delivered at the wall-clock intervals between their
+        /// recorded timestamps, like the live camera would.
+        RealTime,
+        /// Like RealTime, with the intervals divided by
+        /// ReplayOptions::speed.
+        Scaled,
+        /// No waiting: frames are delivered as fast as they can be read and
+        /// decoded, for benchmarking.
+        MaxSpeed
+    };
+
+    struct ReplayOptions {
+        ReplayPacing pacing = ReplayPacing::RealTime;
+        /// Playback speed multiplier for ReplayPacing::Scaled.
+        double speed = 1.;
+        /// Maximum number of decoded frames read ahead of the consumer by the
+        /// background thread.
+        std::size_t prefetchFrames = 8;
+        /// Start over at the first frame after the last, with timestamps
+        /// continuing to increase, instead of ending the replay.
+        bool loop = false;
+        /// Frame rate used to make up timestamps for image sequences that
+        /// were not recorded with any.
+        double defaultFrameRate = 100.;
+        /// Report frame timestamps on the steady clock, as live frames are,
+        /// rather than as offline ones: the first frame at the time it is
+        /// delivered, and the rest at their recorded offsets from it divided
+        /// by the speed (or at the time they are delivered, for
+        /// ReplayPacing::MaxSpeed). Needed when the frames are used alongside
+        /// live data.
+        bool steadyTimestamps = false;
+    };
+
+    /// Factory method to replay a recording as an image source, streaming
+    /// frames from disk with a bounded read-ahead instead of loading them all
+    /// up front.
+    ///
+    /// The path is either a raw frame file (see RawFrameFile.h) or a
+    /// directory of images named 0001.tif and onward. A directory may also
+    /// contain a timestamps.txt file, with one decimal timestamp in seconds
+    /// per line for each frame in order, to replay with recorded timing.
+    ///
+    /// Returns a null pointer if the recording couldn't be opened. grab()
+    /// returns false once the replay ends (unless looping).
+    ImageSourcePtr openReplay(std::string const &path,
+                              ReplayOptions const &opts = ReplayOptions{});
+
+    /// Factory method to replay any kind of recording: raw frame files and
+    /// paths without an extension (taken to be image directories) are opened
+    /// with openReplay(), anything else as a video file with openVideoFile()
+    /// (see VideoFileImageSource.h).
+    ImageSourcePtr openRecording(std::string const &path,
+                                 ReplayOptions const &opts = ReplayOptions{});
+
     /// Factory method to wrap an image source, already determined to be an
-    /// Oculus DK2 camera, with unscrambling and keep-alive code.
+    /// Oculus DK2 camera, with unscrambling and keep-alive code. Only built
+    /// with the UVBI_BUILD_DK2 CMake option.
     ImageSourcePtr openDK2WrappedCamera(ImageSourcePtr &&cam, bool doHid);
 } // namespace uvbi
 } // namespace videotracker
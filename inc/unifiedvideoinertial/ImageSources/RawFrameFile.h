@@ -0,0 +1,96 @@
+/** @file
+    @brief Header for reading and writing a simple uncompressed container of
+    timestamped video frames, for recording the tracking camera and replaying
+    it with openReplay().
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+// Internal Includes
+#include "../TimeValue.h"
+
+// Library/third-party includes
+#include <opencv2/core/core.hpp>
+
+// Standard includes
+#include <cstddef>
+#include <fstream>
+#include <string>
+
+namespace videotracker {
+namespace uvbi {
+    /// File name extension that openReplay() recognizes as a raw frame file.
+    static const char RAW_FRAME_FILE_EXTENSION[] = ".uvbiraw";
+
+    /// Returns true if the file name ends in RAW_FRAME_FILE_EXTENSION.
+    bool isRawFrameFileName(std::string const &fn);
+
+    /// Writes frames, all the same size and type, with their timestamps to a
+    /// raw frame file.
+    ///
+    /// The format (host byte order) is an 8-byte magic string "UVBIRAW1",
+    /// then the width, height and OpenCV type as 32-bit integers, then for
+    /// each frame the timestamp seconds (64-bit) and microseconds (32-bit)
+    /// followed by the pixel rows.
+    class RawFrameWriter {
+      public:
+        /// Throws std::runtime_error if the file can't be created.
+        explicit RawFrameWriter(std::string const &fn);
+
+        /// Appends a frame. The first frame determines the size and type of
+        /// the file: throws std::invalid_argument if a later frame differs,
+        /// and std::runtime_error on a write error.
+        void write(cv::Mat const &frame, util::TimeValue const &timestamp);
+
+        std::size_t getFrameCount() const { return m_frames; }
+
+      private:
+        std::string m_fn;
+        std::ofstream m_os;
+        cv::Size m_size;
+        int m_type = -1;
+        std::size_t m_frames = 0;
+    };
+
+    /// Reads frames back from a file written by RawFrameWriter, in order.
+    class RawFrameReader {
+      public:
+        /// Throws std::runtime_error if the file can't be opened or doesn't
+        /// start with a valid header.
+        explicit RawFrameReader(std::string const &fn);
+
+        cv::Size size() const { return m_size; }
+        int type() const { return m_type; }
+
+        /// Reads the next frame, allocating the image if needed. Returns
+        /// false at the end of the file (a truncated final frame counts as
+        /// the end).
+        bool read(cv::Mat &frame, util::TimeValue &timestamp);
+
+        /// Goes back to the first frame.
+        void rewind();
+
+      private:
+        std::ifstream m_is;
+        std::streampos m_firstFrame;
+        cv::Size m_size;
+        int m_type = -1;
+    };
+} // namespace uvbi
+} // namespace videotracker
@@ -0,0 +1,89 @@
+/** @file
+    @brief Header for an image source that decodes a video file ahead of the
+    consumer, on its own thread, with capture timestamps from a sidecar file.
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+// Internal Includes
+#include "ImageSourceFactories.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace videotracker {
+namespace uvbi {
+    /// Counters describing how well the decoder thread of a video file source
+    /// keeps up with its consumer.
+    struct VideoDecodeStats {
+        /// Number of frames in the preallocated pool.
+        std::size_t poolFrames = 0;
+        std::size_t framesDecoded = 0;
+        std::size_t framesDelivered = 0;
+        /// Times the decoder found the pool full and had to wait for the
+        /// consumer: the consumer is the bottleneck.
+        std::size_t decoderWaits = 0;
+        /// Times grab() found no decoded frame and had to wait for the
+        /// decoder: decoding is the bottleneck.
+        std::size_t consumerWaits = 0;
+        /// Total time grab() spent waiting for the decoder.
+        std::chrono::nanoseconds consumerWaitTime{0};
+        /// Total time spent decoding.
+        std::chrono::nanoseconds decodeTime{0};
+        /// Most decoded frames ever waiting for the consumer at once.
+        std::size_t maxFramesQueued = 0;
+    };
+
+    /// An image source playing back a video file, with extra statistics.
+    class VideoFileImageSource : public ImageSource {
+      public:
+        /// Gets a consistent snapshot of the decoder statistics: may be
+        /// called from any thread.
+        virtual VideoDecodeStats getDecodeStats() const = 0;
+
+      protected:
+        VideoFileImageSource() = default;
+    };
+
+    using VideoFileImageSourcePtr = std::unique_ptr<VideoFileImageSource>;
+
+    /// Factory method to play back a video file (anything cv::VideoCapture can
+    /// open) as an image source. Frames are decoded on a background thread
+    /// into a pool of opts.prefetchFrames preallocated images, and copied out
+    /// in retrieve(), so steady-state playback doesn't allocate.
+    ///
+    /// Capture timestamps are read from the sidecar file `<fn>.timestamps.txt`
+    /// if present (same format as the timestamps.txt of openReplay()), and
+    /// otherwise made up from the frame rate stored in the file, or
+    /// opts.defaultFrameRate if it has none. Pacing and looping are as for
+    /// openReplay(). Retrieving before the first grab(), or once grab() has
+    /// returned false, gives an empty image.
+    ///
+    /// Returns a null pointer if the file couldn't be opened or has no frames.
+    VideoFileImageSourcePtr
+    openVideoFile(std::string const &fn,
+                  ReplayOptions const &opts = ReplayOptions{});
+} // namespace uvbi
+} // namespace videotracker
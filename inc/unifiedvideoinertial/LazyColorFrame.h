@@ -0,0 +1,76 @@
+/** @file
+    @brief Header for a color frame that is only made from its grayscale
+    counterpart if someone actually asks for it.
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <opencv2/core/core.hpp>
+
+// Standard includes
+#include <cstdint>
+
+namespace videotracker {
+namespace uvbi {
+    /// The color version of a frame, for the few consumers that want one (the
+    /// debug display, recording): the tracker itself only needs gray.
+    ///
+    /// Holds a reference to the gray image and converts it the first time
+    /// get() is called, so headless runs never pay for the conversion,
+    /// allocation or copy. Copies share the gray image, and the color image
+    /// too if it had been made already.
+    ///
+    /// Not thread-safe: only one thread at a time may call get().
+    class LazyColorFrame {
+      public:
+        LazyColorFrame() = default;
+        /// Wraps a gray image, to be converted on demand.
+        explicit LazyColorFrame(cv::Mat const &gray) : m_gray(gray) {}
+
+        /// Wraps a color image that already exists, for consumers that got
+        /// one for free: get() then never converts anything.
+        static LazyColorFrame fromColor(cv::Mat const &color);
+
+        /// Deep copy, for handing to another thread: copies the color image
+        /// if it exists, otherwise the gray one (without converting).
+        LazyColorFrame clone() const;
+
+        bool empty() const { return m_gray.empty() && m_color.empty(); }
+
+        /// Whether the color image exists yet.
+        bool materialized() const { return !m_color.empty(); }
+
+        /// Gets the color image, converting from gray if this is the first
+        /// time it's been asked for.
+        cv::Mat const &get() const;
+
+        /// Total number of gray-to-color conversions get() has performed in
+        /// this process: should stay at zero in headless runs.
+        static std::uint64_t getConversionCount();
+
+      private:
+        cv::Mat m_gray;
+        mutable cv::Mat m_color;
+    };
+} // namespace uvbi
+} // namespace videotracker
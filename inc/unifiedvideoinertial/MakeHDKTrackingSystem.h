@@ -211,11 +211,11 @@ namespace uvbi {
         }
     }
 
-    inline std::unique_ptr<TrackingSystem>
-    makeHDKTrackingSystem(ConfigParams const &params) {
+    /// Builds the (cleaned and validated) beacon setup data for the HDK
+    /// described by the config params, in meters and in the tracker's body
+    /// coordinate system.
+    inline TargetSetupData makeHDKTargetSetupData(ConfigParams const &params) {
         auto silent = params.silent;
-
-        std::unique_ptr<TrackingSystem> sys(new TrackingSystem(params));
 #ifdef UVBI_DEBUG_EMISSION_DIRECTION
         {
             auto xform = getTransform<float>();
@@ -225,12 +225,6 @@ namespace uvbi {
         auto sampleBeacons = {5, 32, 9, 10};
 #endif
 
-        auto hmd = sys->createTrackedBody();
-        if (!hmd) {
-            throw std::runtime_error(
-                "Could not create a tracked body for the HMD!");
-        }
-
         const auto numFrontBeacons = getNumHDKFrontPanelBeacons();
         const auto numRearBeacons = getNumHDKRearPanelBeacons();
         const auto useRear = params.includeRearPanel;
@@ -348,8 +342,21 @@ namespace uvbi {
         }
 
         /// Clean and validate the data.
-        auto summary = data.cleanAndValidate(params.silent);
+        data.cleanAndValidate(params.silent);
+        return data;
+    }
+
+    inline std::unique_ptr<TrackingSystem>
+    makeHDKTrackingSystem(ConfigParams const &params) {
+        std::unique_ptr<TrackingSystem> sys(new TrackingSystem(params));
+
+        auto hmd = sys->createTrackedBody();
+        if (!hmd) {
+            throw std::runtime_error(
+                "Could not create a tracked body for the HMD!");
+        }
 
+        auto data = makeHDKTargetSetupData(params);
         auto opticalTarget = hmd->createTarget(
 #if 0
             Eigen::Vector3d(0, 0, 0.04141),
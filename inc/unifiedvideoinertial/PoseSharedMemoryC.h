@@ -0,0 +1,141 @@
+/** @file
+    @brief Header for reading the poses the tracker publishes to shared memory
+    from another process.
+
+    Must be c-safe!
+
+    @date 2026
+*/
+
+/*
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#pragma once
+
+/* Internal Includes */
+#include "APIBaseC.h"
+#include "MathTypesC.h"
+#include "TimeValueC.h"
+
+/* Library/third-party includes */
+/* none */
+
+/* Standard includes */
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup PoseSharedMemory Shared-memory pose publication
+    @brief Poses of the tracked bodies, published by the tracker to a named
+    shared memory region (the poseSharedMemoryName config parameter) so
+    other processes on the same machine can read them without going through
+    the plugin.
+
+    For each body, the region holds the newest pose, and a ring of the most
+    recent ones. The tracker never waits on readers: a read that overlaps a
+    write is retried, and a reader that falls more than the ring's length
+    behind just misses the overwritten poses.
+
+    @{
+*/
+
+/** @brief Version of the shared memory layout: a reader only opens a region
+    with the same version. */
+#define UVBI_POSE_SHM_VERSION 1
+
+/** @brief A pose of a body, in room space, as published by the tracker. */
+typedef struct UVBI_PoseSample {
+    /** @brief Count of poses published for this body up to and including
+        this one: starts at 1, so 0 means "none". */
+    uint64_t sequence;
+    /** @brief Time of the pose on the monotonic clock the tracker stamps
+        live data with (std::chrono::steady_clock, which is CLOCK_MONOTONIC
+        on Linux), in nanoseconds. Only comparable between processes if
+        clockDomain is 0. */
+    int64_t monotonicNanoseconds;
+    /** @brief The same time on the wall clock. */
+    UVBI_TimeValue wallTime;
+    /** @brief 0 if the time is from the monotonic clock, 1 if from the wall
+        clock, or 2 if from recorded or synthetic data. */
+    uint32_t clockDomain;
+    uint32_t reserved;
+    OSVR_Pose3 pose;
+    /** @brief Linear velocity, in m/s. */
+    UVBI_Vec3 linearVelocity;
+    /** @brief Angular velocity as a room-space rotation vector, in rad/s. */
+    UVBI_Vec3 angularVelocity;
+    /** @brief Variances of the position along each axis, in m^2. */
+    UVBI_Vec3 positionVariance;
+    /** @brief Variances of the orientation about each axis, in rad^2. */
+    UVBI_Vec3 orientationVariance;
+} UVBI_PoseSample;
+
+/** @brief Opaque handle to a shared memory region opened for reading. */
+typedef struct UVBI_PoseReaderObject *UVBI_PoseReader;
+
+/** @brief Opens the region the tracker publishes to under the given name.
+
+    @return NULL if there's no such region, or it has a different layout
+    version.
+*/
+UVBI_PoseReader uvbiPoseReaderOpen(const char *name);
+
+/** @brief Closes a region opened with uvbiPoseReaderOpen(). Does nothing if
+    the reader is NULL. */
+void uvbiPoseReaderClose(UVBI_PoseReader reader);
+
+/** @brief Whether the tracker still has the region open: 1 if so, 0 once it
+    has shut down (or if the reader is NULL). */
+int uvbiPoseReaderIsPublishing(UVBI_PoseReader reader);
+
+/** @brief Number of bodies the region holds poses for. */
+uint32_t uvbiPoseReaderGetBodyCount(UVBI_PoseReader reader);
+
+/** @brief Number of the most recent poses kept for each body. */
+uint32_t uvbiPoseReaderGetHistoryLength(UVBI_PoseReader reader);
+
+/** @brief Reads the newest pose of a body.
+
+    @return 1 if a pose was read into dest, 0 if none has been published yet
+    (or the body index is out of range), or -1 if the tracker kept writing
+    the pose faster than it could be read.
+*/
+int uvbiPoseReaderGetLatest(UVBI_PoseReader reader, uint32_t body,
+                            UVBI_PoseSample *dest);
+
+/** @brief Reads the poses of a body newer than a given sequence number,
+    oldest first, as far back as the ring goes.
+
+    @param afterSequence Sequence number of the newest pose already seen,
+    or 0 for all that are kept.
+    @param dest Array to read the poses into.
+    @param maxSamples Size of dest: the newest maxSamples poses are read if
+    there are more.
+
+    @return Number of poses read into dest.
+*/
+size_t uvbiPoseReaderGetHistory(UVBI_PoseReader reader, uint32_t body,
+                                uint64_t afterSequence, UVBI_PoseSample *dest,
+                                size_t maxSamples);
+
+/** @} */
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
@@ -0,0 +1,213 @@
+/** @file
+    @brief Header for a deterministic synthetic scene generator: renders the
+    beacons of one or more targets, blinking their patterns, as seen by a
+    camera, and optionally produces matching IMU data.
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+// Internal Includes
+#include "BeaconSetupData.h"
+#include "BodyIdTypes.h"
+#include "videotrackershared/CameraParameters.h"
+
+// Library/third-party includes
+#include "Timestamp.h"
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+#include <opencv2/core/core.hpp>
+
+// Standard includes
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace videotracker {
+namespace uvbi {
+    class TrackingSystem;
+
+    /// The pose of a body in camera space (the same space as the tracker's
+    /// body state: x right, y down, z forward from the camera) as a function
+    /// of time in seconds since the start of the scene.
+    using SyntheticTrajectory = std::function<Eigen::Isometry3d(double)>;
+
+    /// A body that doesn't move.
+    SyntheticTrajectory makeStaticTrajectory(Eigen::Isometry3d const &pose);
+
+    /// A body swaying smoothly around a center pose: each translation axis
+    /// (meters) and rotation axis (radians, applied in body space) follows a
+    /// sinusoid of the given amplitude, with phases and frequency multiples
+    /// chosen so the motion covers all six degrees of freedom without
+    /// repeating more often than once per period.
+    SyntheticTrajectory
+    makeSwayTrajectory(Eigen::Isometry3d const &center,
+                       Eigen::Vector3d const &linearAmplitude,
+                       Eigen::Vector3d const &angularAmplitude, double period);
+
+    struct SyntheticSceneParams {
+        /// Intrinsics and distortion used to render: the image size is taken
+        /// from here too.
+        CameraParameters camParams = getHDKCameraParameters();
+
+        /// Frames per second - frame n is rendered at time n / frameRate.
+        double frameRate = 100.;
+
+        /// Apparent radius, in meters at the beacon's distance, of a beacon
+        /// showing a "bright" (`*`) or "dim" (`.`) bit of its pattern.
+        double brightBeaconRadius = 0.009;
+        double dimBeaconRadius = 0.0055;
+        /// Smallest radius in pixels a visible beacon is drawn with.
+        double minBeaconRadiusPixels = 1.;
+
+        /// Gray levels.
+        double backgroundLevel = 10.;
+        double brightBeaconLevel = 255.;
+        double dimBeaconLevel = 200.;
+
+        /// Standard deviation, in gray levels, of per-pixel Gaussian noise.
+        double pixelNoise = 2.;
+
+        /// Beacons are visible if the camera is within this angle (radians)
+        /// of their emission direction.
+        double emissionHalfAngle = 75. * EIGEN_PI / 180.;
+
+        /// Beacons closer than this (meters) are not drawn.
+        double nearClip = 0.05;
+
+        /// Seed for all noise: the same seed and scene produce the same
+        /// frames and IMU samples regardless of the order they're requested
+        /// in.
+        std::uint32_t seed = 0;
+
+        /// IMU samples per second, for getIMUSamples().
+        double imuRate = 400.;
+
+        /// Rotation from camera space to the IMU's gravity-aligned (y up)
+        /// world frame. The default corresponds to a level camera.
+        Eigen::Quaterniond imuWorldFromCamera =
+            Eigen::Quaterniond(Eigen::AngleAxisd(EIGEN_PI,
+                                                 Eigen::Vector3d::UnitX()));
+
+        /// Standard deviation (radians) of the noise rotation applied to each
+        /// orientation sample, and (rad/s) of angular velocity noise.
+        double orientationNoise = 1.e-3;
+        double angularVelocityNoise = 1.e-2;
+
+        /// The timestamp of frame 0.
+        util::Timestamp startTime = {util::ClockDomain::Offline,
+                                     std::chrono::seconds(1000)};
+
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    };
+
+    /// One synthetic IMU report: an orientation and an angular velocity (as
+    /// an incremental rotation over dt, in body space) sampled at the same
+    /// time, like the HDK IMU produces.
+    struct SyntheticIMUSample {
+        BodyId body;
+        util::Timestamp tv;
+        Eigen::Quaterniond orientation;
+        Eigen::Quaterniond deltaQuat;
+        double dt;
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    };
+    using SyntheticIMUSampleVec =
+        std::vector<SyntheticIMUSample,
+                    Eigen::aligned_allocator<SyntheticIMUSample>>;
+
+    /// Renders the beacons of any number of targets, each moving along its
+    /// own trajectory and blinking its beacons' patterns (one bit per frame),
+    /// through a distorting camera, with noise. Beacons facing away from the
+    /// camera are culled; beacons occluding one another are not.
+    ///
+    /// Deterministic: rendering the same frame number always produces the
+    /// same image.
+    class SyntheticScene {
+      public:
+        explicit SyntheticScene(SyntheticSceneParams const &params);
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        /// Adds a body carrying the given (cleaned and validated) target,
+        /// such as from makeHDKTargetSetupData(). Beacons with empty or
+        /// disabled patterns are not drawn. Returns the body's ID, assigned
+        /// in order starting at 0 like TrackingSystem::createTrackedBody().
+        BodyId addBody(TargetSetupData const &target,
+                       SyntheticTrajectory trajectory);
+
+        std::size_t getNumBodies() const { return m_bodies.size(); }
+
+        SyntheticSceneParams const &getParams() const { return m_params; }
+
+        /// Renders a frame into a single-channel 8-bit image, reallocating it
+        /// only if needed.
+        void renderFrame(std::size_t frameNumber, cv::Mat &gray,
+                         util::Timestamp &timestamp);
+
+        /// Time of a frame, in seconds since the start of the scene.
+        double getFrameTime(std::size_t frameNumber) const;
+
+        util::Timestamp toTimestamp(double sceneTime) const;
+        double toSceneTime(util::Timestamp const &tv) const;
+
+        /// The ground-truth camera-space pose of a body at a given time.
+        Eigen::Isometry3d getTruePose(BodyId body, double sceneTime) const;
+        /// @overload
+        Eigen::Isometry3d getTruePose(BodyId body,
+                                      util::Timestamp const &tv) const {
+            return getTruePose(body, toSceneTime(tv));
+        }
+
+        /// Gets the IMU samples for all bodies in the scene-time interval
+        /// [begin, end), in time order.
+        SyntheticIMUSampleVec getIMUSamples(double begin, double end) const;
+
+        /// Number of beacons actually drawn in the most recent frame, for
+        /// sanity checks.
+        std::size_t getNumBeaconsDrawn() const { return m_beaconsDrawn; }
+
+      private:
+        struct Beacon {
+            Eigen::Vector3d location;
+            Eigen::Vector3d emissionDirection;
+            std::string pattern;
+        };
+        struct Body {
+            std::vector<Beacon> beacons;
+            SyntheticTrajectory trajectory;
+        };
+        void drawBeacon(cv::Mat &image, Eigen::Vector2d const &center,
+                        double radius, double level) const;
+        Eigen::Quaterniond getIMUOrientation(std::size_t body,
+                                             double sceneTime) const;
+
+        SyntheticSceneParams m_params;
+        std::vector<Body> m_bodies;
+        std::size_t m_beaconsDrawn = 0;
+    };
+
+    /// Feeds a synthetic IMU sample to the IMU of the body it names, as
+    /// TrackerThread would with a real report. The body must have been
+    /// created with an integrated IMU.
+    void applySyntheticIMUSample(TrackingSystem &system,
+                                 SyntheticIMUSample const &sample);
+} // namespace uvbi
+} // namespace videotracker
@@ -41,6 +41,9 @@
 
 /* Standard includes */
 #include <stdint.h>
+#ifndef __cplusplus
+#include <stdbool.h>
+#endif
 
 #if defined(_WIN32) && !defined(__MINGW32__)
 #define KALMANFRAMEWORK_HAVE_STRUCT_TIMEVAL_IN_WINSOCK2_H
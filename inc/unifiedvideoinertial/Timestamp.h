@@ -0,0 +1,226 @@
+/** @file
+    @brief Header for the monotonic, 64-bit nanosecond time base of the
+    tracking core.
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+// Internal Includes
+#include "TimeValue.h"
+#include "videotrackershared/Assert.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <chrono>
+#include <cstdint>
+
+namespace videotracker {
+namespace util {
+    /// The clock a Timestamp was read from: only timestamps from the same
+    /// domain can be compared or subtracted.
+    enum class ClockDomain : std::uint8_t {
+        /// std::chrono::steady_clock: monotonic, so not affected by the wall
+        /// clock being set. Live data is stamped in this domain.
+        Steady,
+        /// The wall clock, as read by util::time::getNow(): the time since
+        /// the Unix epoch that TimeValues from the C API hold.
+        System,
+        /// The timeline of recorded or synthetic data, unrelated to the
+        /// clocks of the current run.
+        Offline
+    };
+
+    /// A point in time as a signed 64-bit count of nanoseconds since the
+    /// epoch of its clock domain, so comparing and subtracting them is plain
+    /// integer arithmetic, with no normalizing as for a TimeValue.
+    ///
+    /// The tracking core uses these throughout: TimeValues are converted to
+    /// and from them only at the C API boundary.
+    ///
+    /// A default-constructed Timestamp, at zero, stands for "no time yet" and
+    /// is taken to be the epoch of every domain, so it may be compared with
+    /// timestamps from any of them.
+    class Timestamp {
+      public:
+        using rep = std::int64_t;
+        using duration = std::chrono::nanoseconds;
+
+        Timestamp() = default;
+        Timestamp(ClockDomain domain, duration sinceEpoch)
+            : m_ns(sinceEpoch.count()), m_domain(domain) {}
+
+        /// Reads the clock of a domain, which can't be ClockDomain::Offline.
+        static Timestamp now(ClockDomain domain = ClockDomain::Steady) {
+            VIDEOTRACKER_ASSERT_MSG(domain != ClockDomain::Offline,
+                                    "Offline time has no clock to read!");
+            if (domain == ClockDomain::System) {
+                return fromTimeValue(time::getNow(), ClockDomain::System);
+            }
+            return Timestamp{
+                ClockDomain::Steady,
+                std::chrono::duration_cast<duration>(
+                    std::chrono::steady_clock::now().time_since_epoch())};
+        }
+
+        /// The same time as a TimeValue, which need not be normalized, taken
+        /// to be in the given domain.
+        static Timestamp fromTimeValue(TimeValue const &tv,
+                                       ClockDomain domain) {
+            return Timestamp{domain,
+                             std::chrono::seconds(tv.seconds) +
+                                 std::chrono::microseconds(tv.microseconds)};
+        }
+
+        /// The same time as a normalized TimeValue, to the microsecond.
+        TimeValue toTimeValue() const {
+            TimeValue ret;
+            /// Both parts truncate toward zero, so they share a sign.
+            ret.seconds = m_ns / NanosecondsPerSecond;
+            ret.microseconds = static_cast<UVBI_TimeValue_Microseconds>(
+                (m_ns % NanosecondsPerSecond) / 1000);
+            return ret;
+        }
+
+        rep count() const { return m_ns; }
+        duration sinceEpoch() const { return duration{m_ns}; }
+        ClockDomain domain() const { return m_domain; }
+
+        /// Whether this may be compared with or subtracted from other.
+        bool comparableWith(Timestamp const &other) const {
+            return m_domain == other.m_domain || m_ns == 0 || other.m_ns == 0;
+        }
+
+        template <typename Rep, typename Period>
+        Timestamp &operator+=(std::chrono::duration<Rep, Period> const &d) {
+            m_ns += std::chrono::duration_cast<duration>(d).count();
+            return *this;
+        }
+
+        template <typename Rep, typename Period>
+        Timestamp &operator-=(std::chrono::duration<Rep, Period> const &d) {
+            m_ns -= std::chrono::duration_cast<duration>(d).count();
+            return *this;
+        }
+
+      private:
+        static const rep NanosecondsPerSecond = 1000000000;
+        rep m_ns = 0;
+        ClockDomain m_domain = ClockDomain::Steady;
+    };
+
+    namespace detail {
+        inline void checkComparable(Timestamp const &a, Timestamp const &b) {
+            VIDEOTRACKER_ASSERT_MSG(a.comparableWith(b),
+                                    "Timestamps from different clock domains "
+                                    "can't be compared!");
+            (void)a;
+            (void)b;
+        }
+    } // namespace detail
+
+    inline bool operator<(Timestamp const &a, Timestamp const &b) {
+        detail::checkComparable(a, b);
+        return a.count() < b.count();
+    }
+    inline bool operator>(Timestamp const &a, Timestamp const &b) {
+        return b < a;
+    }
+    inline bool operator<=(Timestamp const &a, Timestamp const &b) {
+        return !(b < a);
+    }
+    inline bool operator>=(Timestamp const &a, Timestamp const &b) {
+        return !(a < b);
+    }
+    inline bool operator==(Timestamp const &a, Timestamp const &b) {
+        detail::checkComparable(a, b);
+        return a.count() == b.count();
+    }
+    inline bool operator!=(Timestamp const &a, Timestamp const &b) {
+        return !(a == b);
+    }
+
+    /// The time from b to a.
+    inline Timestamp::duration operator-(Timestamp const &a,
+                                         Timestamp const &b) {
+        detail::checkComparable(a, b);
+        return Timestamp::duration{a.count() - b.count()};
+    }
+
+    template <typename Rep, typename Period>
+    inline Timestamp operator+(Timestamp ts,
+                               std::chrono::duration<Rep, Period> const &d) {
+        return ts += d;
+    }
+
+    template <typename Rep, typename Period>
+    inline Timestamp operator-(Timestamp ts,
+                               std::chrono::duration<Rep, Period> const &d) {
+        return ts -= d;
+    }
+
+    namespace time {
+        /// @brief Get a double containing seconds between the timestamps
+        /// (a - b).
+        inline double duration(Timestamp const &a, Timestamp const &b) {
+            return std::chrono::duration<double>(a - b).count();
+        }
+
+        /// The current time in the tracking core's time base.
+        inline Timestamp getSteadyNow() {
+            return Timestamp::now(ClockDomain::Steady);
+        }
+
+        /// Moves a wall-clock timestamp into the steady domain, taking it to
+        /// be as old as the wall clock says it is now. Timestamps from other
+        /// domains are returned as they are.
+        inline Timestamp toSteady(Timestamp const &ts) {
+            if (ts.domain() != ClockDomain::System) {
+                return ts;
+            }
+            auto age = Timestamp::now(ClockDomain::System) - ts;
+            return Timestamp::now(ClockDomain::Steady) - age;
+        }
+
+        /// Moves a steady timestamp onto the wall clock, the inverse of
+        /// toSteady(). Timestamps from other domains are returned as they
+        /// are.
+        inline Timestamp toSystem(Timestamp const &ts) {
+            if (ts.domain() != ClockDomain::Steady) {
+                return ts;
+            }
+            auto age = Timestamp::now(ClockDomain::Steady) - ts;
+            return Timestamp::now(ClockDomain::System) - age;
+        }
+
+        /// Converts a wall-clock TimeValue from the C API into the tracking
+        /// core's time base.
+        inline Timestamp fromApiTimeValue(TimeValue const &tv) {
+            return toSteady(Timestamp::fromTimeValue(tv, ClockDomain::System));
+        }
+
+        /// Converts a timestamp from the tracking core into a wall-clock
+        /// TimeValue for the C API.
+        inline TimeValue toApiTimeValue(Timestamp const &ts) {
+            return toSystem(ts).toTimeValue();
+        }
+    } // namespace time
+} // namespace util
+} // namespace videotracker
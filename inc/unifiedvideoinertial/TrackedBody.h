@@ -31,7 +31,7 @@
 #include "ModelTypes.h"
 
 // Library/third-party includes
-#include "TimeValue.h"
+#include "Timestamp.h"
 #include "videotrackershared/Assert.h"
 #include <Eigen/Core>
 #include <Eigen/Geometry>
@@ -181,8 +181,8 @@ namespace uvbi {
         ///
         /// @return true if a state for the body has been recorded at or prior
         /// to desiredTime and has thus been returned in outTime and outState.
-        bool getStateAtOrBefore(util::TimeValue const &desiredTime,
-                                util::TimeValue &outTime, BodyState &outState);
+        bool getStateAtOrBefore(util::Timestamp const &desiredTime,
+                                util::Timestamp &outTime, BodyState &outState);
 
         /// This is the counterpart to getStateAtOrBefore() and should only be
         /// called subsequent to it. You provide the timestamp that you
@@ -194,22 +194,44 @@ namespace uvbi {
         /// replaced (or immediately followed, implementation detail) by this
         /// one: classes of newer measurements will be replayed on the state as
         /// required to update the current body state to properly incorporate
-        /// the presumably-dated information you just provided.
+        /// the presumably-dated information you just provided - right away,
+        /// or in lazy replay mode, later.
         ///
         /// @param origTime the timestamp originally received from
         /// getStateAtOrBefore() as `outTime`
         /// @param newTime the timestamp currently associated with the state
         /// @param newState the updated state.
-        void replaceStateSnapshot(util::TimeValue const &origTime,
-                                  util::TimeValue const &newTime,
+        void replaceStateSnapshot(util::Timestamp const &origTime,
+                                  util::Timestamp const &newTime,
                                   BodyState const &newState);
 
         /// Clean histories of no-longer-needed historical state and
         /// measurements.
-        void pruneHistory(util::TimeValue const &videoTime);
+        void pruneHistory(util::Timestamp const &videoTime);
+
+        /// @name Lazy replay
+        /// In lazy replay mode (ConfigParams::lazyReplay),
+        /// replaceStateSnapshot() just marks that the IMU measurements newer
+        /// than the snapshot need replaying, and the state stays at the
+        /// snapshot time until they are. Whoever needs a current state must
+        /// call finishPendingReplay() before getState(), and may call
+        /// replayPendingIMU() in idle time to get ahead.
+        /// @{
+        /// Are there IMU measurements left to replay?
+        bool hasPendingReplay() const;
+
+        /// Replays up to maxMeasurements pending IMU measurements (more, if
+        /// that would split some sharing a timestamp).
+        ///
+        /// @return true if none are left pending.
+        bool replayPendingIMU(std::size_t maxMeasurements);
+
+        /// Replays all pending IMU measurements.
+        void finishPendingReplay();
+        /// @}
 
         /// Get timestamp associated with current state.
-        util::TimeValue getStateTime() const;
+        util::Timestamp getStateTime() const;
 
         BodyProcessModel &getProcessModel() { return m_processModel; }
 
@@ -218,7 +240,7 @@ namespace uvbi {
 
         /// Incorporates a brand-new measurement from the IMU into the state.
         /// Called only from the TrackedBodyIMU itself, please!
-        void incorporateNewMeasurementFromIMU(util::TimeValue const &tv,
+        void incorporateNewMeasurementFromIMU(util::Timestamp const &tv,
                                               CannedIMUMeasurement const &meas);
 
         TrackingSystem &getSystem() { return m_system; }
@@ -228,15 +250,37 @@ namespace uvbi {
         /// Method used both when incorporating new measurements and replaying
         /// historical measurements: pushes to state history but not to IMU
         /// history.
-        void applyIMUMeasurement(util::TimeValue const &tv,
+        void applyIMUMeasurement(util::Timestamp const &tv,
                                  CannedIMUMeasurement const &meas);
+        /// Applies or preintegrates the measurement, as configured.
+        void useIMUMeasurement(util::Timestamp const &tv,
+                               CannedIMUMeasurement const &meas);
+        /// Replays pending IMU measurements, stopping after maxMeasurements
+        /// or before any newer than through, if not null.
+        ///
+        /// @return true if none are left pending.
+        bool replayIMU(std::size_t maxMeasurements,
+                       util::Timestamp const *through);
+        /// Are IMU measurements accumulated into windows rather than applied
+        /// one at a time?
+        bool isPreintegratingIMU() const;
+        /// Counterpart to applyIMUMeasurement() when preintegrating: adds the
+        /// measurement to the current window, applying the window once it's
+        /// long enough.
+        void preintegrateIMUMeasurement(util::Timestamp const &tv,
+                                        CannedIMUMeasurement const &meas);
+        /// Makes sure the state history has an entry that has seen every IMU
+        /// measurement up to time, replaying the preintegration windows
+        /// around it if need be, so a video update there doesn't lose the
+        /// measurements in a window spanning it.
+        void endPreintegrationWindowAt(util::Timestamp const &time);
         /// Pushes current state on to history: assumes you've already updated
         /// m_state and the stateTime.
         void pushState();
         TrackingSystem &m_system;
         const BodyId m_id;
 
-        util::TimeValue m_stateTime;
+        util::Timestamp m_stateTime;
         BodyState m_state;
         BodyProcessModel m_processModel;
         /// private implementation data
@@ -34,7 +34,7 @@
 
 // Library/third-party includes
 #include "FlexKalman/PureVectorState.h"
-#include "TimeValue.h"
+#include "Timestamp.h"
 #include "videotrackershared/Assert.h"
 
 // Standard includes
@@ -106,6 +106,21 @@ namespace uvbi {
         /// app
         Eigen::Vector3d getBeaconAutocalibVariance(ZeroBasedBeaconId i) const;
 
+        /// Full covariance of a beacon's autocalibrated position.
+        Eigen::Matrix3d
+        getBeaconAutocalibCovariance(ZeroBasedBeaconId i) const;
+
+        /// Where a beacon started out, before autocalibration, in the same
+        /// space as getBeaconAutocalibPosition().
+        Eigen::Vector3d getBeaconInitialPosition(ZeroBasedBeaconId i) const;
+
+        /// Replaces a beacon's autocalibrated position (in the same space as
+        /// getBeaconAutocalibPosition()) and its covariance, as when
+        /// restoring them from an earlier run.
+        void setBeaconAutocalib(ZeroBasedBeaconId i,
+                                Eigen::Vector3d const &position,
+                                Eigen::Matrix3d const &covariance);
+
         /// Reset beacon autocalibration position and variance.
         void resetBeaconAutocalib();
 
@@ -117,6 +132,25 @@ namespace uvbi {
         std::size_t
         processLedMeasurements(LedMeasurementVec const &undistortedLeds);
 
+        /// Called after processLedMeasurements() when pose-assisted
+        /// identification is on: gives blobs still waiting on their blink
+        /// code a provisional ID, by projecting the beacons from the pose
+        /// predicted for the frame. Does nothing unless tracking in Kalman
+        /// mode.
+        ///
+        /// @param camParams Camera parameters for the image source (no
+        /// distortion)
+        /// @param tv Time of the frame
+        /// @return number of blobs given a provisional ID.
+        std::size_t identifyLedsFromPose(CameraParameters const &camParams,
+                                         util::Timestamp const &tv);
+
+        /// Used in place of processLedMeasurements() (and
+        /// identifyLedsFromPose()) when replaying a frame whose second phase
+        /// has already been run: replaces the LEDs with a copy of those that
+        /// phase left, taken from a target set up the same way.
+        void restoreLeds(LedGroup const &leds);
+
         /// Override configured setting, disabling Kalman (normal) operating
         /// mode.
         void disableKalman();
@@ -128,9 +162,9 @@ namespace uvbi {
         /// Update the pose estimate using the updated LEDs - part of the third
         /// phase of tracking.
         bool updatePoseEstimateFromLeds(CameraParameters const &camParams,
-                                        util::TimeValue const &tv,
+                                        util::Timestamp const &tv,
                                         BodyState &bodyState,
-                                        util::TimeValue const &startingTime,
+                                        util::Timestamp const &startingTime,
                                         bool validStateAndTime);
 
         /// Perform a simple RANSAC pose estimation from updated LEDs (third
@@ -159,7 +193,7 @@ namespace uvbi {
         /// pose estimate?
         bool hasPoseEstimate() const { return m_hasPoseEstimate; }
 
-        util::TimeValue const &getLastUpdate() const;
+        util::Timestamp const &getLastUpdate() const;
 
         /// Get the offset that was subtracted from all beacon positions upon
         /// initialization.
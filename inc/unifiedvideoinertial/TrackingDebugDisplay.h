@@ -33,8 +33,15 @@
 #include <opencv2/core/core.hpp>
 
 // Standard includes
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
 #include <iosfwd>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 
 namespace videotracker {
 struct CameraParameters;
@@ -50,18 +57,27 @@ namespace uvbi {
     class TrackingSystem;
     class TrackingSystem_Impl;
     class TrackedBodyTarget;
+    struct DebugDisplaySnapshot;
     class TrackingDebugDisplay {
       public:
         TrackingDebugDisplay(ConfigParams const &params);
+        ~TrackingDebugDisplay();
 
         TrackingDebugDisplay(TrackingDebugDisplay const &) = delete;
         TrackingDebugDisplay &operator=(TrackingDebugDisplay const &) = delete;
 
+        /// Called by the tracking system after each frame. Every so many
+        /// frames, copies out what the current mode needs to draw: then
+        /// either draws and shows it right away, or (by default) queues it
+        /// for the display thread, dropping the oldest queued frame if the
+        /// display thread is falling behind.
         void triggerDisplay(TrackingSystem &tracking,
                             TrackingSystem_Impl const &impl);
 
         void showDebugImage(cv::Mat const &image, bool needsCopy = true);
 
+        /// Stops displaying and closes the window: may be called from any
+        /// thread.
         void quitDebug();
         cv::Mat createStatusImage(TrackingSystem const &tracking,
                                   CameraParameters const &camParams,
@@ -69,17 +85,45 @@ namespace uvbi {
                                   bool reprojectUnseenBeacons = false);
 
       private:
+        using SnapshotPtr = std::unique_ptr<DebugDisplaySnapshot>;
         std::ostream &msg() const;
-        cv::Mat createAnnotatedBlobImage(TrackingSystem const &tracking,
-                                         CameraParameters const &camParams,
-                                         cv::Mat const &blobImage);
+        SnapshotPtr takeSnapshot(TrackingSystem_Impl const &impl,
+                                 TrackingSystem const &tracking,
+                                 DebugDisplayMode mode);
+        cv::Mat render(DebugDisplaySnapshot &snap);
+        cv::Mat renderAnnotatedBlobImage(DebugDisplaySnapshot &snap);
+        cv::Mat renderStatusImage(DebugDisplaySnapshot &snap,
+                                  cv::Mat const &baseImage,
+                                  bool reprojectUnseenBeacons);
+        /// Renders, shows and handles key presses: on the display thread if
+        /// there is one.
+        void display(DebugDisplaySnapshot &snap);
+        void handleKey(int key);
+        void displayThread();
 
-        bool m_enabled;
-        DebugDisplayMode m_mode = DebugDisplayMode::Status;
+        std::atomic<bool> m_enabled;
+        std::atomic<DebugDisplayMode> m_mode;
+        /// Set by the 'o' key, acted on by the tracking thread.
+        std::atomic<bool> m_toggleIMURequested{false};
         std::string m_windowName;
+        /// Only touched by whichever thread shows the window.
+        bool m_windowShown = false;
         cv::Mat m_displayedFrame;
         ::util::Stride m_debugStride;
         const bool m_performingOptimization;
+
+        /// @name Asynchronous display
+        /// @{
+        const bool m_async;
+        const std::size_t m_queueSize;
+        std::mutex m_queueMutex;
+        std::condition_variable m_queueCondVar;
+        std::deque<SnapshotPtr> m_queue;
+        /// Tells the display thread to close the window and exit: set on
+        /// shutdown, or by quitDebug().
+        bool m_stop = false;
+        std::thread m_thread;
+        /// @}
     };
 } // namespace uvbi
 } // namespace videotracker
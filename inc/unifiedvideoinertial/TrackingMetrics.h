@@ -0,0 +1,353 @@
+/** @file
+    @brief Header for a lock-free registry of per-stage latency histograms,
+    allocation counts, counters, and gauges describing tracking pipeline
+    performance.
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+// Internal Includes
+#include "AllocationCounting.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+namespace videotracker {
+namespace uvbi {
+    /// Pipeline stages for which latency is recorded.
+    ///
+    /// If you add an entry here, also update getMetricName() and bump
+    /// NumMetricStages.
+    enum class MetricStage {
+        /// ImageSource::retrieve() on the image processing thread.
+        ImageRetrieve,
+        /// Blob extraction and undistortion (phase one).
+        BlobExtraction,
+        /// The blob extractor itself, within BlobExtraction: the image
+        /// processing that finds the blobs.
+        BlobDetection,
+        /// LED assignment and identification (phase two).
+        LedUpdate,
+        /// Pose estimation and state history replay (phase three).
+        PoseEstimation,
+        /// The debug display, if enabled.
+        DebugDisplay,
+        /// Phases two and three plus debug display, as seen by the caller.
+        VideoUpdate,
+        /// Time between a frame's timestamp and the end of its video update.
+        FrameLatency,
+        /// Processing a single IMU message on the tracker thread.
+        ImuMessage,
+        /// Time from the tracker thread asking for a frame to the image
+        /// processing thread waking up to get it. Only measured if
+        /// measureSchedulingJitter is set.
+        ImageThreadWakeup,
+        /// Time from the image processing thread finishing a frame to the
+        /// tracker thread picking it up, including any IMU message it was
+        /// busy with. Only measured if measureSchedulingJitter is set.
+        TrackerThreadWakeup
+    };
+    static const std::size_t NumMetricStages = 11;
+
+    /// Monotonically increasing event counts.
+    enum class MetricCounter {
+        /// Frames that completed the video update.
+        Frames,
+        /// Frames lost to a failed camera grab or retrieve.
+        DroppedFrames,
+        /// Hard and soft tracking resets, summed over all targets.
+        TrackingResets,
+        /// IMU messages accepted by the tracker thread.
+        ImuMessages,
+        /// IMU messages refused because the tracker thread queue was full.
+        ImuQueueOverflows,
+        /// Kalman corrections made from IMU data, including those replayed
+        /// after a video update.
+        ImuCorrections,
+        /// Updates refused because a body reporting queue was full.
+        ReportQueueOverflows,
+        /// Frames the asynchronous debug display dropped undrawn because it
+        /// was still busy with earlier ones.
+        DebugFramesDropped,
+        /// Blobs that went from unidentified to identified, whether by blink
+        /// code or provisionally.
+        BeaconIdentifications,
+        /// Frames each of those blobs had been seen in by then, summed:
+        /// divide by BeaconIdentifications for the mean frames to
+        /// identification.
+        BeaconIdentificationFrames,
+        /// Provisional IDs given by pose-assisted identification.
+        ProvisionalBeaconIds,
+        /// Provisional IDs the blink code turned out to disagree with.
+        ProvisionalBeaconIdsRefuted
+    };
+    static const std::size_t NumMetricCounters = 12;
+
+    /// Instantaneous values, or maxima where so noted.
+    enum class MetricGauge {
+        /// Maximum size ever reached by any body's state history.
+        StateHistoryHighWaterMark,
+        /// Maximum size ever reached by any body's IMU measurement history.
+        ImuHistoryHighWaterMark,
+        /// LED measurements extracted from the most recent frame.
+        LedMeasurements,
+        /// Bodies updated by the most recent frame.
+        BodiesUpdated,
+        /// Correction applied to the most recent frame's timestamp by the
+        /// online camera clock offset estimate, in microseconds.
+        CameraClockCorrection,
+        /// Drift of that correction, in parts per billion.
+        CameraClockSkew
+    };
+    static const std::size_t NumMetricGauges = 6;
+
+    const char *getMetricName(MetricStage stage);
+    const char *getMetricName(MetricCounter counter);
+    const char *getMetricName(MetricGauge gauge);
+
+    /// A read-only copy of a LatencyHistogram, suitable for computing
+    /// percentiles without touching the live atomics.
+    class LatencyHistogramSnapshot {
+      public:
+        /// Number of bits of precision kept within each power-of-two range:
+        /// values are recorded with a relative error of at most 1/16.
+        static const std::size_t SubBucketBits = 4;
+        static const std::size_t SubBucketCount = std::size_t(1)
+                                                  << SubBucketBits;
+        /// Enough buckets to cover the whole 64-bit range.
+        static const std::size_t BucketCount =
+            (64 - SubBucketBits + 1) * SubBucketCount;
+        using CountArray = std::array<std::uint64_t, BucketCount>;
+
+        /// Maps a value (nanoseconds) to its bucket index.
+        static std::size_t bucketIndex(std::uint64_t value);
+        /// Smallest value that maps to the given bucket.
+        static std::uint64_t bucketLowerBound(std::size_t index);
+        /// Largest value that maps to the given bucket.
+        static std::uint64_t bucketUpperBound(std::size_t index);
+
+        std::uint64_t count() const { return m_count; }
+        bool empty() const { return m_count == 0; }
+        std::chrono::nanoseconds max() const {
+            return std::chrono::nanoseconds(m_max);
+        }
+        std::chrono::nanoseconds mean() const;
+
+        /// Returns the value at the given percentile (in [0, 100]): the upper
+        /// bound of the bucket containing that rank, clamped to the maximum
+        /// recorded value. Returns zero if empty.
+        std::chrono::nanoseconds percentile(double pct) const;
+
+        CountArray const &buckets() const { return m_buckets; }
+
+      private:
+        friend class LatencyHistogram;
+        CountArray m_buckets = {};
+        std::uint64_t m_count = 0;
+        std::uint64_t m_sum = 0;
+        std::uint64_t m_max = 0;
+    };
+
+    /// Log-linear ("HDR"-style) histogram of durations. Recording is wait-free
+    /// apart from the maximum, which uses a compare-exchange loop that only
+    /// retries while a larger value is racing in.
+    class LatencyHistogram {
+      public:
+        LatencyHistogram();
+        LatencyHistogram(LatencyHistogram const &) = delete;
+        LatencyHistogram &operator=(LatencyHistogram const &) = delete;
+
+        void record(std::chrono::nanoseconds duration);
+        template <typename Rep, typename Period>
+        void record(std::chrono::duration<Rep, Period> const &duration) {
+            record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                duration));
+        }
+
+        /// Copies the current contents. Concurrent recordings may or may not
+        /// be included, and the totals may be off by the handful of values
+        /// recorded during the copy, but no value is ever torn.
+        LatencyHistogramSnapshot snapshot() const;
+
+        void reset();
+
+      private:
+        using AtomicCount = std::atomic<std::uint64_t>;
+        std::array<AtomicCount, LatencyHistogramSnapshot::BucketCount>
+            m_buckets;
+        AtomicCount m_sum;
+        AtomicCount m_max;
+    };
+
+    /// Heap allocations made within the measured scopes of a stage.
+    struct StageAllocationSnapshot {
+        /// Scopes whose allocations were counted.
+        std::uint64_t scopes = 0;
+        AllocationCount total;
+    };
+
+    /// Consistent-enough copy of all metrics at one point in time.
+    struct TrackingMetricsSnapshot {
+        std::array<LatencyHistogramSnapshot, NumMetricStages> stages;
+        /// All zero unless allocationCountingEnabled().
+        std::array<StageAllocationSnapshot, NumMetricStages> allocations;
+        std::array<std::uint64_t, NumMetricCounters> counters = {};
+        std::array<std::int64_t, NumMetricGauges> gauges = {};
+
+        LatencyHistogramSnapshot const &get(MetricStage stage) const {
+            return stages[static_cast<std::size_t>(stage)];
+        }
+        std::uint64_t get(MetricCounter counter) const {
+            return counters[static_cast<std::size_t>(counter)];
+        }
+        std::int64_t get(MetricGauge gauge) const {
+            return gauges[static_cast<std::size_t>(gauge)];
+        }
+        StageAllocationSnapshot const &getAllocations(MetricStage stage) const {
+            return allocations[static_cast<std::size_t>(stage)];
+        }
+    };
+
+    /// Writes a human-readable, one-metric-per-line summary: stage latencies
+    /// in microseconds as count/mean/p50/p90/p99/max, then allocations and
+    /// bytes per scope and per frame for the stages that counted them, then
+    /// counters and gauges.
+    std::ostream &operator<<(std::ostream &os,
+                             TrackingMetricsSnapshot const &snap);
+
+    /// The registry of everything measured about the tracking pipeline. All
+    /// methods may be called from any thread; none of them take a lock.
+    class TrackingMetrics {
+      public:
+        using clock = std::chrono::steady_clock;
+
+        TrackingMetrics() = default;
+        TrackingMetrics(TrackingMetrics const &) = delete;
+        TrackingMetrics &operator=(TrackingMetrics const &) = delete;
+
+        void record(MetricStage stage, std::chrono::nanoseconds duration) {
+            m_stages[static_cast<std::size_t>(stage)].record(duration);
+        }
+        template <typename Rep, typename Period>
+        void record(MetricStage stage,
+                    std::chrono::duration<Rep, Period> const &duration) {
+            record(stage, std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              duration));
+        }
+
+        /// Adds the allocations made within one scope of a stage.
+        void recordAllocations(MetricStage stage, AllocationCount const &count);
+
+        void increment(MetricCounter counter, std::uint64_t n = 1) {
+            m_counters[static_cast<std::size_t>(counter)].fetch_add(
+                n, std::memory_order_relaxed);
+        }
+
+        void setGauge(MetricGauge gauge, std::int64_t value) {
+            m_gauges[static_cast<std::size_t>(gauge)].store(
+                value, std::memory_order_relaxed);
+        }
+
+        /// Raises the gauge to value if it is currently lower - for
+        /// high-water marks.
+        void raiseGauge(MetricGauge gauge, std::int64_t value);
+
+        LatencyHistogram const &get(MetricStage stage) const {
+            return m_stages[static_cast<std::size_t>(stage)];
+        }
+
+        TrackingMetricsSnapshot snapshot() const;
+
+        /// Clears all histograms, counters, and gauges. Values recorded
+        /// concurrently may survive the reset.
+        void reset();
+
+      private:
+        std::array<LatencyHistogram, NumMetricStages> m_stages;
+        struct StageAllocations {
+            std::atomic<std::uint64_t> scopes;
+            std::atomic<std::uint64_t> allocations;
+            std::atomic<std::uint64_t> bytes;
+        };
+        std::array<StageAllocations, NumMetricStages> m_allocations = {};
+        std::array<std::atomic<std::uint64_t>, NumMetricCounters> m_counters =
+            {};
+        std::array<std::atomic<std::int64_t>, NumMetricGauges> m_gauges = {};
+    };
+
+    /// RAII helper: if allocation counting is enabled, records the heap
+    /// allocations the calling thread makes from construction to destruction
+    /// against a stage.
+    class ScopedAllocationCounter {
+      public:
+        ScopedAllocationCounter(TrackingMetrics &metrics, MetricStage stage)
+            : m_metrics(metrics), m_stage(stage),
+              m_enabled(allocationCountingEnabled()) {
+            if (m_enabled) {
+                m_start = getThreadAllocationCount();
+            }
+        }
+        ~ScopedAllocationCounter() {
+            if (m_enabled) {
+                m_metrics.recordAllocations(
+                    m_stage, getThreadAllocationCount() - m_start);
+            }
+        }
+        ScopedAllocationCounter(ScopedAllocationCounter const &) = delete;
+        ScopedAllocationCounter &
+        operator=(ScopedAllocationCounter const &) = delete;
+
+      private:
+        TrackingMetrics &m_metrics;
+        const MetricStage m_stage;
+        const bool m_enabled;
+        AllocationCount m_start;
+    };
+
+    /// RAII helper: records the time from construction to destruction into a
+    /// stage histogram, and counts the allocations made meanwhile.
+    class ScopedStageTimer {
+      public:
+        ScopedStageTimer(TrackingMetrics &metrics, MetricStage stage)
+            : m_allocations(metrics, stage), m_metrics(metrics),
+              m_stage(stage), m_start(TrackingMetrics::clock::now()) {}
+        ~ScopedStageTimer() {
+            m_metrics.record(m_stage, TrackingMetrics::clock::now() - m_start);
+        }
+        ScopedStageTimer(ScopedStageTimer const &) = delete;
+        ScopedStageTimer &operator=(ScopedStageTimer const &) = delete;
+
+      private:
+        /// Constructed first and destroyed last, so the timing is the
+        /// innermost measurement.
+        ScopedAllocationCounter m_allocations;
+        TrackingMetrics &m_metrics;
+        const MetricStage m_stage;
+        const TrackingMetrics::clock::time_point m_start;
+    };
+} // namespace uvbi
+} // namespace videotracker
@@ -31,24 +31,53 @@
 #include "videotrackershared/CameraParameters.h"
 
 // Library/third-party includes
-#include "TimeValue.h"
+#include "Timestamp.h"
 #include <Eigen/Core>
 #include <Eigen/Geometry>
 #include <opencv2/core/core.hpp>
 
 // Standard includes
+#include <chrono>
 #include <cstddef>
 #include <memory>
-#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace videotracker {
 namespace uvbi {
     class TrackedBody;
     class TrackedBodyTarget;
+    class TrackingMetrics;
+    class ClockOffsetEstimator;
     using BodyIndices = std::vector<BodyId>;
 
-    using LedUpdateCount = std::unordered_map<BodyTargetId, std::size_t>;
+    /// The targets that used LED measurements in a frame, each with the
+    /// number it used. A vector, so it keeps its storage from frame to frame.
+    using LedUpdateCount = std::vector<std::pair<BodyTargetId, std::size_t>>;
+
+    /// The LEDs the second phase of tracking left in each target, frame by
+    /// frame, as recorded during a run by
+    /// TrackingSystem::updateBodiesFromVideoData(), for later runs over the
+    /// same frames to replay with TrackingSystem::replayBodiesFromVideoData().
+    class LedStateRecording {
+      public:
+        LedStateRecording();
+        ~LedStateRecording();
+        LedStateRecording(LedStateRecording const &) = delete;
+        LedStateRecording &operator=(LedStateRecording const &) = delete;
+
+        /// Number of frames recorded.
+        std::size_t size() const;
+        bool empty() const { return size() == 0; }
+        void clear();
+
+        /// private impl;
+        struct Impl;
+
+      private:
+        friend class TrackingSystem;
+        std::unique_ptr<Impl> m_impl;
+    };
 
     class TrackingSystem_Impl;
     class TrackingSystem {
@@ -65,9 +94,13 @@ namespace uvbi {
         /// Perform the initial phase of image processing. This does not modify
         /// the bodies, so it can happen in parallel/background processing. It's
         /// also the most expensive, so that's handy.
-        ImageOutputDataPtr performInitialImageProcessing(
-            util::TimeValue const &tv, cv::Mat const &frame,
-            cv::Mat const &frameGray, CameraParameters const &camParams);
+        ///
+        /// Only the grayscale frame is needed: a color version is made from
+        /// it later if, and only if, the debug display wants one.
+        ImageOutputDataPtr
+        performInitialImageProcessing(util::Timestamp const &tv,
+                                      cv::Mat const &frameGray,
+                                      CameraParameters const &camParams);
         /// This is the second phase of the video-based tracking algorithm - the
         /// part that actually changes LED state.
         ///
@@ -78,8 +111,8 @@ namespace uvbi {
         /// not proceeding to the third and final phase, and still keep track of
         /// which beacons are which.
         ///
-        /// @return a reference to an internal map of body IDs to counts of
-        /// used LED measurements for debugging.
+        /// @return a reference to an internal list of the targets that used
+        /// LED measurements, with counts of them, for debugging.
         LedUpdateCount const &
         updateLedsFromVideoData(ImageOutputDataPtr &&imageData);
 
@@ -100,16 +133,41 @@ namespace uvbi {
         BodyIndices const &
         updateBodiesFromVideoData(ImageOutputDataPtr &&imageData);
 
+        /// For tools that run the same frames through the tracker many times,
+        /// changing only parameters that pose estimation reads (see
+        /// haveSameLedIdentificationParams()): the same as the overload
+        /// above, but also appends the LEDs the second phase left to the
+        /// recording.
+        BodyIndices const &
+        updateBodiesFromVideoData(ImageOutputDataPtr &&imageData,
+                                  LedStateRecording &recording);
+
+        /// Replays a recorded frame on a system set up the same way as the
+        /// one that recorded it: the same as updateBodiesFromVideoData(), but
+        /// instead of running the second phase, restores the LEDs it left in
+        /// the recorded run. The image data is still needed, for the time
+        /// and camera parameters.
+        ///
+        /// Pose estimation can refute identifications, so a run with
+        /// different parameters can end up with different LEDs from the
+        /// recorded run, at which point the recording no longer applies.
+        ///
+        /// @return false if this frame's pose estimation left the LEDs
+        /// different from how it left them in the recorded run: the frames
+        /// that follow must then go through updateBodiesFromVideoData().
+        bool replayBodiesFromVideoData(ImageOutputDataPtr &&imageData,
+                                       LedStateRecording const &recording,
+                                       std::size_t frame);
+
         /// All parts of the tracking algorithm combined for convenience.
         ///
         /// @return A reference to a vector of body indices that were
         /// updated with this latest frame.
-        BodyIndices const &processFrame(util::TimeValue const &tv,
-                                        cv::Mat const &frame,
+        BodyIndices const &processFrame(util::Timestamp const &tv,
                                         cv::Mat const &frameGray,
                                         CameraParameters const &camParams) {
             auto imageOutput =
-                performInitialImageProcessing(tv, frame, frameGray, camParams);
+                performInitialImageProcessing(tv, frameGray, camParams);
             return updateBodiesFromVideoData(std::move(imageOutput));
         }
         /// @}
@@ -126,11 +184,21 @@ namespace uvbi {
         }
         TrackedBodyTarget *getTarget(BodyTargetId target);
         TrackedBodyTarget const *getTarget(BodyTargetId target) const;
+
+        /// Access the performance metrics registry for this tracking system.
+        /// Safe to call (and to snapshot) from any thread.
+        TrackingMetrics &getMetrics();
+        TrackingMetrics const &getMetrics() const;
         /// @}
 
         /// @todo refactor;
         ConfigParams const &getParams() const { return m_params; }
 
+        /// The online estimate of the video timestamps' offset from the IMU's,
+        /// or nullptr if estimateCameraClockOffset isn't set. Only for use on
+        /// the tracking thread.
+        ClockOffsetEstimator *getClockOffsetEstimator();
+
         /// @todo just for debugging
         void setUseIMU(bool useIMU) { m_params.imu.useOrientation = useIMU; }
 
@@ -150,14 +218,27 @@ namespace uvbi {
 
         /// Called by TrackedBody::incorporateNewMeasurementFromIMU() if room
         /// calibration is not complete.
-        void calibrationHandleIMUData(BodyId id, util::TimeValue const &tv,
+        void calibrationHandleIMUData(BodyId id, util::Timestamp const &tv,
                                       Eigen::Quaterniond const &quat);
 
       private:
+        /// Takes the time and camera parameters of the frame whose LEDs are
+        /// being updated.
+        void updateFrameCache(ImageProcessingOutput const &imageData);
+
         /// The third phase of the tracking algorithm - LEDs have been updated
         /// with new measurements, we just need to estimate poses.
         void updatePoseEstimates();
 
+        /// Everything updateBodiesFromVideoData() does after the second phase,
+        /// starting with the third.
+        BodyIndices const &
+        finishVideoUpdate(std::chrono::steady_clock::time_point start);
+
+        /// Folds the residuals the pose estimates just handed to the clock
+        /// offset estimator into its estimate.
+        void updateClockOffsetEstimate();
+
         /// Alternate internals called by updatePoseEstimates() when room
         /// calibration is incomplete.
         void calibrationVideoPhaseThree();
@@ -31,7 +31,6 @@
 #include <opencv2/core/core.hpp>
 
 // Standard includes
-#include <deque>
 #include <string>
 #include <utility>
 #include <vector>
@@ -39,7 +38,9 @@
 namespace videotracker {
 
 typedef float Brightness;
-typedef std::deque<Brightness> BrightnessList;
+/// A vector, rather than a deque, so an LED's history keeps its storage as
+/// it is truncated from the front frame after frame.
+typedef std::vector<Brightness> BrightnessList;
 typedef std::pair<Brightness, Brightness> BrightnessMinMax;
 
 /// Pattern repeated almost twice
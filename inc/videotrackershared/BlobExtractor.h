@@ -68,6 +68,9 @@ struct ImageRangeInfo {
     explicit ImageRangeInfo(cv::InputArray img) {
         cv::minMaxIdx(img, &minVal, &maxVal);
     }
+    /// For when the range has been found along with something else.
+    ImageRangeInfo(double minimum, double maximum)
+        : minVal(minimum), maxVal(maximum) {}
     double minVal;
     double maxVal;
     double lerp(double alpha) const {
@@ -86,6 +86,26 @@ struct BlobParams {
     /// thus greatly impacts performance. Adjust with care. Not used by the
     /// EdgeHoleExtractor.
     int thresholdSteps = 4;
+
+    /// Should the SimpleBlobDetector-based extractors use
+    /// MultiThresholdBlobDetector - kept from frame to frame, and working on
+    /// all the thresholds in parallel - instead of creating a
+    /// cv::SimpleBlobDetector for each frame? Both find the same blobs.
+    bool multiThresholdDetector = false;
+
+    /// If positive, search coarse-to-fine: max-pool the frame into square
+    /// tiles this many pixels on a side, and run the extraction at full
+    /// resolution only on the regions around the tiles whose brightest
+    /// pixel reaches the minimum threshold, rather than on the whole frame.
+    /// Worth it for large, mostly-dark frames. 0 (the default) searches the
+    /// whole frame.
+    int coarseTileSize = 0;
+
+    /// If coarseTileSize is positive, the padding, in pixels, added around
+    /// each group of candidate tiles: must cover the part of a blob darker
+    /// than the threshold, and the reach of any filtering the extractor
+    /// does.
+    int coarseTileMargin = 8;
 };
 
 struct EdgeHoleParams {
@@ -121,6 +141,12 @@ struct EdgeHoleParams {
     /// If postEdgeDetectionBlur is true, the value used as a threshold to
     /// binarize the image after the blur.
     int postEdgeDetectionBlurThreshold;
+
+    /// Whether to find the holes in the binarized edge image with a single
+    /// labelling sweep that measures them as it goes (HoleLabeller), rather
+    /// than tracing each with findContours and measuring the contours
+    /// afterwards.
+    bool singlePassHoleLabelling;
 };
 
 } // namespace videotracker
@@ -54,6 +54,24 @@ class CameraDistortionModel {
         return undistorted;
     }
 
+    /// The inverse of undistortPoint(), computed by fixed-point iteration:
+    /// converges quickly for the mild distortion of real lenses.
+    Eigen::Vector2d distortPoint(Eigen::Vector2d const &pointd,
+                                 int iterations = 8) const {
+        Eigen::Vector2d normalizedUndistorted =
+            ((pointd - m_c).array() / m_fl.array()).matrix();
+        Eigen::Vector2d normalizedDistorted = normalizedUndistorted;
+        for (int i = 0; i < iterations; ++i) {
+            double r2 = normalizedDistorted.squaredNorm();
+            normalizedDistorted =
+                normalizedUndistorted /
+                (1 + m_k[0] * r2 + m_k[1] * r2 * r2 + m_k[2] * r2 * r2 * r2);
+        }
+        Eigen::Vector2d distorted =
+            (normalizedDistorted.array() * m_fl.array()).matrix() + m_c;
+        return distorted;
+    }
+
   private:
     Eigen::Vector2d m_fl;
     /// assumes center of project is also center of distortion
@@ -74,6 +74,16 @@ struct CameraParameters {
         return ret;
     }
 
+    /// Makes this an undistorted variant of other, like
+    /// createUndistortedVariant(), but in place, reusing the storage of the
+    /// distortion parameters.
+    void assignUndistortedVariant(CameraParameters const &other) {
+        cameraMatrix = other.cameraMatrix;
+        imageSize = other.imageSize;
+        distortionParameters.clear();
+        normalizeDistortionParameters();
+    }
+
     double focalLengthX() const { return cameraMatrix(0, 0); }
     double focalLengthY() const { return cameraMatrix(1, 1); }
     double focalLength() const { return focalLengthX(); }
@@ -0,0 +1,74 @@
+/** @file
+    @brief Header for the coarse half of a coarse-to-fine blob search: finding
+    the parts of a frame bright enough to be worth a full-resolution look.
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+// Internal Includes
+#include "BlobExtractor.h"
+
+// Library/third-party includes
+#include <opencv2/core/core.hpp>
+
+// Standard includes
+#include <vector>
+
+namespace videotracker {
+/// Max-pools a gray frame into square tiles, then picks out the regions
+/// around the tiles bright enough to hold a blob, so a blob extractor can
+/// search just those at full resolution (see BlobParams::coarseTileSize).
+///
+/// Every blob an extractor could accept has a pixel at least as bright as
+/// its minimum threshold, so it lies in or next to a candidate tile: given a
+/// large enough margin, searching the regions finds the same blobs as
+/// searching the whole frame.
+class CoarseTileSearch {
+  public:
+    /// Max-pools gray (CV_8UC1) into tiles tileSize pixels on a side (the
+    /// ones on the right and bottom edges may be smaller), returning the
+    /// range of the whole frame, found in the same pass: the same as
+    /// ImageRangeInfo(gray).
+    ImageRangeInfo pool(cv::Mat const &gray, int tileSize);
+
+    /// Regions of the frame from the last pool() to search, in its pixel
+    /// coordinates: the bounding box of each 8-connected group of tiles
+    /// whose maximum reaches threshold, padded by margin pixels, clipped to
+    /// the frame, and merged with any other it overlaps, so no pixel is in
+    /// two regions. Empty if no tile reaches threshold. If the regions
+    /// would cover more than half the frame, it's just the whole frame.
+    std::vector<cv::Rect> const &findRegions(double threshold, int margin);
+
+    std::vector<cv::Rect> const &getRegions() const { return regions_; }
+
+    /// The tile maxima from the last pool() (CV_8UC1), one pixel per tile.
+    cv::Mat const &getPooledImage() const { return pooled_; }
+
+  private:
+    cv::Size imageSize_;
+    int tileSize_ = 1;
+    cv::Mat pooled_;
+    std::vector<cv::Rect> regions_;
+    /// @name Scratch space for findRegions()
+    /// @{
+    std::vector<unsigned char> visited_;
+    std::vector<cv::Point> stack_;
+    /// @}
+};
+} // namespace videotracker
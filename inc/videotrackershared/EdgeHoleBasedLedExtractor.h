@@ -31,6 +31,8 @@
 // Internal Includes
 #include "BlobExtractor.h"
 #include "BlobParams.h"
+#include "CoarseTileSearch.h"
+#include "HoleLabeller.h"
 #include "LedMeasurement.h"
 #include "OpenCVVersion.h"
 
@@ -98,6 +100,8 @@ class EdgeHoleBasedLedExtractor {
     ExternalMatGetterReturn getEdgeDetectedBinarizedImage() const {
         return externalMatGetter(edgeBinary_);
     }
+    /// With singlePassHoleLabelling, these are the convex hulls of the
+    /// contours that would otherwise be traced.
     ContourList const &getContours() const { return contours_; }
     LedMeasurementVec const &getMeasurements() const { return measurements_; }
     RejectList const &getRejectList() const { return rejectList_; }
@@ -112,7 +116,18 @@ class EdgeHoleBasedLedExtractor {
         return input;
     }
 #endif
+    /// Edge detection and hole extraction on one region of gray_, which is
+    /// the whole frame unless searching coarse-to-fine.
+    void extractRegion(cv::Rect const &region, BlobParams const &p);
     void checkBlob(ContourType &&contour, BlobParams const &p);
+    /// Counterpart of checkBlob for a hole from holeLabeller_.
+    void checkHole(std::size_t hole, BlobParams const &p);
+    /// The checks common to both: returns true if the blob passes them, in
+    /// which case its measurement has been added. getConvexity is only
+    /// called if the convexity check is enabled and reached.
+    template <typename F>
+    bool checkBlobData(BlobData const &data, BlobParams const &p,
+                       F &&getConvexity);
     void addToRejectList(ContourId id, RejectReason reason,
                          BlobData const &data) {
         rejectList_.emplace_back(id, reason, data.center);
@@ -124,6 +139,8 @@ class EdgeHoleBasedLedExtractor {
     std::uint8_t minBeaconCenterVal_ = 127;
 
     /// @name Frames/intermediates someone might care about
+    /// @brief When searching coarse-to-fine, the edge images are only filled
+    /// in over the regions searched, and are zero elsewhere.
     /// @{
     MatType gray_;
     MatType edge_;
@@ -147,6 +164,18 @@ class EdgeHoleBasedLedExtractor {
     std::vector<cv::Vec4i> hierarchyTempStorage_;
     /// @}
 
+    /// Used instead of consumeHolesOfConnectedComponents if
+    /// extParams_.singlePassHoleLabelling.
+    HoleLabeller holeLabeller_;
+
+    /// Used if BlobParams::coarseTileSize is set.
+    CoarseTileSearch tileSearch_;
+    /// The regions of the frame searched last time.
+    std::vector<cv::Rect> searchedRegions_;
+    /// Where the region being searched starts: added to everything found in
+    /// it to put it in frame coordinates.
+    cv::Point regionOffset_;
+
     /// Erosion filter to remove spurious edges pointing out the camera gave
     /// us an mjpeg-compressed stream.
     cv::Mat compressionArtifactRemovalKernel_;
@@ -46,7 +46,7 @@ class EdgeHoleBlobExtractor : public GenericBlobExtractor {
   protected:
     cv::Mat generateDebugThresholdImage_() const override;
     cv::Mat generateDebugBlobImage_() const override;
-    LedMeasurementVec extractBlobs_() override;
+    void extractBlobs_(LedMeasurementVec &measurements) override;
 
   private:
     BlobParams m_params;
@@ -54,7 +54,10 @@ class GenericBlobExtractor {
   protected:
     virtual cv::Mat generateDebugThresholdImage_() const = 0;
     virtual cv::Mat generateDebugBlobImage_() const = 0;
-    virtual LedMeasurementVec extractBlobs_() = 0;
+    /// Replaces the contents of measurements with the blobs in the latest
+    /// gray image: it's the same vector every frame, so its storage gets
+    /// reused.
+    virtual void extractBlobs_(LedMeasurementVec &measurements) = 0;
     GenericBlobExtractor() = default;
 
   private:
@@ -31,7 +31,7 @@
 #include <json/value.h>
 
 // Standard includes
-// - none
+#include <vector>
 
 namespace videotracker {
 namespace detail {
@@ -75,4 +75,18 @@ inline void getOptionalParameter(T (&dest)[N], Json::Value const &obj,
         dest[i] = json_cast<T>(node[i]);
     }
 }
+/// Gets an optional array parameter of any length from a JSON object: if
+/// it's not present, or not an array, the existing value is left there.
+template <typename T>
+inline void getOptionalParameter(std::vector<T> &dest, Json::Value const &obj,
+                                 const char *key) {
+    Json::Value const &node = obj[key];
+    if (!node.isArray()) {
+        return;
+    }
+    dest.clear();
+    for (Json::Value::ArrayIndex i = 0; i < node.size(); ++i) {
+        dest.push_back(json_cast<T>(node[i]));
+    }
+}
 } // namespace videotracker
@@ -0,0 +1,163 @@
+/** @file
+    @brief Header for a single-pass connected-component labeller that finds
+    the holes in a binary image along with their shape statistics.
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+// Internal Includes
+#include "BlobExtractor.h"
+
+// Library/third-party includes
+#include <opencv2/core/core.hpp>
+
+// Standard includes
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace videotracker {
+/// Statistics of one hole, all accumulated pixel by pixel.
+///
+/// The derived shape measures are those of the contour cv::findContours
+/// would trace around the hole (through the centers of the non-zero pixels
+/// 4-adjacent to it), worked out from the crack edges and corners of the
+/// hole, so they closely match what getBlobDataFromContour() reports for
+/// that contour: exactly, for a hole without islands.
+struct HoleStats {
+    /// @name Raw moments of the hole pixels
+    /// @{
+    std::int64_t m00 = 0;
+    std::int64_t m10 = 0;
+    std::int64_t m01 = 0;
+    /// @}
+
+    /// @name Bounds of the hole pixels (inclusive)
+    /// @{
+    int minX = 0;
+    int minY = 0;
+    int maxX = 0;
+    int maxY = 0;
+    /// @}
+
+    /// Edges between a hole pixel and a non-zero pixel.
+    int crackEdges = 0;
+    /// @name Sums of the coordinates of the hole pixel of each crack edge
+    /// @{
+    std::int64_t crackX = 0;
+    std::int64_t crackY = 0;
+    /// @}
+    /// Pixel corners the hole's crack boundary turns around convexly...
+    int convexCorners = 0;
+    /// ...and concavely.
+    int concaveCorners = 0;
+    /// @name Sums of the centroids of the bits of area added or taken away
+    /// at each corner, in 1/24ths of a pixel
+    /// @{
+    std::int64_t cornerX24 = 0;
+    std::int64_t cornerY24 = 0;
+    /// @}
+
+    /// @name Intensity moments, from the gray image passed in
+    /// @{
+    std::int64_t intensity = 0;
+    std::int64_t intensityX = 0;
+    std::int64_t intensityY = 0;
+    /// @}
+
+    /// Adds in the statistics of another part of the same hole.
+    void merge(HoleStats const &other);
+
+    /// Centroid of the contour polygon.
+    cv::Point2d center() const;
+    /// Centroid of the hole pixels weighted by the gray image intensity:
+    /// falls back to center() for a hole that's black all through.
+    cv::Point2d intensityCentroid() const;
+    /// Area of the contour polygon.
+    double area() const;
+    /// Length of the contour polygon.
+    double perimeter() const;
+    /// Number of non-zero islands in the hole. The crack boundary turns
+    /// four more times convexly than concavely around the outside of the
+    /// hole, and four more times concavely than convexly around each island.
+    int islands() const {
+        return (4 - (convexCorners - concaveCorners)) / 4;
+    }
+    /// Bounding rectangle of the contour.
+    cv::Rect bounds() const {
+        return cv::Rect(minX - 1, minY - 1, maxX - minX + 3, maxY - minY + 3);
+    }
+    /// Everything but the contour itself, which would take another look at
+    /// the image: see HoleLabeller::getHull().
+    BlobData getBlobData() const;
+};
+
+/// Finds the holes in a binary image - the 4-connected regions of zero
+/// pixels that don't touch the image border - the way
+/// consumeHolesOfConnectedComponents() does, but in a single raster sweep of
+/// union-find labelling that gathers each hole's statistics as it goes,
+/// rather than tracing contours and then measuring them one by one.
+///
+/// As with cv::findContours, the one-pixel border of the image is treated as
+/// zero. Unlike it, the area and perimeter of a hole with non-zero islands
+/// in it (see HoleStats::islands()) are those of the hole pixels alone, not
+/// of the outline around everything - though single-pixel islands happen to
+/// come out the same either way.
+class HoleLabeller {
+  public:
+    /// Labels the holes of binary (CV_8UC1), weighting the intensity moments
+    /// by gray (CV_8UC1, same size). Holes come back in the raster order of
+    /// their first pixels.
+    std::vector<HoleStats> const &operator()(cv::Mat const &binary,
+                                             cv::Mat const &gray);
+
+    std::vector<HoleStats> const &getHoles() const { return holes_; }
+
+    /// Fills hull with the convex hull of the contour around a hole from the
+    /// last call, for convexity checks and display: a scan of the hole's
+    /// bounding box only.
+    void getHull(std::size_t hole, ContourType &hull);
+
+  private:
+    using Label = std::int32_t;
+    /// Label of the outside: the border, and everything connected to it.
+    static const Label Outside = 0;
+    /// Label of a non-zero pixel.
+    static const Label NotZero = -1;
+
+    Label newLabel();
+    Label find(Label label);
+    /// Joins the sets of the two labels, returning the root of the result.
+    Label unite(Label a, Label b);
+
+    cv::Mat labels_;
+    std::vector<Label> parent_;
+    /// Statistics per provisional label, merged into the roots at the end.
+    std::vector<HoleStats> provisional_;
+    /// Index into holes_ for each provisional label, -1 for the outside.
+    std::vector<std::int32_t> holeOfLabel_;
+    std::vector<HoleStats> holes_;
+    /// @name Scratch space for getHull()
+    /// @{
+    std::vector<int> colMin_;
+    std::vector<int> colMax_;
+    ContourType hullPoints_;
+    /// @}
+};
+} // namespace videotracker
@@ -71,9 +71,11 @@ findMinMaxBrightness(const BrightnessList &brightnesses) {
 /// @brief Helper for implementations of LedIdentifier to turn a
 /// brightness list into a boolean list based on thresholding on the
 /// halfway point between minimum and maximum brightness.
-inline LedPatternWrapped
-getBitsUsingThreshold(const BrightnessList &brightnesses, float threshold) {
-    LedPatternWrapped ret;
+///
+/// Writes into the given string, so a caller doing this every frame can
+/// reuse its storage.
+inline void getBitsUsingThreshold(const BrightnessList &brightnesses,
+                                  float threshold, LedPatternWrapped &ret) {
     // Allocate output space for our transform.
     ret.resize(brightnesses.size());
 
@@ -87,7 +89,13 @@ getBitsUsingThreshold(const BrightnessList &brightnesses, float threshold) {
                            return '.';
                        }
                    });
+}
 
+/// @overload
+inline LedPatternWrapped
+getBitsUsingThreshold(const BrightnessList &brightnesses, float threshold) {
+    LedPatternWrapped ret;
+    getBitsUsingThreshold(brightnesses, threshold, ret);
     return ret;
 }
 } // namespace videotracker
@@ -0,0 +1,94 @@
+/** @file
+    @brief Header for an in-tree, persistent equivalent of
+    cv::SimpleBlobDetector that finds the blobs at each threshold in parallel.
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+// Internal Includes
+#include "BlobExtractor.h"
+
+// Library/third-party includes
+#include <opencv2/core/core.hpp>
+#include <opencv2/features2d/features2d.hpp>
+
+// Standard includes
+#include <vector>
+
+namespace videotracker {
+/// Does what cv::SimpleBlobDetector does with the same parameters -
+/// binarize at each threshold from minThreshold up to (not including)
+/// maxThreshold, filter the contours at each, then group the blob centers
+/// across thresholds - to the same keypoints, but:
+///
+/// - it's meant to be kept around from frame to frame, reusing its buffers,
+///   rather than constructed per frame, and takes the parameters (whose
+///   thresholds typically change every frame) with each call;
+/// - the thresholds are independent until the grouping, so it binarizes and
+///   filters at all of them at once, on OpenCV's worker threads.
+class MultiThresholdBlobDetector {
+  public:
+    using Params = cv::SimpleBlobDetector::Params;
+
+    /// @param parallel Whether to process the thresholds in parallel.
+    explicit MultiThresholdBlobDetector(bool parallel = true)
+        : parallel_(parallel) {}
+
+    /// Finds the blobs in gray (CV_8UC1), replacing the contents of
+    /// keyPoints with them. Thresholds that leave nothing to do (a
+    /// thresholdStep of 0, as for a frame too dim to spread them out) just
+    /// find nothing.
+    void operator()(cv::Mat const &gray, Params const &params,
+                    std::vector<cv::KeyPoint> &keyPoints);
+
+    /// The number of thresholds the last call looked at.
+    std::size_t getNumThresholds() const { return numLevels_; }
+
+  private:
+    struct Center {
+        cv::Point2d location;
+        double radius;
+        double confidence;
+    };
+    /// Everything to do with one threshold, so they can be worked on
+    /// independently.
+    struct Level {
+        double threshold = 0;
+        cv::Mat binary;
+        /// Copy of binary for findContours to consume, if we need to check
+        /// blob color in binary afterwards.
+        cv::Mat contourInput;
+        ContourList contours;
+        ContourType hull;
+        std::vector<double> dists;
+        std::vector<Center> centers;
+    };
+    /// The per-threshold part: binarize, find contours, and filter them
+    /// into centers.
+    static void findBlobs(cv::Mat const &gray, Params const &params,
+                          Level &level);
+
+    bool parallel_;
+    /// Levels are only added to, so their buffers get reused.
+    std::vector<Level> levels_;
+    std::size_t numLevels_ = 0;
+    /// Groups of centers across thresholds, each sorted by radius.
+    std::vector<std::vector<Center>> groups_;
+};
+} // namespace videotracker
@@ -46,6 +46,10 @@ inline void parseBlobParams(Json::Value const &blob, BlobParams &p) {
     getOptionalParameter(p.minThresholdAlpha, blob, "minThresholdAlpha");
     getOptionalParameter(p.maxThresholdAlpha, blob, "maxThresholdAlpha");
     getOptionalParameter(p.thresholdSteps, blob, "thresholdSteps");
+    getOptionalParameter(p.multiThresholdDetector, blob,
+                         "multiThresholdDetector");
+    getOptionalParameter(p.coarseTileSize, blob, "coarseTileSize");
+    getOptionalParameter(p.coarseTileMargin, blob, "coarseTileMargin");
 }
 
 inline void parseEdgeHoleExtractorParams(Json::Value const &config,
@@ -62,5 +66,7 @@ inline void parseEdgeHoleExtractorParams(Json::Value const &config,
                          "postEdgeDetectionBlurSize");
     getOptionalParameter(p.postEdgeDetectionBlurThreshold, config,
                          "postEdgeDetectionBlurThreshold");
+    getOptionalParameter(p.singlePassHoleLabelling, config,
+                         "singlePassHoleLabelling");
 }
 } // namespace videotracker
@@ -26,9 +26,11 @@
 
 // Internal Includes
 #include "BlobParams.h"
+#include "CoarseTileSearch.h"
 #include "EdgeHoleBasedLedExtractor.h"
 #include "GenericBlobExtractor.h"
 #include "LedMeasurement.h"
+#include "MultiThresholdBlobDetector.h"
 
 // Library/third-party includes
 #include <opencv2/features2d/features2d.hpp>
@@ -72,6 +74,12 @@ class SBDBlobExtractor {
     BlobParams m_params;
     EdgeHoleBasedLedExtractor m_extractor;
     cv::SimpleBlobDetector::Params m_sbdParams;
+    /// Does what a cv::SimpleBlobDetector with m_sbdParams would: used if
+    /// BlobParams::multiThresholdDetector is set.
+    MultiThresholdBlobDetector m_detector;
+    /// Used if BlobParams::coarseTileSize is set: the EdgeHoleExtractor
+    /// has its own.
+    CoarseTileSearch m_tileSearch;
     LedMeasurementVec m_latestMeasurements;
 
     std::vector<cv::KeyPoint> m_keyPoints;
@@ -99,13 +107,18 @@ class SBDGenericBlobExtractor : public GenericBlobExtractor {
   protected:
     cv::Mat generateDebugThresholdImage_() const override;
     cv::Mat generateDebugBlobImage_() const override;
-    LedMeasurementVec extractBlobs_() override;
+    void extractBlobs_(LedMeasurementVec &measurements) override;
 
   private:
     void getKeypoints(cv::Mat const &grayImage);
     BlobParams m_params;
     std::vector<cv::KeyPoint> m_keyPoints;
     cv::SimpleBlobDetector::Params m_sbdParams;
+    /// Does what a cv::SimpleBlobDetector with m_sbdParams would: used if
+    /// BlobParams::multiThresholdDetector is set.
+    MultiThresholdBlobDetector m_detector;
+    /// Used if BlobParams::coarseTileSize is set.
+    CoarseTileSearch m_tileSearch;
 };
 
 BlobExtractorPtr makeBlobExtractor(BlobParams const &blobParams);
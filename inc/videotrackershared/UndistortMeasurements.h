@@ -39,11 +39,11 @@
 #include <vector>
 
 namespace videotracker {
-/// Perform the undistortion of LED measurements.
-inline LedMeasurementVec
-undistortLeds(LedMeasurementVec const &distortedMeasurements,
-              CameraParameters const &camParams) {
-    LedMeasurementVec ret;
+/// Perform the undistortion of LED measurements, into a vector whose
+/// contents are replaced, so its storage can be reused frame after frame.
+inline void undistortLeds(LedMeasurementVec const &distortedMeasurements,
+                          CameraParameters const &camParams,
+                          LedMeasurementVec &ret) {
     ret.resize(distortedMeasurements.size());
     auto distortionModel = CameraDistortionModel{
         Eigen::Vector2d{camParams.focalLengthX(), camParams.focalLengthY()},
@@ -58,6 +58,14 @@ undistortLeds(LedMeasurementVec const &distortedMeasurements,
     };
     std::transform(begin(distortedMeasurements), end(distortedMeasurements),
                    begin(ret), ledUndistort);
+}
+
+/// Perform the undistortion of LED measurements.
+inline LedMeasurementVec
+undistortLeds(LedMeasurementVec const &distortedMeasurements,
+              CameraParameters const &camParams) {
+    LedMeasurementVec ret;
+    undistortLeds(distortedMeasurements, camParams, ret);
     return ret;
 }
 } // namespace videotracker
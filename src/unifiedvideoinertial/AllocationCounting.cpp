@@ -0,0 +1,59 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "unifiedvideoinertial/AllocationCounting.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <atomic>
+
+namespace videotracker {
+namespace uvbi {
+    /// Plain integers, so they're usable from operator new even before (or
+    /// after) anything with a constructor on this thread.
+    static thread_local std::uint64_t s_threadAllocations = 0;
+    static thread_local std::uint64_t s_threadAllocatedBytes = 0;
+
+    static std::atomic<bool> s_countingEnabled{false};
+
+    void noteAllocation(std::size_t bytes) noexcept {
+        ++s_threadAllocations;
+        s_threadAllocatedBytes += bytes;
+    }
+
+    AllocationCount getThreadAllocationCount() {
+        AllocationCount ret;
+        ret.allocations = s_threadAllocations;
+        ret.bytes = s_threadAllocatedBytes;
+        return ret;
+    }
+
+    void enableAllocationCounting() {
+        s_countingEnabled.store(true, std::memory_order_relaxed);
+    }
+
+    bool allocationCountingEnabled() {
+        return s_countingEnabled.load(std::memory_order_relaxed);
+    }
+} // namespace uvbi
+} // namespace videotracker
@@ -0,0 +1,98 @@
+/** @file
+    @brief Replacements for the global operator new and delete that count
+    each allocation for the calling thread, turning on the per-stage
+    allocation counts in the tracking metrics.
+
+    Built as an object library so it can be linked into an executable on
+    purpose, rather than pulled into everything that uses uvbi-core.
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "unifiedvideoinertial/AllocationCounting.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstdlib>
+#include <new>
+
+namespace {
+    struct EnableCounting {
+        EnableCounting() { videotracker::uvbi::enableAllocationCounting(); }
+    };
+    EnableCounting enableCounting;
+
+    /// Same contract as the default operator new: keep calling the new
+    /// handler until the allocation succeeds, or throw if there is none.
+    void *countedAllocate(std::size_t size) {
+        videotracker::uvbi::noteAllocation(size);
+        if (size == 0) {
+            size = 1;
+        }
+        while (true) {
+            if (auto ret = std::malloc(size)) {
+                return ret;
+            }
+            auto handler = std::get_new_handler();
+            if (!handler) {
+                throw std::bad_alloc();
+            }
+            handler();
+        }
+    }
+} // namespace
+
+void *operator new(std::size_t size) { return countedAllocate(size); }
+
+void *operator new[](std::size_t size) { return countedAllocate(size); }
+
+void *operator new(std::size_t size, std::nothrow_t const &) noexcept {
+    try {
+        return countedAllocate(size);
+    } catch (std::bad_alloc &) {
+        return nullptr;
+    }
+}
+
+void *operator new[](std::size_t size, std::nothrow_t const &) noexcept {
+    try {
+        return countedAllocate(size);
+    } catch (std::bad_alloc &) {
+        return nullptr;
+    }
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+
+#ifdef __cpp_sized_deallocation
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
+#endif
+
+void operator delete(void *ptr, std::nothrow_t const &) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::nothrow_t const &) noexcept {
+    std::free(ptr);
+}
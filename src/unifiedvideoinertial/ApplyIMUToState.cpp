@@ -149,21 +149,25 @@ namespace uvbi {
     }
 
     void applyIMUToState(TrackingSystem const &sys,
-                         util::TimeValue const &initialTime, BodyState &state,
+                         util::Timestamp const &initialTime, BodyState &state,
                          BodyProcessModel &processModel,
-                         util::TimeValue const &newTime,
+                         util::Timestamp const &newTime,
                          CannedIMUMeasurement const &meas) {
         if (newTime != initialTime) {
-            auto dt = uvbiTimeValueDurationSeconds(&newTime, &initialTime);
+            auto dt = util::time::duration(newTime, initialTime);
             flexkalman::predict(state, processModel, dt);
 #if 0
             state.externalizeRotation();
 #endif
         }
-        if (meas.orientationValid()) {
-            applyOriToState(sys, state, processModel, meas);
-        } else if (meas.angVelValid()) {
-            applyAngVelToState(sys, state, processModel, meas);
+        if (meas.orientationValid() || meas.angVelValid()) {
+            /// A preintegrated measurement may carry both.
+            if (meas.orientationValid()) {
+                applyOriToState(sys, state, processModel, meas);
+            }
+            if (meas.angVelValid()) {
+                applyAngVelToState(sys, state, processModel, meas);
+            }
         } else {
             // unusually, the measurement is totally invalid. Just normalize and
             // go on.
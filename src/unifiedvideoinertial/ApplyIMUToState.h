@@ -29,7 +29,7 @@
 #include "unifiedvideoinertial/ModelTypes.h"
 
 // Library/third-party includes
-#include "unifiedvideoinertial/TimeValue.h"
+#include "unifiedvideoinertial/Timestamp.h"
 
 // Standard includes
 // - none
@@ -37,11 +37,14 @@
 namespace videotracker {
 namespace uvbi {
     class TrackingSystem;
+    /// Predicts the state forward to newTime, then corrects it with the
+    /// orientation and/or angular velocity in the measurement.
+    ///
     /// @return updated state in place.
     void applyIMUToState(TrackingSystem const &sys,
-                         util::TimeValue const &initialTime, BodyState &state,
+                         util::Timestamp const &initialTime, BodyState &state,
                          BodyProcessModel &processModel,
-                         util::TimeValue const &newTime,
+                         util::Timestamp const &newTime,
                          CannedIMUMeasurement const &meas);
 } // namespace uvbi
 } // namespace videotracker
@@ -75,15 +75,6 @@ namespace uvbi {
         static const char *getPrefix() { return "[AssignMeasurements] "; }
 
       public:
-        AssignMeasurementsToLeds(LedGroup &leds,
-                                 LedMeasurementVec const &measurements,
-                                 const std::size_t numBeacons,
-                                 float blobMoveThresh, bool verbose = false)
-            : leds_(leds), measurements_(measurements), ledsEnd_(end(leds_)),
-              numBeacons_(numBeacons), blobMoveThreshFactor_(blobMoveThresh),
-              maxMatches_((std::min)(leds_.size(), measurements_.size())),
-              verbose_(verbose) {}
-
         using LedAndMeasurement = std::pair<Led &, LedMeasurement const &>;
 
         using LedMeasDistance = std::tuple<std::size_t, std::size_t, float>;
@@ -91,6 +82,39 @@ namespace uvbi {
         using HeapType = std::vector<HeapValueType>;
         using size_type = HeapType::size_type;
 
+        /// The working vectors, which a caller assigning measurements every
+        /// frame can hold on to, so they keep their capacity from one frame
+        /// to the next.
+        struct Scratch {
+            std::vector<LedGroup::iterator> ledRefs;
+            std::vector<LedMeasurement const *> measRefs;
+            HeapType distanceHeap;
+        };
+
+        AssignMeasurementsToLeds(LedGroup &leds,
+                                 LedMeasurementVec const &measurements,
+                                 const std::size_t numBeacons,
+                                 float blobMoveThresh, bool verbose = false)
+            : AssignMeasurementsToLeds(leds, measurements, numBeacons,
+                                       blobMoveThresh, ownScratch_, verbose) {}
+
+        /// Works in the given scratch storage, clearing it first.
+        AssignMeasurementsToLeds(LedGroup &leds,
+                                 LedMeasurementVec const &measurements,
+                                 const std::size_t numBeacons,
+                                 float blobMoveThresh, Scratch &scratch,
+                                 bool verbose = false)
+            : ledRefs_(scratch.ledRefs), measRefs_(scratch.measRefs),
+              distanceHeap_(scratch.distanceHeap), leds_(leds),
+              measurements_(measurements), ledsEnd_(end(leds_)),
+              numBeacons_(numBeacons), blobMoveThreshFactor_(blobMoveThresh),
+              maxMatches_((std::min)(leds_.size(), measurements_.size())),
+              verbose_(verbose) {
+            ledRefs_.clear();
+            measRefs_.clear();
+            distanceHeap_.clear();
+        }
+
         /// Must call first, and only once.
         void populateStructures() {
             VIDEOTRACKER_ASSERT_MSG(!populated_,
@@ -332,24 +356,21 @@ namespace uvbi {
         }
 
         void eraseUnclaimedLedObjects(bool verbose = false) {
-            for (auto &ledIter : ledRefs_) {
-                if (ledIter == ledsEnd_) {
-                    /// already used
-                    continue;
-                }
-                if (verbose) {
-                    if (ledIter->identified()) {
-                        std::cout << "Erasing identified LED "
-                                  << ledIter->getOneBasedID().value()
-                                  << " because of a lack of updated data.\n";
-                    } else {
-                        std::cout << "Erasing unidentified LED at "
-                                  << ledIter->getLocation()
-                                  << " because of a lack of updated data.\n";
-                    }
-                }
-                leds_.erase(ledIter);
-            }
+            removeUnclaimedLedObjects(
+                [&](LedIter const &ledIter) { leds_.erase(ledIter); },
+                verbose);
+        }
+
+        /// Like eraseUnclaimedLedObjects(), but moves the LED objects to the
+        /// end of the given list instead of destroying them, so they can be
+        /// reused without allocating.
+        void retireUnclaimedLedObjects(LedGroup &retired,
+                                       bool verbose = false) {
+            removeUnclaimedLedObjects(
+                [&](LedIter const &ledIter) {
+                    retired.splice(end(retired), leds_, ledIter);
+                },
+                verbose);
         }
 
         size_type numUnclaimedMeasurements() const {
@@ -375,6 +396,29 @@ namespace uvbi {
         using LedIter = LedGroup::iterator;
         using LedPtr = Led *;
         using MeasPtr = LedMeasurement const *;
+
+        /// Calls remove with each LED object that didn't get a measurement.
+        template <typename F>
+        void removeUnclaimedLedObjects(F &&remove, bool verbose) {
+            for (auto &ledIter : ledRefs_) {
+                if (ledIter == ledsEnd_) {
+                    /// already used
+                    continue;
+                }
+                if (verbose) {
+                    if (ledIter->identified()) {
+                        std::cout << "Erasing identified LED "
+                                  << ledIter->getOneBasedID().value()
+                                  << " because of a lack of updated data.\n";
+                    } else {
+                        std::cout << "Erasing unidentified LED at "
+                                  << ledIter->getLocation()
+                                  << " because of a lack of updated data.\n";
+                    }
+                }
+                remove(ledIter);
+            }
+        }
         void checkAndThrowNotPopulated(const char *functionName) const {
             if (!populated_) {
                 throw std::logic_error("Must have called "
@@ -491,10 +535,12 @@ namespace uvbi {
             distanceHeap_.pop_back();
         }
 
+        /// Only used if the caller didn't supply scratch storage.
+        Scratch ownScratch_;
         bool populated_ = false;
-        std::vector<LedIter> ledRefs_;
-        std::vector<MeasPtr> measRefs_;
-        HeapType distanceHeap_;
+        std::vector<LedIter> &ledRefs_;
+        std::vector<MeasPtr> &measRefs_;
+        HeapType &distanceHeap_;
         size_type numMatches_ = 0;
         LedGroup &leds_;
         LedMeasurementVec const &measurements_;
@@ -0,0 +1,151 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "ClockOffsetEstimator.h"
+#include "Clamp.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+
+namespace videotracker {
+namespace uvbi {
+    /// A frame is used only if its least-squares error would have a standard
+    /// deviation under 4ms: this is the inverse of that variance, in 1/s^2.
+    static const double MinFrameInformation = 1. / (0.004 * 0.004);
+    /// Frames whose error is further than this many standard deviations from
+    /// the estimate are taken to be outliers (reacquiring, misidentified
+    /// beacons) and skipped.
+    static const double OutlierGateSigmas = 4.;
+    /// Process noise spectral densities: how far the offset (s^2/s) and the
+    /// skew ((s/s)^2/s) may wander between frames.
+    static const double OffsetProcessNoise = 2.e-4 * 2.e-4;
+    static const double SkewProcessNoise = 1.e-6 * 1.e-6;
+    /// Initial standard deviation of the skew: 100ppm covers typical
+    /// crystal oscillators.
+    static const double InitialSkewStdDev = 1.e-4;
+    /// Largest skew we'll believe: beyond this something else is wrong.
+    static const double MaxSkew = 1.e-3;
+    /// Largest change to the correction from a single frame, so corrected
+    /// frame timestamps keep their order.
+    static const double MaxStepSeconds = 0.001;
+
+    ClockOffsetEstimator::ClockOffsetEstimator(duration maxCorrection)
+        : m_maxCorrection(
+              std::chrono::duration<double>(maxCorrection).count()) {
+        reset();
+    }
+
+    void ClockOffsetEstimator::reset() {
+        m_residualDotVelocity = 0;
+        m_velocitySquaredNorm = 0;
+        m_state.setZero();
+        m_covariance.setZero();
+        m_covariance(0, 0) = m_maxCorrection * m_maxCorrection / 4.;
+        m_covariance(1, 1) = InitialSkewStdDev * InitialSkewStdDev;
+        m_lastUpdate = util::Timestamp{};
+        m_haveUpdate = false;
+        m_framesUsed = 0;
+    }
+
+    void ClockOffsetEstimator::addResidual(
+        Eigen::Vector2d const &residual, Eigen::Vector2d const &imageVelocity,
+        double variance) {
+        if (!(variance > 0)) {
+            return;
+        }
+        m_residualDotVelocity += residual.dot(imageVelocity) / variance;
+        m_velocitySquaredNorm += imageVelocity.squaredNorm() / variance;
+    }
+
+    bool ClockOffsetEstimator::finishFrame(util::Timestamp const &rawTime) {
+        auto residualDotVelocity = m_residualDotVelocity;
+        auto information = m_velocitySquaredNorm;
+        m_residualDotVelocity = 0;
+        m_velocitySquaredNorm = 0;
+        if (!(information >= MinFrameInformation) ||
+            !std::isfinite(residualDotVelocity)) {
+            return false;
+        }
+        if (m_haveUpdate && !rawTime.comparableWith(m_lastUpdate)) {
+            /// The video source changed clocks on us: start over.
+            reset();
+        }
+
+        /// Predict: the correction drifts by the skew.
+        if (m_haveUpdate) {
+            auto dt = std::max(0., util::time::duration(rawTime, m_lastUpdate));
+            Eigen::Matrix2d transition;
+            transition << 1, dt, 0, 1;
+            m_state = transition * m_state;
+            m_covariance = transition * m_covariance * transition.transpose();
+            m_covariance(0, 0) += OffsetProcessNoise * dt;
+            m_covariance(1, 1) += SkewProcessNoise * dt;
+        }
+        m_lastUpdate = rawTime;
+        m_haveUpdate = true;
+
+        /// The frame was corrected by the predicted state, so the residuals
+        /// measure the error left over: that's the innovation.
+        auto innovation = residualDotVelocity / information;
+        auto innovationVariance = m_covariance(0, 0) + 1. / information;
+        if (innovation * innovation >
+            OutlierGateSigmas * OutlierGateSigmas * innovationVariance) {
+            return false;
+        }
+        Eigen::Vector2d gain = m_covariance.col(0) / innovationVariance;
+        auto offsetStep = std::abs(gain[0] * innovation);
+        if (offsetStep > MaxStepSeconds) {
+            /// Take a shorter step: the Joseph form below keeps the
+            /// covariance honest about the gain actually used.
+            gain *= MaxStepSeconds / offsetStep;
+        }
+        m_state += gain * innovation;
+        m_state[0] = clamp(m_state[0], -m_maxCorrection, m_maxCorrection);
+        m_state[1] = clamp(m_state[1], -MaxSkew, MaxSkew);
+        Eigen::Matrix2d keep = Eigen::Matrix2d::Identity();
+        keep.col(0) -= gain;
+        m_covariance = keep * m_covariance * keep.transpose() +
+                       gain * gain.transpose() / information;
+        ++m_framesUsed;
+        return true;
+    }
+
+    ClockOffsetEstimator::duration
+    ClockOffsetEstimator::getCorrection(util::Timestamp const &rawTime) const {
+        if (!m_haveUpdate) {
+            return duration::zero();
+        }
+        auto correction = m_state[0];
+        if (rawTime.comparableWith(m_lastUpdate)) {
+            correction +=
+                m_state[1] *
+                std::max(0., util::time::duration(rawTime, m_lastUpdate));
+        }
+        correction = clamp(correction, -m_maxCorrection, m_maxCorrection);
+        return std::chrono::duration_cast<duration>(
+            std::chrono::duration<double>(correction));
+    }
+} // namespace uvbi
+} // namespace videotracker
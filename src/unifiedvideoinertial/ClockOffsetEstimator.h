@@ -0,0 +1,111 @@
+/** @file
+    @brief Header for estimating, as we track, the offset and drift of the
+    camera's timestamps relative to the IMU's.
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include "unifiedvideoinertial/Timestamp.h"
+#include <Eigen/Core>
+
+// Standard includes
+#include <chrono>
+#include <cstddef>
+
+namespace videotracker {
+namespace uvbi {
+    /// Estimates the correction to add to video frame timestamps to put them
+    /// on the IMU's timeline: an offset, and a skew by which it drifts.
+    ///
+    /// While a body with an IMU turns, its orientation comes from the IMU, so
+    /// if a frame was actually captured at its timestamp plus some error, the
+    /// beacons are seen where the IMU-driven rotation has carried them to by
+    /// then: each beacon's residual is its image velocity due to the angular
+    /// velocity times that error. A least-squares fit of the residuals
+    /// against those image velocities over a frame gives the frame's
+    /// remaining error, and a small Kalman filter over offset and skew takes
+    /// one such measurement per frame.
+    ///
+    /// The residuals come from frames already corrected by the estimate, so
+    /// each measurement is of the error left over: anything that shrinks the
+    /// residuals (like the pose filter partly absorbing the error) only
+    /// slows convergence, and doesn't move where it settles.
+    class ClockOffsetEstimator {
+      public:
+        using duration = std::chrono::nanoseconds;
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        /// @param maxCorrection The largest correction, either way, the
+        /// estimate may make.
+        explicit ClockOffsetEstimator(duration maxCorrection);
+
+        /// Adds a beacon's residual (measured minus predicted, in pixels)
+        /// from the frame being processed, along with the velocity (pixels
+        /// per second) its predicted image location has due to the body's
+        /// angular velocity, and the variance (pixels^2) of its measurement.
+        void addResidual(Eigen::Vector2d const &residual,
+                         Eigen::Vector2d const &imageVelocity,
+                         double variance);
+
+        /// Folds the residuals added since the last call into the estimate,
+        /// if the body was turning quickly enough for them to tell us
+        /// anything, then starts over for the next frame.
+        ///
+        /// @param rawTime The frame's timestamp, before correction.
+        /// @return true if the estimate was updated.
+        bool finishFrame(util::Timestamp const &rawTime);
+
+        /// The correction to add to a frame stamped rawTime.
+        duration getCorrection(util::Timestamp const &rawTime) const;
+
+        /// A frame's timestamp, corrected by the estimate.
+        util::Timestamp correct(util::Timestamp const &rawTime) const {
+            return rawTime + getCorrection(rawTime);
+        }
+
+        /// The estimated drift of the correction, in seconds per second.
+        double getSkew() const { return m_state[1]; }
+
+        /// Frames that have gone into the estimate.
+        std::size_t getFramesUsed() const { return m_framesUsed; }
+
+        /// Discards the estimate and any residuals added.
+        void reset();
+
+      private:
+        double m_maxCorrection;
+        /// @name Least-squares sums for the current frame, each beacon
+        /// weighted by the inverse of its measurement variance.
+        /// @{
+        double m_residualDotVelocity = 0;
+        double m_velocitySquaredNorm = 0;
+        /// @}
+        /// Correction (seconds) at m_lastUpdate, and skew.
+        Eigen::Vector2d m_state;
+        Eigen::Matrix2d m_covariance;
+        util::Timestamp m_lastUpdate;
+        bool m_haveUpdate = false;
+        std::size_t m_framesUsed = 0;
+    };
+} // namespace uvbi
+} // namespace videotracker
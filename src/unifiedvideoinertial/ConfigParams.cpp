@@ -29,7 +29,7 @@
 // - none
 
 // Standard includes
-// - none
+#include <tuple>
 
 namespace videotracker {
 namespace uvbi {
@@ -61,5 +61,55 @@ namespace uvbi {
         : noveltyPenaltyBase(1.282636090487287),
           distanceMeasVarianceBase(0.9163785097),
           distanceMeasVarianceIntercept(308.2142264) {}
+
+    static bool operator==(BlobParams const &a, BlobParams const &b) {
+        return std::tie(a.minDistBetweenBlobs, a.minArea,
+                        a.filterByCircularity, a.minCircularity,
+                        a.filterByConvexity, a.minConvexity,
+                        a.absoluteMinThreshold, a.minThresholdAlpha,
+                        a.maxThresholdAlpha, a.thresholdSteps,
+                        a.coarseTileSize, a.coarseTileMargin) ==
+               std::tie(b.minDistBetweenBlobs, b.minArea,
+                        b.filterByCircularity, b.minCircularity,
+                        b.filterByConvexity, b.minConvexity,
+                        b.absoluteMinThreshold, b.minThresholdAlpha,
+                        b.maxThresholdAlpha, b.thresholdSteps,
+                        b.coarseTileSize, b.coarseTileMargin);
+    }
+
+    static bool operator==(EdgeHoleParams const &a, EdgeHoleParams const &b) {
+        return std::tie(a.preEdgeDetectionBlurSize, a.laplacianKSize,
+                        a.laplacianScale, a.edgeDetectErosion,
+                        a.erosionKernelValue, a.postEdgeDetectionBlur,
+                        a.postEdgeDetectionBlurSize,
+                        a.postEdgeDetectionBlurThreshold,
+                        a.singlePassHoleLabelling) ==
+               std::tie(b.preEdgeDetectionBlurSize, b.laplacianKSize,
+                        b.laplacianScale, b.edgeDetectErosion,
+                        b.erosionKernelValue, b.postEdgeDetectionBlur,
+                        b.postEdgeDetectionBlurSize,
+                        b.postEdgeDetectionBlurThreshold,
+                        b.singlePassHoleLabelling);
+    }
+
+    bool haveSameBlobExtractionParams(ConfigParams const &a,
+                                      ConfigParams const &b) {
+        return a.blobParams == b.blobParams &&
+               a.extractParams == b.extractParams;
+    }
+
+    bool haveSameLedIdentificationParams(ConfigParams const &a,
+                                         ConfigParams const &b) {
+        if (a.poseAssistedIdentification || b.poseAssistedIdentification) {
+            return false;
+        }
+        /// The target set and rear panel decide the beacon count and blink
+        /// patterns the LEDs are identified against.
+        return haveSameBlobExtractionParams(a, b) &&
+               a.blobMoveThreshold == b.blobMoveThreshold &&
+               a.blobsKeepIdentity == b.blobsKeepIdentity &&
+               a.targetSet == b.targetSet &&
+               a.includeRearPanel == b.includeRearPanel;
+    }
 } // namespace uvbi
 } // namespace videotracker
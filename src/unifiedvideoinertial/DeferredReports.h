@@ -0,0 +1,126 @@
+/** @file
+    @brief Header for keeping track of the body reports waiting on a lazy IMU
+    replay.
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+// Internal Includes
+#include "unifiedvideoinertial/TrackedBody.h"
+#include "unifiedvideoinertial/TrackingSystem.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace videotracker {
+namespace uvbi {
+    /// In lazy replay mode, the bodies whose reports are held back until the
+    /// IMU replay after their last video update catches up. Reporting a body
+    /// needs its state to be current, so rather than finishing its replay
+    /// then and there - whether the report was due to video or to an IMU
+    /// message - the report waits, and the replay is done a batch at a time
+    /// whenever there's nothing else to do.
+    class DeferredReports {
+      public:
+        explicit DeferredReports(TrackingSystem &system) : m_system(system) {}
+
+        /// Holds back the body's report if it's waiting on a replay.
+        ///
+        /// @return true if held back.
+        bool defer(BodyId const bodyId) {
+            if (!m_system.getBody(bodyId).hasPendingReplay()) {
+                return false;
+            }
+            if (!contains(bodyId)) {
+                m_bodies.push_back(bodyId);
+            }
+            return true;
+        }
+
+        /// Holds back the reports of those bodies in bodyIds waiting on a
+        /// replay, taking them out of it.
+        template <typename Container> void deferFrom(Container &bodyIds) {
+            for (auto it = bodyIds.begin(); it != bodyIds.end();) {
+                if (defer(*it)) {
+                    it = bodyIds.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+
+        /// Forgets the body's report, if held back: it's been sent anyway.
+        void erase(BodyId const bodyId) {
+            auto it = find(bodyId);
+            if (it != m_bodies.end()) {
+                m_bodies.erase(it);
+            }
+        }
+
+        bool empty() const { return m_bodies.empty(); }
+
+        bool contains(BodyId const bodyId) const {
+            return std::any_of(
+                m_bodies.begin(), m_bodies.end(),
+                [&](BodyId const &other) { return other == bodyId; });
+        }
+
+        /// Replays up to batch IMU measurements for each body waiting on a
+        /// replay (deferred report or not), then calls f with each body
+        /// whose report was held back and is now caught up, no longer
+        /// holding it back.
+        ///
+        /// @return true if there are more to replay.
+        template <typename F> bool replayBatch(std::size_t batch, F &&f) {
+            bool morePending = false;
+            auto const n = m_system.getNumBodies();
+            for (BodyId::wrapped_type i = 0; i < n; ++i) {
+                auto bodyId = BodyId{i};
+                auto &body = m_system.getBody(bodyId);
+                if (body.hasPendingReplay() && !body.replayPendingIMU(batch)) {
+                    morePending = true;
+                    continue;
+                }
+                // Caught up, whether just now or because something else
+                // needed the state first.
+                auto it = find(bodyId);
+                if (it != m_bodies.end()) {
+                    m_bodies.erase(it);
+                    f(bodyId);
+                }
+            }
+            return morePending;
+        }
+
+      private:
+        std::vector<BodyId>::iterator find(BodyId const bodyId) {
+            return std::find(m_bodies.begin(), m_bodies.end(), bodyId);
+        }
+        TrackingSystem &m_system;
+        /// Few enough that a vector beats a set - and, having grown once,
+        /// doesn't allocate again.
+        std::vector<BodyId> m_bodies;
+    };
+} // namespace uvbi
+} // namespace videotracker
@@ -0,0 +1,422 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "GuidedRansacPnP.h"
+
+// Library/third-party includes
+#include <Eigen/Eigenvalues>
+#include <Eigen/Geometry>
+#include <opencv2/core/core.hpp> // for parallel_for_
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <functional>
+#include <limits>
+#include <numeric>
+
+namespace videotracker {
+namespace uvbi {
+    namespace {
+        /// Real roots of a4 x^4 + a3 x^3 + a2 x^2 + a1 x + a0, from the
+        /// eigenvalues of the companion matrix, polished with a couple of
+        /// Newton steps.
+        std::size_t solveQuartic(double a4, double a3, double a2, double a1,
+                                 double a0, double (&roots)[4]) {
+            if (std::abs(a4) < 1.e-12) {
+                return 0;
+            }
+            Eigen::Matrix4d companion = Eigen::Matrix4d::Zero();
+            companion.bottomLeftCorner<3, 3>().setIdentity();
+            companion(0, 3) = -a0 / a4;
+            companion(1, 3) = -a1 / a4;
+            companion(2, 3) = -a2 / a4;
+            companion(3, 3) = -a3 / a4;
+            Eigen::EigenSolver<Eigen::Matrix4d> solver(companion, false);
+            if (solver.info() != Eigen::Success) {
+                return 0;
+            }
+            std::size_t n = 0;
+            for (int i = 0; i < 4; ++i) {
+                std::complex<double> root = solver.eigenvalues()[i];
+                if (std::abs(root.imag()) > 1.e-6 * (1. + std::abs(root))) {
+                    continue;
+                }
+                double x = root.real();
+                for (int iter = 0; iter < 2; ++iter) {
+                    double f = (((a4 * x + a3) * x + a2) * x + a1) * x + a0;
+                    double df = ((4 * a4 * x + 3 * a3) * x + 2 * a2) * x + a1;
+                    if (df == 0.) {
+                        break;
+                    }
+                    x -= f / df;
+                }
+                roots[n++] = x;
+            }
+            return n;
+        }
+
+        /// Draws minimal samples from correspondences sorted by decreasing
+        /// priority, PROSAC-style: at first only from the top few, then
+        /// gradually widening to all of them by the time the sample budget is
+        /// used up.
+        class ProsacSampler {
+          public:
+            static const std::size_t SampleSize = 3;
+            ProsacSampler(std::size_t numPoints, std::size_t maxSamples)
+                : m_numPoints(numPoints) {
+                /// Expected number of samples, out of maxSamples uniform ones,
+                /// drawn only from the top SampleSize correspondences.
+                m_tn = static_cast<double>(maxSamples);
+                for (std::size_t i = 0; i < SampleSize; ++i) {
+                    m_tn *= static_cast<double>(SampleSize - i) /
+                            static_cast<double>(numPoints - i);
+                }
+            }
+
+            template <typename Rng>
+            void draw(Rng &rng, std::array<std::size_t, SampleSize> &sample) {
+                ++m_t;
+                std::size_t poolSize = m_n;
+                std::size_t numRandom = SampleSize;
+                if (m_tPrime >= m_t) {
+                    /// Always include the newest member of the pool, so every
+                    /// sample drawn is one not drawn from the smaller pool.
+                    sample[SampleSize - 1] = m_n - 1;
+                    poolSize = m_n - 1;
+                    numRandom = SampleSize - 1;
+                }
+                std::uniform_int_distribution<std::size_t> dist(0,
+                                                                poolSize - 1);
+                for (std::size_t i = 0; i < numRandom; ++i) {
+                    bool repeated;
+                    do {
+                        sample[i] = dist(rng);
+                        repeated = std::find(sample.begin(),
+                                             sample.begin() + i,
+                                             sample[i]) != sample.begin() + i;
+                    } while (repeated);
+                }
+                /// Widen the pool when it's been sampled as much as it would
+                /// have been by uniform sampling.
+                if (m_t >= m_tPrime && m_n < m_numPoints) {
+                    double tNext = m_tn * static_cast<double>(m_n + 1) /
+                                   static_cast<double>(m_n + 1 - SampleSize);
+                    m_tPrime += (std::max)(
+                        std::size_t(1),
+                        static_cast<std::size_t>(std::ceil(tNext - m_tn)));
+                    m_tn = tNext;
+                    ++m_n;
+                }
+            }
+
+          private:
+            std::size_t m_numPoints;
+            std::size_t m_n = SampleSize;
+            std::size_t m_t = 0;
+            std::size_t m_tPrime = 1;
+            double m_tn;
+        };
+
+        /// Number of samples needed to have drawn an all-inlier sample with
+        /// the given confidence, if the inlier ratio is as given.
+        double requiredSamples(double inlierRatio, double confidence) {
+            double allInliers = inlierRatio * inlierRatio * inlierRatio;
+            if (allInliers >= 1.) {
+                return 0.;
+            }
+            if (allInliers <= 0.) {
+                return std::numeric_limits<double>::max();
+            }
+            return std::log(1. - confidence) / std::log(1. - allInliers);
+        }
+
+        class ScoreAliveBody : public cv::ParallelLoopBody {
+          public:
+            explicit ScoreAliveBody(std::function<void(int)> const &f)
+                : m_f(f) {}
+            void operator()(cv::Range const &range) const override {
+                for (int i = range.start; i < range.end; ++i) {
+                    m_f(i);
+                }
+            }
+
+          private:
+            std::function<void(int)> const &m_f;
+        };
+    } // namespace
+
+    std::size_t solveP3P(std::array<Eigen::Vector3d, 3> const &bearings,
+                         std::array<Eigen::Vector3d, 3> const &points,
+                         std::vector<PnPPose> &poses) {
+        double a2 = (points[1] - points[2]).squaredNorm();
+        double b2 = (points[0] - points[2]).squaredNorm();
+        double c2 = (points[0] - points[1]).squaredNorm();
+        if (a2 < 1.e-12 || b2 < 1.e-12 || c2 < 1.e-12 ||
+            (points[1] - points[0])
+                    .cross(points[2] - points[0])
+                    .squaredNorm() < 1.e-12 * b2 * c2) {
+            return 0;
+        }
+        double cosAlpha = bearings[1].dot(bearings[2]);
+        double cosBeta = bearings[0].dot(bearings[2]);
+        double cosGamma = bearings[0].dot(bearings[1]);
+
+        /// Grunert's quartic in v = s3 / s1, as given by Haralick et al.,
+        /// "Review and analysis of solutions of the three point perspective
+        /// pose estimation problem," IJCV 13(3), 1994.
+        double amcb = (a2 - c2) / b2;
+        double apcb = (a2 + c2) / b2;
+        double bmcb = (b2 - c2) / b2;
+        double bmab = (b2 - a2) / b2;
+        double cosAlpha2 = cosAlpha * cosAlpha;
+        double cosBeta2 = cosBeta * cosBeta;
+        double cosGamma2 = cosGamma * cosGamma;
+        double A4 = (amcb - 1) * (amcb - 1) - 4 * c2 / b2 * cosAlpha2;
+        double A3 = 4 * (amcb * (1 - amcb) * cosBeta -
+                         (1 - apcb) * cosAlpha * cosGamma +
+                         2 * c2 / b2 * cosAlpha2 * cosBeta);
+        double A2 = 2 * (amcb * amcb - 1 + 2 * amcb * amcb * cosBeta2 +
+                         2 * bmcb * cosAlpha2 -
+                         4 * apcb * cosAlpha * cosBeta * cosGamma +
+                         2 * bmab * cosGamma2);
+        double A1 = 4 * (-amcb * (1 + amcb) * cosBeta +
+                         2 * a2 / b2 * cosGamma2 * cosBeta -
+                         (1 - apcb) * cosAlpha * cosGamma);
+        double A0 = (1 + amcb) * (1 + amcb) - 4 * a2 / b2 * cosGamma2;
+
+        double roots[4];
+        auto numRoots = solveQuartic(A4, A3, A2, A1, A0, roots);
+        std::size_t numPoses = 0;
+        Eigen::Matrix3d src;
+        Eigen::Matrix3d dst;
+        for (int i = 0; i < 3; ++i) {
+            src.col(i) = points[i];
+        }
+        for (std::size_t i = 0; i < numRoots; ++i) {
+            double v = roots[i];
+            double denom = 2 * (cosGamma - v * cosAlpha);
+            if (v <= 0 || std::abs(denom) < 1.e-12) {
+                continue;
+            }
+            double u = ((-1 + amcb) * v * v - 2 * amcb * cosBeta * v + 1 +
+                        amcb) /
+                       denom;
+            double s1sq = b2 / (1 + v * v - 2 * v * cosBeta);
+            if (u <= 0 || !(s1sq > 0)) {
+                continue;
+            }
+            double s1 = std::sqrt(s1sq);
+            dst.col(0) = s1 * bearings[0];
+            dst.col(1) = u * s1 * bearings[1];
+            dst.col(2) = v * s1 * bearings[2];
+            Eigen::Matrix4d xform = Eigen::umeyama(src, dst, false);
+            if (!xform.allFinite()) {
+                continue;
+            }
+            PnPPose pose;
+            pose.rotation = xform.topLeftCorner<3, 3>();
+            pose.translation = xform.topRightCorner<3, 1>();
+            poses.push_back(pose);
+            ++numPoses;
+        }
+        return numPoses;
+    }
+
+    GuidedRansacPnP::GuidedRansacPnP(GuidedRansacPnPOptions const &opts) {
+        setOptions(opts);
+    }
+
+    void GuidedRansacPnP::setOptions(GuidedRansacPnPOptions const &opts) {
+        m_opts = opts;
+        m_opts.samplesPerBatch =
+            (std::max)(m_opts.samplesPerBatch, std::size_t(1));
+        m_opts.preemptionBlockSize =
+            (std::max)(m_opts.preemptionBlockSize, std::size_t(1));
+    }
+
+    void GuidedRansacPnP::score(Hypothesis &hyp, std::size_t begin,
+                                std::size_t end) const {
+        auto maxErrorSq = m_opts.maxError * m_opts.maxError;
+        for (std::size_t j = begin; j < end; ++j) {
+            Eigen::Vector3d p =
+                hyp.pose.rotation * m_objectPoints[j] + hyp.pose.translation;
+            /// Points behind the camera count as far as they can.
+            auto errSq = maxErrorSq;
+            if (p.z() > 0) {
+                errSq = (p.head<2>() / p.z() - m_imagePoints[j]).squaredNorm();
+            }
+            if (errSq < maxErrorSq) {
+                hyp.inliers++;
+                hyp.cost += errSq;
+            } else {
+                hyp.cost += maxErrorSq;
+            }
+        }
+    }
+
+    void GuidedRansacPnP::scoreAlive(std::size_t begin, std::size_t end) {
+        std::function<void(int)> scoreOne = [&](int i) {
+            score(m_hyps[m_alive[i]], begin, end);
+        };
+        auto n = static_cast<int>(m_alive.size());
+        if (m_opts.parallel && n > 1) {
+            cv::parallel_for_(cv::Range(0, n), ScoreAliveBody(scoreOne));
+        } else {
+            for (int i = 0; i < n; ++i) {
+                scoreOne(i);
+            }
+        }
+    }
+
+    std::size_t GuidedRansacPnP::preemptiveScore() {
+        m_alive.resize(m_hyps.size());
+        std::iota(m_alive.begin(), m_alive.end(), std::size_t(0));
+        auto byCost = [&](std::size_t lhs, std::size_t rhs) {
+            return m_hyps[lhs].cost < m_hyps[rhs].cost;
+        };
+        auto numPoints = m_objectPoints.size();
+        std::size_t scored = 0;
+        while (scored < numPoints) {
+            auto blockEnd =
+                (std::min)(numPoints, scored + m_opts.preemptionBlockSize);
+            if (m_alive.size() == 1) {
+                /// Just one left: finish it off.
+                blockEnd = numPoints;
+            }
+            scoreAlive(scored, blockEnd);
+            scored = blockEnd;
+            if (m_alive.size() > 1) {
+                auto keep = (m_alive.size() + 1) / 2;
+                std::nth_element(m_alive.begin(), m_alive.begin() + keep - 1,
+                                 m_alive.end(), byCost);
+                m_alive.resize(keep);
+            }
+        }
+        return *std::min_element(m_alive.begin(), m_alive.end(), byCost);
+    }
+
+    bool GuidedRansacPnP::operator()(PnPCorrespondenceVec const &corrs,
+                                     std::size_t minInliers,
+                                     PnPPose const *prior,
+                                     GuidedRansacPnPResult &result) {
+        result = GuidedRansacPnPResult{};
+        minInliers = (std::max)(minInliers, ProsacSampler::SampleSize);
+        auto numPoints = corrs.size();
+        if (numPoints < minInliers) {
+            return false;
+        }
+
+        /// Put the correspondences in priority order: stable, so that ties
+        /// keep the caller's order.
+        m_order.resize(numPoints);
+        std::iota(m_order.begin(), m_order.end(), std::size_t(0));
+        std::stable_sort(m_order.begin(), m_order.end(),
+                         [&](std::size_t lhs, std::size_t rhs) {
+                             return corrs[lhs].priority > corrs[rhs].priority;
+                         });
+        m_objectPoints.resize(numPoints);
+        m_imagePoints.resize(numPoints);
+        m_bearings.resize(numPoints);
+        for (std::size_t i = 0; i < numPoints; ++i) {
+            auto const &corr = corrs[m_order[i]];
+            m_objectPoints[i] = corr.objectPoint;
+            m_imagePoints[i] = corr.imagePoint;
+            m_bearings[i] = corr.imagePoint.homogeneous().normalized();
+        }
+
+        Hypothesis best;
+        bool haveBest = false;
+        auto isBetter = [&](Hypothesis const &hyp) {
+            return !haveBest || hyp.inliers > best.inliers ||
+                   (hyp.inliers == best.inliers && hyp.cost < best.cost);
+        };
+
+        if (prior) {
+            best.pose = *prior;
+            score(best, 0, numPoints);
+            haveBest = true;
+            result.fromPrior = true;
+            result.hypotheses++;
+        }
+
+        ProsacSampler sampler(numPoints, m_opts.maxSamples);
+        std::array<std::size_t, ProsacSampler::SampleSize> sample;
+        std::array<Eigen::Vector3d, 3> sampleBearings;
+        std::array<Eigen::Vector3d, 3> samplePoints;
+        while (result.samples < m_opts.maxSamples) {
+            if (haveBest &&
+                static_cast<double>(result.samples) >=
+                    requiredSamples(static_cast<double>(best.inliers) /
+                                        static_cast<double>(numPoints),
+                                    m_opts.confidence)) {
+                break;
+            }
+            /// Generate a batch of hypotheses.
+            m_poses.clear();
+            auto batchEnd = (std::min)(m_opts.maxSamples,
+                                       result.samples + m_opts.samplesPerBatch);
+            for (; result.samples < batchEnd; ++result.samples) {
+                sampler.draw(m_rng, sample);
+                for (std::size_t i = 0; i < sample.size(); ++i) {
+                    sampleBearings[i] = m_bearings[sample[i]];
+                    samplePoints[i] = m_objectPoints[sample[i]];
+                }
+                solveP3P(sampleBearings, samplePoints, m_poses);
+            }
+            if (m_poses.empty()) {
+                continue;
+            }
+            m_hyps.resize(m_poses.size());
+            for (std::size_t i = 0; i < m_poses.size(); ++i) {
+                m_hyps[i].pose = m_poses[i];
+                m_hyps[i].cost = 0;
+                m_hyps[i].inliers = 0;
+            }
+            result.hypotheses += m_hyps.size();
+            auto &winner = m_hyps[preemptiveScore()];
+            if (isBetter(winner)) {
+                best = winner;
+                haveBest = true;
+                result.fromPrior = false;
+            }
+        }
+
+        if (!haveBest || best.inliers < minInliers) {
+            return false;
+        }
+
+        /// Collect the inliers, in the caller's indexing.
+        result.pose = best.pose;
+        for (std::size_t j = 0; j < numPoints; ++j) {
+            Hypothesis one;
+            one.pose = best.pose;
+            score(one, j, j + 1);
+            if (one.inliers) {
+                result.inliers.push_back(m_order[j]);
+            }
+        }
+        std::sort(result.inliers.begin(), result.inliers.end());
+        return true;
+    }
+} // namespace uvbi
+} // namespace videotracker
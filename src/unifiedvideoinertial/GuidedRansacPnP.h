@@ -0,0 +1,169 @@
+/** @file
+    @brief Header for a minimal-solver RANSAC perspective-n-point estimator
+    with prioritized sampling and preemptive hypothesis scoring.
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <Eigen/Core>
+
+// Standard includes
+#include <array>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace videotracker {
+namespace uvbi {
+    /// A rigid transform taking points from object (model) space into camera
+    /// space.
+    struct PnPPose {
+        Eigen::Matrix3d rotation = Eigen::Matrix3d::Identity();
+        Eigen::Vector3d translation = Eigen::Vector3d::Zero();
+    };
+
+    /// Solves the perspective-three-point problem (Grunert's method): finds
+    /// the poses that put each object point on the ray of the corresponding
+    /// bearing, in front of the camera. Bearings must be unit vectors.
+    ///
+    /// Appends up to four solutions to poses, and returns how many it
+    /// appended: none if the points are degenerate (e.g. collinear).
+    std::size_t solveP3P(std::array<Eigen::Vector3d, 3> const &bearings,
+                         std::array<Eigen::Vector3d, 3> const &points,
+                         std::vector<PnPPose> &poses);
+
+    struct PnPCorrespondence {
+        Eigen::Vector3d objectPoint;
+        /// Undistorted, normalized image coordinates (on the z = 1 plane).
+        Eigen::Vector2d imagePoint;
+        /// Correspondences with higher priority are sampled first, so give
+        /// the ones most likely to be inliers the highest.
+        double priority = 0.;
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    };
+    using PnPCorrespondenceVec =
+        std::vector<PnPCorrespondence,
+                    Eigen::aligned_allocator<PnPCorrespondence>>;
+
+    struct GuidedRansacPnPOptions {
+        /// Max distance, on the normalized image plane, between an
+        /// observation and its reprojection for the correspondence to count
+        /// as an inlier.
+        double maxError = 0.005;
+        /// Sampling stops once it is this confident that no hypothesis with
+        /// more inliers remains to be drawn.
+        double confidence = 0.99;
+        /// Upper bound on the number of minimal samples drawn.
+        std::size_t maxSamples = 64;
+        /// Minimal samples drawn before their hypotheses are scored (and
+        /// early termination checked).
+        std::size_t samplesPerBatch = 8;
+        /// Correspondences each hypothesis still in the running is scored
+        /// against before the worse half of them are discarded.
+        std::size_t preemptionBlockSize = 4;
+        /// Score the hypotheses of a batch in parallel.
+        bool parallel = false;
+    };
+
+    struct GuidedRansacPnPResult {
+        PnPPose pose;
+        /// Indices, into the correspondences passed in, of the inliers to
+        /// pose.
+        std::vector<std::size_t> inliers;
+        /// Minimal samples drawn.
+        std::size_t samples = 0;
+        /// Pose hypotheses scored, including the prior.
+        std::size_t hypotheses = 0;
+        /// True if the prior pose was the one returned.
+        bool fromPrior = false;
+    };
+
+    /// RANSAC for the perspective-n-point problem, built for re-acquiring a
+    /// pose quickly from a handful of identified beacons:
+    ///
+    /// - hypotheses come from P3P on minimal samples of three
+    ///   correspondences, drawn PROSAC-style: from the highest-priority
+    ///   correspondences first, widening the pool as sampling goes on;
+    /// - a prior pose, if given, is scored before any sampling, and if every
+    ///   correspondence is an inlier to it no samples are drawn at all;
+    /// - the hypotheses from each batch of samples are scored preemptively,
+    ///   a block of correspondences at a time, discarding the worse half
+    ///   after each block, so that only the best is scored against all of
+    ///   them;
+    /// - sampling stops as soon as the usual RANSAC bound says the best
+    ///   hypothesis is good enough at the requested confidence.
+    ///
+    /// The pose returned is that of the best hypothesis, not refined using
+    /// all of its inliers: that's left to the caller.
+    class GuidedRansacPnP {
+      public:
+        explicit GuidedRansacPnP(
+            GuidedRansacPnPOptions const &opts = GuidedRansacPnPOptions());
+
+        /// @param prior Pose to try before sampling, or nullptr.
+        /// @return true if a pose with at least minInliers inliers (and no
+        /// fewer than three) was found.
+        bool operator()(PnPCorrespondenceVec const &corrs,
+                        std::size_t minInliers, PnPPose const *prior,
+                        GuidedRansacPnPResult &result);
+
+        GuidedRansacPnPOptions const &getOptions() const { return m_opts; }
+        void setOptions(GuidedRansacPnPOptions const &opts);
+
+      private:
+        struct Hypothesis {
+            PnPPose pose;
+            /// Truncated-quadratic reprojection cost over the
+            /// correspondences scored so far.
+            double cost = 0.;
+            std::size_t inliers = 0;
+        };
+        /// Adds the score of hyp against the correspondences in [begin, end)
+        /// of priority order.
+        void score(Hypothesis &hyp, std::size_t begin, std::size_t end) const;
+        /// Scores each hypothesis still in the running against the
+        /// correspondences in [begin, end) of priority order.
+        void scoreAlive(std::size_t begin, std::size_t end);
+        /// Scores the batch of hypotheses in m_hyps preemptively, returning
+        /// the index of the winner, which is the only one scored against all
+        /// correspondences.
+        std::size_t preemptiveScore();
+
+        GuidedRansacPnPOptions m_opts;
+        std::mt19937 m_rng;
+
+        /// @name Scratch space, reused between calls
+        /// @{
+        /// Correspondences in priority order.
+        std::vector<Eigen::Vector3d> m_objectPoints;
+        std::vector<Eigen::Vector2d, Eigen::aligned_allocator<Eigen::Vector2d>>
+            m_imagePoints;
+        std::vector<Eigen::Vector3d> m_bearings;
+        std::vector<std::size_t> m_order;
+        std::vector<PnPPose> m_poses;
+        std::vector<Hypothesis> m_hyps;
+        std::vector<std::size_t> m_alive;
+        /// @}
+    };
+} // namespace uvbi
+} // namespace videotracker
@@ -126,7 +126,8 @@ namespace uvbi {
 
         // Get a list of boolean values for 0's and 1's using
         // the threshold computed above.
-        auto bits = getBitsUsingThreshold(brightnesses, threshold);
+        auto &bits = d_bits;
+        getBitsUsingThreshold(brightnesses, threshold, bits);
 
         // Search through the available patterns to see if the passed-in
         // pattern matches any of them.  If so, return that pattern.  We
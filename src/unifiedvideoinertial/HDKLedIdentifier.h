@@ -31,7 +31,7 @@
 // - none
 
 // Standard includes
-// - none
+#include <cstddef>
 
 namespace videotracker {
 namespace uvbi {
@@ -54,9 +54,15 @@ namespace uvbi {
                                 BrightnessList &brightnesses, bool &lastBright,
                                 bool blobsKeepId) const override;
 
+        std::size_t getHistoryLength() const override { return d_length; }
+
       private:
         size_t d_length;        //< Length of all patterns
         PatternList d_patterns; //< Patterns by index
+        /// Working storage for getId(), so patterns longer than fit in a
+        /// string without allocating don't allocate every frame. This makes
+        /// getId() unsafe to call from more than one thread at a time.
+        mutable LedPatternWrapped d_bits;
     };
 
 } // namespace uvbi
@@ -28,9 +28,10 @@
 // - none
 
 // Library/third-party includes
-#include "unifiedvideoinertial/TimeValue.h"
+#include "unifiedvideoinertial/Timestamp.h"
 
 // Standard includes
+#include <algorithm>
 #include <deque>
 #include <iterator>
 #include <stdexcept>
@@ -40,7 +41,7 @@ namespace uvbi {
     namespace history {
 
         namespace detail {
-            using timestamp = videotracker::util::TimeValue;
+            using timestamp = videotracker::util::Timestamp;
 
             template <typename ValueType>
             using full_value_type = std::pair<timestamp, ValueType>;
@@ -346,7 +347,7 @@ namespace uvbi {
             /// Adds a new value to history. It must be newer (or equal time,
             /// based on template parameters) than the newest (or the history
             /// must be empty).
-            void push_newest(videotracker::util::TimeValue const &tv,
+            void push_newest(timestamp_type const &tv,
                              value_type const &value) {
                 if (is_valid_to_push_newest(tv)) {
                     m_history.emplace_back(tv, value);
@@ -29,7 +29,7 @@
 
 // Library/third-party includes
 #include "ClientReportTypesC.h"
-#include "unifiedvideoinertial/TimeValue.h"
+#include "unifiedvideoinertial/Timestamp.h"
 #include "unifiedvideoinertial/nonstd/variant.hpp"
 
 // Standard includes
@@ -49,7 +49,7 @@ namespace uvbi {
     /// and the internal tracking system's pointer to IMU object.
     template <typename ReportType> class TimestampedImuReport {
       public:
-        TimestampedImuReport(TrackedBodyIMU &myImu, util::TimeValue const &tv,
+        TimestampedImuReport(TrackedBodyIMU &myImu, util::Timestamp const &tv,
                              ReportType const &d)
             : imuPtr(&myImu), timestamp(tv), data(d) {}
 
@@ -59,14 +59,14 @@ namespace uvbi {
       public:
         TrackedBodyIMU &imu() const { return *imuPtr; }
 
-        util::TimeValue timestamp;
+        util::Timestamp timestamp;
         ReportType data;
     };
 
     /// Generic constructor/factory function
     template <typename ReportType>
     inline TimestampedImuReport<ReportType>
-    makeImuReport(TrackedBodyIMU &myImu, util::TimeValue const &tv,
+    makeImuReport(TrackedBodyIMU &myImu, util::Timestamp const &tv,
                   ReportType const &d) {
         return TimestampedImuReport<ReportType>{myImu, tv, d};
     }
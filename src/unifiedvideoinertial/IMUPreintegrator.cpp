@@ -0,0 +1,113 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "IMUPreintegrator.h"
+#include "unifiedvideoinertial/AngVelTools.h"
+
+// Library/third-party includes
+#include "videotrackershared/Assert.h"
+
+// Standard includes
+// - none
+
+namespace videotracker {
+namespace uvbi {
+    void IMUPreintegrator::begin(util::Timestamp const &startTime) {
+        m_start = startTime;
+        m_newest = startTime;
+        m_numSamples = 0;
+        m_hasOrientation = false;
+        m_hasAngVel = false;
+        m_angVelEnd = startTime;
+        m_angVelSeconds = 0;
+        m_deltaQuat.setIdentity();
+        m_integratedVariance.setZero();
+        m_weightedSum.setZero();
+        m_weightedSquaredSum.setZero();
+    }
+
+    void IMUPreintegrator::add(util::Timestamp const &tv,
+                               CannedIMUMeasurement const &meas) {
+        VIDEOTRACKER_ASSERT_MSG(!(tv < m_newest),
+                                "IMU samples must be added in order, not "
+                                "before the start of the window!");
+        m_newest = tv;
+        ++m_numSamples;
+        if (meas.orientationValid()) {
+            m_orientation = meas;
+            m_hasOrientation = true;
+        }
+        if (meas.angVelValid()) {
+            Eigen::Vector3d angVel;
+            meas.restoreAngVel(angVel);
+            Eigen::Vector3d var;
+            meas.restoreAngVelVariance(var);
+            auto dt = util::time::duration(tv, m_angVelEnd);
+            m_angVelEnd = tv;
+            m_angVelSeconds += dt;
+            m_deltaQuat = (m_deltaQuat * angVelVecToIncRot(angVel, dt))
+                              .normalized();
+            m_integratedVariance += var * (dt * dt);
+            m_weightedSum += angVel * dt;
+            m_weightedSquaredSum += angVel.cwiseAbs2() * dt;
+            m_lastAngVel = angVel;
+            m_lastAngVelVariance = var;
+            m_angVelYawCorrection = meas.getYawCorrection();
+            m_hasAngVel = true;
+        }
+    }
+
+    double IMUPreintegrator::getSpan() const {
+        return util::time::duration(m_newest, m_start);
+    }
+
+    CannedIMUMeasurement IMUPreintegrator::getMeasurement() const {
+        VIDEOTRACKER_ASSERT_MSG(!empty(),
+                                "No IMU samples to make a measurement from!");
+        auto ret = CannedIMUMeasurement{};
+        if (m_hasOrientation) {
+            ret = m_orientation;
+        }
+        if (!m_hasAngVel) {
+            return ret;
+        }
+        if (!m_hasOrientation) {
+            ret.setYawCorrection(m_angVelYawCorrection);
+        }
+        const double seconds = m_angVelSeconds;
+        if (seconds <= 0) {
+            /// Only samples at the very start of the window: nothing to
+            /// integrate over.
+            ret.setAngVel(m_lastAngVel, m_lastAngVelVariance);
+            return ret;
+        }
+        Eigen::Vector3d angVel =
+            incRotToAngVelVec(Eigen::Quaterniond(m_deltaQuat), seconds);
+        Eigen::Vector3d mean = m_weightedSum / seconds;
+        Eigen::Vector3d spread =
+            (m_weightedSquaredSum / seconds - mean.cwiseAbs2()).cwiseMax(0.);
+        Eigen::Vector3d var =
+            m_integratedVariance / (seconds * seconds) + spread;
+        ret.setAngVel(angVel, var);
+        return ret;
+    }
+} // namespace uvbi
+} // namespace videotracker
@@ -0,0 +1,105 @@
+/** @file
+    @brief Header for accumulating a window of IMU samples into a single
+    measurement for the Kalman filter.
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+// Internal Includes
+#include "unifiedvideoinertial/CannedIMUMeasurement.h"
+
+// Library/third-party includes
+#include "unifiedvideoinertial/Timestamp.h"
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+// Standard includes
+#include <cstddef>
+
+namespace videotracker {
+namespace uvbi {
+    /// Accumulates the IMU samples arriving over a window of time into one
+    /// CannedIMUMeasurement, so the filter can take a correction or two per
+    /// window instead of one per sample.
+    ///
+    /// - Angular velocity samples are integrated: each is taken to hold from
+    ///   the previous one (or the start of the window) until its own
+    ///   timestamp, and their incremental rotations are composed. The result
+    ///   is the mean angular velocity over the window, with the samples'
+    ///   variances propagated through the integration, plus the spread of
+    ///   the samples about that mean, since the filter takes it as the
+    ///   angular velocity at the end of the window.
+    /// - Orientation samples come from an AHRS that has already filtered
+    ///   them, so successive ones aren't independent: fusing them would be
+    ///   overconfident. The newest one is kept, as is.
+    ///
+    /// A window holding a single sample gives back that sample.
+    class IMUPreintegrator {
+      public:
+        /// Discards any samples and starts a new window with the state at
+        /// the given time.
+        void begin(util::Timestamp const &startTime);
+
+        /// Discards any samples: begin() must be called before adding more.
+        void clear() { m_numSamples = 0; }
+
+        /// Adds a sample, which must be no older than the start of the window
+        /// or any sample already added: an orientation and an angular
+        /// velocity report may share a timestamp.
+        void add(util::Timestamp const &tv, CannedIMUMeasurement const &meas);
+
+        bool empty() const { return m_numSamples == 0; }
+
+        std::size_t size() const { return m_numSamples; }
+
+        /// Seconds from the start of the window to the newest sample.
+        double getSpan() const;
+
+        /// Timestamp of the newest sample: the time the measurement applies.
+        util::Timestamp const &getNewestTime() const { return m_newest; }
+
+        /// The measurement standing in for all the samples added since
+        /// begin(). Only valid if not empty().
+        CannedIMUMeasurement getMeasurement() const;
+
+      private:
+        util::Timestamp m_start;
+        util::Timestamp m_newest;
+        std::size_t m_numSamples = 0;
+
+        bool m_hasOrientation = false;
+        CannedIMUMeasurement m_orientation;
+
+        bool m_hasAngVel = false;
+        Angle m_angVelYawCorrection;
+        /// End of the time covered by the angular velocity samples so far.
+        util::Timestamp m_angVelEnd;
+        double m_angVelSeconds = 0;
+        /// Composed incremental rotation.
+        Eigen::Quaternion<double, Eigen::DontAlign> m_deltaQuat;
+        /// Sum of each sample's variance times the square of its duration.
+        Eigen::Vector3d m_integratedVariance;
+        /// Duration-weighted sums of the samples and of their squares.
+        Eigen::Vector3d m_weightedSum;
+        Eigen::Vector3d m_weightedSquaredSum;
+        Eigen::Vector3d m_lastAngVel;
+        Eigen::Vector3d m_lastAngVelVariance;
+    };
+} // namespace uvbi
+} // namespace videotracker
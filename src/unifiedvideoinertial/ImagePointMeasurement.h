@@ -90,6 +90,13 @@ namespace uvbi {
             return m_measurement - predicted;
         }
 
+        /// Velocity, in pixels per second, of the predicted image point due
+        /// to the body's angular velocity alone. Assumes the incremental
+        /// rotation has been externalized, as getJacobian() does.
+        Eigen::Vector2d getRotationalImageVelocity(State const &state) const {
+            return getRotationJacobian() * state.a().angularVelocity();
+        }
+
         void setMeasurement(Vector const &m) { m_measurement = m; }
         Eigen::Matrix<double, 2, 3> getBeaconJacobian() const {
             auto v1 = m_rot(0, 2) * m_beacon[2] + m_rot(0, 1) * m_beacon[1] +
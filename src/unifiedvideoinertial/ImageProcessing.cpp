@@ -0,0 +1,88 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "unifiedvideoinertial/ImageProcessing.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+namespace videotracker {
+namespace uvbi {
+    void ImageProcessingOutputRecycler::
+    operator()(ImageProcessingOutput *output) const {
+        if (m_pool) {
+            m_pool->release(output);
+        } else {
+            delete output;
+        }
+    }
+
+    const std::size_t ImageProcessingOutputPool::MaxIdleOutputs;
+
+    std::shared_ptr<ImageProcessingOutputPool>
+    ImageProcessingOutputPool::create() {
+        return std::shared_ptr<ImageProcessingOutputPool>(
+            new ImageProcessingOutputPool);
+    }
+
+    ImageProcessingOutputPool::ImageProcessingOutputPool() {
+        /// So releasing never has to grow it.
+        m_idle.reserve(MaxIdleOutputs);
+    }
+
+    ImageOutputDataPtr ImageProcessingOutputPool::acquire() {
+        ImageProcessingOutputRecycler recycler(shared_from_this());
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_idle.empty()) {
+                ImageOutputDataPtr ret(m_idle.back().release(), recycler);
+                m_idle.pop_back();
+                return ret;
+            }
+        }
+        return ImageOutputDataPtr(new ImageProcessingOutput, recycler);
+    }
+
+    std::size_t ImageProcessingOutputPool::idle() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_idle.size();
+    }
+
+    void ImageProcessingOutputPool::release(ImageProcessingOutput *output) {
+        std::unique_ptr<ImageProcessingOutput> out(output);
+        /// Let go of the images now, rather than whenever the output is next
+        /// used: the camera may want its buffers back. The measurements just
+        /// keep their capacity.
+        out->ledMeasurements.clear();
+        out->frame = LazyColorFrame{};
+        out->frameGray.release();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_idle.size() < MaxIdleOutputs) {
+            m_idle.push_back(std::move(out));
+            return;
+        }
+        /// Otherwise, the output is deleted once the lock is released.
+    }
+} // namespace uvbi
+} // namespace videotracker
@@ -24,7 +24,9 @@
 
 // Internal Includes
 #include "ImageProcessingThread.h"
+#include "ThreadScheduling.h"
 #include "TrackerThread.h"
+#include "unifiedvideoinertial/TrackingMetrics.h"
 #include "unifiedvideoinertial/TrackingSystem.h"
 
 #include "unifiedvideoinertial/ImageSources/ImageSource.h"
@@ -33,6 +35,7 @@
 #include "unifiedvideoinertial/Finally.h"
 
 // Standard includes
+#include <chrono>
 #include <iostream>
 
 namespace videotracker {
@@ -44,7 +47,8 @@ namespace uvbi {
         : trackingSystem_(trackingSystem), cam_(cam),
           trackerThreadObj_(trackerThread), camParams_(camParams),
           cameraUsecOffset_(cameraUsecOffset),
-          logBlobs_(trackingSystem_.getParams().logRawBlobs) {
+          logBlobs_(trackingSystem_.getParams().logRawBlobs),
+          measureJitter_(trackingSystem_.getParams().measureSchedulingJitter) {
         if (logBlobs_) {
             blobFile_.open("blobs.csv");
             if (blobFile_) {
@@ -60,6 +64,9 @@ namespace uvbi {
         {
             std::lock_guard<std::mutex> lock{stateMutex_};
             next_ = NextOp::DoFrame;
+            if (measureJitter_) {
+                doFrameSignalled_ = std::chrono::steady_clock::now();
+            }
         }
         stateCondVar_.notify_all();
     }
@@ -73,6 +80,7 @@ namespace uvbi {
     }
 
     void ImageProcessingThread::threadAction() {
+        setupScheduling();
         while (true) {
             {
                 std::unique_lock<std::mutex> lock(stateMutex_);
@@ -92,24 +100,53 @@ namespace uvbi {
                 /// Otherwise, we should do a frame.
                 /// Re-set the next op while we still hold the mutex.
                 next_ = NextOp::Waiting;
+                if (measureJitter_) {
+                    lastWakeupDelay_ =
+                        std::chrono::steady_clock::now() - doFrameSignalled_;
+                    trackingSystem_.getMetrics().record(
+                        MetricStage::ImageThreadWakeup, lastWakeupDelay_);
+                }
             }
             doFrame();
         }
     }
 
+    void ImageProcessingThread::setupScheduling() {
+        auto const &params = trackingSystem_.getParams();
+        auto scheduling = getImageThreadScheduling(params);
+        if (scheduling.isDefault()) {
+            return;
+        }
+        for (auto const &failure : applyToCurrentThread(scheduling)) {
+            warn() << failure << std::endl;
+        }
+        if (params.numThreads > 0) {
+            /// OpenCV's worker threads were started (by the pthreads or
+            /// OpenMP backend) on whatever thread first needed them, so
+            /// restart them from this one for them to inherit its
+            /// scheduling.
+            cv::setNumThreads(0);
+            cv::setNumThreads(params.numThreads);
+        }
+    }
+
     void ImageProcessingThread::doFrame() {
         ImageOutputDataPtr data;
         /// On scope exit, no matter how, signal to the tracker thread that
         /// we're done.
         auto signalCompletion = util::finally([&] {
             trackerThreadObj_.signalImageProcessingComplete(std::move(data),
-                                                            frame_, gray_);
+                                                            gray_);
         });
 
-        // Pull the image into an OpenCV matrix named m_frame.
-        util::TimeValue frameTime;
-        cam_.retrieve(frame_, gray_, frameTime);
-        if (!frame_.data || !gray_.data) {
+        // Pull the image into an OpenCV matrix named gray_.
+        util::Timestamp frameTime;
+        {
+            ScopedStageTimer timer(trackingSystem_.getMetrics(),
+                                   MetricStage::ImageRetrieve);
+            cam_.retrieveGray(gray_, frameTime);
+        }
+        if (!gray_.data) {
             // let the tracker thread warn if it wants to, we'll just get
             // out.
             return;
@@ -122,14 +159,13 @@ namespace uvbi {
 
         if (cameraUsecOffset_ != 0) {
             // apply offset, if non-zero.
-            const util::TimeValue offset{0, cameraUsecOffset_};
-            uvbiTimeValueSum(&frameTime, &offset);
+            frameTime += std::chrono::microseconds(cameraUsecOffset_);
         }
 
         // Do the slow, but intentionally async-able part of the image
         // processing.
-        data = trackingSystem_.performInitialImageProcessing(frameTime, frame_,
-                                                             gray_, camParams_);
+        data = trackingSystem_.performInitialImageProcessing(frameTime, gray_,
+                                                             camParams_);
         // Log blobs, if applicable
         if (logBlobs_) {
             if (!blobFile_) {
@@ -137,7 +173,9 @@ namespace uvbi {
                 logBlobs_ = false;
                 return;
             }
-            blobFile_ << data->tv.seconds << "," << data->tv.microseconds;
+            /// Logged with the wall-clock time, as before.
+            auto tv = util::time::toApiTimeValue(data->tv);
+            blobFile_ << tv.seconds << "," << tv.microseconds;
             for (auto &measurement : data->ledMeasurements) {
                 blobFile_ << "," << measurement.loc.x << ","
                           << measurement.loc.y << "," << measurement.diameter;
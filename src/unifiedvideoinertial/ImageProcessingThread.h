@@ -31,6 +31,7 @@
 #include <opencv2/core/core.hpp>
 
 // Standard includes
+#include <chrono>
 #include <condition_variable>
 #include <cstdint>
 #include <fstream>
@@ -65,6 +66,13 @@ namespace uvbi {
         /// Did we get the exit message?
         bool exiting() const { return exiting_; }
 
+        /// How long the thread took to wake up for the last frame, if
+        /// measuring scheduling jitter. Only for the tracker thread, once
+        /// that frame is complete.
+        std::chrono::nanoseconds getLastWakeupDelay() const {
+            return lastWakeupDelay_;
+        }
+
       private:
         /// Helper providing a prefixed output stream for normal messages.
         std::ostream &msg() const;
@@ -72,6 +80,8 @@ namespace uvbi {
         std::ostream &warn() const;
         /// Performs the retrieval and processing of a single frame.
         void doFrame();
+        /// Applies the configured scheduling to this thread.
+        void setupScheduling();
 
         TrackingSystem &trackingSystem_;
         ImageSource &cam_;
@@ -89,7 +99,15 @@ namespace uvbi {
         std::condition_variable stateCondVar_;
         NextOp next_ = NextOp::Waiting;
 
-        cv::Mat frame_;
+        /// @name Scheduling jitter measurement
+        /// @{
+        const bool measureJitter_;
+        std::chrono::steady_clock::time_point doFrameSignalled_;
+        std::chrono::nanoseconds lastWakeupDelay_{0};
+        /// @}
+
+        /// Only the gray frame is retrieved: the tracker makes a color one
+        /// from it if it needs one.
         cv::Mat gray_;
 
         bool exiting_ = false;
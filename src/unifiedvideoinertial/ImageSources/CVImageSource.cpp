@@ -47,14 +47,14 @@ namespace uvbi {
         bool ok() const override { return m_camera && m_camera->isOpened(); }
         bool grab() override;
         void retrieveColor(cv::Mat &color,
-                           videotracker::util::TimeValue &timestamp) override;
+                           videotracker::util::Timestamp &timestamp) override;
         cv::Size resolution() const override;
 
       private:
         void storeRes();
         CVCapturePtr m_camera;
         cv::Size m_res;
-        videotracker::util::TimeValue m_timestamp = {};
+        videotracker::util::Timestamp m_timestamp = {};
     };
 
     ImageSourcePtr openOpenCVCamera(int which) {
@@ -71,14 +71,14 @@ namespace uvbi {
     bool OpenCVImageSource::grab() {
         bool ret = m_camera->grab();
         if (ret) {
-            m_timestamp = util::time::getNow();
+            m_timestamp = util::time::getSteadyNow();
         }
         return ret;
     }
 
     void
     OpenCVImageSource::retrieveColor(cv::Mat &color,
-                                     videotracker::util::TimeValue &timestamp) {
+                                     videotracker::util::Timestamp &timestamp) {
         m_camera->retrieve(color);
         timestamp = m_timestamp;
     }
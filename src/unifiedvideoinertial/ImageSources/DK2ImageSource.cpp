@@ -23,8 +23,9 @@
 // limitations under the License.
 
 // Internal Includes
-#include "ImageSourceFactories.h"
+#include "DK2Unscramble.h"
 #include "Oculus_DK2.h"
+#include "unifiedvideoinertial/ImageSources/ImageSourceFactories.h"
 
 // Library/third-party includes
 #include <opencv2/imgproc/imgproc.hpp>
@@ -47,14 +48,19 @@ namespace uvbi {
         bool ok() const override { return m_camera && m_camera->ok(); }
         bool grab() override;
         void retrieve(cv::Mat &color, cv::Mat &gray,
-                      videotracker::util::TimeValue &timestamp) override;
+                      videotracker::util::Timestamp &timestamp) override;
+        void retrieveGray(cv::Mat &gray,
+                          videotracker::util::Timestamp &timestamp) override;
         cv::Size resolution() const override;
         void retrieveColor(cv::Mat &color,
-                           videotracker::util::TimeValue &timestamp) override;
+                           videotracker::util::Timestamp &timestamp) override;
 
       private:
         ImageSourcePtr m_camera;
+        /// The frame as the camera decodes it, reused every frame.
         cv::Mat m_scratch;
+        /// Unscrambled frame for retrieveColor(), reused every frame.
+        cv::Mat m_gray;
         std::unique_ptr<oculus_dk2::Oculus_DK2_HID> m_hid;
     };
 
@@ -77,20 +83,22 @@ namespace uvbi {
 
     void
     DK2WrappedImageSource::retrieve(cv::Mat &color, cv::Mat &gray,
-                                    videotracker::util::TimeValue &timestamp) {
+                                    videotracker::util::Timestamp &timestamp) {
+        retrieveGray(gray, timestamp);
+        cv::cvtColor(gray, color, cv::COLOR_GRAY2BGR);
+    }
 
+    void DK2WrappedImageSource::retrieveGray(
+        cv::Mat &gray, videotracker::util::Timestamp &timestamp) {
         m_camera->retrieveColor(m_scratch, timestamp);
-
-        gray = osvr::oculus_dk2::unscramble_image(m_scratch);
-        cv::cvtColor(gray, color, cv::GRAY2RGB);
+        /// Straight into the caller's buffer: no allocation once it's the
+        /// right size, and no color image unless one is asked for.
+        oculus_dk2::unscrambleImage(m_scratch, gray);
     }
 
     void DK2WrappedImageSource::retrieveColor(
-        cv::Mat &color, videotracker::util::TimeValue &timestamp) {
-        // Here we implement retrieveColor by implementing retrieve and just
-        // tossing the gray result...
-        cv::Mat dummy;
-        retrieve(color, dummy, timestamp);
+        cv::Mat &color, videotracker::util::Timestamp &timestamp) {
+        retrieve(color, m_gray, timestamp);
     }
 
     cv::Size DK2WrappedImageSource::resolution() const {
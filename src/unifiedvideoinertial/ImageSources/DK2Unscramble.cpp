@@ -0,0 +1,136 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "DK2Unscramble.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define UVBI_DK2_UNSCRAMBLE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace videotracker {
+namespace oculus_dk2 {
+    /// Fixed-point Rec.601 luma weights, scaled by 2^14: the same ones
+    /// OpenCV uses for 8-bit BGR to YCrCb, so results match it exactly.
+    static const int LUMA_SHIFT = 14;
+    static const int LUMA_B = 1868;
+    static const int LUMA_G = 9617;
+    static const int LUMA_R = 4899;
+    static const int LUMA_ROUND = 1 << (LUMA_SHIFT - 1);
+
+    void unscrambleRowScalar(const std::uint8_t *bgr, std::uint8_t *gray,
+                             std::size_t pixels) {
+        for (std::size_t i = 0; i < pixels; ++i, bgr += 3, gray += 2) {
+            auto y = static_cast<std::uint8_t>(
+                (bgr[0] * LUMA_B + bgr[1] * LUMA_G + bgr[2] * LUMA_R +
+                 LUMA_ROUND) >>
+                LUMA_SHIFT);
+            gray[0] = y;
+            gray[1] = y;
+        }
+    }
+
+#ifdef UVBI_DK2_UNSCRAMBLE_SSE2
+    /// Splits 16 interleaved BGR pixels into their three channels, with
+    /// nothing but SSE2 unpacks.
+    static inline void deinterleave(const std::uint8_t *ptr, __m128i &b,
+                                    __m128i &g, __m128i &r) {
+        auto in0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+        auto in1 =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr + 16));
+        auto in2 =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr + 32));
+        /// Each round interleaves the low half of one register with the high
+        /// half of the next: after four, the bytes are sorted by channel.
+        for (int round = 0; round < 4; ++round) {
+            auto t0 = _mm_unpacklo_epi8(in0, _mm_unpackhi_epi64(in1, in1));
+            auto t1 = _mm_unpacklo_epi8(_mm_unpackhi_epi64(in0, in0), in2);
+            auto t2 = _mm_unpacklo_epi8(in1, _mm_unpackhi_epi64(in2, in2));
+            in0 = t0;
+            in1 = t1;
+            in2 = t2;
+        }
+        b = in0;
+        g = in1;
+        r = in2;
+    }
+
+    /// Luma of 8 pixels, given their channels widened to 16 bits.
+    static inline __m128i luma8(__m128i b, __m128i g, __m128i r) {
+        const auto bgWeights = _mm_set1_epi32((LUMA_G << 16) | LUMA_B);
+        const auto rWeights = _mm_set1_epi32((LUMA_ROUND << 16) | LUMA_R);
+        const auto one = _mm_set1_epi16(1);
+        /// Pair up (b, g) and (r, 1) so one multiply-add per pair gives
+        /// b * LUMA_B + g * LUMA_G and r * LUMA_R + LUMA_ROUND in 32 bits.
+        auto bgLo = _mm_madd_epi16(_mm_unpacklo_epi16(b, g), bgWeights);
+        auto bgHi = _mm_madd_epi16(_mm_unpackhi_epi16(b, g), bgWeights);
+        auto rLo = _mm_madd_epi16(_mm_unpacklo_epi16(r, one), rWeights);
+        auto rHi = _mm_madd_epi16(_mm_unpackhi_epi16(r, one), rWeights);
+        auto lo = _mm_srli_epi32(_mm_add_epi32(bgLo, rLo), LUMA_SHIFT);
+        auto hi = _mm_srli_epi32(_mm_add_epi32(bgHi, rHi), LUMA_SHIFT);
+        return _mm_packs_epi32(lo, hi);
+    }
+#endif // UVBI_DK2_UNSCRAMBLE_SSE2
+
+    void unscrambleRow(const std::uint8_t *bgr, std::uint8_t *gray,
+                       std::size_t pixels) {
+        std::size_t i = 0;
+#ifdef UVBI_DK2_UNSCRAMBLE_SSE2
+        const auto zero = _mm_setzero_si128();
+        for (; i + 16 <= pixels; i += 16) {
+            __m128i b, g, r;
+            deinterleave(bgr + i * 3, b, g, r);
+            auto yLo = luma8(_mm_unpacklo_epi8(b, zero),
+                             _mm_unpacklo_epi8(g, zero),
+                             _mm_unpacklo_epi8(r, zero));
+            auto yHi = luma8(_mm_unpackhi_epi8(b, zero),
+                             _mm_unpackhi_epi8(g, zero),
+                             _mm_unpackhi_epi8(r, zero));
+            auto y = _mm_packus_epi16(yLo, yHi);
+            /// Interleaving with itself doubles each pixel horizontally.
+            auto out = reinterpret_cast<__m128i *>(gray + i * 2);
+            _mm_storeu_si128(out, _mm_unpacklo_epi8(y, y));
+            _mm_storeu_si128(out + 1, _mm_unpackhi_epi8(y, y));
+        }
+#endif // UVBI_DK2_UNSCRAMBLE_SSE2
+        unscrambleRowScalar(bgr + i * 3, gray + i * 2, pixels - i);
+    }
+
+    void unscrambleImage(cv::Mat const &bgr, cv::Mat &gray) {
+        if (bgr.type() != CV_8UC3) {
+            throw std::invalid_argument(
+                "DK2 unscrambling needs an 8-bit, 3-channel image");
+        }
+        gray.create(bgr.rows, bgr.cols * 2, CV_8UC1);
+        for (int y = 0; y < bgr.rows; ++y) {
+            unscrambleRow(bgr.ptr<std::uint8_t>(y), gray.ptr<std::uint8_t>(y),
+                          static_cast<std::size_t>(bgr.cols));
+        }
+    }
+} // namespace oculus_dk2
+} // namespace videotracker
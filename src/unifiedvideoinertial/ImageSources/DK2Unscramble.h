@@ -0,0 +1,55 @@
+/** @file
+    @brief Header for the kernel that recovers the real grayscale image from
+    the mis-decoded frames of a DK2 camera.
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <opencv2/core/core.hpp>
+
+// Standard includes
+#include <cstddef>
+#include <cstdint>
+
+namespace videotracker {
+namespace oculus_dk2 {
+    /// Unscrambles one row: computes the luma of each of @p pixels 8-bit BGR
+    /// input pixels, bit-exact with cv::COLOR_BGR2YCrCb, and writes it twice
+    /// to @p gray, which must have room for 2 * @p pixels bytes.
+    ///
+    /// Uses SSE2 where available.
+    void unscrambleRow(const std::uint8_t *bgr, std::uint8_t *gray,
+                       std::size_t pixels);
+
+    /// Portable version of unscrambleRow(), used for the tail of each row and
+    /// as the reference in tests.
+    void unscrambleRowScalar(const std::uint8_t *bgr, std::uint8_t *gray,
+                             std::size_t pixels);
+
+    /// Unscrambles a whole CV_8UC3 frame from a DK2 camera into a CV_8UC1
+    /// image twice as wide, in one pass. @p gray is only (re)allocated if it
+    /// doesn't already have the right size and type, so passing the same
+    /// buffer every frame doesn't allocate.
+    void unscrambleImage(cv::Mat const &bgr, cv::Mat &gray);
+} // namespace oculus_dk2
+} // namespace videotracker
@@ -54,7 +54,7 @@ namespace uvbi {
         }
         bool grab() override;
         void retrieveColor(cv::Mat &color,
-                           videotracker::util::TimeValue &timestamp) override;
+                           videotracker::util::Timestamp &timestamp) override;
         cv::Size resolution() const override;
 
       private:
@@ -131,9 +131,11 @@ namespace uvbi {
         return m_camera->read_image_to_memory();
     }
     void DirectShowImageSource::retrieveColor(
-        cv::Mat &color, videotracker::util::TimeValue &timestamp) {
+        cv::Mat &color, videotracker::util::Timestamp &timestamp) {
         color = ::retrieve(*m_camera);
-        timestamp = m_camera->get_buffer_timestamp();
+        /// DirectShow stamps buffers with the wall clock.
+        timestamp =
+            util::time::fromApiTimeValue(m_camera->get_buffer_timestamp());
     }
     cv::Size DirectShowImageSource::resolution() const { return m_res; }
 
@@ -24,7 +24,7 @@
 
 // Internal Includes
 #include "unifiedvideoinertial/ImageSources/ImageSourceFactories.h"
-#include "unifiedvideoinertial/TimeValue.h"
+#include "unifiedvideoinertial/Timestamp.h"
 
 // Library/third-party includes
 #include <opencv2/highgui/highgui.hpp> // for image capture
@@ -47,14 +47,17 @@ namespace uvbi {
         bool ok() const override { return !m_images.empty(); }
         bool grab() override;
         void retrieveColor(cv::Mat &color,
-                           videotracker::util::TimeValue &timestamp) override;
+                           videotracker::util::Timestamp &timestamp) override;
         cv::Size resolution() const override;
 
       private:
         std::vector<cv::Mat> m_images;
         size_t m_currentImage = 0;
         cv::Size m_res;
-        videotracker::util::TimeValue m_timestamp = {};
+        /// Made up, 10ms apart.
+        videotracker::util::Timestamp m_timestamp = {
+            videotracker::util::ClockDomain::Offline,
+            std::chrono::nanoseconds(0)};
     };
 
     ImageSourcePtr openImageFileSequence(std::string const &dir) {
@@ -92,7 +95,7 @@ namespace uvbi {
 
     void
     FakeImageSource::retrieveColor(cv::Mat &color,
-                                   videotracker::util::TimeValue &timestamp) {
+                                   videotracker::util::Timestamp &timestamp) {
         m_images[m_currentImage].copyTo(color);
         timestamp = m_timestamp;
     }
@@ -35,9 +35,14 @@ namespace videotracker {
 namespace uvbi {
     ImageSource::~ImageSource() = default;
     void ImageSource::retrieve(cv::Mat &color, cv::Mat &gray,
-                               videotracker::util::TimeValue &timestamp) {
+                               videotracker::util::Timestamp &timestamp) {
         retrieveColor(color, timestamp);
         cv::cvtColor(color, gray, cv::COLOR_RGB2GRAY);
     }
+    void ImageSource::retrieveGray(cv::Mat &gray,
+                                   videotracker::util::Timestamp &timestamp) {
+        cv::Mat color;
+        retrieve(color, gray, timestamp);
+    }
 } // namespace uvbi
 } // namespace videotracker
@@ -23,11 +23,11 @@ Sensics, Inc.
 // limitations under the License.
 
 #include "Oculus_DK2.h"
+#include "DK2Unscramble.h"
 //#include <opencv2/core/operations.hpp>
 #include <opencv2/imgproc/imgproc.hpp> // for image scaling
 
-using namespace uvbi;
-using namespace oculus_dk2;
+using namespace videotracker::oculus_dk2;
 
 static const vrpn_uint16 OCULUS_VENDOR = 0x2833;
 static const vrpn_uint16 DK2_PRODUCT = 0x0021;
@@ -147,7 +147,7 @@ void Oculus_DK2_HID::on_data_received(size_t bytes, vrpn_uint8 *buffer) {
     // XXX
 }
 
-cv::Mat osvr::oculus_dk2::unscramble_image(const cv::Mat &image) {
+cv::Mat videotracker::oculus_dk2::unscramble_image(const cv::Mat &image) {
     //   From the documentation: "Note OpenCV 1.x
     // functions cvRetrieveFrame and cv.RetrieveFrame return image
     // stored inside the video capturing structure. It is not
@@ -211,30 +211,18 @@ cv::Mat osvr::oculus_dk2::unscramble_image(const cv::Mat &image) {
     // output on the DK2 does not specify the color space, just the
     // encoding format.
 
-    // Okay, so here we convert from BGR back into YUV.
-    cv::Mat yuvImage;
-    cv::cvtColor(image, yuvImage, cv::COLOR_BGR2YCrCb);
-
-    // Then we repack the individual components; every Y is used
-    // (second and fourth entry), but Cb is the first entry of
-    // four and Cr the third:  Cb0 Y0 Cr0 Y1 Cb2 Y2 Cr2 Y3.
-    // So the image itself has interplated Cb and Cr values...
-    // For now, we do a brain-dead conversion, where we double the width
-    // of the YUV image, make it grayscale, and copy the Y channels from
-    // the input image into neighboring pixels in the output image; doubling
-    // every one.
+    // So we take the Y channel of the BGR to YCrCb conversion (every Y is
+    // used, but Cb is the first entry of four and Cr the third:
+    // Cb0 Y0 Cr0 Y1 Cb2 Y2 Cr2 Y3, so the image itself has interpolated Cb
+    // and Cr values...)  For now, we do a brain-dead conversion, where we
+    // double the width of the image, make it grayscale, and copy the Y
+    // channel from the input image into neighboring pixels in the output
+    // image; doubling every one. unscrambleImage() does this in a single
+    // pass without computing Cr and Cb at all.
     //  TODO: Invert the transformation used to get from YUV to BGR and
     // determine the actual components, which are in fact a set of greyscale
     // values.
-    cv::Mat outImage(yuvImage.rows, yuvImage.cols * 2, CV_8UC1, cv::Scalar(0));
-    for (int r = 0; r < yuvImage.rows; r++) {
-        for (int c = 0; c < yuvImage.cols; c++) {
-            outImage.at<unsigned char>(r, c * 2) =
-                yuvImage.at<cv::Vec3b>(r, c)[0];
-            outImage.at<unsigned char>(r, c * 2 + 1) =
-                yuvImage.at<cv::Vec3b>(r, c)[0];
-        }
-    }
-
+    cv::Mat outImage;
+    unscrambleImage(image, outImage);
     return outImage;
 }
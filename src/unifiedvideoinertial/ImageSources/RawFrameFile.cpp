@@ -0,0 +1,130 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "unifiedvideoinertial/ImageSources/RawFrameFile.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+namespace videotracker {
+namespace uvbi {
+    static const char RAW_FRAME_MAGIC[] = "UVBIRAW1";
+    static const std::size_t RAW_FRAME_MAGIC_LEN = sizeof(RAW_FRAME_MAGIC) - 1;
+
+    template <typename T> static inline void writeBinary(std::ostream &os, T v) {
+        os.write(reinterpret_cast<const char *>(&v), sizeof(T));
+    }
+    template <typename T> static inline bool readBinary(std::istream &is, T &v) {
+        return static_cast<bool>(
+            is.read(reinterpret_cast<char *>(&v), sizeof(T)));
+    }
+
+    bool isRawFrameFileName(std::string const &fn) {
+        static const std::size_t extLen = sizeof(RAW_FRAME_FILE_EXTENSION) - 1;
+        return fn.size() > extLen &&
+               fn.compare(fn.size() - extLen, extLen,
+                          RAW_FRAME_FILE_EXTENSION) == 0;
+    }
+
+    RawFrameWriter::RawFrameWriter(std::string const &fn)
+        : m_fn(fn), m_os(fn, std::ios::binary | std::ios::trunc) {
+        if (!m_os) {
+            throw std::runtime_error("Could not create raw frame file " + fn);
+        }
+    }
+
+    void RawFrameWriter::write(cv::Mat const &frame,
+                               util::TimeValue const &timestamp) {
+        if (m_type < 0) {
+            m_size = frame.size();
+            m_type = frame.type();
+            m_os.write(RAW_FRAME_MAGIC, RAW_FRAME_MAGIC_LEN);
+            writeBinary(m_os, std::int32_t(m_size.width));
+            writeBinary(m_os, std::int32_t(m_size.height));
+            writeBinary(m_os, std::int32_t(m_type));
+        } else if (frame.size() != m_size || frame.type() != m_type) {
+            throw std::invalid_argument(
+                "All frames in a raw frame file must have the same size and "
+                "type");
+        }
+        writeBinary(m_os, std::int64_t(timestamp.seconds));
+        writeBinary(m_os, std::int32_t(timestamp.microseconds));
+        auto rowBytes = static_cast<std::streamsize>(frame.cols) *
+                        static_cast<std::streamsize>(frame.elemSize());
+        for (int y = 0; y < frame.rows; ++y) {
+            m_os.write(reinterpret_cast<const char *>(frame.ptr(y)), rowBytes);
+        }
+        if (!m_os) {
+            throw std::runtime_error("Error writing to raw frame file " + m_fn);
+        }
+        ++m_frames;
+    }
+
+    RawFrameReader::RawFrameReader(std::string const &fn)
+        : m_is(fn, std::ios::binary) {
+        if (!m_is) {
+            throw std::runtime_error("Could not open raw frame file " + fn);
+        }
+        char magic[RAW_FRAME_MAGIC_LEN];
+        std::int32_t width = 0;
+        std::int32_t height = 0;
+        std::int32_t type = -1;
+        if (!m_is.read(magic, RAW_FRAME_MAGIC_LEN) ||
+            std::memcmp(magic, RAW_FRAME_MAGIC, RAW_FRAME_MAGIC_LEN) != 0 ||
+            !readBinary(m_is, width) || !readBinary(m_is, height) ||
+            !readBinary(m_is, type) || width <= 0 || height <= 0 || type < 0) {
+            throw std::runtime_error(fn + " is not a valid raw frame file");
+        }
+        m_size = cv::Size(width, height);
+        m_type = type;
+        m_firstFrame = m_is.tellg();
+    }
+
+    bool RawFrameReader::read(cv::Mat &frame, util::TimeValue &timestamp) {
+        std::int64_t seconds;
+        std::int32_t microseconds;
+        if (!readBinary(m_is, seconds) || !readBinary(m_is, microseconds)) {
+            return false;
+        }
+        frame.create(m_size, m_type);
+        auto rowBytes = static_cast<std::streamsize>(frame.cols) *
+                        static_cast<std::streamsize>(frame.elemSize());
+        for (int y = 0; y < frame.rows; ++y) {
+            if (!m_is.read(reinterpret_cast<char *>(frame.ptr(y)), rowBytes)) {
+                return false;
+            }
+        }
+        timestamp.seconds = seconds;
+        timestamp.microseconds = microseconds;
+        return true;
+    }
+
+    void RawFrameReader::rewind() {
+        m_is.clear();
+        m_is.seekg(m_firstFrame);
+    }
+} // namespace uvbi
+} // namespace videotracker
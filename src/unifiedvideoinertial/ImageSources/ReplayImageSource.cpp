@@ -0,0 +1,313 @@
+/** @file
+    @brief Implementation of an image source that replays a recording from
+    disk, prefetching frames on a background thread and pacing them by their
+    recorded timestamps.
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "ReplayTiming.h"
+#include "unifiedvideoinertial/ImageSources/ImageSourceFactories.h"
+#include "unifiedvideoinertial/ImageSources/RawFrameFile.h"
+#include "unifiedvideoinertial/ImageSources/VideoFileImageSource.h"
+#include "unifiedvideoinertial/Timestamp.h"
+
+// Library/third-party includes
+#include <opencv2/highgui/highgui.hpp> // for imread
+#include <opencv2/imgproc/imgproc.hpp>
+
+// Standard includes
+#include <condition_variable>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace videotracker {
+namespace uvbi {
+    namespace {
+        struct ReplayFrame {
+            cv::Mat image;
+            util::Timestamp timestamp;
+        };
+
+        /// Reads the frames of a recording in order, from the prefetch thread.
+        class FrameLoader {
+          public:
+            virtual ~FrameLoader() = default;
+            /// Returns false at the end of the recording.
+            virtual bool load(ReplayFrame &frame) = 0;
+            virtual void rewind() = 0;
+        };
+
+        class RawFileLoader : public FrameLoader {
+          public:
+            explicit RawFileLoader(std::string const &fn) : m_reader(fn) {}
+            bool load(ReplayFrame &frame) override {
+                util::TimeValue recorded;
+                if (!m_reader.read(frame.image, recorded)) {
+                    return false;
+                }
+                frame.timestamp = util::Timestamp::fromTimeValue(
+                    recorded, util::ClockDomain::Offline);
+                return true;
+            }
+            void rewind() override { m_reader.rewind(); }
+
+          private:
+            RawFrameReader m_reader;
+        };
+
+        class ImageSequenceLoader : public FrameLoader {
+          public:
+            ImageSequenceLoader(std::string const &dir, double frameRate)
+                : m_dir(dir), m_frameRate(frameRate),
+                  m_timestamps(readTimestampFile(dir + "/timestamps.txt")) {}
+            bool load(ReplayFrame &frame) override {
+                std::ostringstream fileName;
+                fileName << m_dir << "/" << std::setfill('0') << std::setw(4)
+                         << (m_index + 1) << ".tif";
+                frame.image = cv::imread(fileName.str(), cv::IMREAD_COLOR);
+                if (!frame.image.data) {
+                    return false;
+                }
+                frame.timestamp =
+                    getFrameTimestamp(m_timestamps, m_index, m_frameRate);
+                ++m_index;
+                return true;
+            }
+            void rewind() override { m_index = 0; }
+
+          private:
+            std::string m_dir;
+            double m_frameRate;
+            std::vector<util::Timestamp> m_timestamps;
+            std::size_t m_index = 0;
+        };
+    } // namespace
+
+    class ReplayImageSource : public ImageSource {
+      public:
+        ReplayImageSource(std::unique_ptr<FrameLoader> &&loader,
+                          ReplayOptions const &opts);
+        ~ReplayImageSource() override;
+
+        bool ok() const override { return m_ok; }
+        bool grab() override;
+        void retrieveColor(cv::Mat &color,
+                           videotracker::util::Timestamp &timestamp) override;
+        void retrieve(cv::Mat &color, cv::Mat &gray,
+                      videotracker::util::Timestamp &timestamp) override;
+        void retrieveGray(cv::Mat &gray,
+                          videotracker::util::Timestamp &timestamp) override;
+        cv::Size resolution() const override { return m_res; }
+
+      private:
+        void prefetchThread();
+
+        std::unique_ptr<FrameLoader> m_loader;
+        ReplayOptions m_opts;
+        bool m_ok = false;
+        cv::Size m_res;
+
+        /// @name Shared with the prefetch thread
+        /// @{
+        std::mutex m_mutex;
+        std::condition_variable m_frameReady;
+        std::condition_variable m_spaceReady;
+        std::deque<ReplayFrame> m_queue;
+        bool m_finished = false;
+        bool m_stop = false;
+        /// @}
+
+        LoopingTimestamps m_loopTimestamps;
+        ReplayPacer m_pacer;
+        ReplayFrame m_current;
+        std::thread m_thread;
+    };
+
+    ImageSourcePtr openReplay(std::string const &path,
+                              ReplayOptions const &opts) {
+        auto ret = ImageSourcePtr{};
+        std::unique_ptr<FrameLoader> loader;
+        try {
+            if (isRawFrameFileName(path)) {
+                loader.reset(new RawFileLoader{path});
+            } else {
+                loader.reset(
+                    new ImageSequenceLoader{path, opts.defaultFrameRate});
+            }
+        } catch (std::exception &e) {
+            std::cerr << "Could not open replay: " << e.what() << std::endl;
+            return ret;
+        }
+        ret.reset(new ReplayImageSource{std::move(loader), opts});
+        if (!ret->ok()) {
+            // if we couldn't load, reset the pointer right now.
+            ret.reset();
+        }
+        return ret;
+    }
+
+    ImageSourcePtr openRecording(std::string const &path,
+                                 ReplayOptions const &opts) {
+        auto lastSlash = path.find_last_of("/\\");
+        auto lastDot = path.find_last_of('.');
+        bool hasExtension =
+            lastDot != std::string::npos &&
+            (lastSlash == std::string::npos || lastDot > lastSlash);
+        if (isRawFrameFileName(path) || !hasExtension) {
+            return openReplay(path, opts);
+        }
+        return openVideoFile(path, opts);
+    }
+
+    ReplayImageSource::ReplayImageSource(std::unique_ptr<FrameLoader> &&loader,
+                                         ReplayOptions const &opts)
+        : m_loader(std::move(loader)), m_opts(opts),
+          m_loopTimestamps(opts.defaultFrameRate), m_pacer(opts) {
+        if (m_opts.prefetchFrames == 0) {
+            m_opts.prefetchFrames = 1;
+        }
+        /// Load the first frame here, to know the resolution and that
+        /// there's anything to replay at all.
+        ReplayFrame first;
+        if (!m_loader->load(first)) {
+            return;
+        }
+        m_res = first.image.size();
+        first.timestamp = m_loopTimestamps(first.timestamp);
+        m_queue.push_back(std::move(first));
+        m_ok = true;
+        m_thread = std::thread([&] { prefetchThread(); });
+    }
+
+    ReplayImageSource::~ReplayImageSource() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_spaceReady.notify_all();
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+    }
+
+    void ReplayImageSource::prefetchThread() {
+        while (true) {
+            ReplayFrame frame;
+            bool loaded = false;
+            try {
+                loaded = m_loader->load(frame);
+                if (!loaded && m_opts.loop) {
+                    m_loader->rewind();
+                    m_loopTimestamps.startNextPass();
+                    loaded = m_loader->load(frame);
+                }
+            } catch (std::exception &e) {
+                std::cerr << "Error reading replay frame: " << e.what()
+                          << std::endl;
+                loaded = false;
+            }
+            if (loaded) {
+                frame.timestamp = m_loopTimestamps(frame.timestamp);
+            }
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (!loaded) {
+                m_finished = true;
+                lock.unlock();
+                m_frameReady.notify_all();
+                return;
+            }
+            m_spaceReady.wait(lock, [&] {
+                return m_stop || m_queue.size() < m_opts.prefetchFrames;
+            });
+            if (m_stop) {
+                return;
+            }
+            m_queue.push_back(std::move(frame));
+            lock.unlock();
+            m_frameReady.notify_one();
+        }
+    }
+
+    bool ReplayImageSource::grab() {
+        if (!m_ok) {
+            return false;
+        }
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_frameReady.wait(lock,
+                              [&] { return !m_queue.empty() || m_finished; });
+            if (m_queue.empty()) {
+                m_ok = false;
+                return false;
+            }
+            m_current = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+        m_spaceReady.notify_one();
+        m_pacer.waitFor(m_current.timestamp);
+        m_current.timestamp = m_pacer.reported(m_current.timestamp);
+        return true;
+    }
+
+    void
+    ReplayImageSource::retrieveColor(cv::Mat &color,
+                                     videotracker::util::Timestamp &timestamp) {
+        if (m_current.image.channels() == 1) {
+            cv::cvtColor(m_current.image, color, cv::COLOR_GRAY2BGR);
+        } else {
+            /// Each prefetched frame has its own buffer, so this can share
+            /// it rather than copy.
+            color = m_current.image;
+        }
+        timestamp = m_current.timestamp;
+    }
+
+    void ReplayImageSource::retrieve(cv::Mat &color, cv::Mat &gray,
+                                     videotracker::util::Timestamp &timestamp) {
+        if (m_current.image.channels() == 1) {
+            /// Recorded as gray already: no need to round-trip through color.
+            gray = m_current.image;
+            cv::cvtColor(gray, color, cv::COLOR_GRAY2BGR);
+            timestamp = m_current.timestamp;
+            return;
+        }
+        ImageSource::retrieve(color, gray, timestamp);
+    }
+
+    void
+    ReplayImageSource::retrieveGray(cv::Mat &gray,
+                                    videotracker::util::Timestamp &timestamp) {
+        if (m_current.image.channels() == 1) {
+            /// No conversion at all, in either direction.
+            gray = m_current.image;
+            timestamp = m_current.timestamp;
+            return;
+        }
+        /// retrieveColor() shares the prefetched buffer, so this doesn't
+        /// copy the color image either.
+        ImageSource::retrieveGray(gray, timestamp);
+    }
+} // namespace uvbi
+} // namespace videotracker
@@ -0,0 +1,208 @@
+/** @file
+    @brief Header with timestamp and pacing helpers shared by the image
+    sources that replay recordings.
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+// Internal Includes
+#include "unifiedvideoinertial/ImageSources/ImageSourceFactories.h"
+#include "unifiedvideoinertial/Timestamp.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace videotracker {
+namespace uvbi {
+    /// Parses a decimal seconds string as written by
+    /// util::time::toDecimalString() into an offline timestamp, keeping up
+    /// to nanosecond precision.
+    inline util::Timestamp parseDecimalTimestamp(std::string const &str) {
+        std::istringstream is(str);
+        long long seconds = 0;
+        if (!(is >> seconds)) {
+            throw std::runtime_error("Could not parse timestamp " + str);
+        }
+        long long nanoseconds = 0;
+        if (is.peek() == '.') {
+            is.get();
+            std::string frac;
+            is >> frac;
+            frac.resize(9, '0');
+            nanoseconds = std::stoll(frac);
+            if (str[0] == '-') {
+                nanoseconds = -nanoseconds;
+            }
+        }
+        return util::Timestamp{util::ClockDomain::Offline,
+                               std::chrono::seconds(seconds) +
+                                   std::chrono::nanoseconds(nanoseconds)};
+    }
+
+    /// Reads a timestamp file: one decimal timestamp per line, for each frame
+    /// in order, with blank lines and lines starting with # ignored. Returns
+    /// an empty vector if the file doesn't exist.
+    inline std::vector<util::Timestamp>
+    readTimestampFile(std::string const &fn) {
+        std::vector<util::Timestamp> ret;
+        std::ifstream is(fn);
+        std::string line;
+        while (std::getline(is, line)) {
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            ret.push_back(parseDecimalTimestamp(line));
+        }
+        return ret;
+    }
+
+    /// The timestamp of a frame: the recorded one if there is one, otherwise
+    /// made up at the given frame rate, continuing from the last recorded
+    /// timestamp (or from zero, if none were recorded, with frame 0 one frame
+    /// interval after zero). Either way, it's an offline timestamp.
+    inline util::Timestamp
+    getFrameTimestamp(std::vector<util::Timestamp> const &recorded,
+                      std::size_t index, double frameRate) {
+        if (index < recorded.size()) {
+            return recorded[index];
+        }
+        auto base = recorded.empty()
+                        ? util::Timestamp{util::ClockDomain::Offline,
+                                          std::chrono::nanoseconds(0)}
+                        : recorded.back();
+        auto extraFrames = static_cast<long long>(index + 1 - recorded.size());
+        /// Whole microseconds per frame, so made-up times don't accumulate
+        /// rounding error.
+        auto frameMicroseconds = std::llround(1.e6 / frameRate);
+        return base + std::chrono::microseconds(extraFrames * frameMicroseconds);
+    }
+
+    /// Adjusts the timestamps of a looping replay so they keep increasing:
+    /// each pass after the first starts one frame interval after the last
+    /// frame of the previous one.
+    class LoopingTimestamps {
+      public:
+        explicit LoopingTimestamps(double defaultFrameRate)
+            : m_lastInterval(1. / defaultFrameRate) {}
+
+        /// Call when the recording restarts from its first frame.
+        void startNextPass() {
+            m_offset = m_last +
+                       std::chrono::duration<double>(m_lastInterval) - m_first;
+        }
+
+        /// Takes a timestamp as recorded, returns it as it should be reported.
+        util::Timestamp operator()(util::Timestamp ts) {
+            if (!m_haveFirst) {
+                m_haveFirst = true;
+                m_first = ts;
+                m_last = ts;
+            }
+            ts += m_offset;
+            auto interval = util::time::duration(ts, m_last);
+            if (interval > 0) {
+                m_lastInterval = interval;
+            }
+            m_last = ts;
+            return ts;
+        }
+
+      private:
+        bool m_haveFirst = false;
+        util::Timestamp m_first = {};
+        util::Timestamp m_last = {};
+        util::Timestamp::duration m_offset{0};
+        double m_lastInterval;
+    };
+
+    /// Waits before delivering each frame of a replay, according to the
+    /// pacing option: the first frame is delivered immediately and sets the
+    /// time origin.
+    class ReplayPacer {
+      public:
+        explicit ReplayPacer(ReplayOptions const &opts)
+            : m_pacing(opts.pacing),
+              m_speed(opts.pacing == ReplayPacing::Scaled && opts.speed > 0
+                          ? opts.speed
+                          : 1.),
+              m_steadyTimestamps(opts.steadyTimestamps) {}
+
+        void waitFor(util::Timestamp const &frameTime) {
+            if (!m_started) {
+                m_started = true;
+                m_wallStart = clock::now();
+                /// The same instant, so no frame is stamped before it's due.
+                m_steadyStart = util::Timestamp{
+                    util::ClockDomain::Steady,
+                    std::chrono::duration_cast<util::Timestamp::duration>(
+                        m_wallStart.time_since_epoch())};
+                m_recordingStart = frameTime;
+                return;
+            }
+            if (m_pacing == ReplayPacing::MaxSpeed) {
+                return;
+            }
+            auto recordingElapsed =
+                util::time::duration(frameTime, m_recordingStart);
+            auto due = m_wallStart +
+                       std::chrono::duration_cast<clock::duration>(
+                           std::chrono::duration<double>(recordingElapsed /
+                                                         m_speed));
+            std::this_thread::sleep_until(due);
+        }
+
+        /// The timestamp to report for a frame once waitFor() has been
+        /// called for it. On the steady clock, that's when the pacing
+        /// delivers it: its recorded offset from the first frame, scaled by
+        /// the speed, or simply now when not pacing at all.
+        util::Timestamp reported(util::Timestamp const &frameTime) const {
+            if (!m_steadyTimestamps) {
+                return frameTime;
+            }
+            if (m_pacing == ReplayPacing::MaxSpeed) {
+                return util::Timestamp::now(util::ClockDomain::Steady);
+            }
+            auto recordingElapsed =
+                util::time::duration(frameTime, m_recordingStart);
+            return m_steadyStart +
+                   std::chrono::duration<double>(recordingElapsed / m_speed);
+        }
+
+      private:
+        using clock = std::chrono::steady_clock;
+        ReplayPacing m_pacing;
+        double m_speed;
+        bool m_steadyTimestamps;
+        bool m_started = false;
+        clock::time_point m_wallStart;
+        util::Timestamp m_steadyStart = {};
+        util::Timestamp m_recordingStart = {};
+    };
+} // namespace uvbi
+} // namespace videotracker
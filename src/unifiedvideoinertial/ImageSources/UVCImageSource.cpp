@@ -70,7 +70,7 @@ namespace uvbi {
         /// overriding just this method will let the default implementation of
         /// retrieve() do the RGB to Gray for you.
         void retrieveColor(cv::Mat &color,
-                           videotracker::util::TimeValue &timestamp) override;
+                           videotracker::util::Timestamp &timestamp) override;
 
       protected:
         /// This callback function is called each time a new frame is received
@@ -102,7 +102,7 @@ namespace uvbi {
             cameraHandle_;
 
         uvc_stream_ctrl_t streamControl_;
-        videotracker::util::TimeValue m_timestamp = {};
+        videotracker::util::Timestamp m_timestamp = {};
         cv::Size resolution_;          //< resolution of camera
         std::queue<Frame_ptr> frames_; //< raw UVC frames
 
@@ -196,7 +196,7 @@ namespace uvbi {
 
         // Good to go!
         if (!frames_.empty()) {
-            m_timestamp = util::time::getNow();
+            m_timestamp = util::time::getSteadyNow();
         }
         return !frames_.empty();
     }
@@ -204,7 +204,7 @@ namespace uvbi {
     cv::Size UVCImageSource::resolution() const { return resolution_; }
 
     void videotracker::uvbi::UVCImageSource::retrieveColor(
-        cv::Mat &color, util::TimeValue &timestamp) {
+        cv::Mat &color, util::Timestamp &timestamp) {
         // Grab a frame from the queue, but don't keep the queue locked!
         Frame_ptr current_frame;
         {
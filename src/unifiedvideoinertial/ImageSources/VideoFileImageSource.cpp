@@ -0,0 +1,282 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "ReplayTiming.h"
+#include "unifiedvideoinertial/ImageSources/VideoFileImageSource.h"
+#include "unifiedvideoinertial/Timestamp.h"
+
+// Library/third-party includes
+#include <opencv2/highgui/highgui.hpp> // for video capture
+
+// Standard includes
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace videotracker {
+namespace uvbi {
+    using CVCapturePtr = std::unique_ptr<cv::VideoCapture>;
+
+    class DecodeAheadVideoSource : public VideoFileImageSource {
+      public:
+        DecodeAheadVideoSource(CVCapturePtr &&capture,
+                               std::vector<util::Timestamp> &&timestamps,
+                               double frameRate, ReplayOptions const &opts);
+        ~DecodeAheadVideoSource() override;
+
+        bool ok() const override { return m_ok; }
+        bool grab() override;
+        void retrieveColor(cv::Mat &color,
+                           videotracker::util::Timestamp &timestamp) override;
+        cv::Size resolution() const override { return m_res; }
+        VideoDecodeStats getDecodeStats() const override;
+
+      private:
+        using clock = std::chrono::steady_clock;
+        struct PoolFrame {
+            cv::Mat image;
+            util::Timestamp timestamp;
+        };
+        static const std::size_t NoFrame = ~std::size_t(0);
+
+        /// Decodes the next frame into a pool frame, rewinding if looping.
+        /// Called only on the decode thread (and by the constructor before it
+        /// starts).
+        bool decode(PoolFrame &frame);
+        void decodeThread();
+
+        CVCapturePtr m_capture;
+        std::vector<util::Timestamp> m_recordedTimestamps;
+        double m_frameRate;
+        ReplayOptions m_opts;
+        std::size_t m_frameIndex = 0;
+        LoopingTimestamps m_loopTimestamps;
+        ReplayPacer m_pacer;
+        bool m_ok = false;
+        cv::Size m_res;
+
+        std::vector<PoolFrame> m_pool;
+        /// @name Shared with the decode thread
+        /// @{
+        mutable std::mutex m_mutex;
+        std::condition_variable m_frameReady;
+        std::condition_variable m_slotFree;
+        std::deque<std::size_t> m_free;
+        std::deque<std::size_t> m_ready;
+        bool m_finished = false;
+        bool m_stop = false;
+        VideoDecodeStats m_stats;
+        /// @}
+
+        /// Pool frame most recently returned by grab(): owned by the
+        /// consumer until the next grab().
+        std::size_t m_current = NoFrame;
+        std::thread m_thread;
+    };
+
+    const std::size_t DecodeAheadVideoSource::NoFrame;
+
+    VideoFileImageSourcePtr openVideoFile(std::string const &fn,
+                                          ReplayOptions const &opts) {
+        auto ret = VideoFileImageSourcePtr{};
+        auto capture = CVCapturePtr{new cv::VideoCapture(fn)};
+        if (!capture->isOpened()) {
+            std::cerr << "Could not open video file " << fn << std::endl;
+            return ret;
+        }
+        std::vector<util::Timestamp> timestamps;
+        try {
+            timestamps = readTimestampFile(fn + ".timestamps.txt");
+        } catch (std::exception &e) {
+            std::cerr << "Could not read timestamps for " << fn << ": "
+                      << e.what() << std::endl;
+            return ret;
+        }
+        auto frameRate = capture->get(cv::CAP_PROP_FPS);
+        if (!(frameRate > 0)) {
+            frameRate = opts.defaultFrameRate;
+        }
+        ret.reset(new DecodeAheadVideoSource{
+            std::move(capture), std::move(timestamps), frameRate, opts});
+        if (!ret->ok()) {
+            // if we couldn't load, reset the pointer right now.
+            ret.reset();
+        }
+        return ret;
+    }
+
+    DecodeAheadVideoSource::DecodeAheadVideoSource(
+        CVCapturePtr &&capture, std::vector<util::Timestamp> &&timestamps,
+        double frameRate, ReplayOptions const &opts)
+        : m_capture(std::move(capture)),
+          m_recordedTimestamps(std::move(timestamps)), m_frameRate(frameRate),
+          m_opts(opts), m_loopTimestamps(frameRate), m_pacer(opts),
+          m_pool((std::max)(opts.prefetchFrames, std::size_t(2))) {
+        /// Decode the first frame here, to size the rest of the pool and to
+        /// know there's anything to play at all.
+        if (!decode(m_pool[0])) {
+            return;
+        }
+        m_res = m_pool[0].image.size();
+        for (std::size_t i = 1; i < m_pool.size(); ++i) {
+            m_pool[i].image.create(m_res, m_pool[0].image.type());
+            m_free.push_back(i);
+        }
+        m_ready.push_back(0);
+        m_stats.poolFrames = m_pool.size();
+        m_stats.framesDecoded = 1;
+        m_stats.maxFramesQueued = 1;
+        m_ok = true;
+        m_thread = std::thread([&] { decodeThread(); });
+    }
+
+    DecodeAheadVideoSource::~DecodeAheadVideoSource() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_slotFree.notify_all();
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+    }
+
+    bool DecodeAheadVideoSource::decode(PoolFrame &frame) {
+        auto start = clock::now();
+        /// read() decodes into the existing buffer when the size and type
+        /// match, which they do after the first frame.
+        bool ok = m_capture->read(frame.image);
+        if (!ok && m_opts.loop && m_frameIndex > 0) {
+            m_capture->set(cv::CAP_PROP_POS_FRAMES, 0);
+            m_frameIndex = 0;
+            m_loopTimestamps.startNextPass();
+            ok = m_capture->read(frame.image);
+        }
+        auto elapsed = clock::now() - start;
+        if (ok) {
+            frame.timestamp = m_loopTimestamps(getFrameTimestamp(
+                m_recordedTimestamps, m_frameIndex, m_frameRate));
+            ++m_frameIndex;
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.decodeTime +=
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed);
+        return ok;
+    }
+
+    void DecodeAheadVideoSource::decodeThread() {
+        while (true) {
+            std::size_t slot;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                if (m_free.empty() && !m_stop) {
+                    m_stats.decoderWaits++;
+                    m_slotFree.wait(lock,
+                                    [&] { return m_stop || !m_free.empty(); });
+                }
+                if (m_stop) {
+                    return;
+                }
+                slot = m_free.front();
+                m_free.pop_front();
+            }
+            /// The slot is ours alone until it's in the ready queue.
+            bool ok = decode(m_pool[slot]);
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!ok) {
+                    m_free.push_back(slot);
+                    m_finished = true;
+                } else {
+                    m_ready.push_back(slot);
+                    m_stats.framesDecoded++;
+                    m_stats.maxFramesQueued =
+                        (std::max)(m_stats.maxFramesQueued, m_ready.size());
+                }
+            }
+            m_frameReady.notify_one();
+            if (!ok) {
+                return;
+            }
+        }
+    }
+
+    bool DecodeAheadVideoSource::grab() {
+        if (!m_ok) {
+            return false;
+        }
+        std::size_t slot;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            /// The consumer is done with the previous frame now.
+            if (m_current != NoFrame) {
+                m_free.push_back(m_current);
+                m_current = NoFrame;
+                m_slotFree.notify_one();
+            }
+            if (m_ready.empty() && !m_finished) {
+                auto start = clock::now();
+                m_frameReady.wait(
+                    lock, [&] { return !m_ready.empty() || m_finished; });
+                m_stats.consumerWaits++;
+                m_stats.consumerWaitTime +=
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        clock::now() - start);
+            }
+            if (m_ready.empty()) {
+                m_ok = false;
+                return false;
+            }
+            slot = m_ready.front();
+            m_ready.pop_front();
+            m_stats.framesDelivered++;
+            m_current = slot;
+        }
+        /// The frame is the consumer's alone now.
+        auto &timestamp = m_pool[slot].timestamp;
+        m_pacer.waitFor(timestamp);
+        timestamp = m_pacer.reported(timestamp);
+        return true;
+    }
+
+    void DecodeAheadVideoSource::retrieveColor(
+        cv::Mat &color, videotracker::util::Timestamp &timestamp) {
+        if (m_current == NoFrame) {
+            /// Nothing grabbed, or past the end of the video.
+            color.release();
+            return;
+        }
+        /// Copy out, since the pool frame gets reused: the destination buffer
+        /// is reused too if the caller keeps passing the same one.
+        m_pool[m_current].image.copyTo(color);
+        timestamp = m_pool[m_current].timestamp;
+    }
+
+    VideoDecodeStats DecodeAheadVideoSource::getDecodeStats() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+} // namespace uvbi
+} // namespace videotracker
@@ -27,8 +27,24 @@ Sensics, Inc.
 namespace videotracker {
 namespace uvbi {
 
-    Led::Led(LedIdentifier *identifier, LedMeasurement const &meas)
-        : m_identifier(identifier) {
+    Led::Led(LedIdentifier *identifier, LedMeasurement const &meas) {
+        restart(identifier, meas);
+    }
+
+    void Led::restart(LedIdentifier *identifier, LedMeasurement const &meas) {
+        m_brightnessHistory.clear();
+        if (identifier) {
+            /// Room for the longest the identifier lets the history get.
+            m_brightnessHistory.reserve(identifier->getHistoryLength() + 1);
+        }
+        m_id = ZeroBasedBeaconId(SENTINEL_NO_IDENTIFIER_OBJECT);
+        m_identifier = identifier;
+        m_lastBright = false;
+        m_newlyRecognized = false;
+        m_novelty = 0;
+        m_provisional = false;
+        m_framesSeen = 0;
+        m_wasUsedLastFrame = false;
         /// Doesn't matter what the blobs keep ID pref is here, because this is
         /// a new blob so there's no ID to keep.
         addMeasurement(meas, false);
@@ -37,6 +53,7 @@ namespace uvbi {
     void Led::addMeasurement(LedMeasurement const &meas, bool blobsKeepId) {
         m_latestMeasurement = meas;
         m_brightnessHistory.push_back(meas.brightness);
+        ++m_framesSeen;
 
         // If we don't have an identifier, then our ID is unknown.
         // Otherwise, try and find it.
@@ -44,9 +61,24 @@ namespace uvbi {
             m_id = ZeroBasedBeaconId(SENTINEL_NO_IDENTIFIER_OBJECT);
         } else {
             auto const oldId = m_id;
-            m_id = m_identifier->getId(m_id, m_brightnessHistory, m_lastBright,
-                                       blobsKeepId);
             using Id = ZeroBasedBeaconId;
+            if (m_provisional) {
+                /// Decode as if we had no ID, so keeping IDs can't confirm a
+                /// provisional one unseen.
+                const auto noData =
+                    Id(SENTINEL_NO_IDENTIFIER_OBJECT_OR_INSUFFICIENT_DATA);
+                auto decoded = m_identifier->getId(
+                    noData, m_brightnessHistory, m_lastBright, blobsKeepId);
+                if (decoded != noData) {
+                    /// The blink code has been seen in full: it has the
+                    /// final say from here on.
+                    m_provisional = false;
+                    m_id = decoded;
+                }
+            } else {
+                m_id = m_identifier->getId(m_id, m_brightnessHistory,
+                                           m_lastBright, blobsKeepId);
+            }
             if (Id(SENTINEL_MARKED_MISIDENTIFIED) == oldId &&
                 (Id(SENTINEL_NO_IDENTIFIER_OBJECT_OR_INSUFFICIENT_DATA) ==
                      m_id ||
@@ -75,11 +107,20 @@ namespace uvbi {
 
     void Led::markMisidentified() {
         m_id = ZeroBasedBeaconId(SENTINEL_MARKED_MISIDENTIFIED);
+        m_provisional = false;
         if (!m_brightnessHistory.empty()) {
             m_brightnessHistory.clear();
             m_brightnessHistory.push_back(getMeasurement().brightness);
         }
     }
 
+    void Led::setProvisionalId(ZeroBasedBeaconId id) {
+        if (id != m_id) {
+            m_novelty = MAX_NOVELTY;
+        }
+        m_id = id;
+        m_provisional = true;
+    }
+
 } // namespace uvbi
 } // namespace videotracker
@@ -32,6 +32,7 @@
 #include <opencv2/core/core.hpp>
 
 // Standard includes
+#include <cstddef>
 #include <vector>
 
 namespace videotracker {
@@ -61,6 +62,11 @@ namespace uvbi {
         Led(LedIdentifier *identifier, LedMeasurement const &meas);
         /// @}
 
+        /// @brief Starts over as a new blob, just as if constructed with
+        /// these arguments, but keeping the storage of the brightness
+        /// history.
+        void restart(LedIdentifier *identifier, LedMeasurement const &meas);
+
         static const uint8_t MAX_NOVELTY = 4;
         /// @brief Add a new measurement for this LED, which must be for a frame
         /// that is just following the previous measurement, so that the
@@ -153,6 +159,25 @@ namespace uvbi {
         /// knowledge that can refute the identification of this blob.
         void markMisidentified();
 
+        /// Gives this blob an ID from somewhere other than its blink code,
+        /// such as the predicted pose of its target. It stays provisional
+        /// until the blink code has been seen in full, which then either
+        /// confirms or replaces it.
+        void setProvisionalId(ZeroBasedBeaconId id);
+
+        /// Is the current ID a provisional one, not yet confirmed by the
+        /// blink code?
+        bool provisional() const { return m_provisional; }
+
+        /// Number of frames this blob has been seen in, including the first.
+        std::size_t framesSeen() const { return m_framesSeen; }
+
+        /// Points a copy of an LED, made for another target, at that
+        /// target's identifier (which must use the same patterns).
+        void setIdentifier(LedIdentifier *identifier) {
+            m_identifier = identifier;
+        }
+
       private:
         /// Most recent measurement
         LedMeasurement m_latestMeasurement;
@@ -172,7 +197,10 @@ namespace uvbi {
         bool m_lastBright = false;
 
         bool m_newlyRecognized = false;
-        uint8_t m_novelty;
+        uint8_t m_novelty = 0;
+
+        bool m_provisional = false;
+        std::size_t m_framesSeen = 0;
 
         bool m_wasUsedLastFrame = false;
     };
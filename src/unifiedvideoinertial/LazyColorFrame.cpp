@@ -0,0 +1,62 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "unifiedvideoinertial/LazyColorFrame.h"
+
+// Library/third-party includes
+#include <opencv2/imgproc/imgproc.hpp>
+
+// Standard includes
+#include <atomic>
+
+namespace videotracker {
+namespace uvbi {
+    static std::atomic<std::uint64_t> g_colorConversions{0};
+
+    LazyColorFrame LazyColorFrame::fromColor(cv::Mat const &color) {
+        LazyColorFrame ret;
+        ret.m_color = color;
+        return ret;
+    }
+
+    LazyColorFrame LazyColorFrame::clone() const {
+        LazyColorFrame ret;
+        if (materialized()) {
+            ret.m_color = m_color.clone();
+        } else {
+            ret.m_gray = m_gray.clone();
+        }
+        return ret;
+    }
+
+    cv::Mat const &LazyColorFrame::get() const {
+        if (m_color.empty() && !m_gray.empty()) {
+            cv::cvtColor(m_gray, m_color, cv::COLOR_GRAY2BGR);
+            g_colorConversions.fetch_add(1, std::memory_order_relaxed);
+        }
+        return m_color;
+    }
+
+    std::uint64_t LazyColorFrame::getConversionCount() {
+        return g_colorConversions.load(std::memory_order_relaxed);
+    }
+} // namespace uvbi
+} // namespace videotracker
@@ -32,7 +32,7 @@
 // - none
 
 // Standard includes
-// - none
+#include <cstddef>
 
 namespace videotracker {
 namespace uvbi {
@@ -69,6 +69,10 @@ namespace uvbi {
                                         bool &lastBright,
                                         bool blobsKeepId) const = 0;
 
+        /// @brief The number of brightnesses getId() truncates the list to.
+        /// The list grows one longer than this between truncations.
+        virtual std::size_t getHistoryLength() const = 0;
+
       protected:
     };
 
@@ -25,6 +25,7 @@
 #pragma once
 
 // Internal Includes
+#include "ClockOffsetEstimator.h"
 #include "unifiedvideoinertial/ConfigParams.h"
 #include "unifiedvideoinertial/ModelTypes.h"
 #include "unifiedvideoinertial/TrackedBodyTarget.h"
@@ -32,7 +33,7 @@
 #include "videotrackershared/CameraParameters.h"
 
 // Library/third-party includes
-#include "unifiedvideoinertial/TimeValue.h"
+#include "unifiedvideoinertial/Timestamp.h"
 #include <Eigen/Core>
 #include <Eigen/Geometry>
 
@@ -49,11 +50,17 @@ namespace uvbi {
         std::vector<bool> const &beaconFixed;
         Vec3Vector const &beaconEmissionDirection;
         /// Time that the state is coming in at.
-        videotracker::util::TimeValue const &startingTime;
+        videotracker::util::Timestamp const &startingTime;
         BodyState &state;
         BodyProcessModel &processModel;
         std::vector<BeaconData> &beaconDebug;
         Eigen::Vector3d targetToBody;
+        /// If not null, the estimator to hand the residuals of beacons to, for
+        /// the offset of the video timestamps from the IMU's.
+        ClockOffsetEstimator *clockOffset;
+        /// Whether state holds the body's state as of startingTime, rather
+        /// than a placeholder, so estimators may use it as a prior.
+        bool stateValid;
     };
 } // namespace uvbi
 } // namespace videotracker
@@ -31,6 +31,7 @@
 #include "videotrackershared/cvToEigen.h"
 
 // Library/third-party includes
+#include "FlexKalman/FlexibleKalmanFilter.h"
 #include <opencv2/calib3d/calib3d.hpp>
 #include <opencv2/core/affine.hpp>
 #include <opencv2/core/core.hpp>
@@ -46,14 +47,36 @@
 
 static const float MAX_REPROJECTION_ERROR = 4.f;
 
+/// Beacons that the last pose puts within this many times the inlier
+/// threshold of where they're seen are sampled first by the guided RANSAC.
+static const double LAST_POSE_AGREEMENT_SCALE = 5.;
+
 namespace videotracker {
 namespace uvbi {
+    static GuidedRansacPnPOptions
+    makeGuidedRansacOptions(ConfigParams const &params) {
+        GuidedRansacPnPOptions ret;
+        ret.maxSamples =
+            static_cast<std::size_t>((std::max)(params.ransacMaxSamples, 1));
+        ret.confidence = params.ransacConfidence;
+        ret.parallel = params.ransacParallelScoring;
+        return ret;
+    }
+
+    RANSACPoseEstimator::RANSACPoseEstimator()
+        : m_guidedPnP(m_guidedOptions) {}
+
+    RANSACPoseEstimator::RANSACPoseEstimator(ConfigParams const &params)
+        : m_guided(params.guidedRansac),
+          m_guidedOptions(makeGuidedRansacOptions(params)),
+          m_guidedPnP(m_guidedOptions) {}
+
     bool RANSACPoseEstimator::
     operator()(CameraParameters const &camParams, LedPtrList const &leds,
                BeaconStateVec const &beacons,
                std::vector<BeaconData> &beaconDebug, Eigen::Vector3d &outXlate,
                Eigen::Quaterniond &outQuat, int skipBrightsCutoff,
-               std::size_t iterations) {
+               std::size_t iterations, PnPPose const *prior) {
 
         bool skipBrights = false;
 
@@ -77,6 +100,7 @@ namespace uvbi {
         std::vector<cv::Point3f> objectPoints;
         std::vector<cv::Point2f> imagePoints;
         std::vector<ZeroBasedBeaconId> beaconIds;
+        LedPtrList usedLeds;
         for (auto const &led : leds) {
             if (skipBrights && led->isBright()) {
                 continue;
@@ -86,6 +110,7 @@ namespace uvbi {
             beaconDebug[index].variance = -1;
             beaconDebug[index].measurement = led->getLocationForTracking();
             beaconIds.push_back(id);
+            usedLeds.push_back(led);
 
             /// Effectively invert the image points here so we get the output of
             /// a coordinate system we want.
@@ -104,114 +129,65 @@ namespace uvbi {
         // m_permittedOutliers outliers. Even in simulation data, we sometimes
         // find duplicate IDs for LEDs, indicating that we are getting
         // mis-identified ones sometimes.
-        // We tried using the previous guess to reduce the amount of computation
-        // being done, but this got us stuck in infinite locations.  We seem to
-        // do okay without using it, so leaving it out.
-        // @todo Make number of iterations into a parameter.
-        bool usePreviousGuess = false;
-        cv::Mat inlierIndices;
-
         cv::Mat rvec;
         cv::Mat tvec;
-#if CV_MAJOR_VERSION == 2
-        cv::solvePnPRansac(
-            objectPoints, imagePoints, camParams.cameraMatrix,
-            camParams.distortionParameters, rvec, tvec, usePreviousGuess,
-            iterations, MAX_REPROJECTION_ERROR,
-            static_cast<int>(objectPoints.size() - m_permittedOutliers),
-            inlierIndices);
-#elif CV_MAJOR_VERSION >= 3
-        // parameter added to the OpenCV 3.0 interface in place of the number of
-        // inliers
-        /// @todo how to determine this requested confidence from the data we're
-        /// given?
-        double confidence = 0.99;
-        auto ransacResult = cv::solvePnPRansac(
-            objectPoints, imagePoints, camParams.cameraMatrix,
-            camParams.distortionParameters, rvec, tvec, usePreviousGuess,
-            iterations, MAX_REPROJECTION_ERROR, confidence, inlierIndices);
-        if (!ransacResult) {
+        std::vector<int> inlierIndices;
+        auto gotPose =
+            m_guided ? estimateGuided(camParams, objectPoints, imagePoints,
+                                      usedLeds, iterations, prior, rvec, tvec,
+                                      inlierIndices)
+                     : estimateOpenCV(camParams, objectPoints, imagePoints,
+                                      iterations, rvec, tvec, inlierIndices);
+        if (!gotPose) {
             return false;
         }
-#else
-#error "Unrecognized OpenCV version!"
-#endif
 
         //==========================================================================
         // Make sure we got all the inliers we needed.  Otherwise, reject this
         // pose.
-        if (inlierIndices.rows < static_cast<int>(m_requiredInliers)) {
+        if (inlierIndices.size() < m_requiredInliers) {
             return false;
         }
 
-        if (inlierIndices.rows > 0) {
-
 #ifdef UVBI_TEST_RANSAC_REPROJECTION
-            //==========================================================================
-            // Reproject the inliers into the image and make sure they are
-            // actually
-            // close to the expected location; otherwise, we have a bad pose.
-            const double pixelReprojectionErrorForSingleAxisMax = 4;
-            std::vector<cv::Point3f> inlierObjectPoints;
-            std::vector<cv::Point2f> inlierImagePoints;
-            for (int i = 0; i < inlierIndices.rows; i++) {
-                inlierObjectPoints.push_back(objectPoints[i]);
-                inlierImagePoints.push_back(imagePoints[i]);
+        //==========================================================================
+        // Reproject the inliers into the image and make sure they are
+        // actually
+        // close to the expected location; otherwise, we have a bad pose.
+        const double pixelReprojectionErrorForSingleAxisMax = 4;
+        std::vector<cv::Point3f> inlierObjectPoints;
+        std::vector<cv::Point2f> inlierImagePoints;
+        for (auto i : inlierIndices) {
+            inlierObjectPoints.push_back(objectPoints[i]);
+            inlierImagePoints.push_back(imagePoints[i]);
+        }
+        std::vector<cv::Point2f> reprojectedPoints;
+        cv::projectPoints(inlierObjectPoints, rvec, tvec,
+                          camParams.cameraMatrix,
+                          camParams.distortionParameters, reprojectedPoints);
+
+        for (size_t i = 0; i < reprojectedPoints.size(); i++) {
+            if (reprojectedPoints[i].x - inlierImagePoints[i].x >
+                pixelReprojectionErrorForSingleAxisMax) {
+                std::cout << "Reject on reprojected beacon id "
+                          << makeOneBased(beaconIds[inlierIndices[i]]).value()
+                          << " x axis." << std::endl;
+                return false;
             }
-            std::vector<cv::Point2f> reprojectedPoints;
-            cv::projectPoints(
-                inlierObjectPoints, rvec, tvec, camParams.cameraMatrix,
-                camParams.distortionParameters, reprojectedPoints);
-
-            for (size_t i = 0; i < reprojectedPoints.size(); i++) {
-                if (reprojectedPoints[i].x - inlierImagePoints[i].x >
-                    pixelReprojectionErrorForSingleAxisMax) {
-                    std::cout << "Reject on reprojected beacon id "
-                              << makeOneBased(inlierBeaconIds[i]).value()
-                              << " x axis." << std::endl;
-                    return false;
-                }
-                if (reprojectedPoints[i].y - inlierImagePoints[i].y >
-                    pixelReprojectionErrorForSingleAxisMax) {
-                    std::cout << "Reject on reprojected beacon id "
-                              << makeOneBased(inlierBeaconIds[i]).value()
-                              << " y axis." << std::endl;
-                    return false;
-                }
+            if (reprojectedPoints[i].y - inlierImagePoints[i].y >
+                pixelReprojectionErrorForSingleAxisMax) {
+                std::cout << "Reject on reprojected beacon id "
+                          << makeOneBased(beaconIds[inlierIndices[i]]).value()
+                          << " y axis." << std::endl;
+                return false;
             }
+        }
 #endif
 
-            /// Make a vector of the inlier beacon IDs.
-            std::vector<ZeroBasedBeaconId> inlierBeaconIds;
-            inlierBeaconIds.reserve(inlierIndices.rows);
-
-            for (int i = 0; i < inlierIndices.rows; i++) {
-                inlierBeaconIds.push_back(beaconIds[i]);
-            }
-
-            /// Now, we will sort that vector of inlier beacon IDs so we can
-            /// rapidly binary search it to flag the LEDs we used.
-
-            // Need a custom comparator for the ID type.
-            auto idComparator = [](ZeroBasedBeaconId const &lhs,
-                                   ZeroBasedBeaconId const &rhs) {
-                return lhs.value() < rhs.value();
-            };
-            std::sort(begin(inlierBeaconIds), end(inlierBeaconIds),
-                      idComparator);
-            // This lambda wraps binary_search to do what it says: check to see
-            // if a given beacon ID is in the list of inlier beacons.
-            auto isAnInlierBeacon = [&inlierBeaconIds, &idComparator](
-                                        ZeroBasedBeaconId const &needle) {
-                return std::binary_search(begin(inlierBeaconIds),
-                                          end(inlierBeaconIds), needle,
-                                          idComparator);
-            };
-            for (auto &led : leds) {
-                if (isAnInlierBeacon(led->getID())) {
-                    led->markAsUsed();
-                }
-            }
+        /// Flag the LEDs we used: the inlier indices refer to usedLeds
+        /// directly.
+        for (auto i : inlierIndices) {
+            usedLeds[i]->markAsUsed();
         }
 
         //==========================================================================
@@ -288,6 +264,114 @@ namespace uvbi {
         return true;
     }
 
+    bool RANSACPoseEstimator::estimateOpenCV(
+        CameraParameters const &camParams,
+        std::vector<cv::Point3f> const &objectPoints,
+        std::vector<cv::Point2f> const &imagePoints, std::size_t iterations,
+        cv::Mat &rvec, cv::Mat &tvec, std::vector<int> &inlierIndices) {
+        // We tried using the previous guess to reduce the amount of computation
+        // being done, but this got us stuck in infinite locations.  We seem to
+        // do okay without using it, so leaving it out.
+        bool usePreviousGuess = false;
+#if CV_MAJOR_VERSION == 2
+        cv::solvePnPRansac(
+            objectPoints, imagePoints, camParams.cameraMatrix,
+            camParams.distortionParameters, rvec, tvec, usePreviousGuess,
+            iterations, MAX_REPROJECTION_ERROR,
+            static_cast<int>(objectPoints.size() - m_permittedOutliers),
+            inlierIndices);
+        return true;
+#elif CV_MAJOR_VERSION >= 3
+        // parameter added to the OpenCV 3.0 interface in place of the number of
+        // inliers
+        /// @todo how to determine this requested confidence from the data we're
+        /// given?
+        double confidence = 0.99;
+        return cv::solvePnPRansac(
+            objectPoints, imagePoints, camParams.cameraMatrix,
+            camParams.distortionParameters, rvec, tvec, usePreviousGuess,
+            iterations, MAX_REPROJECTION_ERROR, confidence, inlierIndices);
+#else
+#error "Unrecognized OpenCV version!"
+#endif
+    }
+
+    bool RANSACPoseEstimator::estimateGuided(
+        CameraParameters const &camParams,
+        std::vector<cv::Point3f> const &objectPoints,
+        std::vector<cv::Point2f> const &imagePoints, LedPtrList const &usedLeds,
+        std::size_t iterations, PnPPose const *prior, cv::Mat &rvec,
+        cv::Mat &tvec, std::vector<int> &inlierIndices) {
+        /// The guided RANSAC works on the normalized image plane.
+        cv::undistortPoints(imagePoints, m_normalizedPoints,
+                            camParams.cameraMatrix,
+                            camParams.distortionParameters);
+        auto maxError = MAX_REPROJECTION_ERROR / camParams.focalLength();
+        if (!prior && m_haveLastPose) {
+            prior = &m_lastPose;
+        }
+
+        /// Sample the beacons most likely to be right first: those that have
+        /// had their identity for a while, then those that aren't bright
+        /// (which the identifier finds harder to tell apart), and above all
+        /// those that are where the prior pose says they should be.
+        auto n = objectPoints.size();
+        m_correspondences.resize(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            auto &corr = m_correspondences[i];
+            auto const &led = *usedLeds[i];
+            corr.objectPoint = cvToVector(objectPoints[i]).cast<double>();
+            corr.imagePoint = Eigen::Vector2d(m_normalizedPoints[i].x,
+                                              m_normalizedPoints[i].y);
+            corr.priority = 1. - 0.5 * led.novelty() / double(Led::MAX_NOVELTY);
+            if (led.isBright()) {
+                corr.priority -= 0.25;
+            }
+            if (prior) {
+                Eigen::Vector3d p =
+                    prior->rotation * corr.objectPoint + prior->translation;
+                if (p.z() > 0 &&
+                    (p.head<2>() / p.z() - corr.imagePoint).norm() <
+                        LAST_POSE_AGREEMENT_SCALE * maxError) {
+                    corr.priority += 1.;
+                }
+            }
+        }
+
+        auto opts = m_guidedOptions;
+        opts.maxError = maxError;
+        opts.maxSamples = (std::max)(opts.maxSamples, iterations);
+        m_guidedPnP.setOptions(opts);
+        GuidedRansacPnPResult result;
+        if (!m_guidedPnP(m_correspondences, m_requiredInliers, prior,
+                         result)) {
+            return false;
+        }
+
+        /// Polish the pose using all the inliers, as solvePnPRansac does.
+        std::vector<cv::Point3f> inlierObjectPoints;
+        std::vector<cv::Point2f> inlierImagePoints;
+        inlierIndices.clear();
+        for (auto i : result.inliers) {
+            inlierIndices.push_back(static_cast<int>(i));
+            inlierObjectPoints.push_back(objectPoints[i]);
+            inlierImagePoints.push_back(imagePoints[i]);
+        }
+        rvec = eiQuatToRotVec(Eigen::Quaterniond(result.pose.rotation));
+        cv::eigen2cv(result.pose.translation, tvec);
+        bool useExtrinsicGuess = true;
+        cv::solvePnP(inlierObjectPoints, inlierImagePoints,
+                     camParams.cameraMatrix, camParams.distortionParameters,
+                     rvec, tvec, useExtrinsicGuess);
+
+        /// Remember the polished pose for next time.
+        m_lastPose.rotation = cvRotVecToQuat(rvec).toRotationMatrix();
+        m_lastPose.translation = cvToVector3d(tvec);
+        m_haveLastPose = m_lastPose.rotation.allFinite() &&
+                         m_lastPose.translation.allFinite();
+        return true;
+    }
+
     /// Variance in Meters^2
     static const double InitialPositionStateError = 0.;
     /// Variance in Radians^2
@@ -301,14 +385,37 @@ namespace uvbi {
         InitialVelocityStateError,    InitialVelocityStateError,
         InitialVelocityStateError,    InitialAngVelStateError,
         InitialAngVelStateError,      InitialAngVelStateError};
-    bool RANSACPoseEstimator::operator()(EstimatorInOutParams const &p,
-                                         LedPtrList const &leds) {
+    bool RANSACPoseEstimator::predictPrior(
+        EstimatorInOutParams const &p,
+        videotracker::util::Timestamp const &frameTime, PnPPose &prior) {
+        if (!p.stateValid) {
+            return false;
+        }
+        auto state = p.state;
+        if (p.startingTime != frameTime) {
+            auto dt = util::time::duration(frameTime, p.startingTime);
+            flexkalman::predict(state, p.processModel, dt);
+        }
+        prior.rotation = state.getQuaternion().toRotationMatrix();
+        prior.translation = state.position();
+        /// A body that hasn't been seen yet sits at the camera.
+        return prior.rotation.allFinite() && prior.translation.allFinite() &&
+               prior.translation.z() > 0;
+    }
+
+    bool RANSACPoseEstimator::
+    operator()(EstimatorInOutParams const &p, LedPtrList const &leds,
+               videotracker::util::Timestamp const &frameTime) {
         Eigen::Vector3d xlate;
         Eigen::Quaterniond quat;
-        /// Call the main pose estimation to get the vector and quat.
+        /// Call the main pose estimation to get the vector and quat, guided
+        /// by where the body is expected to be.
         {
+            PnPPose prior;
+            auto havePrior = predictPrior(p, frameTime, prior);
             auto ret = (*this)(p.camParams, leds, p.beacons, p.beaconDebug,
-                               xlate, quat);
+                               xlate, quat, -1, 5,
+                               havePrior ? &prior : nullptr);
             if (!ret) {
                 return false;
             }
@@ -25,6 +25,7 @@
 #pragma once
 
 // Internal Includes
+#include "GuidedRansacPnP.h"
 #include "PoseEstimatorTypes.h"
 #include "unifiedvideoinertial/ConfigParams.h"
 
@@ -33,11 +34,16 @@
 
 // Standard includes
 #include <cstddef>
+#include <vector>
 
 namespace videotracker {
 namespace uvbi {
     class RANSACPoseEstimator {
       public:
+        /// Uses the guided RANSAC with default options.
+        RANSACPoseEstimator();
+        explicit RANSACPoseEstimator(ConfigParams const &params);
+
         /// Perform RANSAC-based pose estimation.
         ///
         /// @param[out] outXlate translation output parameter
@@ -45,12 +51,18 @@ namespace uvbi {
         /// @param skipBrightsCutoff If positive, the number of non-bright LEDs
         /// seen that will trigger us to skip using bright LEDs in pose
         /// estimation.
+        /// @param iterations For OpenCV's RANSAC, the number of iterations;
+        /// for the guided RANSAC, raises its sample limit if larger.
+        /// @param prior For the guided RANSAC, the expected pose (from model
+        /// space to camera space, as for cv::solvePnP) to try first and to
+        /// prioritize by. If null, the last pose estimated is used instead.
         /// @return true if a pose was estimated.
         bool operator()(CameraParameters const &camParams,
                         LedPtrList const &leds, BeaconStateVec const &beacons,
                         std::vector<BeaconData> &beaconDebug,
                         Eigen::Vector3d &outXlate, Eigen::Quaterniond &outQuat,
-                        int skipBrightsCutoff = -1, std::size_t iterations = 5);
+                        int skipBrightsCutoff = -1, std::size_t iterations = 5,
+                        PnPPose const *prior = nullptr);
 
         /// Perform RANSAC-based pose estimation and use it to update a body
         /// state (state vector and error covariance)
@@ -58,11 +70,49 @@ namespace uvbi {
         /// @param[out] state Tracked body state that will be updated if a pose
         /// was estimated
         /// @return true if a pose was estimated.
-        bool operator()(EstimatorInOutParams const &p, LedPtrList const &leds);
+        bool operator()(EstimatorInOutParams const &p, LedPtrList const &leds,
+                        videotracker::util::Timestamp const &frameTime);
+
+        /// Gets the pose the body state in the params predicts for the frame
+        /// time, in the form the prior takes. Returns false if the params
+        /// don't hold a valid state, or it doesn't put the target in front of
+        /// the camera.
+        static bool predictPrior(EstimatorInOutParams const &p,
+                                 videotracker::util::Timestamp const &frameTime,
+                                 PnPPose &prior);
 
       private:
+        /// Each of these estimates rvec and tvec (from model space to camera
+        /// space, as for cv::solvePnP) and fills in the indices of the inlier
+        /// points, returning false if no pose was found.
+        bool estimateGuided(CameraParameters const &camParams,
+                            std::vector<cv::Point3f> const &objectPoints,
+                            std::vector<cv::Point2f> const &imagePoints,
+                            LedPtrList const &usedLeds, std::size_t iterations,
+                            PnPPose const *prior, cv::Mat &rvec, cv::Mat &tvec,
+                            std::vector<int> &inlierIndices);
+        bool estimateOpenCV(CameraParameters const &camParams,
+                            std::vector<cv::Point3f> const &objectPoints,
+                            std::vector<cv::Point2f> const &imagePoints,
+                            std::size_t iterations, cv::Mat &rvec,
+                            cv::Mat &tvec, std::vector<int> &inlierIndices);
+
         const std::size_t m_requiredInliers = 4;
         const std::size_t m_permittedOutliers = 0;
+        bool m_guided = true;
+        /// As configured: the inlier threshold is set per call from the
+        /// camera parameters.
+        GuidedRansacPnPOptions m_guidedOptions;
+        GuidedRansacPnP m_guidedPnP;
+        /// @name Scratch space for the guided RANSAC
+        /// @{
+        PnPCorrespondenceVec m_correspondences;
+        std::vector<cv::Point2f> m_normalizedPoints;
+        /// @}
+        /// The last pose estimated, as given by rvec and tvec, for the guided
+        /// RANSAC to try first and to prioritize by when not given a prior.
+        bool m_haveLastPose = false;
+        PnPPose m_lastPose;
     };
 } // namespace uvbi
 } // namespace videotracker
@@ -40,16 +40,27 @@ namespace uvbi {
         : m_positionVarianceScale(positionVarianceScale),
           m_orientationVariance(orientationVariance) {}
 
+    RANSACKalmanPoseEstimator::RANSACKalmanPoseEstimator(
+        ConfigParams const &params)
+        : m_ransac(params),
+          m_positionVarianceScale(params.softResetPositionVarianceScale),
+          m_orientationVariance(params.softResetOrientationVariance) {}
+
     bool RANSACKalmanPoseEstimator::
     operator()(EstimatorInOutParams const &p, LedPtrList const &leds,
-               videotracker::util::TimeValue const &frameTime) {
+               videotracker::util::Timestamp const &frameTime) {
 
         Eigen::Vector3d xlate;
         Eigen::Quaterniond quat;
-        /// Call the main pose estimation to get the vector and quat.
+        /// Call the main pose estimation to get the vector and quat, guided
+        /// by where the body is expected to be.
         {
+            PnPPose prior;
+            auto havePrior =
+                RANSACPoseEstimator::predictPrior(p, frameTime, prior);
             auto ret = m_ransac(p.camParams, leds, p.beacons, p.beaconDebug,
-                                xlate, quat);
+                                xlate, quat, -1, 5,
+                                havePrior ? &prior : nullptr);
             if (!ret) {
                 return false;
             }
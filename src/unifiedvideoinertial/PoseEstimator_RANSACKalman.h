@@ -41,12 +41,14 @@ namespace uvbi {
       public:
         RANSACKalmanPoseEstimator(double positionVarianceScale = 1.e-1,
                                   double orientationVariance = 1.e0);
+        /// Takes the soft reset and RANSAC parameters from the config.
+        explicit RANSACKalmanPoseEstimator(ConfigParams const &params);
         /// Perform RANSAC-based pose estimation but filter results in via an
         /// EKF to the body state.
         ///
         /// @return true if a pose was estimated.
         bool operator()(EstimatorInOutParams const &p, LedPtrList const &leds,
-                        videotracker::util::TimeValue const &frameTime);
+                        videotracker::util::Timestamp const &frameTime);
 
       private:
         RANSACPoseEstimator m_ransac;
@@ -122,7 +122,7 @@ namespace uvbi {
 
     bool SCAATKalmanPoseEstimator::
     operator()(EstimatorInOutParams const &p, LedPtrList const &leds,
-               videotracker::util::TimeValue const &frameTime, double videoDt) {
+               videotracker::util::Timestamp const &frameTime, double videoDt) {
         bool gotMeasurement = false;
         double varianceFactor = 1;
 
@@ -328,6 +328,12 @@ namespace uvbi {
             debug.variance = effectiveVariance;
             meas.setVariance(effectiveVariance);
 
+            if (p.clockOffset && squaredResidual <= maxSquaredResidual) {
+                p.clockOffset->addResidual(
+                    residual, meas.getRotationalImageVelocity(state),
+                    effectiveVariance);
+            }
+
             /// Now, do the correction.
             auto model = flexkalman::makeAugmentedProcessModel(p.processModel,
                                                                beaconProcess);
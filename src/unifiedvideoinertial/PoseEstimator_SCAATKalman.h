@@ -49,7 +49,7 @@ namespace uvbi {
         };
         SCAATKalmanPoseEstimator(ConfigParams const &params);
         bool operator()(EstimatorInOutParams const &p, LedPtrList const &leds,
-                        videotracker::util::TimeValue const &frameTime,
+                        videotracker::util::Timestamp const &frameTime,
                         double videoDt);
 
         /// Given a list of LED pointers, filters them out according to
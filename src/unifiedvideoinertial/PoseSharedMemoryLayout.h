@@ -0,0 +1,141 @@
+/** @file
+    @brief Header describing the layout of the shared memory region poses are
+    published to, shared by the writer and the C reader library.
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+// Internal Includes
+#include "unifiedvideoinertial/PoseSharedMemoryC.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace videotracker {
+namespace uvbi {
+    /// The region starts with a RegionHeader, followed by bodyCount blocks of
+    /// bodyStride bytes: a BodyHeader, then historyLength SeqlockedSamples
+    /// making up the ring, where the pose with sequence number n goes in
+    /// slot (n - 1) % historyLength.
+    ///
+    /// Everything the reader loads while the writer may be storing to it is
+    /// an atomic, so a torn read is detected (and retried) rather than being
+    /// a data race. Those atomics are lock-free, so they work across
+    /// processes.
+    namespace pose_shm {
+        /// "UVBP": written last when creating the region, so a reader never
+        /// sees one half set up.
+        static const std::uint32_t Magic = 0x55564250;
+
+        /// How many times a reader tries to read a pose that keeps being
+        /// written before giving up.
+        static const int MaxReadAttempts = 64;
+
+        using Word = std::uint64_t;
+        static_assert(sizeof(UVBI_PoseSample) % sizeof(Word) == 0,
+                      "Pose samples must be copied a whole word at a time");
+        static const std::size_t SampleWords =
+            sizeof(UVBI_PoseSample) / sizeof(Word);
+        static_assert(ATOMIC_LLONG_LOCK_FREE == 2,
+                      "Shared memory needs lock-free 64-bit atomics");
+
+        /// A pose guarded by a sequence lock: the sequence is odd while the
+        /// pose is being written.
+        struct SeqlockedSample {
+            std::atomic<Word> seq;
+            std::atomic<Word> words[SampleWords];
+        };
+
+        struct RegionHeader {
+            std::atomic<std::uint32_t> magic;
+            std::uint32_t version;
+            std::uint32_t bodyCount;
+            std::uint32_t historyLength;
+            std::uint64_t bodyStride;
+        };
+
+        struct BodyHeader {
+            SeqlockedSample latest;
+            /// Count of poses published for the body.
+            std::atomic<std::uint64_t> published;
+        };
+
+        inline std::size_t getBodyStride(std::size_t historyLength) {
+            return sizeof(BodyHeader) +
+                   historyLength * sizeof(SeqlockedSample);
+        }
+
+        inline std::size_t getRegionSize(std::size_t bodyCount,
+                                         std::size_t historyLength) {
+            return sizeof(RegionHeader) +
+                   bodyCount * getBodyStride(historyLength);
+        }
+
+        inline BodyHeader &getBody(RegionHeader &header, std::size_t body) {
+            auto base = reinterpret_cast<unsigned char *>(&header + 1);
+            return *reinterpret_cast<BodyHeader *>(base +
+                                                   body * header.bodyStride);
+        }
+
+        inline SeqlockedSample *getHistory(BodyHeader &body) {
+            return reinterpret_cast<SeqlockedSample *>(&body + 1);
+        }
+
+        /// Only one thread may write a given SeqlockedSample.
+        inline void write(SeqlockedSample &dest,
+                          UVBI_PoseSample const &sample) {
+            Word buf[SampleWords];
+            std::memcpy(buf, &sample, sizeof(sample));
+            auto seq = dest.seq.load(std::memory_order_relaxed);
+            dest.seq.store(seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            for (std::size_t i = 0; i < SampleWords; ++i) {
+                dest.words[i].store(buf[i], std::memory_order_relaxed);
+            }
+            dest.seq.store(seq + 2, std::memory_order_release);
+        }
+
+        /// @return false if every attempt overlapped a write.
+        inline bool read(SeqlockedSample const &src, UVBI_PoseSample &sample) {
+            Word buf[SampleWords];
+            for (int attempt = 0; attempt < MaxReadAttempts; ++attempt) {
+                auto before = src.seq.load(std::memory_order_acquire);
+                if (before % 2 != 0) {
+                    continue;
+                }
+                for (std::size_t i = 0; i < SampleWords; ++i) {
+                    buf[i] = src.words[i].load(std::memory_order_relaxed);
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (src.seq.load(std::memory_order_relaxed) == before) {
+                    std::memcpy(&sample, buf, sizeof(sample));
+                    return true;
+                }
+            }
+            return false;
+        }
+    } // namespace pose_shm
+} // namespace uvbi
+} // namespace videotracker
@@ -0,0 +1,131 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "unifiedvideoinertial/PoseSharedMemoryC.h"
+#include "PoseSharedMemoryLayout.h"
+#include "SharedMemoryRegion.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <memory>
+
+using namespace videotracker::uvbi;
+
+struct UVBI_PoseReaderObject {
+    std::unique_ptr<SharedMemoryRegion> region;
+    pose_shm::RegionHeader *header;
+};
+
+namespace {
+pose_shm::BodyHeader *getBodyIfValid(UVBI_PoseReader reader, uint32_t body) {
+    if (!reader || body >= reader->header->bodyCount) {
+        return nullptr;
+    }
+    return &pose_shm::getBody(*reader->header, body);
+}
+} // namespace
+
+UVBI_PoseReader uvbiPoseReaderOpen(const char *name) {
+    if (!name) {
+        return nullptr;
+    }
+    auto region = SharedMemoryRegion::open(name);
+    if (!region || region->size() < sizeof(pose_shm::RegionHeader)) {
+        return nullptr;
+    }
+    auto header = static_cast<pose_shm::RegionHeader *>(region->data());
+    /// Acquiring the magic number makes the rest of the header visible.
+    if (header->magic.load(std::memory_order_acquire) != pose_shm::Magic ||
+        header->version != UVBI_POSE_SHM_VERSION ||
+        header->historyLength == 0 ||
+        header->bodyStride !=
+            pose_shm::getBodyStride(header->historyLength) ||
+        region->size() < pose_shm::getRegionSize(header->bodyCount,
+                                                 header->historyLength)) {
+        return nullptr;
+    }
+    auto ret = new UVBI_PoseReaderObject;
+    ret->region = std::move(region);
+    ret->header = header;
+    return ret;
+}
+
+void uvbiPoseReaderClose(UVBI_PoseReader reader) { delete reader; }
+
+int uvbiPoseReaderIsPublishing(UVBI_PoseReader reader) {
+    return reader && reader->header->magic.load(std::memory_order_acquire) ==
+                         pose_shm::Magic
+               ? 1
+               : 0;
+}
+
+uint32_t uvbiPoseReaderGetBodyCount(UVBI_PoseReader reader) {
+    return reader ? reader->header->bodyCount : 0;
+}
+
+uint32_t uvbiPoseReaderGetHistoryLength(UVBI_PoseReader reader) {
+    return reader ? reader->header->historyLength : 0;
+}
+
+int uvbiPoseReaderGetLatest(UVBI_PoseReader reader, uint32_t body,
+                            UVBI_PoseSample *dest) {
+    auto block = getBodyIfValid(reader, body);
+    if (!block || !dest ||
+        block->published.load(std::memory_order_acquire) == 0) {
+        return 0;
+    }
+    return pose_shm::read(block->latest, *dest) ? 1 : -1;
+}
+
+size_t uvbiPoseReaderGetHistory(UVBI_PoseReader reader, uint32_t body,
+                                uint64_t afterSequence, UVBI_PoseSample *dest,
+                                size_t maxSamples) {
+    auto block = getBodyIfValid(reader, body);
+    if (!block || !dest || maxSamples == 0) {
+        return 0;
+    }
+    auto historyLength = reader->header->historyLength;
+    auto newest = block->published.load(std::memory_order_acquire);
+    if (newest <= afterSequence) {
+        return 0;
+    }
+    /// Oldest sequence number we want that could still be in the ring.
+    auto first = afterSequence + 1;
+    auto available = std::min<uint64_t>(historyLength, maxSamples);
+    if (newest - first + 1 > available) {
+        first = newest - available + 1;
+    }
+    auto history = pose_shm::getHistory(*block);
+    size_t count = 0;
+    for (auto sequence = first; sequence <= newest; ++sequence) {
+        auto &sample = dest[count];
+        /// A slot that won't read cleanly, or has been overwritten by a
+        /// newer pose since we looked at the count, is skipped.
+        if (pose_shm::read(history[(sequence - 1) % historyLength], sample) &&
+            sample.sequence == sequence) {
+            ++count;
+        }
+    }
+    return count;
+}
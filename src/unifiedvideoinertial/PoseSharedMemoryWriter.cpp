@@ -0,0 +1,138 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "PoseSharedMemoryWriter.h"
+#include "EigenInterop.h"
+#include "PoseSharedMemoryLayout.h"
+#include "SharedMemoryRegion.h"
+
+// Library/third-party includes
+#include "videotrackershared/Assert.h"
+
+// Standard includes
+#include <new>
+
+namespace videotracker {
+namespace uvbi {
+    UVBI_PoseSample makePoseSample(util::Timestamp const &tv,
+                                   BodyState const &state,
+                                   Eigen::Isometry3d const &trackerToRoom) {
+        UVBI_PoseSample ret = {};
+        /// Readers can only line up times from the steady clock with their
+        /// own, so wall-clock times are moved onto it.
+        auto steady = util::time::toSteady(tv);
+        ret.monotonicNanoseconds = steady.count();
+        ret.clockDomain = static_cast<std::uint32_t>(steady.domain());
+        ret.wallTime = util::time::toApiTimeValue(tv);
+
+        Eigen::Isometry3d output = trackerToRoom * state.getIsometry();
+        Eigen::Quaterniond orientation =
+            Eigen::Quaterniond(output.rotation()).normalized();
+        util::eigen_interop::map(ret.pose).rotation() = orientation;
+        util::eigen_interop::map(ret.pose).translation() =
+            output.translation();
+
+        Eigen::Matrix3d rotation = trackerToRoom.linear();
+        util::eigen_interop::map(ret.linearVelocity) =
+            rotation * state.velocity();
+        /// The state's is in body space: report it in room space, as the
+        /// plugin does.
+        util::eigen_interop::map(ret.angularVelocity) =
+            orientation * state.angularVelocity();
+
+        auto const &covariance = state.errorCovariance();
+        util::eigen_interop::map(ret.positionVariance) =
+            (rotation * covariance.topLeftCorner<3, 3>() *
+             rotation.transpose())
+                .diagonal();
+        util::eigen_interop::map(ret.orientationVariance) =
+            (rotation * covariance.block<3, 3>(3, 3) * rotation.transpose())
+                .diagonal();
+        return ret;
+    }
+
+    std::unique_ptr<PoseSharedMemoryWriter>
+    PoseSharedMemoryWriter::make(std::string const &name,
+                                 std::size_t numBodies,
+                                 std::size_t historyLength) {
+        std::unique_ptr<PoseSharedMemoryWriter> ret;
+        if (historyLength == 0) {
+            return ret;
+        }
+        auto region = SharedMemoryRegion::create(
+            name, pose_shm::getRegionSize(numBodies, historyLength));
+        if (!region) {
+            return ret;
+        }
+        ret.reset(new PoseSharedMemoryWriter(std::move(region), numBodies,
+                                             historyLength));
+        return ret;
+    }
+
+    PoseSharedMemoryWriter::PoseSharedMemoryWriter(
+        std::unique_ptr<SharedMemoryRegion> &&region, std::size_t numBodies,
+        std::size_t historyLength)
+        : m_region(std::move(region)), m_numBodies(numBodies),
+          m_historyLength(historyLength) {
+        using namespace pose_shm;
+        /// The region comes zero-filled, which is how the atomics start out
+        /// too: constructing them in place just makes that official.
+        auto &header = *new (m_region->data()) RegionHeader;
+        header.version = UVBI_POSE_SHM_VERSION;
+        header.bodyCount = static_cast<std::uint32_t>(numBodies);
+        header.historyLength = static_cast<std::uint32_t>(historyLength);
+        header.bodyStride = getBodyStride(historyLength);
+        for (std::size_t i = 0; i < numBodies; ++i) {
+            auto &body = getBody(header, i);
+            new (&body) BodyHeader;
+            body.latest.seq.store(0, std::memory_order_relaxed);
+            body.published.store(0, std::memory_order_relaxed);
+            auto history = getHistory(body);
+            for (std::size_t j = 0; j < historyLength; ++j) {
+                new (&history[j]) SeqlockedSample;
+                history[j].seq.store(0, std::memory_order_relaxed);
+            }
+        }
+        header.magic.store(Magic, std::memory_order_release);
+    }
+
+    PoseSharedMemoryWriter::~PoseSharedMemoryWriter() {
+        /// Tell readers still attached that nothing more is coming.
+        auto &header =
+            *static_cast<pose_shm::RegionHeader *>(m_region->data());
+        header.magic.store(0, std::memory_order_release);
+    }
+
+    void PoseSharedMemoryWriter::publish(std::size_t body,
+                                         UVBI_PoseSample sample) {
+        using namespace pose_shm;
+        VIDEOTRACKER_ASSERT_MSG(body < m_numBodies,
+                                "Publishing a pose for an unknown body!");
+        auto &header = *static_cast<RegionHeader *>(m_region->data());
+        auto &block = getBody(header, body);
+        auto sequence = block.published.load(std::memory_order_relaxed) + 1;
+        sample.sequence = sequence;
+        write(getHistory(block)[(sequence - 1) % m_historyLength], sample);
+        write(block.latest, sample);
+        block.published.store(sequence, std::memory_order_release);
+    }
+} // namespace uvbi
+} // namespace videotracker
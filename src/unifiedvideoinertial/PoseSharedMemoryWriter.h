@@ -0,0 +1,86 @@
+/** @file
+    @brief Header for publishing body poses to shared memory, for other
+    processes to read with the C reader library.
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+// Internal Includes
+#include "unifiedvideoinertial/ModelTypes.h"
+#include "unifiedvideoinertial/PoseSharedMemoryC.h"
+
+// Library/third-party includes
+#include "unifiedvideoinertial/Timestamp.h"
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+// Standard includes
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace videotracker {
+namespace uvbi {
+    class SharedMemoryRegion;
+
+    /// Makes the sample published for a body state, transformed from tracker
+    /// (camera) space into room space. The sequence number is left at 0.
+    UVBI_PoseSample makePoseSample(util::Timestamp const &tv,
+                                   BodyState const &state,
+                                   Eigen::Isometry3d const &trackerToRoom);
+
+    /// Publishes the poses of a fixed number of bodies to a named shared
+    /// memory region: see PoseSharedMemoryC.h for reading them.
+    ///
+    /// Publishing never blocks or allocates, so it's fine for the tracking
+    /// thread, which must be the only one publishing.
+    class PoseSharedMemoryWriter {
+      public:
+        /// Creates the region, replacing any left over with the same name.
+        ///
+        /// @return nullptr if it couldn't be created.
+        static std::unique_ptr<PoseSharedMemoryWriter>
+        make(std::string const &name, std::size_t numBodies,
+             std::size_t historyLength);
+
+        ~PoseSharedMemoryWriter();
+
+        /// Publishes a body's pose as the newest one, and into the ring,
+        /// filling in its sequence number.
+        void publish(std::size_t body, UVBI_PoseSample sample);
+
+        /// @overload
+        void publish(std::size_t body, util::Timestamp const &tv,
+                     BodyState const &state,
+                     Eigen::Isometry3d const &trackerToRoom) {
+            publish(body, makePoseSample(tv, state, trackerToRoom));
+        }
+
+        std::size_t getNumBodies() const { return m_numBodies; }
+
+      private:
+        PoseSharedMemoryWriter(std::unique_ptr<SharedMemoryRegion> &&region,
+                               std::size_t numBodies,
+                               std::size_t historyLength);
+        std::unique_ptr<SharedMemoryRegion> m_region;
+        std::size_t m_numBodies;
+        std::size_t m_historyLength;
+    };
+} // namespace uvbi
+} // namespace videotracker
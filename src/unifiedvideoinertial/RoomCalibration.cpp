@@ -75,8 +75,7 @@ namespace uvbi {
 
     RoomCalibration::RoomCalibration(Eigen::Vector3d const &camPosition,
                                      bool cameraIsForward)
-        : m_lastVideoData(util::time::getNow()),
-          m_suppliedCamPosition(camPosition),
+        : m_suppliedCamPosition(camPosition),
           m_cameraIsForward(cameraIsForward) {}
 
     bool RoomCalibration::wantVideoData(TrackingSystem const & /*sys*/,
@@ -102,7 +101,7 @@ namespace uvbi {
 
     void RoomCalibration::processVideoData(TrackingSystem const &sys,
                                            BodyTargetId const &target,
-                                           util::TimeValue const &timestamp,
+                                           util::Timestamp const &timestamp,
                                            Eigen::Vector3d const &xlate,
                                            Eigen::Quaterniond const &quat) {
         if (!wantVideoData(sys, target)) {
@@ -120,7 +119,9 @@ namespace uvbi {
         }
         bool firstData = !haveVideoData();
         m_videoTarget = target;
-        auto dt = duration(timestamp, m_lastVideoData);
+        /// The first frame has nothing to measure from: our construction
+        /// time may not even be in the same clock domain.
+        auto dt = firstData ? 0. : duration(timestamp, m_lastVideoData);
         m_lastVideoData = timestamp;
         if (dt <= 0) {
             dt = 1; // in case of weirdness, avoid divide by zero.
@@ -246,7 +247,7 @@ namespace uvbi {
     }
     void RoomCalibration::processIMUData(TrackingSystem const &sys,
                                          BodyId const &body,
-                                         util::TimeValue const & /*timestamp*/,
+                                         util::Timestamp const & /*timestamp*/,
                                          Eigen::Quaterniond const &quat) {
         if (haveIMUData() && m_imuBody != body) {
 // Already got data from a different IMU
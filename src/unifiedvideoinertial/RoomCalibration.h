@@ -30,7 +30,7 @@
 // Library/third-party includes
 #include "unifiedvideoinertial/Angles.h"
 #include "unifiedvideoinertial/EigenFilters.h"
-#include "unifiedvideoinertial/TimeValue.h"
+#include "unifiedvideoinertial/Timestamp.h"
 #include <Eigen/Core>
 #include <Eigen/Geometry>
 
@@ -59,12 +59,12 @@ namespace uvbi {
 
         void processVideoData(TrackingSystem const &sys,
                               BodyTargetId const &target,
-                              util::TimeValue const &timestamp,
+                              util::Timestamp const &timestamp,
                               Eigen::Vector3d const &xlate,
                               Eigen::Quaterniond const &quat);
 
         void processIMUData(TrackingSystem const &sys, BodyId const &body,
-                            util::TimeValue const &timestamp,
+                            util::Timestamp const &timestamp,
                             Eigen::Quaterniond const &quat);
 
         /// When completed feeding data, this method will check to see if
@@ -115,7 +115,7 @@ namespace uvbi {
         /// @name Video-based tracking data and input filters
         /// @{
         BodyTargetId m_videoTarget;
-        util::TimeValue m_lastVideoData;
+        util::Timestamp m_lastVideoData;
         /// @}
 
         /// Filter on pose in camera space (video data)
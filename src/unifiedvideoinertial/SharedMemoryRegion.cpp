@@ -0,0 +1,183 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "SharedMemoryRegion.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstdint>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace videotracker {
+namespace uvbi {
+#ifdef _WIN32
+    /// Named file mappings don't want the leading slash POSIX needs.
+    static std::string getPlatformName(std::string const &name) {
+        if (!name.empty() && name[0] == '/') {
+            return name.substr(1);
+        }
+        return name;
+    }
+
+    std::unique_ptr<SharedMemoryRegion>
+    SharedMemoryRegion::create(std::string const &name, std::size_t size) {
+        std::unique_ptr<SharedMemoryRegion> ret(new SharedMemoryRegion);
+        ret->m_name = getPlatformName(name);
+        auto size64 = static_cast<std::uint64_t>(size);
+        /// Pagefile-backed mappings start out zero-filled.
+        ret->m_handle = CreateFileMappingA(
+            INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+            static_cast<DWORD>(size64 >> 32),
+            static_cast<DWORD>(size64 & 0xffffffff), ret->m_name.c_str());
+        if (!ret->m_handle) {
+            return nullptr;
+        }
+        if (GetLastError() == ERROR_ALREADY_EXISTS) {
+            /// Some other process has it open: we can't start afresh.
+            return nullptr;
+        }
+        ret->m_data =
+            MapViewOfFile(ret->m_handle, FILE_MAP_ALL_ACCESS, 0, 0, size);
+        if (!ret->m_data) {
+            return nullptr;
+        }
+        ret->m_size = size;
+        ret->m_owner = true;
+        return ret;
+    }
+
+    std::unique_ptr<SharedMemoryRegion>
+    SharedMemoryRegion::open(std::string const &name) {
+        std::unique_ptr<SharedMemoryRegion> ret(new SharedMemoryRegion);
+        ret->m_name = getPlatformName(name);
+        ret->m_handle =
+            OpenFileMappingA(FILE_MAP_READ, FALSE, ret->m_name.c_str());
+        if (!ret->m_handle) {
+            return nullptr;
+        }
+        ret->m_data = MapViewOfFile(ret->m_handle, FILE_MAP_READ, 0, 0, 0);
+        if (!ret->m_data) {
+            return nullptr;
+        }
+        MEMORY_BASIC_INFORMATION info;
+        if (!VirtualQuery(ret->m_data, &info, sizeof(info))) {
+            return nullptr;
+        }
+        ret->m_size = info.RegionSize;
+        return ret;
+    }
+
+    SharedMemoryRegion::~SharedMemoryRegion() {
+        /// The mapping goes away with its last handle, so there's nothing
+        /// extra for the owner to do.
+        if (m_data) {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_handle) {
+            CloseHandle(m_handle);
+        }
+    }
+#else
+    /// POSIX shared memory object names start with a slash.
+    static std::string getPlatformName(std::string const &name) {
+        if (!name.empty() && name[0] == '/') {
+            return name;
+        }
+        return "/" + name;
+    }
+
+    std::unique_ptr<SharedMemoryRegion>
+    SharedMemoryRegion::create(std::string const &name, std::size_t size) {
+        std::unique_ptr<SharedMemoryRegion> ret(new SharedMemoryRegion);
+        ret->m_name = getPlatformName(name);
+        /// Anything by this name is left over from a run that didn't clean
+        /// up: start afresh, so readers still attached to it don't see our
+        /// poses appear in a region laid out for some other configuration.
+        shm_unlink(ret->m_name.c_str());
+        auto fd = shm_open(ret->m_name.c_str(), O_RDWR | O_CREAT | O_EXCL,
+                           S_IRUSR | S_IWUSR);
+        if (fd < 0) {
+            return nullptr;
+        }
+        ret->m_owner = true;
+        /// A newly-sized shared memory object reads as zeros.
+        if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            close(fd);
+            return nullptr;
+        }
+        auto data =
+            mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED) {
+            return nullptr;
+        }
+        ret->m_data = data;
+        ret->m_size = size;
+        return ret;
+    }
+
+    std::unique_ptr<SharedMemoryRegion>
+    SharedMemoryRegion::open(std::string const &name) {
+        std::unique_ptr<SharedMemoryRegion> ret(new SharedMemoryRegion);
+        ret->m_name = getPlatformName(name);
+        auto fd = shm_open(ret->m_name.c_str(), O_RDONLY, 0);
+        if (fd < 0) {
+            return nullptr;
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+            close(fd);
+            return nullptr;
+        }
+        auto size = static_cast<std::size_t>(info.st_size);
+        auto data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED) {
+            return nullptr;
+        }
+        ret->m_data = data;
+        ret->m_size = size;
+        return ret;
+    }
+
+    SharedMemoryRegion::~SharedMemoryRegion() {
+        if (m_data) {
+            munmap(m_data, m_size);
+        }
+        if (m_owner) {
+            shm_unlink(m_name.c_str());
+        }
+    }
+#endif
+} // namespace uvbi
+} // namespace videotracker
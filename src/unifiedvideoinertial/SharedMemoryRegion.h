@@ -0,0 +1,77 @@
+/** @file
+    @brief Header for a named region of memory shared between processes.
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace videotracker {
+namespace uvbi {
+    /// A named region of memory shared between processes on this machine,
+    /// mapped into this one: POSIX shared memory, or a named file mapping on
+    /// Windows.
+    class SharedMemoryRegion {
+      public:
+        /// Creates a zero-filled region, read-write, replacing any of the
+        /// same name left over from an earlier run. The region is removed
+        /// when this object is destroyed, though processes that have it open
+        /// keep their mapping.
+        ///
+        /// @return nullptr if it couldn't be created.
+        static std::unique_ptr<SharedMemoryRegion>
+        create(std::string const &name, std::size_t size);
+
+        /// Opens an existing region, read-only.
+        ///
+        /// @return nullptr if there's no such region.
+        static std::unique_ptr<SharedMemoryRegion>
+        open(std::string const &name);
+
+        ~SharedMemoryRegion();
+
+        // noncopyable
+        SharedMemoryRegion(SharedMemoryRegion const &) = delete;
+        SharedMemoryRegion &operator=(SharedMemoryRegion const &) = delete;
+
+        void *data() const { return m_data; }
+        std::size_t size() const { return m_size; }
+
+      private:
+        SharedMemoryRegion() = default;
+        std::string m_name;
+        void *m_data = nullptr;
+        std::size_t m_size = 0;
+        /// Whether we created it, and so should remove it.
+        bool m_owner = false;
+#ifdef _WIN32
+        void *m_handle = nullptr;
+#endif
+    };
+} // namespace uvbi
+} // namespace videotracker
@@ -25,7 +25,7 @@
 #pragma once
 
 // Internal Includes
-#include "unifiedvideoinertial/TimeValue.h"
+#include "unifiedvideoinertial/Timestamp.h"
 
 // Library/third-party includes
 #include "FlexKalman/FlexibleKalmanBase.h"
@@ -91,7 +91,7 @@ namespace uvbi {
             }
 
           private:
-            util::TimeValue m_timestamp;
+            util::Timestamp m_timestamp;
             StateVectorBackup m_stateVector;
             StateCovarianceBackup m_covariance;
         };
@@ -0,0 +1,335 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "unifiedvideoinertial/SyntheticScene.h"
+#include "TrackedBodyIMU.h"
+#include "unifiedvideoinertial/TrackedBody.h"
+#include "unifiedvideoinertial/TrackingSystem.h"
+#include "videotrackershared/CameraDistortionModel.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+namespace videotracker {
+namespace uvbi {
+    namespace {
+        /// Mixes several values into a well-distributed seed (splitmix64
+        /// finalizer), so each frame or sample gets independent noise.
+        inline std::uint64_t mixSeed(std::uint64_t a, std::uint64_t b,
+                                     std::uint64_t c = 0) {
+            std::uint64_t z = a * 0x9E3779B97F4A7C15ULL + b;
+            z = z * 0x9E3779B97F4A7C15ULL + c;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        }
+
+        inline bool isDrawablePattern(std::string const &pattern) {
+            return !pattern.empty() &&
+                   pattern.find_first_not_of("*.") == std::string::npos;
+        }
+
+        /// Rotation by the given rotation vector.
+        inline Eigen::Quaterniond rotationFromVector(Eigen::Vector3d const &v) {
+            auto angle = v.norm();
+            if (angle == 0) {
+                return Eigen::Quaterniond::Identity();
+            }
+            return Eigen::Quaterniond(Eigen::AngleAxisd(angle, v / angle));
+        }
+
+        template <typename Engine>
+        inline Eigen::Vector3d gaussianVector(Engine &engine, double stddev) {
+            if (stddev <= 0) {
+                return Eigen::Vector3d::Zero();
+            }
+            std::normal_distribution<double> dist(0., stddev);
+            Eigen::Vector3d ret;
+            ret << dist(engine), dist(engine), dist(engine);
+            return ret;
+        }
+    } // namespace
+
+    SyntheticTrajectory makeStaticTrajectory(Eigen::Isometry3d const &pose) {
+        // Capturing the parts: a bare Isometry3d can't safely live in the
+        // heap storage of a std::function, due to alignment.
+        Eigen::Matrix3d rot = pose.linear();
+        Eigen::Vector3d xlate = pose.translation();
+        return [rot, xlate](double) {
+            Eigen::Isometry3d ret = Eigen::Isometry3d::Identity();
+            ret.linear() = rot;
+            ret.translation() = xlate;
+            return ret;
+        };
+    }
+
+    SyntheticTrajectory
+    makeSwayTrajectory(Eigen::Isometry3d const &center,
+                       Eigen::Vector3d const &linearAmplitude,
+                       Eigen::Vector3d const &angularAmplitude, double period) {
+        if (period <= 0) {
+            throw std::invalid_argument("Sway period must be positive!");
+        }
+        Eigen::Matrix3d rot = center.linear();
+        Eigen::Vector3d xlate = center.translation();
+        Eigen::Vector3d lin = linearAmplitude;
+        Eigen::Vector3d ang = angularAmplitude;
+        const double omega = 2. * EIGEN_PI / period;
+        return [rot, xlate, lin, ang, omega](double t) {
+            using std::sin;
+            Eigen::Vector3d offset(lin.x() * sin(omega * t),
+                                   lin.y() * sin(2. * omega * t + 0.5),
+                                   lin.z() * sin(3. * omega * t + 1.));
+            Eigen::Vector3d angles(ang.x() * sin(2. * omega * t + 1.3),
+                                   ang.y() * sin(omega * t + 2.1),
+                                   ang.z() * sin(3. * omega * t + 0.7));
+            Eigen::Quaterniond incRot =
+                Eigen::AngleAxisd(angles.x(), Eigen::Vector3d::UnitX()) *
+                Eigen::AngleAxisd(angles.y(), Eigen::Vector3d::UnitY()) *
+                Eigen::AngleAxisd(angles.z(), Eigen::Vector3d::UnitZ());
+            Eigen::Isometry3d ret = Eigen::Isometry3d::Identity();
+            ret.linear() = rot * incRot.toRotationMatrix();
+            ret.translation() = xlate + offset;
+            return ret;
+        };
+    }
+
+    SyntheticScene::SyntheticScene(SyntheticSceneParams const &params)
+        : m_params(params) {
+        if (m_params.frameRate <= 0 || m_params.imuRate <= 0) {
+            throw std::invalid_argument(
+                "Synthetic scene frame and IMU rates must be positive!");
+        }
+    }
+
+    BodyId SyntheticScene::addBody(TargetSetupData const &target,
+                                   SyntheticTrajectory trajectory) {
+        if (!trajectory) {
+            throw std::invalid_argument(
+                "Synthetic scene bodies need a trajectory!");
+        }
+        Body body;
+        body.trajectory = std::move(trajectory);
+        auto n = target.numBeacons();
+        for (TargetSetupData::size_type i = 0; i < n; ++i) {
+            if (i >= target.patterns.size() ||
+                !isDrawablePattern(target.patterns[i])) {
+                continue;
+            }
+            auto const &loc = target.locations[i];
+            Beacon beacon;
+            beacon.location = Eigen::Vector3d(loc.x, loc.y, loc.z);
+            if (i < target.emissionDirections.size()) {
+                auto const &dir = target.emissionDirections[i];
+                beacon.emissionDirection =
+                    Eigen::Vector3d(dir[0], dir[1], dir[2]);
+                if (!beacon.emissionDirection.isZero()) {
+                    beacon.emissionDirection.normalize();
+                }
+            } else {
+                beacon.emissionDirection = Eigen::Vector3d::Zero();
+            }
+            beacon.pattern = target.patterns[i];
+            body.beacons.push_back(std::move(beacon));
+        }
+        m_bodies.push_back(std::move(body));
+        return BodyId(static_cast<BodyId::wrapped_type>(m_bodies.size() - 1));
+    }
+
+    double SyntheticScene::getFrameTime(std::size_t frameNumber) const {
+        return static_cast<double>(frameNumber) / m_params.frameRate;
+    }
+
+    util::Timestamp SyntheticScene::toTimestamp(double sceneTime) const {
+        return m_params.startTime +
+               std::chrono::nanoseconds(std::llround(sceneTime * 1.e9));
+    }
+
+    double SyntheticScene::toSceneTime(util::Timestamp const &tv) const {
+        return util::time::duration(tv, m_params.startTime);
+    }
+
+    Eigen::Isometry3d SyntheticScene::getTruePose(BodyId body,
+                                                  double sceneTime) const {
+        return m_bodies.at(body.value()).trajectory(sceneTime);
+    }
+
+    void SyntheticScene::drawBeacon(cv::Mat &image,
+                                    Eigen::Vector2d const &center,
+                                    double radius, double level) const {
+        // Anti-aliased disc: full level inside the radius, ramping down to the
+        // background over one pixel at the edge. Overlapping beacons take the
+        // brighter value rather than summing.
+        const auto background = static_cast<float>(m_params.backgroundLevel);
+        const auto contrast = static_cast<float>(level) - background;
+        const auto reach = radius + 1.;
+        const int xBegin =
+            (std::max)(0, static_cast<int>(std::floor(center.x() - reach)));
+        const int xEnd = (std::min)(
+            image.cols, static_cast<int>(std::ceil(center.x() + reach)) + 1);
+        const int yBegin =
+            (std::max)(0, static_cast<int>(std::floor(center.y() - reach)));
+        const int yEnd = (std::min)(
+            image.rows, static_cast<int>(std::ceil(center.y() + reach)) + 1);
+        for (int y = yBegin; y < yEnd; ++y) {
+            auto row = image.ptr<float>(y);
+            const double dy = y - center.y();
+            for (int x = xBegin; x < xEnd; ++x) {
+                const double dx = x - center.x();
+                const double coverage = (std::min)(
+                    1., (std::max)(0., radius + 0.5 - std::hypot(dx, dy)));
+                if (coverage > 0) {
+                    row[x] = (std::max)(
+                        row[x], background +
+                                    contrast * static_cast<float>(coverage));
+                }
+            }
+        }
+    }
+
+    void SyntheticScene::renderFrame(std::size_t frameNumber, cv::Mat &gray,
+                                     util::Timestamp &timestamp) {
+        auto const &cam = m_params.camParams;
+        const auto t = getFrameTime(frameNumber);
+        timestamp = toTimestamp(t);
+
+        cv::Mat canvas(cam.imageSize, CV_32FC1,
+                       cv::Scalar(m_params.backgroundLevel));
+
+        const CameraDistortionModel distortion{
+            Eigen::Vector2d{cam.focalLengthX(), cam.focalLengthY()},
+            cam.eiPrincipalPoint(),
+            Eigen::Vector3d{cam.k1(), cam.k2(), cam.k3()}};
+        const Eigen::Vector2d focalLengths{cam.focalLengthX(),
+                                           cam.focalLengthY()};
+        const Eigen::Vector2d principalPoint = cam.eiPrincipalPoint();
+        const double cosHalfAngle = std::cos(m_params.emissionHalfAngle);
+
+        m_beaconsDrawn = 0;
+        for (auto const &body : m_bodies) {
+            const Eigen::Isometry3d pose = body.trajectory(t);
+            for (auto const &beacon : body.beacons) {
+                const Eigen::Vector3d p = pose * beacon.location;
+                if (p.z() < m_params.nearClip) {
+                    continue;
+                }
+                if (!beacon.emissionDirection.isZero()) {
+                    const Eigen::Vector3d emission =
+                        pose.linear() * beacon.emissionDirection;
+                    if (emission.dot(-p.normalized()) < cosHalfAngle) {
+                        continue;
+                    }
+                }
+                const Eigen::Vector2d ideal =
+                    (p.head<2>() / p.z()).cwiseProduct(focalLengths) +
+                    principalPoint;
+                const Eigen::Vector2d center = distortion.distortPoint(ideal);
+
+                const bool bright =
+                    beacon.pattern[frameNumber % beacon.pattern.size()] == '*';
+                const double radius = (std::max)(
+                    m_params.minBeaconRadiusPixels,
+                    cam.focalLengthX() *
+                        (bright ? m_params.brightBeaconRadius
+                                : m_params.dimBeaconRadius) /
+                        p.z());
+                if (center.x() + radius < 0 || center.y() + radius < 0 ||
+                    center.x() - radius >= canvas.cols ||
+                    center.y() - radius >= canvas.rows) {
+                    continue;
+                }
+                drawBeacon(canvas, center, radius,
+                           bright ? m_params.brightBeaconLevel
+                                  : m_params.dimBeaconLevel);
+                ++m_beaconsDrawn;
+            }
+        }
+
+        if (m_params.pixelNoise > 0) {
+            cv::RNG rng(mixSeed(m_params.seed, frameNumber));
+            cv::Mat noise(canvas.size(), CV_32FC1);
+            rng.fill(noise, cv::RNG::NORMAL, 0., m_params.pixelNoise);
+            canvas += noise;
+        }
+        // Rounds and saturates.
+        canvas.convertTo(gray, CV_8UC1);
+    }
+
+    Eigen::Quaterniond
+    SyntheticScene::getIMUOrientation(std::size_t body,
+                                      double sceneTime) const {
+        return m_params.imuWorldFromCamera *
+               Eigen::Quaterniond(
+                   m_bodies[body].trajectory(sceneTime).linear());
+    }
+
+    SyntheticIMUSampleVec SyntheticScene::getIMUSamples(double begin,
+                                                        double end) const {
+        SyntheticIMUSampleVec ret;
+        const auto dt = 1. / m_params.imuRate;
+        const auto first =
+            static_cast<std::int64_t>(std::ceil(begin * m_params.imuRate));
+        for (auto k = first;; ++k) {
+            const auto t = static_cast<double>(k) * dt;
+            if (t >= end) {
+                break;
+            }
+            for (std::size_t i = 0; i < m_bodies.size(); ++i) {
+                std::mt19937 engine(static_cast<std::mt19937::result_type>(
+                    mixSeed(m_params.seed, i + 1,
+                            static_cast<std::uint64_t>(k))));
+                SyntheticIMUSample sample;
+                sample.body = BodyId(static_cast<BodyId::wrapped_type>(i));
+                sample.tv = toTimestamp(t);
+                sample.dt = dt;
+                const auto quat = getIMUOrientation(i, t);
+                const auto prevQuat = getIMUOrientation(i, t - dt);
+                sample.orientation =
+                    (quat * rotationFromVector(gaussianVector(
+                                engine, m_params.orientationNoise)))
+                        .normalized();
+                sample.deltaQuat =
+                    (prevQuat.inverse() * quat *
+                     rotationFromVector(gaussianVector(
+                         engine, m_params.angularVelocityNoise * dt)))
+                        .normalized();
+                ret.push_back(sample);
+            }
+        }
+        return ret;
+    }
+
+    void applySyntheticIMUSample(TrackingSystem &system,
+                                 SyntheticIMUSample const &sample) {
+        auto &imu = system.getBody(sample.body).getIMU();
+        imu.updatePoseFromOrientation(sample.tv, sample.orientation);
+        imu.updatePoseFromAngularVelocity(sample.tv, sample.deltaQuat,
+                                          sample.dt);
+    }
+} // namespace uvbi
+} // namespace videotracker
@@ -0,0 +1,204 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "ThreadScheduling.h"
+#include "Clamp.h"
+#include "unifiedvideoinertial/ConfigParams.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cerrno>
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#endif
+
+namespace videotracker {
+namespace uvbi {
+    ThreadScheduling getTrackerThreadScheduling(ConfigParams const &params) {
+        ThreadScheduling ret;
+        ret.cpus = params.trackerThreadCpus;
+        ret.realtimePriority = params.realtimePriority;
+        ret.niceness = params.threadNiceness;
+        return ret;
+    }
+
+    ThreadScheduling getImageThreadScheduling(ConfigParams const &params) {
+        ThreadScheduling ret;
+        ret.cpus = params.imageThreadCpus;
+        ret.realtimePriority = params.realtimePriority;
+        ret.niceness = params.threadNiceness;
+        return ret;
+    }
+
+#ifdef _WIN32
+    static std::string describeLastError() {
+        return "error " + std::to_string(GetLastError());
+    }
+
+    static bool setAffinity(std::vector<int> const &cpus,
+                            std::string &error) {
+        DWORD_PTR mask = 0;
+        for (auto cpu : cpus) {
+            if (cpu < 0 || cpu >= static_cast<int>(sizeof(mask) * 8)) {
+                error = "CPU " + std::to_string(cpu) + " out of range";
+                return false;
+            }
+            mask |= DWORD_PTR(1) << cpu;
+        }
+        if (!SetThreadAffinityMask(GetCurrentThread(), mask)) {
+            error = describeLastError();
+            return false;
+        }
+        return true;
+    }
+
+    static bool setRealtimePriority(int, std::string &error) {
+        if (!SetThreadPriority(GetCurrentThread(),
+                               THREAD_PRIORITY_TIME_CRITICAL)) {
+            error = describeLastError();
+            return false;
+        }
+        return true;
+    }
+
+    static bool setNiceness(int niceness, std::string &error) {
+        /// Windows only has a handful of thread priorities: map the nice
+        /// range onto them.
+        int priority = THREAD_PRIORITY_NORMAL;
+        if (niceness <= -10) {
+            priority = THREAD_PRIORITY_HIGHEST;
+        } else if (niceness < 0) {
+            priority = THREAD_PRIORITY_ABOVE_NORMAL;
+        } else if (niceness >= 10) {
+            priority = THREAD_PRIORITY_LOWEST;
+        } else if (niceness > 0) {
+            priority = THREAD_PRIORITY_BELOW_NORMAL;
+        }
+        if (!SetThreadPriority(GetCurrentThread(), priority)) {
+            error = describeLastError();
+            return false;
+        }
+        return true;
+    }
+
+    bool lockProcessMemory() {
+        /// VirtualLock only works a range at a time, up to the working set
+        /// size: there's no equivalent of locking everything.
+        return false;
+    }
+#else
+    static bool setAffinity(std::vector<int> const &cpus,
+                            std::string &error) {
+#ifdef __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (auto cpu : cpus) {
+            if (cpu < 0 || cpu >= CPU_SETSIZE) {
+                error = "CPU " + std::to_string(cpu) + " out of range";
+                return false;
+            }
+            CPU_SET(cpu, &set);
+        }
+        auto result = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        if (result != 0) {
+            error = std::strerror(result);
+            return false;
+        }
+        return true;
+#else
+        (void)cpus;
+        error = "not supported on this platform";
+        return false;
+#endif
+    }
+
+    static bool setRealtimePriority(int priority, std::string &error) {
+        sched_param param;
+        std::memset(&param, 0, sizeof(param));
+        param.sched_priority =
+            clamp(priority, sched_get_priority_min(SCHED_FIFO),
+                  sched_get_priority_max(SCHED_FIFO));
+        auto result =
+            pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (result != 0) {
+            error = std::strerror(result);
+            return false;
+        }
+        return true;
+    }
+
+    static bool setNiceness(int niceness, std::string &error) {
+#ifdef __linux__
+        /// On Linux, the nice value is per-thread, addressed by thread ID.
+        auto tid = static_cast<id_t>(syscall(SYS_gettid));
+        if (setpriority(PRIO_PROCESS, tid, niceness) != 0) {
+            error = std::strerror(errno);
+            return false;
+        }
+        return true;
+#else
+        /// Elsewhere it would apply to the whole process.
+        (void)niceness;
+        error = "not supported on this platform";
+        return false;
+#endif
+    }
+
+    bool lockProcessMemory() {
+        return mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+    }
+#endif
+
+    std::vector<std::string>
+    applyToCurrentThread(ThreadScheduling const &scheduling) {
+        std::vector<std::string> failures;
+        std::string error;
+        if (!scheduling.cpus.empty() && !setAffinity(scheduling.cpus, error)) {
+            failures.push_back("Could not set CPU affinity: " + error);
+        }
+        if (scheduling.realtimePriority > 0) {
+            if (!setRealtimePriority(scheduling.realtimePriority, error)) {
+                failures.push_back("Could not set real-time priority: " +
+                                   error);
+            }
+        } else if (scheduling.niceness != 0 &&
+                   !setNiceness(scheduling.niceness, error)) {
+            failures.push_back("Could not set nice value: " + error);
+        }
+        return failures;
+    }
+} // namespace uvbi
+} // namespace videotracker
@@ -0,0 +1,71 @@
+/** @file
+    @brief Header for setting the CPU placement and priority of the tracking
+    threads.
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <string>
+#include <vector>
+
+namespace videotracker {
+namespace uvbi {
+    struct ConfigParams;
+
+    /// How a thread should be scheduled: the defaults leave it alone.
+    struct ThreadScheduling {
+        /// CPUs it may run on: empty for any.
+        std::vector<int> cpus;
+        /// Real-time priority, or 0 for normal scheduling.
+        int realtimePriority = 0;
+        /// Nice value, if not real-time.
+        int niceness = 0;
+
+        bool isDefault() const {
+            return cpus.empty() && realtimePriority <= 0 && niceness == 0;
+        }
+    };
+
+    /// Scheduling of the tracker thread, from the config.
+    ThreadScheduling getTrackerThreadScheduling(ConfigParams const &params);
+
+    /// Scheduling of the image processing thread, from the config.
+    ThreadScheduling getImageThreadScheduling(ConfigParams const &params);
+
+    /// Applies the scheduling to the calling thread. Threads it goes on to
+    /// start inherit it.
+    ///
+    /// @return A description of each setting the OS refused: empty if all
+    /// were applied.
+    std::vector<std::string>
+    applyToCurrentThread(ThreadScheduling const &scheduling);
+
+    /// Locks all of the process's memory, now and later, into RAM.
+    ///
+    /// @return false if the OS refused, or can't.
+    bool lockProcessMemory();
+} // namespace uvbi
+} // namespace videotracker
@@ -30,12 +30,12 @@
 #include "EigenInterop.h"
 #include "FlexKalman/EigenQuatExponentialMap.h"
 #include "FlexKalman/FlexibleKalmanFilter.h"
-#include "unifiedvideoinertial/TimeValue.h"
+#include "unifiedvideoinertial/Timestamp.h"
 #include <Eigen/Core>
 #include <Eigen/Geometry>
 
 // Standard includes
-// - none
+#include <chrono>
 
 namespace videotracker {
 namespace uvbi {
@@ -81,44 +81,65 @@ namespace uvbi {
         report.vel.linearVelocityValid = true;
     }
 
-    std::unique_ptr<BodyReporting> BodyReporting::make() {
-        std::unique_ptr<BodyReporting> ret(new BodyReporting);
+    std::unique_ptr<BodyReporting> BodyReporting::make(BodyReportingMode mode) {
+        std::unique_ptr<BodyReporting> ret(new BodyReporting(mode));
         return ret;
     }
 
-    bool BodyReporting::getReport(double additionalPrediction,
-                                  BodyReport &report) {
-
+    bool BodyReporting::receiveState() {
         QueueValueType queueVal;
-        bool gotOne = false;
-        // Read all the queued-up states, but only keep the most recent one.
-        while (m_queue.read(queueVal)) {
-            gotOne = true;
+        QueueValueType const *newest = nullptr;
+        if (m_mode == BodyReportingMode::LatestOnly) {
+            if (m_latest.receive()) {
+                newest = &m_latest.readBuffer();
+            }
+        } else {
+            // Read all the queued-up states, but only keep the most recent
+            // one.
+            while (m_queue.read(queueVal)) {
+                newest = &queueVal;
+            }
         }
-        if (!gotOne) {
+        if (!newest) {
             return false;
         }
 
         /// Thaw out the frozen state.
-        m_dataTime = queueVal.timestamp;
-        Eigen::Map<QueueValueVec> valMap(queueVal.stateData.data());
+        m_dataTime = newest->timestamp;
+        Eigen::Map<const QueueValueVec> valMap(newest->stateData.data());
         m_state.incrementalOrientation() = Eigen::Vector3d::Zero();
         m_state.position() = valMap.head<3>();
         m_state.setQuaternion(Eigen::Quaterniond(valMap.segment<4>(3)));
         m_state.velocity() = valMap.segment<3>(7);
         m_state.angularVelocity() = valMap.tail<3>();
+        return true;
+    }
+
+    bool BodyReporting::getReport(double additionalPrediction,
+                                  BodyReport &report) {
+        return getReport(util::time::getSteadyNow(), additionalPrediction,
+                         report);
+    }
+
+    bool BodyReporting::getReport(util::Timestamp const &now,
+                                  double additionalPrediction,
+                                  BodyReport &report) {
+        if (!receiveState()) {
+            return false;
+        }
 
         // If we have a process model, and have non-zero velocity, then we can
-        // do some prediction.
+        // do some prediction - as long as the state isn't from recorded or
+        // synthetic data, which has no relation to "now".
         bool doingPrediction =
-            m_hasProcessModel && (m_state.stateVector().tail<6>() !=
-                                  flexkalman::types::Vector<6>::Zero());
+            m_hasProcessModel && now.comparableWith(m_dataTime) &&
+            (m_state.stateVector().tail<6>() !=
+             flexkalman::types::Vector<6>::Zero());
 
         if (doingPrediction) {
             // If we have non-zero velocity, then we can do some prediction.
-            auto currentTime = util::time::getNow();
             /// Difference between measurement time and now.
-            auto dt = uvbiTimeValueDurationSeconds(&currentTime, &m_dataTime);
+            auto dt = util::time::duration(now, m_dataTime);
             /// and the additional time into the future we'd like to predict.
             dt += additionalPrediction;
 
@@ -129,25 +150,33 @@ namespace uvbi {
             /// Be sure to post-correct.
 
             /// OK, now set a proper timestamp for our prediction.
-            report.timestamp = currentTime + std::chrono::duration<double>(
-                                                 additionalPrediction);
+            report.timestamp = util::time::toApiTimeValue(
+                now + std::chrono::duration<double>(additionalPrediction));
         } else {
-            report.timestamp = m_dataTime;
+            report.timestamp = util::time::toApiTimeValue(m_dataTime);
         }
         assignStateToBodyReport(m_state, report, m_trackerToRoom);
         report.status = ReportStatus::Valid;
         return true;
     }
 
-    bool BodyReporting::updateState(util::TimeValue const &tv,
+    bool BodyReporting::updateState(util::Timestamp const &tv,
                                     BodyState const &state) {
-        QueueValueType val;
+        bool latestOnly = m_mode == BodyReportingMode::LatestOnly;
+        QueueValueType queueVal;
+        /// Fill in the triple buffer's back buffer in place, or a temporary
+        /// to copy into the queue.
+        QueueValueType &val = latestOnly ? m_latest.writeBuffer() : queueVal;
         /// Initialize the array inside the queue value
         QueueValueVec::Map(val.stateData.data()) << state.position(),
             state.getQuaternion().coeffs(), state.velocity(),
             state.angularVelocity();
 
         val.timestamp = tv;
+        if (latestOnly) {
+            m_latest.publish();
+            return true;
+        }
         return m_queue.write(val);
     }
 
@@ -161,9 +190,26 @@ namespace uvbi {
         m_trackerToRoom = xform;
     }
 
-    BodyReporting::BodyReporting()
-        : m_trackerToRoom(Eigen::Isometry3d::Identity()),
-          m_queue(REPORT_QUEUE_SIZE) {}
+    BodyReporting::BodyReporting(BodyReportingMode mode)
+        : m_trackerToRoom(Eigen::Isometry3d::Identity()), m_mode(mode),
+          /// The queue goes unused in latest-only mode, so keep it minimal.
+          m_queue(mode == BodyReportingMode::Queue ? REPORT_QUEUE_SIZE : 2) {}
+
+    std::size_t getReports(BodyReportingVector &bodies,
+                           double additionalPrediction,
+                           std::vector<BodyReport> &reports) {
+        reports.resize(bodies.size());
+        auto now = util::time::getSteadyNow();
+        std::size_t numValid = 0;
+        for (std::size_t i = 0; i < bodies.size(); ++i) {
+            if (bodies[i]->getReport(now, additionalPrediction, reports[i])) {
+                ++numValid;
+            } else {
+                reports[i].status = ReportStatus::NoReportAvailable;
+            }
+        }
+        return numValid;
+    }
 
 } // namespace uvbi
 } // namespace videotracker
@@ -25,17 +25,20 @@
 #pragma once
 
 // Internal Includes
+#include "TripleBuffer.h"
 #include "unifiedvideoinertial/ModelTypes.h"
 
 // Library/third-party includes
 #include "ClientReportTypesC.h"
-#include "unifiedvideoinertial/TimeValue.h"
+#include "unifiedvideoinertial/Timestamp.h"
 #include "unifiedvideoinertial/nonstd/optional.hpp"
 #include <folly/ProducerConsumerQueue.h>
 
 // Standard includes
 #include <array>
+#include <cstddef>
 #include <memory>
+#include <vector>
 
 namespace videotracker {
 namespace uvbi {
@@ -55,17 +58,31 @@ namespace uvbi {
         explicit operator bool() const { return status == ReportStatus::Valid; }
 
         ReportStatus status;
+        /// Wall-clock time, for the C API.
         util::TimeValue timestamp;
         OSVR_PoseState pose;
         OSVR_VelocityState vel;
     };
 
+    /// How a BodyReporting hands states from the tracking thread to the
+    /// mainloop thread.
+    enum class BodyReportingMode {
+        /// A bounded queue of every state: the consumer drains it to find the
+        /// newest, and the producer drops states when it's full.
+        Queue,
+        /// Only the newest state is kept, in a triple buffer: never full, and
+        /// receiving takes constant time however many states were produced
+        /// since the last report.
+        LatestOnly
+    };
+
     /// A per-body class intended to marshall data coming from the
     /// tracking/processing thread back to the mainloop thread.
     class BodyReporting {
       public:
         /// Factory function
-        static std::unique_ptr<BodyReporting> make();
+        static std::unique_ptr<BodyReporting>
+        make(BodyReportingMode mode = BodyReportingMode::Queue);
 
         EIGEN_MAKE_ALIGNED_OPERATOR_NEW
         /// @name mainloop-thread methods
@@ -78,6 +95,12 @@ namespace uvbi {
         /// additionalPrediction if nonzero). If false is returned, no reports
         /// were available to consume.
         bool getReport(double additionalPrediction, BodyReport &report);
+
+        /// Like the other overload, but predicting to the given time (plus
+        /// additionalPrediction) instead of looking up the current time, so a
+        /// caller can report several bodies consistently.
+        bool getReport(util::Timestamp const &now, double additionalPrediction,
+                       BodyReport &report);
         /// @}
 
         /// @name processing-thread methods
@@ -85,7 +108,7 @@ namespace uvbi {
 
         /// "Produces" an updated state.
         /// @return false if there was no room in the queue.
-        bool updateState(util::TimeValue const &tv, BodyState const &state);
+        bool updateState(util::Timestamp const &tv, BodyState const &state);
 
         /// One-time call: sets up the process model, allowing the consumer end
         /// of this class to predict to "now".
@@ -97,7 +120,10 @@ namespace uvbi {
         void setTrackerToRoomTransform(Eigen::Isometry3d const &xform);
         /// @}
       private:
-        BodyReporting();
+        explicit BodyReporting(BodyReportingMode mode);
+        /// Receives the newest state into m_state and m_dataTime, if any is
+        /// available.
+        bool receiveState();
         /// @name One-time initialization
         /// @{
         bool m_hasProcessModel = false;
@@ -106,25 +132,39 @@ namespace uvbi {
         /// @}
 
         template <std::size_t ArraySize> struct QueueValue {
-            util::TimeValue timestamp;
+            util::Timestamp timestamp;
             std::array<double, ArraySize> stateData;
         };
         /// 13 elements, instead of 12, because we're shipping a quaternion
         /// instead of an incremental rotation.
         using QueueValueType = QueueValue<13>;
         using QueueValueVec = Eigen::Matrix<double, 13, 1>;
-        /// The communication channel between threads.
+        /// @name The communication channel between threads: which one is
+        /// used depends on m_mode.
+        /// @{
+        BodyReportingMode m_mode;
         folly::ProducerConsumerQueue<QueueValueType> m_queue;
+        TripleBuffer<QueueValueType> m_latest;
+        /// @}
 
         /// @name Convenience members used by the consumer side, so they don't
         /// have to create them each time.
         /// @{
         BodyState m_state;
-        util::TimeValue m_dataTime;
+        util::Timestamp m_dataTime;
         /// @}
     };
     using BodyReportingPtr = std::unique_ptr<BodyReporting>;
 
     using BodyReportingVector = std::vector<BodyReportingPtr>;
+
+    /// Gets reports for all bodies at once, all predicted to the same "now"
+    /// (plus additionalPrediction), which is looked up only once. reports is
+    /// resized to match bodies: entries for bodies with no new state have
+    /// status ReportStatus::NoReportAvailable. Returns the number of valid
+    /// reports.
+    std::size_t getReports(BodyReportingVector &bodies,
+                           double additionalPrediction,
+                           std::vector<BodyReport> &reports);
 } // namespace uvbi
 } // namespace videotracker
@@ -27,20 +27,21 @@
 #include "ApplyIMUToState.h"
 #include "BodyTargetInterface.h"
 #include "HistoryContainer.h"
+#include "IMUPreintegrator.h"
 #include "StateHistory.h"
 #include "TrackedBodyIMU.h"
 #include "unifiedvideoinertial/CannedIMUMeasurement.h"
 #include "unifiedvideoinertial/TrackedBodyTarget.h"
+#include "unifiedvideoinertial/TrackingMetrics.h"
 #include "unifiedvideoinertial/TrackingSystem.h"
 
 // Library/third-party includes
 #include "FlexKalman/FlexibleKalmanFilter.h"
 #include "unifiedvideoinertial/nonstd/optional.hpp"
 
-#include "unifiedvideoinertial/Stride.h"
-
 // Standard includes
 #include <iostream>
+#include <limits>
 
 namespace videotracker {
 namespace uvbi {
@@ -50,6 +51,13 @@ namespace uvbi {
 
         HistoryContainer<BodyStateHistoryEntry> stateHistory;
         HistoryContainer<CannedIMUMeasurement> imuMeasurements;
+        /// IMU measurements not yet applied, if preintegrating.
+        IMUPreintegrator preintegrator;
+        /// Whether IMU measurements after a video update remain to be
+        /// replayed.
+        bool replayPending = false;
+        /// Timestamp of the last IMU measurement replayed, if replayPending.
+        util::Timestamp replayedThrough;
         bool everHadPose = false;
     };
     TrackedBody::TrackedBody(TrackingSystem &system, BodyId id)
@@ -100,13 +108,18 @@ namespace uvbi {
     }
 
     BodyId TrackedBody::getId() const { return m_id; }
-    videotracker::util::TimeValue TrackedBody::getStateTime() const {
+    videotracker::util::Timestamp TrackedBody::getStateTime() const {
         return m_stateTime;
     }
 
     bool TrackedBody::getStateAtOrBefore(
-        videotracker::util::TimeValue const &desiredTime,
-        videotracker::util::TimeValue &outTime, BodyState &outState) {
+        videotracker::util::Timestamp const &desiredTime,
+        videotracker::util::Timestamp &outTime, BodyState &outState) {
+        /// Any state we hand out should have seen the IMU up to then.
+        replayIMU(std::numeric_limits<std::size_t>::max(), &desiredTime);
+        if (isPreintegratingIMU()) {
+            endPreintegrationWindowAt(desiredTime);
+        }
         auto it = m_impl->stateHistory.closest_not_newer(desiredTime);
         if (m_impl->stateHistory.end() == it) {
             /// couldn't find such a state.
@@ -117,12 +130,12 @@ namespace uvbi {
         return true;
     }
 
-    inline videotracker::util::TimeValue getOldestPossibleMeasurementSource(
+    inline videotracker::util::Timestamp getOldestPossibleMeasurementSource(
         TrackedBody const &body,
-        videotracker::util::TimeValue const &videoTime) {
+        videotracker::util::Timestamp const &videoTime) {
         /// @todo assumes a single camera, or that "videoTime" is the timestamp
         /// of the "oldest" camera data.
-        videotracker::util::TimeValue oldest = videoTime;
+        videotracker::util::Timestamp oldest = videoTime;
         if (body.hasIMU()) {
             /// If the IMU has an older timestamp
             auto imuTimestamp = body.getIMU().getLastUpdate();
@@ -134,16 +147,14 @@ namespace uvbi {
     }
 
     void
-    TrackedBody::pruneHistory(videotracker::util::TimeValue const &videoTime) {
-#if 0
-        static ::util::Stride s(100);
-        if (++s) {
-            std::cout << "stateHistory High water mark: "
-                      << m_impl->stateHistory.highWaterMark() << std::endl;
-            std::cout << "imuMeasurements High water mark: "
-                      << m_impl->imuMeasurements.highWaterMark() << std::endl;
-        }
-#endif
+    TrackedBody::pruneHistory(videotracker::util::Timestamp const &videoTime) {
+        auto &metrics = getSystem().getMetrics();
+        metrics.raiseGauge(
+            MetricGauge::StateHistoryHighWaterMark,
+            static_cast<std::int64_t>(m_impl->stateHistory.highWaterMark()));
+        metrics.raiseGauge(
+            MetricGauge::ImuHistoryHighWaterMark,
+            static_cast<std::int64_t>(m_impl->imuMeasurements.highWaterMark()));
 
         if (m_impl->stateHistory.empty()) {
             // can't prune an empty structure
@@ -159,14 +170,17 @@ namespace uvbi {
             oldest = m_impl->stateHistory.newest_timestamp();
         }
 
+        /// Don't discard IMU measurements we've yet to replay.
+        replayIMU(std::numeric_limits<std::size_t>::max(), &oldest);
+
         m_impl->stateHistory.pop_before(oldest);
 
         m_impl->imuMeasurements.pop_before(oldest);
     }
 
     void TrackedBody::replaceStateSnapshot(
-        videotracker::util::TimeValue const &origTime,
-        videotracker::util::TimeValue const &newTime,
+        videotracker::util::Timestamp const &origTime,
+        videotracker::util::Timestamp const &newTime,
         BodyState const &newState) {
 #if !(defined(UVBI_ASSUME_SINGLE_CAMERA) &&                                    \
       defined(UVBI_ASSUME_CAMERA_ALWAYS_SLOWER))
@@ -186,13 +200,55 @@ namespace uvbi {
             pushState();
         }
 
-        /// Replay the IMU measurements timestamped later than our estimate
+        /// The IMU measurements timestamped later than our estimate need
+        /// replaying. If preintegrating, getStateAtOrBefore() ended the window
+        /// at the snapshot, so any open one now holds only newer measurements,
+        /// which the replay will add again. In lazy replay mode, that's left
+        /// until someone needs the state.
+        m_impl->preintegrator.clear();
+        m_impl->replayPending = true;
+        m_impl->replayedThrough = newTime;
+        if (!getParams().lazyReplay) {
+            finishPendingReplay();
+        }
+    }
+
+    bool TrackedBody::hasPendingReplay() const {
+        return m_impl->replayPending;
+    }
+
+    bool TrackedBody::replayPendingIMU(std::size_t maxMeasurements) {
+        return replayIMU(maxMeasurements, nullptr);
+    }
+
+    void TrackedBody::finishPendingReplay() {
+        replayIMU(std::numeric_limits<std::size_t>::max(), nullptr);
+    }
+
+    bool TrackedBody::replayIMU(std::size_t maxMeasurements,
+                                util::Timestamp const *through) {
+        if (!m_impl->replayPending) {
+            return true;
+        }
         auto numReplayed = std::size_t{0};
-        for (auto &imuHist :
-             m_impl->imuMeasurements.get_range_newer_than(newTime)) {
-            applyIMUMeasurement(imuHist.first, imuHist.second);
+        for (auto &imuHist : m_impl->imuMeasurements.get_range_newer_than(
+                 m_impl->replayedThrough)) {
+            auto const &tv = imuHist.first;
+            if (through && *through < tv) {
+                return false;
+            }
+            // Measurements sharing a timestamp go together, since we resume
+            // after the last timestamp replayed.
+            if (numReplayed >= maxMeasurements &&
+                !(numReplayed > 0 && tv == m_impl->replayedThrough)) {
+                return false;
+            }
+            useIMUMeasurement(tv, imuHist.second);
+            m_impl->replayedThrough = tv;
             ++numReplayed;
         }
+        m_impl->replayPending = false;
+        return true;
     }
 
     void TrackedBody::pushState() {
@@ -201,7 +257,7 @@ namespace uvbi {
     }
 
     void TrackedBody::incorporateNewMeasurementFromIMU(
-        util::TimeValue const &tv, CannedIMUMeasurement const &meas) {
+        util::Timestamp const &tv, CannedIMUMeasurement const &meas) {
         if (!getSystem().isRoomCalibrationComplete()) {
             /// If room calibration is incomplete, don't handle this locally. If
             /// it's an orientation, hand it to the tracking system to hand off
@@ -224,14 +280,16 @@ namespace uvbi {
         /// measurement.
         /// If we haven't yet got a pose from video, toss this or we'll end up
         /// getting NaNs.
-        if (hasEverHadPoseEstimate()) {
-            applyIMUMeasurement(tv, meas);
+        /// If we're behind on replaying, it'll be picked up from the history
+        /// when we catch up.
+        if (hasEverHadPoseEstimate() && !m_impl->replayPending) {
+            useIMUMeasurement(tv, meas);
         }
 
         m_impl->imuMeasurements.push_newest(tv, meas);
     }
 
-    void TrackedBody::applyIMUMeasurement(util::TimeValue const &tv,
+    void TrackedBody::applyIMUMeasurement(util::Timestamp const &tv,
                                           CannedIMUMeasurement const &meas) {
         // Only apply and push new stuff
         if (m_impl->stateHistory.is_valid_to_push_newest(tv)) {
@@ -239,6 +297,76 @@ namespace uvbi {
                             tv, meas);
             m_stateTime = tv;
             pushState();
+            getSystem().getMetrics().increment(
+                MetricCounter::ImuCorrections,
+                (meas.orientationValid() ? 1 : 0) +
+                    (meas.angVelValid() ? 1 : 0));
+        }
+    }
+
+    void TrackedBody::useIMUMeasurement(util::Timestamp const &tv,
+                                        CannedIMUMeasurement const &meas) {
+        if (isPreintegratingIMU()) {
+            preintegrateIMUMeasurement(tv, meas);
+        } else {
+            applyIMUMeasurement(tv, meas);
+        }
+    }
+
+    bool TrackedBody::isPreintegratingIMU() const {
+        return getParams().imu.preintegrationSeconds > 0;
+    }
+
+    void TrackedBody::preintegrateIMUMeasurement(
+        util::Timestamp const &tv, CannedIMUMeasurement const &meas) {
+        // Same test as applying it right away, and it can't be before the
+        // state it will be integrated from.
+        if (!m_impl->stateHistory.is_valid_to_push_newest(tv) ||
+            tv < m_stateTime) {
+            return;
+        }
+        auto &preintegrator = m_impl->preintegrator;
+        if (preintegrator.empty()) {
+            preintegrator.begin(m_stateTime);
+        }
+        preintegrator.add(tv, meas);
+        if (preintegrator.getSpan() >= getParams().imu.preintegrationSeconds) {
+            applyIMUMeasurement(preintegrator.getNewestTime(),
+                                preintegrator.getMeasurement());
+            preintegrator.clear();
+        }
+    }
+
+    void
+    TrackedBody::endPreintegrationWindowAt(util::Timestamp const &time) {
+        auto imuIt = m_impl->imuMeasurements.closest_not_newer(time);
+        auto stateIt = m_impl->stateHistory.closest_not_newer(time);
+        if (m_impl->imuMeasurements.end() == imuIt ||
+            m_impl->stateHistory.end() == stateIt ||
+            !(stateIt->first < imuIt->first)) {
+            /// The state at or before then has seen every measurement up to
+            /// then already.
+            return;
+        }
+        /// Those measurements are in a window ending later, or still open:
+        /// go back to the state before them and replay them into a window
+        /// ending at the newest of them.
+        auto const startTime = stateIt->first;
+        stateIt->second.restore(m_state);
+        m_stateTime = startTime;
+        m_impl->stateHistory.pop_after(startTime);
+        m_impl->preintegrator.clear();
+        m_impl->replayPending = true;
+        m_impl->replayedThrough = startTime;
+        replayIMU(std::numeric_limits<std::size_t>::max(), &time);
+        auto &preintegrator = m_impl->preintegrator;
+        if (!preintegrator.empty()) {
+            applyIMUMeasurement(preintegrator.getNewestTime(),
+                                preintegrator.getMeasurement());
+            preintegrator.clear();
+        }
+        if (!getParams().lazyReplay) {
+            finishPendingReplay();
         }
     }
 
@@ -46,7 +46,7 @@ namespace uvbi {
           m_useAngularVelocity(getParams().imu.useAngularVelocity),
           m_angularVelocityVariance(angularVelocityVariance) {}
     void
-    TrackedBodyIMU::updatePoseFromOrientation(util::TimeValue const &tv,
+    TrackedBodyIMU::updatePoseFromOrientation(util::Timestamp const &tv,
                                               Eigen::Quaterniond const &quat) {
         // Choose the equivalent quaternion to the input that makes the data
         // smooth with previous quaternions.
@@ -80,7 +80,7 @@ namespace uvbi {
         updatePoseFromMeasurement(tv, preprocessOrientation(tv, rawSmoothQuat));
     }
     void TrackedBodyIMU::updatePoseFromAngularVelocity(
-        util::TimeValue const &tv, Eigen::Quaterniond const &deltaquat,
+        util::Timestamp const &tv, Eigen::Quaterniond const &deltaquat,
         double dt) {
         if (!m_yawKnown) {
             // No calibration yet, and angular velocity isn't useful there.
@@ -120,7 +120,7 @@ namespace uvbi {
     }
 
     CannedIMUMeasurement
-    TrackedBodyIMU::preprocessOrientation(util::TimeValue const & /*tv*/,
+    TrackedBodyIMU::preprocessOrientation(util::Timestamp const & /*tv*/,
                                           Eigen::Quaterniond const &quat) {
 
         auto ret = CannedIMUMeasurement{};
@@ -132,7 +132,7 @@ namespace uvbi {
 
     /// Processes an angular velocity
     CannedIMUMeasurement TrackedBodyIMU::preprocessAngularVelocity(
-        util::TimeValue const & /*tv*/, Eigen::Quaterniond const &deltaquat,
+        util::Timestamp const & /*tv*/, Eigen::Quaterniond const &deltaquat,
         double dt) {
         Eigen::Vector3d rot =
             incRotToAngVelVec(transformRawIMUAngularVelocity(deltaquat), dt);
@@ -144,7 +144,7 @@ namespace uvbi {
     }
 
     bool TrackedBodyIMU::updatePoseFromMeasurement(
-        util::TimeValue const &tv, CannedIMUMeasurement const &meas) {
+        util::Timestamp const &tv, CannedIMUMeasurement const &meas) {
         if (!meas.orientationValid() && !meas.angVelValid()) {
             return false;
         }
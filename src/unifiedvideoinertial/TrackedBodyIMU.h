@@ -30,7 +30,7 @@
 
 // Library/third-party includes
 #include "unifiedvideoinertial/Angles.h"
-#include "unifiedvideoinertial/TimeValue.h"
+#include "unifiedvideoinertial/Timestamp.h"
 #include <Eigen/Core>
 #include <Eigen/Geometry>
 
@@ -53,20 +53,22 @@ namespace uvbi {
         TrackedBody const &getBody() const { return m_body; }
 
         /// Processes an orientation
-        void updatePoseFromOrientation(util::TimeValue const &tv,
+        void updatePoseFromOrientation(util::Timestamp const &tv,
                                        Eigen::Quaterniond const &quat);
 
         /// Processes an angular velocity
-        void updatePoseFromAngularVelocity(util::TimeValue const &tv,
+        void updatePoseFromAngularVelocity(util::Timestamp const &tv,
                                            Eigen::Quaterniond const &deltaquat,
                                            double dt);
 
         bool hasPoseEstimate() const { return m_hasOrientation; }
-        util::TimeValue const &getLastUpdate() const { return m_last; }
+        util::Timestamp const &getLastUpdate() const { return m_last; }
         /// This estimate incorporates the calibration yaw correction.
         Eigen::Quaterniond const &getPoseEstimate() const { return m_quat; }
 
         bool calibrationYawKnown() const { return m_yawKnown; }
+        /// Only meaningful if calibrationYawKnown().
+        Angle getCalibrationYaw() const { return m_yaw; }
         void setCalibrationYaw(Angle yaw) {
             using namespace Eigen;
             using namespace util;
@@ -93,7 +95,7 @@ namespace uvbi {
         /// spits out a "canned" measurement that can be stored and incorporated
         /// into state.
         CannedIMUMeasurement
-        preprocessAngularVelocity(util::TimeValue const &tv,
+        preprocessAngularVelocity(util::Timestamp const &tv,
                                   Eigen::Quaterniond const &deltaquat,
                                   double dt);
 
@@ -101,14 +103,14 @@ namespace uvbi {
         /// and spits out a "canned" measurement that can be stored and
         /// incorporated into state.
         CannedIMUMeasurement
-        preprocessOrientation(util::TimeValue const &tv,
+        preprocessOrientation(util::Timestamp const &tv,
                               Eigen::Quaterniond const &quat);
 
         /// Takes in timestamps and a canned measurement and passes it to the
         /// body to incorporate into state.
         /// @return false if you pass a completely invalid/empty canned
         /// measurement.
-        bool updatePoseFromMeasurement(util::TimeValue const &tv,
+        bool updatePoseFromMeasurement(util::Timestamp const &tv,
                                        CannedIMUMeasurement const &meas);
 
         ConfigParams const &getParams() const;
@@ -130,7 +132,7 @@ namespace uvbi {
         bool m_hasOrientation = false;
         /// measurement in room space (corrected for yaw)
         Eigen::Quaterniond m_quat;
-        util::TimeValue m_last;
+        util::Timestamp m_last;
     };
 } // namespace uvbi
 } // namespace videotracker
@@ -32,19 +32,28 @@
 #include "PoseEstimator_RANSAC.h"
 #include "PoseEstimator_RANSACKalman.h"
 #include "PoseEstimator_SCAATKalman.h"
+#include "TrackedBodyIMU.h"
 #include "unifiedvideoinertial/CSV.h"
 #include "unifiedvideoinertial/CSVCellGroup.h"
 #include "unifiedvideoinertial/TrackedBody.h"
+#include "unifiedvideoinertial/TrackingMetrics.h"
+#include "unifiedvideoinertial/TrackingSystem.h"
+#include "videotrackershared/ProjectPoint.h"
 #include "videotrackershared/cvToEigen.h"
 
 // Library/third-party includes
+#include "FlexKalman/FlexibleKalmanFilter.h"
 #include "unifiedvideoinertial/Stride.h"
 #include "videotrackershared/Assert.h"
 
 // Standard includes
 #include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
 
 #undef UVBI_DEBUG_ERROR_VARIANCE_WHEN_TRACKING_LOST
 #undef UVBI_DEBUG_ERROR_VARIANCE
@@ -140,11 +149,47 @@ namespace uvbi {
         std::size_t m_framesWithoutValidBeacons = 0;
     };
 
+    /// An LED's identification before a new measurement, so what the
+    /// measurement changed can be counted.
+    struct LedIdentification {
+        explicit LedIdentification(Led const &led)
+            : id(led.getID()), identified(led.identified()),
+              provisional(led.provisional()) {}
+        ZeroBasedBeaconId id;
+        bool identified;
+        bool provisional;
+    };
+
+    inline void countIdentificationChanges(TrackingMetrics &metrics,
+                                           LedIdentification const &before,
+                                           Led const &led) {
+        if (!before.identified && led.identified()) {
+            metrics.increment(MetricCounter::BeaconIdentifications);
+            metrics.increment(MetricCounter::BeaconIdentificationFrames,
+                              led.framesSeen());
+        }
+        if (before.provisional && !led.provisional() &&
+            led.getID() != before.id) {
+            metrics.increment(MetricCounter::ProvisionalBeaconIdsRefuted);
+        }
+    }
+
+    /// Whether a beacon has a blink pattern that can identify it, rather
+    /// than being disabled.
+    inline std::vector<bool>
+    getBeaconsWithPatterns(TargetSetupData const &setupData) {
+        std::vector<bool> ret;
+        for (auto &pat : setupData.patterns) {
+            ret.push_back(!pat.empty() &&
+                          pat.find_first_not_of("*.") == std::string::npos);
+        }
+        return ret;
+    }
+
     struct TrackedBodyTarget::Impl {
         Impl(ConfigParams const &params, BodyTargetInterface const &bodyIface)
-            : bodyInterface(bodyIface), kalmanEstimator(params),
-              ransacKalmanEstimator(params.softResetPositionVarianceScale,
-                                    params.softResetOrientationVariance),
+            : bodyInterface(bodyIface), ransacEstimator(params),
+              kalmanEstimator(params), ransacKalmanEstimator(params),
               permitKalman(params.permitKalman), softResets(params.softResets)
 
 #ifdef UVBI_DUMP_BLOB_CSV
@@ -155,8 +200,26 @@ namespace uvbi {
         }
         BodyTargetInterface bodyInterface;
         LedGroup leds;
+        /// LEDs of blobs that went away, for new blobs to reuse: splicing
+        /// them back into leds allocates nothing.
+        LedGroup retiredLeds;
         LedPtrList usableLeds;
         LedIdentifierPtr identifier;
+        /// Which beacons pose-assisted identification may hand out.
+        std::vector<bool> beaconHasPattern;
+        /// @name Per-frame working storage, kept to reuse its capacity
+        /// @{
+        AssignMeasurementsToLeds::Scratch assignmentScratch;
+        std::vector<Led *> identificationCandidates;
+        std::vector<bool> beaconTaken;
+        std::vector<std::size_t> projectedBeacons;
+        std::vector<cv::Point2f> projections;
+        std::vector<std::size_t> nearestBeacon;
+        std::vector<float> nearestBeaconDist;
+        std::vector<float> secondBeaconDist;
+        std::vector<float> nearestBlobDist;
+        std::vector<float> secondBlobDist;
+        /// @}
         RANSACPoseEstimator ransacEstimator;
         SCAATKalmanPoseEstimator kalmanEstimator;
         RANSACKalmanPoseEstimator ransacKalmanEstimator;
@@ -174,7 +237,7 @@ namespace uvbi {
         const bool softResets = false;
 
         bool hasPrev = false;
-        videotracker::util::TimeValue lastEstimate;
+        videotracker::util::Timestamp lastEstimate;
 
         /// Number of times we've lost or otherwise had to reset tracking, "soft
         /// resets" included.
@@ -271,6 +334,7 @@ namespace uvbi {
             std::unique_ptr<OsvrHdkLedIdentifier> identifier(
                 new OsvrHdkLedIdentifier(setupData.patterns));
             m_impl->identifier = std::move(identifier);
+            m_impl->beaconHasPattern = getBeaconsWithPatterns(setupData);
         }
         m_verifyInvariants();
     }
@@ -303,6 +367,36 @@ namespace uvbi {
         return m_beacons.at(i.value())->errorCovariance().diagonal();
     }
 
+    Eigen::Matrix3d TrackedBodyTarget::getBeaconAutocalibCovariance(
+        ZeroBasedBeaconId i) const {
+        VIDEOTRACKER_ASSERT(!i.empty());
+        VIDEOTRACKER_ASSERT_MSG(
+            i.value() < getNumBeacons(),
+            "Beacon ID must be less than number of beacons.");
+        return m_beacons.at(i.value())->errorCovariance();
+    }
+
+    Eigen::Vector3d
+    TrackedBodyTarget::getBeaconInitialPosition(ZeroBasedBeaconId i) const {
+        VIDEOTRACKER_ASSERT(!i.empty());
+        VIDEOTRACKER_ASSERT_MSG(
+            i.value() < getNumBeacons(),
+            "Beacon ID must be less than number of beacons.");
+        return m_origBeacons.at(i.value())->stateVector() + m_beaconOffset;
+    }
+
+    void TrackedBodyTarget::setBeaconAutocalib(
+        ZeroBasedBeaconId i, Eigen::Vector3d const &position,
+        Eigen::Matrix3d const &covariance) {
+        VIDEOTRACKER_ASSERT(!i.empty());
+        VIDEOTRACKER_ASSERT_MSG(
+            i.value() < getNumBeacons(),
+            "Beacon ID must be less than number of beacons.");
+        auto &beacon = *m_beacons.at(i.value());
+        beacon.setStateVector(position - m_beaconOffset);
+        beacon.setErrorCovariance(covariance);
+    }
+
     void TrackedBodyTarget::resetBeaconAutocalib() {
         m_beacons.clear();
         for (auto &beacon : m_origBeacons) {
@@ -312,9 +406,6 @@ namespace uvbi {
 
     std::size_t TrackedBodyTarget::processLedMeasurements(
         LedMeasurementVec const &undistortedLeds) {
-        // std::list<LedMeasurement> measurements{begin(undistortedLeds),
-        // end(undistortedLeds)};
-        auto measurements = LedMeasurementVec{undistortedLeds};
         const auto prevUsableLedCount = usableLeds().size();
         /// Clear the "usableLeds" that will be populated in a later step, if we
         /// get that far.
@@ -334,10 +425,12 @@ namespace uvbi {
 
         const auto prevLedCount = myLeds.size();
 
-        const auto numMeasurements = measurements.size();
+        const auto numMeasurements = undistortedLeds.size();
+        auto &metrics = getBody().getSystem().getMetrics();
 
         AssignMeasurementsToLeds assignment(myLeds, undistortedLeds,
-                                            m_numBeacons, blobMoveThreshold);
+                                            m_numBeacons, blobMoveThreshold,
+                                            m_impl->assignmentScratch);
 
         assignment.populateStructures();
         static const auto HEAP_PREFIX = "[ASSIGN HEAP] ";
@@ -360,7 +453,9 @@ namespace uvbi {
             auto ledAndMeasurement = assignment.getMatch();
             auto &led = ledAndMeasurement.first;
             auto &meas = ledAndMeasurement.second;
+            const LedIdentification before(led);
             led.addMeasurement(meas, blobsKeepIdentity);
+            countIdentificationChanges(metrics, before, led);
             if (handleOutOfRangeIds(led, m_numBeacons)) {
                 /// For some reason, filtering in that measurement caused an LED
                 /// object to go bad. The above function wiped the LED object,
@@ -399,14 +494,20 @@ namespace uvbi {
                 << "\tRemaining: " << assignment.size() << "\n";
         }
 
-        assignment.eraseUnclaimedLedObjects(verbose);
+        auto &retiredLeds = m_impl->retiredLeds;
+        assignment.retireUnclaimedLedObjects(retiredLeds, verbose);
 
         // If we have any blobs that have not been associated with an
         // LED, then we add a new LED for each of them.
         // std::cout << "Had " << Leds.size() << " LEDs, " <<
         // keyPoints.size() << " new ones available" << std::endl;
         assignment.forEachUnclaimedMeasurement([&](LedMeasurement const &meas) {
-            myLeds.emplace_back(m_impl->identifier.get(), meas);
+            if (retiredLeds.empty()) {
+                myLeds.emplace_back(m_impl->identifier.get(), meas);
+                return;
+            }
+            myLeds.splice(end(myLeds), retiredLeds, begin(retiredLeds));
+            myLeds.back().restart(m_impl->identifier.get(), meas);
         });
 
         /// Do the initial filtering of the LED group to just the identified
@@ -451,14 +552,155 @@ namespace uvbi {
         return assignment.numCompletedMatches();
     }
 
+    std::size_t
+    TrackedBodyTarget::identifyLedsFromPose(CameraParameters const &camParams,
+                                            util::Timestamp const &tv) {
+        if (!m_hasPoseEstimate ||
+            m_impl->trackingState != TargetTrackingState::Kalman) {
+            /// Without a pose we trust, the blink code is all we've got.
+            return 0;
+        }
+        using Id = ZeroBasedBeaconId;
+        const auto noData =
+            Id(Led::SENTINEL_NO_IDENTIFIER_OBJECT_OR_INSUFFICIENT_DATA);
+        /// Only blobs too new for their blink code get a provisional ID:
+        /// the others have been found not to be beacons, one way or another.
+        auto &candidates = m_impl->identificationCandidates;
+        auto &beaconTaken = m_impl->beaconTaken;
+        candidates.clear();
+        beaconTaken.assign(m_numBeacons, false);
+        for (auto &led : leds()) {
+            if (led.identified()) {
+                beaconTaken[asIndex(led.getID())] = true;
+            } else if (led.getID() == noData) {
+                candidates.push_back(&led);
+            }
+        }
+        if (candidates.empty()) {
+            return 0;
+        }
+
+        /// Predict the pose at the frame time, as the Kalman estimator
+        /// will.
+        auto &body = getBody();
+        util::Timestamp stateTime;
+        BodyState state;
+        if (!body.getStateAtOrBefore(tv, stateTime, state)) {
+            return 0;
+        }
+        if (stateTime != tv) {
+            flexkalman::predict(state, body.getProcessModel(),
+                                util::time::duration(tv, stateTime));
+            state.externalizeRotation();
+        }
+        const Eigen::Quaterniond rotation = state.getQuaternion();
+        const Eigen::Matrix3d rotate = rotation.toRotationMatrix();
+        const Eigen::Vector3d translation =
+            state.position() - computeTranslationCorrectionToBody(rotation);
+        const auto focalLength = camParams.focalLength();
+        const Eigen::Vector2d principalPoint = camParams.eiPrincipalPoint();
+
+        /// Project the beacons not already claimed that face the camera
+        /// closely enough for the estimator to use.
+        auto &beacons = m_impl->projectedBeacons;
+        auto &projections = m_impl->projections;
+        beacons.clear();
+        projections.clear();
+        for (std::size_t i = 0; i < m_numBeacons; ++i) {
+            if (beaconTaken[i] || !m_impl->beaconHasPattern[i]) {
+                continue;
+            }
+            auto zComponent =
+                (rotate * cvToVector(m_beaconEmissionDirection[i])).z();
+            if (zComponent > getParams().maxZComponent) {
+                continue;
+            }
+            Eigen::Vector3d beacon =
+                rotate * m_beacons[i]->stateVector() + translation;
+            if (beacon.z() <= 0) {
+                continue;
+            }
+            Eigen::Vector2d pt =
+                projectPoint(focalLength, principalPoint, beacon);
+            beacons.push_back(i);
+            projections.emplace_back(static_cast<float>(pt.x()),
+                                     static_cast<float>(pt.y()));
+        }
+        if (beacons.empty()) {
+            return 0;
+        }
+
+        /// For each blob, the nearest projection and the distance to the
+        /// next-nearest; for each projection, the nearest two blobs.
+        const auto inf = std::numeric_limits<float>::infinity();
+        const auto numCandidates = candidates.size();
+        const auto numBeacons = beacons.size();
+        auto &nearestBeacon = m_impl->nearestBeacon;
+        auto &nearestBeaconDist = m_impl->nearestBeaconDist;
+        auto &secondBeaconDist = m_impl->secondBeaconDist;
+        auto &nearestBlobDist = m_impl->nearestBlobDist;
+        auto &secondBlobDist = m_impl->secondBlobDist;
+        nearestBeacon.assign(numCandidates, 0);
+        nearestBeaconDist.assign(numCandidates, inf);
+        secondBeaconDist.assign(numCandidates, inf);
+        nearestBlobDist.assign(numBeacons, inf);
+        secondBlobDist.assign(numBeacons, inf);
+        for (std::size_t c = 0; c < numCandidates; ++c) {
+            auto loc = candidates[c]->getLocationForTracking();
+            for (std::size_t b = 0; b < numBeacons; ++b) {
+                auto dist = std::sqrt(sqDist(loc, projections[b]));
+                if (dist < nearestBeaconDist[c]) {
+                    secondBeaconDist[c] = nearestBeaconDist[c];
+                    nearestBeaconDist[c] = dist;
+                    nearestBeacon[c] = b;
+                } else if (dist < secondBeaconDist[c]) {
+                    secondBeaconDist[c] = dist;
+                }
+                if (dist < nearestBlobDist[b]) {
+                    secondBlobDist[b] = nearestBlobDist[b];
+                    nearestBlobDist[b] = dist;
+                } else if (dist < secondBlobDist[b]) {
+                    secondBlobDist[b] = dist;
+                }
+            }
+        }
+
+        /// Only hand out an ID when the blob and the beacon are each
+        /// clearly the other's nearest.
+        const auto maxDist = getParams().poseAssistedIdMaxDistance;
+        const auto ratio = getParams().poseAssistedIdAmbiguityRatio;
+        auto &metrics = body.getSystem().getMetrics();
+        std::size_t ret = 0;
+        for (std::size_t c = 0; c < numCandidates; ++c) {
+            auto b = nearestBeacon[c];
+            auto dist = nearestBeaconDist[c];
+            if (dist > maxDist || secondBeaconDist[c] <= ratio * dist ||
+                nearestBlobDist[b] != dist ||
+                secondBlobDist[b] <= ratio * dist) {
+                continue;
+            }
+            auto &led = *candidates[c];
+            const LedIdentification before(led);
+            led.setProvisionalId(
+                Id(static_cast<UnderlyingBeaconIdType>(beacons[b])));
+            countIdentificationChanges(metrics, before, led);
+            metrics.increment(MetricCounter::ProvisionalBeaconIds);
+            ++ret;
+        }
+        if (ret != 0) {
+            updateUsableLeds();
+        }
+        return ret;
+    }
+
     void TrackedBodyTarget::disableKalman() { m_impl->permitKalman = false; }
 
     void TrackedBodyTarget::permitKalman() { m_impl->permitKalman = true; }
 
     bool TrackedBodyTarget::updatePoseEstimateFromLeds(
         CameraParameters const &camParams,
-        videotracker::util::TimeValue const &tv, BodyState &bodyState,
-        videotracker::util::TimeValue const &startingTime,
+        videotracker::util::Timestamp const &tv, BodyState &bodyState,
+        videotracker::util::Timestamp const &startingTime,
         bool validStateAndTime) {
 
         /// Must pre/post correct the state by our offset :-/
@@ -541,16 +783,24 @@ namespace uvbi {
             break;
         }
 
+        /// Only the residuals of a body whose orientation comes from its IMU
+        /// say anything about the video timestamps relative to the IMU's.
+        ClockOffsetEstimator *clockOffset = nullptr;
+        if (getBody().hasIMU() && getBody().getIMU().calibrationYawKnown()) {
+            clockOffset = getBody().getSystem().getClockOffsetEstimator();
+        }
+
         /// main estimation dispatch
         auto params = EstimatorInOutParams{
             camParams, m_beacons, m_beaconMeasurementVariance, m_beaconFixed,
             m_beaconEmissionDirection, startingTime, bodyState,
             getBody().getProcessModel(), m_beaconDebugData,
             /*m_targetToBody*/
-            Eigen::Vector3d::Zero()};
+            Eigen::Vector3d::Zero(), clockOffset, validStateAndTime};
         switch (m_impl->trackingState) {
         case TargetTrackingState::RANSAC: {
-            m_hasPoseEstimate = m_impl->ransacEstimator(params, usableLeds());
+            m_hasPoseEstimate =
+                m_impl->ransacEstimator(params, usableLeds(), tv);
             m_impl->lastFrameAlgorithm = TargetTrackingState::RANSAC;
             break;
         }
@@ -565,8 +815,7 @@ namespace uvbi {
         case TargetTrackingState::RANSACWhenBlobDetected:
         case TargetTrackingState::EnteringKalman:
         case TargetTrackingState::Kalman: {
-            auto videoDt =
-                uvbiTimeValueDurationSeconds(&tv, &m_impl->lastEstimate);
+            auto videoDt = util::time::duration(tv, m_impl->lastEstimate);
             m_hasPoseEstimate =
                 m_impl->kalmanEstimator(params, usableLeds(), tv, videoDt);
             m_impl->lastFrameAlgorithm = TargetTrackingState::Kalman;
@@ -717,6 +966,8 @@ namespace uvbi {
               << std::endl;
 #endif
         m_impl->trackingResets++;
+        getBody().getSystem().getMetrics().increment(
+            MetricCounter::TrackingResets);
         // Zero out velocities if we're coming from Kalman.
         switch (m_impl->trackingState) {
         case TargetTrackingState::RANSACWhenBlobDetected:
@@ -736,6 +987,8 @@ namespace uvbi {
     void TrackedBodyTarget::enterRANSACKalmanMode() {
         /// Still counts as a reset.
         m_impl->trackingResets++;
+        getBody().getSystem().getMetrics().increment(
+            MetricCounter::TrackingResets);
 #if 0
         // Zero out velocities if we're coming from Kalman.
         switch (m_impl->trackingState) {
@@ -791,6 +1044,19 @@ namespace uvbi {
         return 0.0;
     }
 
+    void TrackedBodyTarget::restoreLeds(LedGroup const &leds) {
+        if (getParams().streamBeaconDebugInfo) {
+            for (auto &data : m_beaconDebugData) {
+                data.reset();
+            }
+        }
+        m_impl->leds = leds;
+        for (auto &led : m_impl->leds) {
+            led.setIdentifier(m_impl->identifier.get());
+        }
+        updateUsableLeds();
+    }
+
     LedGroup &TrackedBodyTarget::leds() { return m_impl->leds; }
 
     LedPtrList &TrackedBodyTarget::usableLeds() { return m_impl->usableLeds; }
@@ -805,7 +1071,7 @@ namespace uvbi {
             usable.push_back(&led);
         }
     }
-    videotracker::util::TimeValue const &
+    videotracker::util::Timestamp const &
     TrackedBodyTarget::getLastUpdate() const {
         return m_impl->lastEstimate;
     }
@@ -26,16 +26,21 @@
 #include "TrackerThread.h"
 #include "AdditionalReports.h"
 #include "ImageProcessingThread.h"
+#include "PoseSharedMemoryWriter.h"
 #include "ProcessIMUMessage.h"
+#include "ThreadScheduling.h"
 #include "TrackedBodyIMU.h"
+#include "WarmStart.h"
 #include "unifiedvideoinertial/SpaceTransformations.h"
 #include "unifiedvideoinertial/TrackedBody.h"
 #include "unifiedvideoinertial/TrackedBodyTarget.h"
+#include "unifiedvideoinertial/TrackingMetrics.h"
 
 // Library/third-party includes
 #include "EigenInterop.h"
 
 // Standard includes
+#include <algorithm>
 #include <future>
 #include <iostream>
 #include <type_traits>
@@ -56,7 +61,11 @@ namespace uvbi {
         : m_trackingSystem(trackingSystem), m_cam(imageSource),
           m_reportingVec(reportingVec), m_camParams(camParams),
           m_cameraUsecOffset(cameraUsecOffset), m_bufferImu(bufferImu),
-          m_debugData(debugData), m_imuMessages(IMU_MESSAGE_QUEUE_SIZE),
+          m_debugData(debugData),
+          m_measureJitter(
+              trackingSystem.getParams().measureSchedulingJitter),
+          m_deferredReports(trackingSystem),
+          m_imuMessages(IMU_MESSAGE_QUEUE_SIZE),
           m_debugDataMessages(32) {
         msg() << "Tracker thread object created." << std::endl;
     }
@@ -86,6 +95,8 @@ namespace uvbi {
         /// Initialize reporting vector, as far as we can.
         m_numBodies = m_trackingSystem.getNumBodies();
         setupReportingVectorProcessModels();
+        setupPoseSharedMemory();
+        restoreWarmStart();
 
         /// Launch the image proc thread in a waiting state.
 
@@ -93,6 +104,7 @@ namespace uvbi {
             m_trackingSystem, m_cam, *this, m_camParams, m_cameraUsecOffset};
         imageProcThreadObj_ = &imageProcThreadObj;
         m_imageThread = std::thread{[&] { imageProcThreadObj.threadAction(); }};
+        setupScheduling();
 
         msg() << "Tracker thread object entering its main execution loop."
               << std::endl;
@@ -105,6 +117,7 @@ namespace uvbi {
                 /// Call the doFrame() method to perform one video frame's worth
                 /// of processing.
                 doFrame();
+                saveWarmStart(false);
 
                 {
                     /// Copy the run flag.
@@ -125,7 +138,11 @@ namespace uvbi {
             m_run = false;
         }
 #endif
+        saveWarmStart(true);
         msg() << "Tracker thread object: functor exiting." << std::endl;
+        if (m_measureJitter) {
+            reportSchedulingJitter();
+        }
 
         if (!imageProcThreadObj.exiting()) {
             msg() << "Telling image processing thread to exit." << std::endl;
@@ -148,9 +165,12 @@ namespace uvbi {
                                         util::TimeValue const &tv,
                                         OSVR_OrientationReport const &report) {
         /// Main thread method!
-        if (!m_imuMessages.write(makeImuReport(imu, tv, report))) {
+        auto timestamp = util::time::fromApiTimeValue(tv);
+        if (!m_imuMessages.write(makeImuReport(imu, timestamp, report))) {
             // no room for IMU message!
             // msg() << "Dropped IMU orientation message!\n";
+            m_trackingSystem.getMetrics().increment(
+                MetricCounter::ImuQueueOverflows);
             return false;
         }
         m_messageCondVar.notify_one();
@@ -162,8 +182,11 @@ namespace uvbi {
                                    util::TimeValue const &tv,
                                    OSVR_AngularVelocityReport const &report) {
         /// Main thread method!
-        if (!m_imuMessages.write(makeImuReport(imu, tv, report))) {
+        auto timestamp = util::time::fromApiTimeValue(tv);
+        if (!m_imuMessages.write(makeImuReport(imu, timestamp, report))) {
             // no room for IMU message!
+            m_trackingSystem.getMetrics().increment(
+                MetricCounter::ImuQueueOverflows);
             return false;
         }
         m_messageCondVar.notify_one();
@@ -176,14 +199,15 @@ namespace uvbi {
 
     void
     TrackerThread::signalImageProcessingComplete(ImageOutputDataPtr &&imageData,
-                                                 cv::Mat const &frame,
                                                  cv::Mat const &frameGray) {
         m_imageData = std::move(imageData);
-        m_frame = frame;
         m_frameGray = frameGray;
         {
             std::lock_guard<std::mutex> lock{m_messageMutex};
             m_timeConsumingImageStepComplete = true;
+            if (m_measureJitter) {
+                m_imageStepCompleted = our_clock::now();
+            }
         }
         m_messageCondVar.notify_one();
     }
@@ -206,6 +230,8 @@ namespace uvbi {
             // Again failing without quitting, in hopes we get better luck
             // next time...
             warn() << "Camera grab failed." << std::endl;
+            m_trackingSystem.getMetrics().increment(
+                MetricCounter::DroppedFrames);
             return;
         }
         // When we triggered the grab was a good guess of the time
@@ -227,15 +253,28 @@ namespace uvbi {
             {
                 /// Wait for something to do (Completion of image, IMU reports)
                 std::unique_lock<std::mutex> lock(m_messageMutex);
-                m_messageCondVar.wait(lock, [&] {
+                auto haveMessage = [&] {
                     return m_timeConsumingImageStepComplete ||
                            !m_imuMessages.isEmpty();
-                });
+                };
+                if (m_replayWhenIdle && !haveMessage()) {
+                    /// Nothing else to do right now: catch up on replaying
+                    /// IMU reports after the last video update, a batch at a
+                    /// time so we're never far from checking again.
+                    lock.unlock();
+                    m_replayWhenIdle = replayPendingIMU();
+                    continue;
+                }
+                m_messageCondVar.wait(lock, haveMessage);
                 if (m_timeConsumingImageStepComplete) {
                     /// Set a flag to get us out of this innermost loop - we'll
                     /// finish up processing this frame and trigger another grab
                     /// before we look at more IMU data.
                     finishedImage = true;
+                    if (m_measureJitter) {
+                        m_trackerWakeupDelay =
+                            our_clock::now() - m_imageStepCompleted;
+                    }
                 }
                 // Otherwise we have some IMU reports to keep us busy in the
                 // meantime.
@@ -268,23 +307,28 @@ namespace uvbi {
                     // if it's time, send a report even if we haven't gotten a
                     // video frame with useful things in it yet.
                     if (shouldSendImuReport()) {
+                        deferReportsPendingReplay(imuIndices);
                         updateReportingVector(imuIndices);
                         imuIndices.clear();
                     }
-                } else {
-
+                } else if (!deferReportPendingReplay(id)) {
                     /// Immediately update the reporting vector for that body.
                     updateReportingVector(id);
                 }
             }
         } while (!finishedImage);
+        if (m_measureJitter) {
+            recordSchedulingJitter();
+        }
 
         // OK, once we get here, we know the timeConsumingImageStep is complete.
-        if (!m_frame.data || !m_frameGray.data) {
+        if (!m_frameGray.data) {
             // but it ended early due to error.
             warn() << "Camera retrieve appeared to fail: frames had null "
                       "pointers!"
                    << std::endl;
+            m_trackingSystem.getMetrics().increment(
+                MetricCounter::DroppedFrames);
             return;
         }
 
@@ -329,11 +373,48 @@ namespace uvbi {
             }
         }
 
+        deferReportsPendingReplay(sortedBodyIds);
         updateReportingVector(sortedBodyIds);
     }
 
+    void
+    TrackerThread::deferReportsPendingReplay(UpdatedBodyIndices &bodyIds) {
+        if (!m_trackingSystem.getParams().lazyReplay) {
+            return;
+        }
+        m_deferredReports.deferFrom(bodyIds);
+        m_replayWhenIdle = m_replayWhenIdle || !m_deferredReports.empty();
+    }
+
+    bool TrackerThread::deferReportPendingReplay(BodyId const bodyId) {
+        if (!m_trackingSystem.getParams().lazyReplay ||
+            !m_deferredReports.defer(bodyId)) {
+            return false;
+        }
+        m_replayWhenIdle = true;
+        return true;
+    }
+
+    bool TrackerThread::replayPendingIMU() {
+        auto batch = static_cast<std::size_t>(
+            std::max(m_trackingSystem.getParams().lazyReplayBatch, 1));
+        UpdatedBodyIndices caughtUp;
+        auto morePending = m_deferredReports.replayBatch(
+            batch, [&](BodyId const bodyId) { caughtUp.insert(bodyId); });
+        /// Nothing is left deferred once all are caught up: these are
+        /// reported now, or, if the room calibration isn't done yet, dropped
+        /// like any other report would be.
+        if (!caughtUp.empty()) {
+            updateReportingVector(caughtUp);
+        }
+        return morePending;
+    }
+
     std::pair<BodyId, ImuMessageCategory>
     TrackerThread::processIMUMessage(IMUMessage const &m) {
+        auto &metrics = m_trackingSystem.getMetrics();
+        ScopedStageTimer timer(metrics, MetricStage::ImuMessage);
+        metrics.increment(MetricCounter::ImuMessages);
         return videotracker::uvbi::processImuMessage(m);
     }
 
@@ -389,7 +470,8 @@ namespace uvbi {
             state.position() = m_trackingSystem.getCameraPose().translation();
             state.setQuaternion(
                 Quaterniond(m_trackingSystem.getCameraPose().rotation()));
-            getCamPoseReporting()->updateState(util::time::getNow(), state);
+            getCamPoseReporting()->updateState(util::time::getSteadyNow(),
+                                               state);
         }
     }
 
@@ -445,6 +527,163 @@ namespace uvbi {
         }
     }
 
+    void TrackerThread::setupPoseSharedMemory() {
+        auto const &params = m_trackingSystem.getParams();
+        if (params.poseSharedMemoryName.empty()) {
+            return;
+        }
+        m_poseShm = PoseSharedMemoryWriter::make(
+            params.poseSharedMemoryName, m_numBodies,
+            static_cast<std::size_t>(
+                std::max(params.poseSharedMemoryHistory, 1)));
+        if (!m_poseShm) {
+            warn() << "Could not create the shared memory region "
+                   << params.poseSharedMemoryName
+                   << " to publish poses to: continuing without it."
+                   << std::endl;
+            return;
+        }
+        msg() << "Publishing poses to shared memory region "
+              << params.poseSharedMemoryName << std::endl;
+    }
+
+    void TrackerThread::setupScheduling() {
+        auto const &params = m_trackingSystem.getParams();
+        if (params.lockMemory) {
+            if (lockProcessMemory()) {
+                msg() << "Locked memory." << std::endl;
+            } else {
+                warn() << "Could not lock memory." << std::endl;
+            }
+        }
+        for (auto const &failure :
+             applyToCurrentThread(getTrackerThreadScheduling(params))) {
+            warn() << failure << std::endl;
+        }
+        if (m_measureJitter) {
+            m_schedulingLog.open("scheduling.csv");
+            if (m_schedulingLog) {
+                m_schedulingLog
+                    << "frame,imageThreadWakeupUsec,trackerThreadWakeupUsec"
+                    << std::endl;
+            } else {
+                warn() << "Could not open scheduling jitter file!"
+                       << std::endl;
+            }
+        }
+    }
+
+    void TrackerThread::recordSchedulingJitter() {
+        m_trackingSystem.getMetrics().record(MetricStage::TrackerThreadWakeup,
+                                             m_trackerWakeupDelay);
+        ++m_jitterFrames;
+        if (m_schedulingLog) {
+            using usec = std::chrono::duration<double, std::micro>;
+            m_schedulingLog
+                << m_jitterFrames << ","
+                << usec(imageProcThreadObj_->getLastWakeupDelay()).count()
+                << "," << usec(m_trackerWakeupDelay).count() << "\n";
+        }
+    }
+
+    void TrackerThread::reportSchedulingJitter() {
+        auto snap = m_trackingSystem.getMetrics().snapshot();
+        msg() << "Scheduling delays over " << m_jitterFrames
+              << " frames, in microseconds (p50/p99/max):" << std::endl;
+        for (auto stage : {MetricStage::ImageThreadWakeup,
+                           MetricStage::TrackerThreadWakeup}) {
+            using usec = std::chrono::duration<double, std::micro>;
+            auto const &hist = snap.get(stage);
+            msg() << "  " << getMetricName(stage) << ": "
+                  << usec(hist.percentile(50)).count() << "/"
+                  << usec(hist.percentile(99)).count() << "/"
+                  << usec(hist.max()).count() << std::endl;
+        }
+    }
+
+    void TrackerThread::restoreWarmStart() {
+        auto const &params = m_trackingSystem.getParams();
+        if (params.warmStartFile.empty()) {
+            return;
+        }
+        auto snapshot = loadWarmStart(params.warmStartFile);
+        if (!snapshot) {
+            msg() << "No usable warm start file " << params.warmStartFile
+                  << ": starting from scratch." << std::endl;
+            return;
+        }
+        auto result = ::videotracker::uvbi::restoreWarmStart(
+            m_trackingSystem, m_camParams, *snapshot,
+            params.warmStartRoomCalibration);
+        if (!result.cameraMatched) {
+            msg() << "Warm start file " << params.warmStartFile
+                  << " is for a different camera: starting from scratch."
+                  << std::endl;
+            return;
+        }
+        auto &os = msg();
+        os << "Warm start: restored beacon autocalibration for "
+           << result.targetsRestored << " target(s)";
+        if (result.targetsMismatched > 0) {
+            os << " (" << result.targetsMismatched << " no longer matched)";
+        }
+        os << (result.roomCalibrationRestored
+                   ? ", and the room calibration."
+                   : ", but not the room calibration.")
+           << std::endl;
+    }
+
+    void TrackerThread::saveWarmStart(bool atExit) {
+        auto const &params = m_trackingSystem.getParams();
+        if (params.warmStartFile.empty()) {
+            return;
+        }
+        auto now = our_clock::now();
+        if (!atExit &&
+            (params.warmStartSaveInterval <= 0 || now < m_nextWarmStartSave)) {
+            return;
+        }
+        /// Nothing worth saving until then, and we wouldn't want to replace
+        /// a good file with it.
+        if (!m_trackingSystem.isRoomCalibrationComplete()) {
+            return;
+        }
+        if (m_warmStartSave.valid()) {
+            auto ready = m_warmStartSave.wait_for(std::chrono::seconds(0)) ==
+                         std::future_status::ready;
+            if (!atExit && !ready) {
+                /// Still writing the last one.
+                return;
+            }
+            if (!m_warmStartSave.get()) {
+                warn() << "Could not save the warm start file "
+                       << params.warmStartFile << std::endl;
+            }
+        }
+        m_nextWarmStartSave =
+            now + std::chrono::duration_cast<our_clock::duration>(
+                      std::chrono::duration<double>(
+                          params.warmStartSaveInterval));
+        /// Capturing is quick: only the writing is left to another thread.
+        auto snapshot = captureWarmStart(m_trackingSystem, m_camParams);
+        if (atExit) {
+            if (::videotracker::uvbi::saveWarmStart(params.warmStartFile,
+                                                    snapshot)) {
+                msg() << "Saved the warm start file " << params.warmStartFile
+                      << std::endl;
+            } else {
+                warn() << "Could not save the warm start file "
+                       << params.warmStartFile << std::endl;
+            }
+            return;
+        }
+        auto filename = params.warmStartFile;
+        m_warmStartSave =
+            std::async(std::launch::async, [filename, snapshot] {
+                return ::videotracker::uvbi::saveWarmStart(filename, snapshot);
+            });
+    }
+
     bool TrackerThread::setupReportingVectorRoomTransforms() {
         if (!m_trackingSystem.haveCameraPose()) {
             /// can't do this if we haven't got the transform yet...
@@ -509,8 +748,20 @@ namespace uvbi {
 
     void TrackerThread::updateReportingVector(BodyId const bodyId) {
         auto &body = m_trackingSystem.getBody(bodyId);
-        m_reportingVec[bodyId.value()]->updateState(body.getStateTime(),
-                                                    body.getState());
+        /// The report needs the state to be current.
+        body.finishPendingReplay();
+        m_deferredReports.erase(bodyId);
+        if (!m_reportingVec[bodyId.value()]->updateState(body.getStateTime(),
+                                                         body.getState())) {
+            m_trackingSystem.getMetrics().increment(
+                MetricCounter::ReportQueueOverflows);
+        }
+        /// Out-of-process readers get room-space poses only.
+        if (m_poseShm && m_setCameraPose) {
+            m_poseShm->publish(bodyId.value(), body.getStateTime(),
+                               body.getState(),
+                               m_trackingSystem.getCameraPose());
+        }
         if (m_debugData && bodyId == BodyId(0)) {
             DebugArray newDebugArray = {};
             auto &target = *body.getTarget(TargetId(0));
@@ -25,6 +25,7 @@
 #pragma once
 
 // Internal Includes
+#include "DeferredReports.h"
 #include "IMUMessage.h"
 #include "ThreadsafeBodyReporting.h"
 #include "unifiedvideoinertial/ImageSources/ImageSource.h"
@@ -44,8 +45,10 @@
 #include <chrono>
 #include <condition_variable>
 #include <cstdint>
+#include <fstream>
 #include <future>
 #include <iosfwd>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <thread>
@@ -69,6 +72,7 @@ namespace uvbi {
     using UpdatedBodyIndices = folly::sorted_vector_set<BodyId, BodyIdOrdering>;
 
     class ImageProcessingThread;
+    class PoseSharedMemoryWriter;
 
     class TrackerThread {
       public:
@@ -97,7 +101,9 @@ namespace uvbi {
         /// after the current frame.
         void triggerStop();
 
-        /// Submit an orientation report for an IMU
+        /// Submit an orientation report for an IMU, timestamped by the wall
+        /// clock as the C API does: it's moved into the tracker's time base
+        /// here.
         /// @return false if there is no room in the queue for the message
         bool submitIMUReport(TrackedBodyIMU &imu, util::TimeValue const &tv,
                              OSVR_OrientationReport const &report);
@@ -112,7 +118,6 @@ namespace uvbi {
         /// Call from image processing thread to signal completion of frame
         /// processing.
         void signalImageProcessingComplete(ImageOutputDataPtr &&imageData,
-                                           cv::Mat const &frame,
                                            cv::Mat const &frameGray);
 
       private:
@@ -129,6 +134,32 @@ namespace uvbi {
         /// known)
         void setupReportingVectorProcessModels();
 
+        /// Creates the shared memory region to publish poses to, if
+        /// configured. Call once m_numBodies is known.
+        void setupPoseSharedMemory();
+
+        /// Applies the configured scheduling to this thread, locks memory if
+        /// configured, and opens the scheduling jitter log if measuring.
+        /// Call once the image processing thread has started, so it doesn't
+        /// inherit this thread's placement.
+        void setupScheduling();
+
+        /// Records the scheduling delays of the frame just completed.
+        void recordSchedulingJitter();
+
+        /// Prints a summary of the scheduling delays measured.
+        void reportSchedulingJitter();
+
+        /// Restores beacon autocalibration, and room calibration if
+        /// ConfigParams::warmStartRoomCalibration is set, from the warm start
+        /// file, if configured and still applicable.
+        void restoreWarmStart();
+
+        /// Saves the warm start file, if configured and room calibration is
+        /// complete: in the background when the save interval is up, or, at
+        /// exit, right away.
+        void saveWarmStart(bool atExit);
+
         /// Should call only once room calibration is completed.
         bool setupReportingVectorRoomTransforms();
 
@@ -140,6 +171,24 @@ namespace uvbi {
         /// - just reports the single body.
         void updateReportingVector(BodyId const bodyId);
 
+        /// In lazy replay mode, takes the bodies still waiting on an IMU replay
+        /// out of bodyIds, to be reported once replayPendingIMU() gets them
+        /// caught up.
+        void deferReportsPendingReplay(UpdatedBodyIndices &bodyIds);
+
+        /// In lazy replay mode, holds back the report of a body still
+        /// waiting on an IMU replay in the same way.
+        ///
+        /// @return true if held back.
+        bool deferReportPendingReplay(BodyId const bodyId);
+
+        /// Replays a batch of IMU reports for each body that has some pending
+        /// after a video update. Deferred reports of bodies that catch up are
+        /// sent, or dropped if they can't be yet (no room calibration).
+        ///
+        /// @return true if there are more to replay.
+        bool replayPendingIMU();
+
         /// This function is responsible for triggering the image capture and
         /// processing asynchronously in a separate thread.
         void launchTimeConsumingImageStep();
@@ -173,6 +222,9 @@ namespace uvbi {
 
         const bool m_debugData = false;
 
+        /// Whether to measure scheduling delays.
+        const bool m_measureJitter = false;
+
         using our_clock = std::chrono::steady_clock;
 
         bool shouldSendImuReport() {
@@ -197,9 +249,38 @@ namespace uvbi {
 
         bool m_setCameraPose = false;
 
+        /// Publishes reported poses to shared memory, if configured.
+        std::unique_ptr<PoseSharedMemoryWriter> m_poseShm;
+
+        /// @name Scheduling jitter measurement
+        /// @{
+        /// When the image processing thread last signalled completion.
+        our_clock::time_point m_imageStepCompleted;
+        /// How long we took to notice.
+        std::chrono::nanoseconds m_trackerWakeupDelay{0};
+        /// Frames measured so far.
+        std::uint64_t m_jitterFrames = 0;
+        /// Output file the delays of each frame are logged to.
+        std::ofstream m_schedulingLog;
+        /// @}
+
+        /// @name Warm start
+        /// @{
+        our_clock::time_point m_nextWarmStartSave;
+        /// The save in progress, if any.
+        std::future<bool> m_warmStartSave;
+        /// @}
+
+        /// @name Lazy replay
+        /// @{
+        /// Bodies whose report is waiting on an IMU replay.
+        DeferredReports m_deferredReports;
+        /// Whether to replay IMU reports when there's nothing else to do.
+        bool m_replayWhenIdle = false;
+        /// @}
+
         /// @name Updated asynchronously by timeConsumingImageStep()
         /// @{
-        cv::Mat m_frame;
         cv::Mat m_frameGray;
         ImageOutputDataPtr m_imageData;
         /// @}
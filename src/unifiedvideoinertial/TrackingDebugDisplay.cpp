@@ -22,12 +22,15 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+
 // Internal Includes
 #include "unifiedvideoinertial/TrackingDebugDisplay.h"
 #include "LED.h"
 #include "TrackingSystem_Impl.h"
+#include "unifiedvideoinertial/LazyColorFrame.h"
 #include "unifiedvideoinertial/TrackedBody.h"
 #include "unifiedvideoinertial/TrackedBodyTarget.h"
+#include "unifiedvideoinertial/TrackingMetrics.h"
 #include "unifiedvideoinertial/TrackingSystem.h"
 #include "videotrackershared/CameraParameters.h"
 #include "videotrackershared/SBDBlobExtractor.h"
@@ -40,6 +43,7 @@
 
 // Standard includes
 #include <algorithm>
+#include <array>
 #include <iostream>
 #include <vector>
 
@@ -55,11 +59,44 @@ namespace uvbi {
     static const auto CVCOLOR_VIOLET = cv::Vec3b(127, 0, 255);
 
     static const auto DEBUG_WINDOW_NAME = "OSVR Tracker Debug Window";
-    static const auto DEBUG_FRAME_STRIDE = 11;
+
+    /// What the debug display needs to know about an LED to draw it.
+    struct LedSnapshot {
+        cv::Point2f location;
+        float diameter;
+        ZeroBasedBeaconId id;
+        bool identified;
+        bool usedLastFrame;
+    };
+
+    /// Everything the debug display draws for one frame, copied out of the
+    /// tracking system so it can be drawn later, on another thread.
+    struct DebugDisplaySnapshot {
+        DebugDisplayMode mode;
+        /// The image to draw on: owned by the snapshot.
+        LazyColorFrame image;
+        /// @name Body 0, target 0: the only one drawn.
+        /// @{
+        bool haveBody = false;
+        bool haveTarget = false;
+        bool hasPose = false;
+        std::vector<LedSnapshot> leds;
+        /// Reprojection of each beacon, by zero-based ID, if there's a pose.
+        std::vector<cv::Point2f> beaconReprojections;
+        /// Ends of the x, y and z axes of the target, if there's a pose.
+        std::array<cv::Point2f, 6> axisEnds;
+        /// @}
+    };
+
     TrackingDebugDisplay::TrackingDebugDisplay(ConfigParams const &params)
-        : m_enabled(params.debug), m_windowName(DEBUG_WINDOW_NAME),
-          m_debugStride(DEBUG_FRAME_STRIDE),
-          m_performingOptimization(params.performingOptimization) {
+        : m_enabled(params.debug), m_mode(DebugDisplayMode::Status),
+          m_windowName(DEBUG_WINDOW_NAME),
+          m_debugStride(static_cast<unsigned int>(
+              (std::max)(params.debugStride, 1))),
+          m_performingOptimization(params.performingOptimization),
+          m_async(params.debugAsync),
+          m_queueSize(static_cast<std::size_t>(
+              (std::max)(params.debugQueueSize, 1))) {
         if (!m_enabled) {
             return;
         }
@@ -82,6 +119,21 @@ namespace uvbi {
                    "continue operation)\n"
                 << std::endl;
         }
+        if (m_async) {
+            m_thread = std::thread([&] { displayThread(); });
+        }
+    }
+
+    TrackingDebugDisplay::~TrackingDebugDisplay() {
+        if (!m_thread.joinable()) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            m_stop = true;
+        }
+        m_queueCondVar.notify_one();
+        m_thread.join();
     }
 
     void TrackingDebugDisplay::showDebugImage(cv::Mat const &image,
@@ -92,14 +144,28 @@ namespace uvbi {
             m_displayedFrame = image;
         }
         cv::imshow(m_windowName, m_displayedFrame);
+        m_windowShown = true;
     }
 
     void TrackingDebugDisplay::quitDebug() {
         if (!m_enabled) {
             return;
         }
-        cv::destroyWindow(m_windowName);
         m_enabled = false;
+        if (m_async && std::this_thread::get_id() != m_thread.get_id()) {
+            /// The window belongs to the display thread: wake it up to close
+            /// it on its way out, now rather than at shutdown. Nothing queued
+            /// is going to be shown.
+            {
+                std::lock_guard<std::mutex> lock(m_queueMutex);
+                m_stop = true;
+                m_queue.clear();
+            }
+            m_queueCondVar.notify_one();
+            return;
+        }
+        cv::destroyWindow(m_windowName);
+        m_windowShown = false;
     }
 
     struct WindowCoordsPoint {
@@ -107,15 +173,6 @@ namespace uvbi {
         cv::Point2f point;
     };
 
-    inline WindowCoordsPoint invertLoc(cv::Mat const &image,
-                                       const cv::Point2f &loc) {
-
-        return USING_INVERTED_LED_POSITION
-                   ? WindowCoordsPoint{cv::Point2f(image.cols - loc.x,
-                                                   image.rows - loc.y)}
-                   : WindowCoordsPoint{loc};
-    }
-
     inline Eigen::Vector2d pointToEigenVec(const cv::Point2f &pt) {
         return Eigen::Vector2d(pt.x, pt.y);
     }
@@ -133,10 +190,9 @@ namespace uvbi {
 
             /// Utility function to draw a keypoint-sized circle on the image at
             /// the LED location.
-            void drawLedCircle(Led const &led, bool filled,
+            void drawLedCircle(LedSnapshot const &led, bool filled,
                                const cv::Vec3b &color) {
-                cv::circle(image_, led.getLocation(),
-                           led.getMeasurement().diameter / 2.,
+                cv::circle(image_, led.location, led.diameter / 2.,
                            cv::Scalar(color), filled ? -1 : 1);
             }
 
@@ -159,23 +215,14 @@ namespace uvbi {
                 drawLedLabel(id, toWindowCoords(location), color, size, offset);
             }
 
-            /// @overload
-            /// Takes an Eigen::Vector2d as the location, with optional offset.
-            void drawLedLabel(OneBasedBeaconId id, Eigen::Vector2d const &loc,
-                              const cv::Vec3b &color = CVCOLOR_GRAY,
-                              double size = 0.5,
-                              const cv::Point2f &offset = cv::Point2f(0, 0)) {
-                drawLedLabel(id, eigenVecToPoint(loc), color, size, offset);
-            }
-
             /// @overload
             /// Takes an LED directly, with optional offset.
-            void drawLedLabel(Led const &led,
+            void drawLedLabel(LedSnapshot const &led,
                               const cv::Vec3b &color = CVCOLOR_GRAY,
                               double size = 0.5,
                               const cv::Point2f &offset = cv::Point2f(0, 0)) {
-                drawLedLabel(led.getOneBasedID(),
-                             WindowCoordsPoint{led.getLocation()}, color, size,
+                drawLedLabel(makeOneBased(led.id),
+                             WindowCoordsPoint{led.location}, color, size,
                              offset);
             }
 
@@ -194,11 +241,6 @@ namespace uvbi {
                            : WindowCoordsPoint{loc};
             }
 
-            WindowCoordsPoint
-            vecToWindowCoords(Eigen::Vector2d const &loc) const {
-                return toWindowCoords(eigenVecToPoint(loc));
-            }
-
             cv::Mat &image() { return image_; }
 
           private:
@@ -233,21 +275,20 @@ namespace uvbi {
             Eigen::Vector2d m_pp;
         };
     } // namespace
-    inline void drawOriginAxes(Reprojection &reproject, DebugImage &dbgImg,
-                               double size = 0.02) {
-        auto drawLine = [&](Eigen::Vector3d const &axis,
-                            const cv::Vec3b &color) {
+    inline void drawOriginAxes(DebugDisplaySnapshot const &snap,
+                               DebugImage &dbgImg) {
+        auto drawLine = [&](std::size_t axis, const cv::Vec3b &color) {
             auto beginWindowPoint =
-                dbgImg.vecToWindowCoords(reproject(axis * 0.5 * size));
+                dbgImg.toWindowCoords(snap.axisEnds[axis * 2]);
             auto endWindowPoint =
-                dbgImg.vecToWindowCoords(reproject(axis * -0.5 * size));
+                dbgImg.toWindowCoords(snap.axisEnds[axis * 2 + 1]);
             cv::line(dbgImg.image(), beginWindowPoint.point,
                      endWindowPoint.point, cv::Scalar(color));
         };
 
-        drawLine(Eigen::Vector3d::UnitX(), CVCOLOR_RED);
-        drawLine(Eigen::Vector3d::UnitY(), CVCOLOR_GREEN);
-        drawLine(Eigen::Vector3d::UnitZ(), CVCOLOR_BLUE);
+        drawLine(0, CVCOLOR_RED);
+        drawLine(1, CVCOLOR_GREEN);
+        drawLine(2, CVCOLOR_BLUE);
     }
 
     inline Eigen::Vector2d
@@ -264,25 +305,95 @@ namespace uvbi {
 #endif
     }
 
-    cv::Mat TrackingDebugDisplay::createAnnotatedBlobImage(
-        TrackingSystem const &tracking, CameraParameters const &camParams,
-        cv::Mat const &blobImage) {
-        cv::Mat output;
-        blobImage.copyTo(output);
+    /// Copies the state of body 0, target 0 into the snapshot.
+    static void snapshotTarget(TrackingSystem const &tracking,
+                               CameraParameters const &camParams,
+                               DebugDisplaySnapshot &snap) {
+        /// @todo right now, just looks at body 0, target 0 - generalize
+        snap.haveBody = tracking.getNumBodies() != 0;
+        if (!snap.haveBody) {
+            return;
+        }
+        auto &body = tracking.getBody(BodyId{0});
+        auto targetPtr = body.getTarget(TargetId{0});
+        snap.haveTarget = targetPtr != nullptr;
+        if (!snap.haveTarget) {
+            return;
+        }
+        snap.leds.reserve(targetPtr->leds().size());
+        for (auto const &led : targetPtr->leds()) {
+            snap.leds.push_back(LedSnapshot{
+                led.getLocation(), led.getMeasurement().diameter, led.getID(),
+                led.identified(), led.wasUsedLastFrame()});
+        }
+        snap.hasPose = targetPtr->hasPoseEstimate();
+        if (!snap.hasPose) {
+            return;
+        }
+        Reprojection reproject{*targetPtr, camParams};
+        auto numBeacons = targetPtr->getNumBeacons();
+        snap.beaconReprojections.reserve(numBeacons);
+        for (UnderlyingBeaconIdType i = 0; i < numBeacons; ++i) {
+            snap.beaconReprojections.push_back(eigenVecToPoint(
+                getBeaconReprojection(reproject, *targetPtr,
+                                      ZeroBasedBeaconId(i))));
+        }
+        static const double axisSize = 0.02;
+        for (std::size_t axis = 0; axis < 3; ++axis) {
+            Eigen::Vector3d unit = Eigen::Vector3d::Unit(axis);
+            snap.axisEnds[axis * 2] =
+                eigenVecToPoint(reproject(unit * 0.5 * axisSize));
+            snap.axisEnds[axis * 2 + 1] =
+                eigenVecToPoint(reproject(unit * -0.5 * axisSize));
+        }
+    }
+
+    TrackingDebugDisplay::SnapshotPtr
+    TrackingDebugDisplay::takeSnapshot(TrackingSystem_Impl const &impl,
+                                       TrackingSystem const &tracking,
+                                       DebugDisplayMode mode) {
+        SnapshotPtr snap(new DebugDisplaySnapshot);
+        snap->mode = mode;
+        auto &blobEx = impl.blobExtractor;
+        /// Copy only the image this mode draws on, and only the tracking
+        /// state it needs: drawing, and any conversion to color, happen
+        /// later.
+        switch (mode) {
+        case DebugDisplayMode::InputImage:
+            snap->image = impl.frame.clone();
+            break;
+        case DebugDisplayMode::Thresholding:
+            snap->image = LazyColorFrame::fromColor(
+                blobEx->getDebugThresholdImage().clone());
+            break;
+        case DebugDisplayMode::Blobs:
+            snap->image = LazyColorFrame::fromColor(
+                blobEx->getDebugBlobImage().clone());
+            snapshotTarget(tracking, impl.camParams, *snap);
+            break;
+        case DebugDisplayMode::Status:
+        case DebugDisplayMode::StatusWithAllReprojections:
+            snap->image = impl.frame.clone();
+            snapshotTarget(tracking, impl.camParams, *snap);
+            break;
+        }
+        return snap;
+    }
+
+    cv::Mat
+    TrackingDebugDisplay::renderAnnotatedBlobImage(DebugDisplaySnapshot &snap) {
+        /// The snapshot owns its image, so we can draw right on it.
+        cv::Mat output = snap.image.get();
         DebugImage img(output);
-        if (tracking.getNumBodies() == 0) {
+        if (!snap.haveBody) {
             /// No bodies - just show blobs.
             img.drawStatusMessage(
                 "No tracked bodies registered, only showing detected blobs",
                 CVCOLOR_RED);
             return output;
         }
-        /// @todo right now, just looks at body 0, target 0 - generalize
-        auto &body = tracking.getBody(BodyId{0});
-
-        auto targetPtr = body.getTarget(TargetId{0});
 
-        if (!targetPtr) {
+        if (!snap.haveTarget) {
             /// No optical target 0 on this body, just show blobs.
             img.drawStatusMessage(
                 "No target registered on body 0, only showing detected blobs",
@@ -293,23 +404,18 @@ namespace uvbi {
         const auto textSize = 0.5;
 
         /// Label each of the blobs.
-        auto &leds = targetPtr->leds();
-        for (auto &led : leds) {
+        for (auto &led : snap.leds) {
             img.drawLedLabel(led, CVCOLOR_RED, textSize, labelOffset);
         }
 
-        if (targetPtr->hasPoseEstimate()) {
+        if (snap.hasPose) {
             /// Reproject the beacons.
-            Reprojection reproject{*targetPtr, camParams};
-
-            auto numBeacons = targetPtr->getNumBeacons();
-            using size_type = decltype(numBeacons);
-            for (size_type i = 0; i < numBeacons; ++i) {
+            auto numBeacons = snap.beaconReprojections.size();
+            for (std::size_t i = 0; i < numBeacons; ++i) {
                 auto beaconId = ZeroBasedBeaconId(i);
-                Eigen::Vector2d imagePoint =
-                    getBeaconReprojection(reproject, *targetPtr, beaconId);
-                img.drawLedLabel(makeOneBased(beaconId), imagePoint,
-                                 CVCOLOR_GREEN, textSize, labelOffset);
+                img.drawLedLabel(makeOneBased(beaconId),
+                                 snap.beaconReprojections[i], CVCOLOR_GREEN,
+                                 textSize, labelOffset);
             }
         } else {
             img.drawStatusMessage("No video tracker pose for this "
@@ -323,12 +429,20 @@ namespace uvbi {
     cv::Mat TrackingDebugDisplay::createStatusImage(
         TrackingSystem const &tracking, CameraParameters const &camParams,
         cv::Mat const &baseImage, bool reprojectUnseenBeacons) {
+        DebugDisplaySnapshot snap;
+        snapshotTarget(tracking, camParams, snap);
+        return renderStatusImage(snap, baseImage, reprojectUnseenBeacons);
+    }
+
+    cv::Mat TrackingDebugDisplay::renderStatusImage(
+        DebugDisplaySnapshot &snap, cv::Mat const &baseImage,
+        bool reprojectUnseenBeacons) {
         cv::Mat output;
 
         DebugImage img(output);
         baseImage.copyTo(output);
 
-        if (tracking.getNumBodies() == 0) {
+        if (!snap.haveBody) {
             /// No bodies - show a message and swit
             img.drawStatusMessage("No tracked bodies registered, "
                                   "showing raw input image - press "
@@ -336,12 +450,8 @@ namespace uvbi {
                                   CVCOLOR_RED);
             return output;
         }
-        /// @todo right now, just looks at body 0, target 0 - generalize
-        auto &body = tracking.getBody(BodyId{0});
-
-        auto targetPtr = body.getTarget(TargetId{0});
 
-        if (!targetPtr) {
+        if (!snap.haveTarget) {
             /// No optical target 0 on this body
             img.drawStatusMessage("No target registered on body 0, "
                                   "showing raw input image - press "
@@ -358,9 +468,6 @@ namespace uvbi {
         const auto baseBeaconLabelColor =
             m_performingOptimization ? CVCOLOR_WHITE : CVCOLOR_BLACK;
 
-        auto gotPose = targetPtr->hasPoseEstimate();
-        auto numBeacons = targetPtr->getNumBeacons();
-
         using BeaconIdContainer = std::vector<ZeroBasedBeaconId>;
 
         auto drawnBeaconIds = BeaconIdContainer{};
@@ -370,29 +477,28 @@ namespace uvbi {
 
         /// Unidentified blobs look the same whether or not we have a pose, so
         /// we make a little lambda here to avoid repeating ourselves too much.
-        auto drawUnidentifiedBlob = [&img](Led const &led) {
+        auto drawUnidentifiedBlob = [&img](LedSnapshot const &led) {
             /// Red empty circle for un-identified blob
             img.drawLedCircle(led, false, CVCOLOR_RED);
         };
 
-        if (gotPose) {
+        if (snap.hasPose) {
             /// We have a pose - so we'll reproject identified beacons.
-            Reprojection reproject{*targetPtr, camParams};
 
             /// Draw axes.
-            drawOriginAxes(reproject, img);
+            drawOriginAxes(snap, img);
 
-            for (auto const &led : targetPtr->leds()) {
-                if (led.identified()) {
+            for (auto const &led : snap.leds) {
+                if (led.identified) {
                     /// Identified, and we have a pose
 
-                    auto beaconId = led.getID();
+                    auto beaconId = led.id;
                     recordBeaconAsDrawn(beaconId);
 
                     // Color-code identified beacons based on
                     // whether or not we used their data.
                     auto color =
-                        led.wasUsedLastFrame() ? CVCOLOR_GREEN : CVCOLOR_YELLOW;
+                        led.usedLastFrame ? CVCOLOR_GREEN : CVCOLOR_YELLOW;
                     img.drawLedCircle(led, true, color);
 
                     /// Draw main label in black, then draw the reprojection in
@@ -403,12 +509,10 @@ namespace uvbi {
                     img.drawLedLabel(led, baseBeaconLabelColor, textSize);
 
                     /// label at reprojection
-                    Eigen::Vector2d imagePoint =
-                        getBeaconReprojection(reproject, *targetPtr, beaconId);
-                    auto windowPoint =
-                        WindowCoordsPoint{eigenVecToPoint(imagePoint)};
-                    img.drawLedLabel(makeOneBased(beaconId), imagePoint,
-                                     mainBeaconLabelColor, textSize);
+                    img.drawLedLabel(
+                        makeOneBased(beaconId),
+                        snap.beaconReprojections[beaconId.value()],
+                        mainBeaconLabelColor, textSize);
                 } else {
                     drawUnidentifiedBlob(led);
                 }
@@ -427,26 +531,23 @@ namespace uvbi {
                                               comparator);
                 };
                 /// Now, we must draw reprojections of the unseen beacons.
-                auto numBeacons = targetPtr->getNumBeacons();
-                for (UnderlyingBeaconIdType i = 0; i < numBeacons; ++i) {
+                auto numBeacons = snap.beaconReprojections.size();
+                for (std::size_t i = 0; i < numBeacons; ++i) {
                     auto beaconId = ZeroBasedBeaconId(i);
                     if (haveDrawnBeaconAlready(beaconId)) {
                         /// already drawn - so skip it.
                         continue;
                     }
                     /// label at reprojection
-                    Eigen::Vector2d imagePoint =
-                        getBeaconReprojection(reproject, *targetPtr, beaconId);
-                    auto windowPoint =
-                        WindowCoordsPoint{eigenVecToPoint(imagePoint)};
-                    img.drawLedLabel(makeOneBased(beaconId), imagePoint,
+                    img.drawLedLabel(makeOneBased(beaconId),
+                                     snap.beaconReprojections[i],
                                      CVCOLOR_VIOLET, textSize);
                 }
             }
         } else {
             /// If we don't have a pose...
-            for (auto const &led : targetPtr->leds()) {
-                if (led.identified()) {
+            for (auto const &led : snap.leds) {
+                if (led.identified) {
                     // If identified, but we don't have a pose, draw
                     // them as yellow outlines.
                     img.drawLedCircle(led, false, CVCOLOR_YELLOW);
@@ -460,8 +561,31 @@ namespace uvbi {
         return output;
     }
 
+    cv::Mat TrackingDebugDisplay::render(DebugDisplaySnapshot &snap) {
+        switch (snap.mode) {
+        case DebugDisplayMode::InputImage:
+        case DebugDisplayMode::Thresholding:
+            return snap.image.get();
+        case DebugDisplayMode::Blobs:
+            return renderAnnotatedBlobImage(snap);
+        case DebugDisplayMode::Status:
+            return renderStatusImage(snap, snap.image.get(), false);
+        case DebugDisplayMode::StatusWithAllReprojections:
+            return renderStatusImage(snap, snap.image.get(), true);
+        }
+        return cv::Mat{};
+    }
+
     void TrackingDebugDisplay::triggerDisplay(TrackingSystem &tracking,
                                               TrackingSystem_Impl const &impl) {
+        if (m_toggleIMURequested.exchange(false)) {
+            /// Requested by a key press, but only safe to act on here.
+            /// @todo TEMPORARY DEBUGGING CODE - REMOVE!
+            auto newState = !tracking.getParams().imu.useOrientation;
+            msg() << "Toggling orientation usage to " << std::boolalpha
+                  << newState << std::endl;
+            tracking.setUseIMU(newState);
+        }
         if (!m_enabled) {
             /// We're not displaying things.
             return;
@@ -472,31 +596,32 @@ namespace uvbi {
             /// not our turn.
             return;
         }
-        auto &blobEx = impl.blobExtractor;
-        /// Update the display
-        switch (m_mode) {
-        case DebugDisplayMode::InputImage:
-            showDebugImage(impl.frame);
-            break;
-        case DebugDisplayMode::Thresholding:
-            showDebugImage(blobEx->getDebugThresholdImage());
-            break;
-        case DebugDisplayMode::Blobs:
-            showDebugImage(
-                createAnnotatedBlobImage(tracking, impl.camParams,
-                                         blobEx->getDebugBlobImage()),
-                false);
-            break;
-        case DebugDisplayMode::Status:
-            showDebugImage(
-                createStatusImage(tracking, impl.camParams, impl.frame), false);
-            break;
-        case DebugDisplayMode::StatusWithAllReprojections:
-            showDebugImage(
-                createStatusImage(tracking, impl.camParams, impl.frame, true),
-                false);
-            break;
+        auto snap = takeSnapshot(impl, tracking, m_mode);
+        if (!m_async) {
+            display(*snap);
+            return;
         }
+        bool dropped = false;
+        {
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            if (m_queue.size() >= m_queueSize) {
+                /// The display thread is behind: the newest frame is the one
+                /// worth showing.
+                m_queue.pop_front();
+                dropped = true;
+            }
+            m_queue.push_back(std::move(snap));
+        }
+        m_queueCondVar.notify_one();
+        if (dropped) {
+            tracking.getMetrics().increment(
+                MetricCounter::DebugFramesDropped);
+        }
+    }
+
+    void TrackingDebugDisplay::display(DebugDisplaySnapshot &snap) {
+        /// Update the display: the rendered image is ours, no need to copy.
+        showDebugImage(render(snap), false);
 
         /// Run the event loop briefly to see if there were keyboard presses.
         int key = cv::waitKey(1) & 0xff;
@@ -505,7 +630,32 @@ namespace uvbi {
             // optimizer.
             return;
         }
+        handleKey(key);
+    }
 
+    void TrackingDebugDisplay::displayThread() {
+        while (true) {
+            SnapshotPtr snap;
+            {
+                std::unique_lock<std::mutex> lock(m_queueMutex);
+                m_queueCondVar.wait(
+                    lock, [&] { return m_stop || !m_queue.empty(); });
+                if (m_stop) {
+                    break;
+                }
+                snap = std::move(m_queue.front());
+                m_queue.pop_front();
+            }
+            if (m_enabled) {
+                display(*snap);
+            }
+        }
+        if (m_windowShown) {
+            cv::destroyWindow(m_windowName);
+        }
+    }
+
+    void TrackingDebugDisplay::handleKey(int key) {
         switch (key) {
 
         case 's':
@@ -561,15 +711,10 @@ namespace uvbi {
 
         case 'o':
         case 'O':
-            // toggle orientation from IMU
+            // toggle orientation from IMU, next time the tracker calls us.
             /// @todo TEMPORARY DEBUGGING CODE - REMOVE!
-            {
-                auto newState = !tracking.getParams().imu.useOrientation;
-                msg() << "Toggling orientation usage to " << std::boolalpha
-                      << newState << std::endl;
-                tracking.setUseIMU(newState);
-                break;
-            }
+            m_toggleIMURequested = true;
+            break;
         default:
             // something else or nothing at all, no worries.
             break;
@@ -0,0 +1,322 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "unifiedvideoinertial/TrackingMetrics.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace videotracker {
+namespace uvbi {
+    const char *getMetricName(MetricStage stage) {
+        switch (stage) {
+        case MetricStage::ImageRetrieve:
+            return "imageRetrieve";
+        case MetricStage::BlobExtraction:
+            return "blobExtraction";
+        case MetricStage::BlobDetection:
+            return "blobDetection";
+        case MetricStage::LedUpdate:
+            return "ledUpdate";
+        case MetricStage::PoseEstimation:
+            return "poseEstimation";
+        case MetricStage::DebugDisplay:
+            return "debugDisplay";
+        case MetricStage::VideoUpdate:
+            return "videoUpdate";
+        case MetricStage::FrameLatency:
+            return "frameLatency";
+        case MetricStage::ImuMessage:
+            return "imuMessage";
+        case MetricStage::ImageThreadWakeup:
+            return "imageThreadWakeup";
+        case MetricStage::TrackerThreadWakeup:
+            return "trackerThreadWakeup";
+        }
+        return "unknown";
+    }
+
+    const char *getMetricName(MetricCounter counter) {
+        switch (counter) {
+        case MetricCounter::Frames:
+            return "frames";
+        case MetricCounter::DroppedFrames:
+            return "droppedFrames";
+        case MetricCounter::TrackingResets:
+            return "trackingResets";
+        case MetricCounter::ImuMessages:
+            return "imuMessages";
+        case MetricCounter::ImuQueueOverflows:
+            return "imuQueueOverflows";
+        case MetricCounter::ImuCorrections:
+            return "imuCorrections";
+        case MetricCounter::ReportQueueOverflows:
+            return "reportQueueOverflows";
+        case MetricCounter::DebugFramesDropped:
+            return "debugFramesDropped";
+        case MetricCounter::BeaconIdentifications:
+            return "beaconIdentifications";
+        case MetricCounter::BeaconIdentificationFrames:
+            return "beaconIdentificationFrames";
+        case MetricCounter::ProvisionalBeaconIds:
+            return "provisionalBeaconIds";
+        case MetricCounter::ProvisionalBeaconIdsRefuted:
+            return "provisionalBeaconIdsRefuted";
+        }
+        return "unknown";
+    }
+
+    const char *getMetricName(MetricGauge gauge) {
+        switch (gauge) {
+        case MetricGauge::StateHistoryHighWaterMark:
+            return "stateHistoryHighWaterMark";
+        case MetricGauge::ImuHistoryHighWaterMark:
+            return "imuHistoryHighWaterMark";
+        case MetricGauge::LedMeasurements:
+            return "ledMeasurements";
+        case MetricGauge::BodiesUpdated:
+            return "bodiesUpdated";
+        case MetricGauge::CameraClockCorrection:
+            return "cameraClockCorrectionMicroseconds";
+        case MetricGauge::CameraClockSkew:
+            return "cameraClockSkewPartsPerBillion";
+        }
+        return "unknown";
+    }
+
+    const std::size_t LatencyHistogramSnapshot::SubBucketBits;
+    const std::size_t LatencyHistogramSnapshot::SubBucketCount;
+    const std::size_t LatencyHistogramSnapshot::BucketCount;
+
+    /// Index of the most significant set bit: value must be non-zero.
+    static inline std::size_t highestBit(std::uint64_t value) {
+        std::size_t ret = 0;
+        for (std::size_t shift = 32; shift > 0; shift /= 2) {
+            if (value >> shift) {
+                value >>= shift;
+                ret += shift;
+            }
+        }
+        return ret;
+    }
+
+    std::size_t LatencyHistogramSnapshot::bucketIndex(std::uint64_t value) {
+        if (value < SubBucketCount) {
+            // Small values are recorded exactly.
+            return static_cast<std::size_t>(value);
+        }
+        auto shift = highestBit(value) - SubBucketBits;
+        auto sub = static_cast<std::size_t>(value >> shift) &
+                   (SubBucketCount - 1);
+        return (shift + 1) * SubBucketCount + sub;
+    }
+
+    std::uint64_t
+    LatencyHistogramSnapshot::bucketLowerBound(std::size_t index) {
+        if (index < SubBucketCount) {
+            return index;
+        }
+        auto shift = index / SubBucketCount - 1;
+        auto sub = index % SubBucketCount;
+        return std::uint64_t(SubBucketCount + sub) << shift;
+    }
+
+    std::uint64_t
+    LatencyHistogramSnapshot::bucketUpperBound(std::size_t index) {
+        if (index < SubBucketCount) {
+            return index;
+        }
+        auto shift = index / SubBucketCount - 1;
+        return bucketLowerBound(index) + ((std::uint64_t(1) << shift) - 1);
+    }
+
+    std::chrono::nanoseconds LatencyHistogramSnapshot::mean() const {
+        if (empty()) {
+            return std::chrono::nanoseconds::zero();
+        }
+        return std::chrono::nanoseconds(m_sum / m_count);
+    }
+
+    std::chrono::nanoseconds
+    LatencyHistogramSnapshot::percentile(double pct) const {
+        if (empty()) {
+            return std::chrono::nanoseconds::zero();
+        }
+        pct = (std::min)(100., (std::max)(0., pct));
+        auto rank = static_cast<std::uint64_t>(
+            std::ceil(pct / 100. * static_cast<double>(m_count)));
+        rank = (std::max)(rank, std::uint64_t(1));
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < BucketCount; ++i) {
+            seen += m_buckets[i];
+            if (seen >= rank) {
+                return std::chrono::nanoseconds(
+                    (std::min)(bucketUpperBound(i), m_max));
+            }
+        }
+        return max();
+    }
+
+    LatencyHistogram::LatencyHistogram() { reset(); }
+
+    void LatencyHistogram::record(std::chrono::nanoseconds duration) {
+        auto value = static_cast<std::uint64_t>(
+            (std::max)(duration.count(), std::chrono::nanoseconds::rep(0)));
+        auto idx = LatencyHistogramSnapshot::bucketIndex(value);
+        m_buckets[idx].fetch_add(1, std::memory_order_relaxed);
+        m_sum.fetch_add(value, std::memory_order_relaxed);
+        auto prevMax = m_max.load(std::memory_order_relaxed);
+        while (prevMax < value &&
+               !m_max.compare_exchange_weak(prevMax, value,
+                                            std::memory_order_relaxed)) {
+        }
+    }
+
+    LatencyHistogramSnapshot LatencyHistogram::snapshot() const {
+        LatencyHistogramSnapshot ret;
+        /// The count is taken from the buckets actually copied, so percentile
+        /// ranks stay consistent even when recordings race with the copy.
+        std::uint64_t bucketTotal = 0;
+        for (std::size_t i = 0; i < ret.m_buckets.size(); ++i) {
+            ret.m_buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+            bucketTotal += ret.m_buckets[i];
+        }
+        ret.m_count = bucketTotal;
+        ret.m_sum = m_sum.load(std::memory_order_relaxed);
+        ret.m_max = m_max.load(std::memory_order_relaxed);
+        return ret;
+    }
+
+    void LatencyHistogram::reset() {
+        for (auto &bucket : m_buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        m_sum.store(0, std::memory_order_relaxed);
+        m_max.store(0, std::memory_order_relaxed);
+    }
+
+    void TrackingMetrics::raiseGauge(MetricGauge gauge, std::int64_t value) {
+        auto &g = m_gauges[static_cast<std::size_t>(gauge)];
+        auto prev = g.load(std::memory_order_relaxed);
+        while (prev < value &&
+               !g.compare_exchange_weak(prev, value,
+                                        std::memory_order_relaxed)) {
+        }
+    }
+
+    void TrackingMetrics::recordAllocations(MetricStage stage,
+                                            AllocationCount const &count) {
+        auto &allocs = m_allocations[static_cast<std::size_t>(stage)];
+        allocs.scopes.fetch_add(1, std::memory_order_relaxed);
+        allocs.allocations.fetch_add(count.allocations,
+                                     std::memory_order_relaxed);
+        allocs.bytes.fetch_add(count.bytes, std::memory_order_relaxed);
+    }
+
+    TrackingMetricsSnapshot TrackingMetrics::snapshot() const {
+        TrackingMetricsSnapshot ret;
+        for (std::size_t i = 0; i < NumMetricStages; ++i) {
+            ret.stages[i] = m_stages[i].snapshot();
+            auto const &allocs = m_allocations[i];
+            auto &dest = ret.allocations[i];
+            dest.scopes = allocs.scopes.load(std::memory_order_relaxed);
+            dest.total.allocations =
+                allocs.allocations.load(std::memory_order_relaxed);
+            dest.total.bytes = allocs.bytes.load(std::memory_order_relaxed);
+        }
+        for (std::size_t i = 0; i < NumMetricCounters; ++i) {
+            ret.counters[i] = m_counters[i].load(std::memory_order_relaxed);
+        }
+        for (std::size_t i = 0; i < NumMetricGauges; ++i) {
+            ret.gauges[i] = m_gauges[i].load(std::memory_order_relaxed);
+        }
+        return ret;
+    }
+
+    void TrackingMetrics::reset() {
+        for (auto &stage : m_stages) {
+            stage.reset();
+        }
+        for (auto &allocs : m_allocations) {
+            allocs.scopes.store(0, std::memory_order_relaxed);
+            allocs.allocations.store(0, std::memory_order_relaxed);
+            allocs.bytes.store(0, std::memory_order_relaxed);
+        }
+        for (auto &counter : m_counters) {
+            counter.store(0, std::memory_order_relaxed);
+        }
+        for (auto &gauge : m_gauges) {
+            gauge.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    static inline double toMicroseconds(std::chrono::nanoseconds ns) {
+        return std::chrono::duration<double, std::micro>(ns).count();
+    }
+
+    static inline double perUnit(std::uint64_t total, std::uint64_t units) {
+        return units == 0 ? 0. : static_cast<double>(total) / units;
+    }
+
+    std::ostream &operator<<(std::ostream &os,
+                             TrackingMetricsSnapshot const &snap) {
+        for (std::size_t i = 0; i < NumMetricStages; ++i) {
+            auto const &hist = snap.stages[i];
+            os << getMetricName(static_cast<MetricStage>(i))
+               << "_us: count=" << hist.count()
+               << " mean=" << toMicroseconds(hist.mean())
+               << " p50=" << toMicroseconds(hist.percentile(50))
+               << " p90=" << toMicroseconds(hist.percentile(90))
+               << " p99=" << toMicroseconds(hist.percentile(99))
+               << " max=" << toMicroseconds(hist.max()) << "\n";
+        }
+        auto frames = snap.get(MetricCounter::Frames);
+        for (std::size_t i = 0; i < NumMetricStages; ++i) {
+            auto const &allocs = snap.allocations[i];
+            if (allocs.scopes == 0) {
+                continue;
+            }
+            auto const &total = allocs.total;
+            os << getMetricName(static_cast<MetricStage>(i))
+               << "_allocs: scopes=" << allocs.scopes
+               << " total=" << total.allocations << " bytes=" << total.bytes
+               << " perScope=" << perUnit(total.allocations, allocs.scopes)
+               << " bytesPerScope=" << perUnit(total.bytes, allocs.scopes)
+               << " perFrame=" << perUnit(total.allocations, frames)
+               << " bytesPerFrame=" << perUnit(total.bytes, frames) << "\n";
+        }
+        for (std::size_t i = 0; i < NumMetricCounters; ++i) {
+            os << getMetricName(static_cast<MetricCounter>(i)) << ": "
+               << snap.counters[i] << "\n";
+        }
+        for (std::size_t i = 0; i < NumMetricGauges; ++i) {
+            os << getMetricName(static_cast<MetricGauge>(i)) << ": "
+               << snap.gauges[i] << "\n";
+        }
+        return os;
+    }
+} // namespace uvbi
+} // namespace videotracker
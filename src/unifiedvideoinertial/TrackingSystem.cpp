@@ -25,10 +25,12 @@
 // Internal Includes
 #include "unifiedvideoinertial/TrackingSystem.h"
 #include "ForEachTracked.h"
+#include "LED.h"
 #include "RoomCalibration.h"
 #include "TrackingSystem_Impl.h"
 #include "unifiedvideoinertial/TrackedBody.h"
 #include "unifiedvideoinertial/TrackedBodyTarget.h"
+#include "unifiedvideoinertial/TrackingMetrics.h"
 #include "videotrackershared/SBDBlobExtractor.h"
 #include "videotrackershared/UndistortMeasurements.h"
 
@@ -39,10 +41,12 @@
 
 // Standard includes
 #include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <iterator>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 static const auto ROOM_CALIBRATION_SKIP_BRIGHTS_CUTOFF = 4;
 static const auto CALIBRATION_RANSAC_ITERATIONS = 8;
@@ -50,6 +54,45 @@ static const auto CALIBRATION_RANSAC_ITERATIONS = 8;
 namespace videotracker {
 namespace uvbi {
 
+    /// One frame of a LedStateRecording.
+    struct RecordedLedFrame {
+        /// Each target's LEDs after the second phase, in forEachTarget()
+        /// order.
+        std::vector<LedGroup> leds;
+        LedUpdateCount updateCount;
+        /// The IDs of every target's LEDs after the third phase, in the same
+        /// order. Refuting identifications is the only change pose estimation
+        /// makes to the LEDs that the next frame's second phase reads, so
+        /// these are enough to tell whether a replay has parted ways with the
+        /// recorded run.
+        std::vector<ZeroBasedBeaconId> idsAfterPoseEstimation;
+    };
+
+    struct LedStateRecording::Impl {
+        std::vector<RecordedLedFrame> frames;
+    };
+
+    LedStateRecording::LedStateRecording() : m_impl(new Impl) {}
+
+    LedStateRecording::~LedStateRecording() = default;
+
+    std::size_t LedStateRecording::size() const {
+        return m_impl->frames.size();
+    }
+
+    void LedStateRecording::clear() { m_impl->frames.clear(); }
+
+    static std::vector<ZeroBasedBeaconId>
+    getLedIds(TrackingSystem const &sys) {
+        std::vector<ZeroBasedBeaconId> ret;
+        forEachTarget(sys, [&](TrackedBodyTarget const &target) {
+            for (auto &led : target.leds()) {
+                ret.push_back(led.getID());
+            }
+        });
+        return ret;
+    }
+
     TrackingSystem::TrackingSystem(ConfigParams const &params)
         : m_params(params), m_impl(new TrackingSystem_Impl(params)) {}
 
@@ -71,23 +114,48 @@ namespace uvbi {
         return getBody(target.first).getTarget(target.second);
     }
 
+    TrackingMetrics &TrackingSystem::getMetrics() { return m_impl->metrics; }
+
+    TrackingMetrics const &TrackingSystem::getMetrics() const {
+        return m_impl->metrics;
+    }
+
+    ClockOffsetEstimator *TrackingSystem::getClockOffsetEstimator() {
+        if (!m_params.estimateCameraClockOffset) {
+            return nullptr;
+        }
+        return &m_impl->clockOffset;
+    }
+
     ImageOutputDataPtr TrackingSystem::performInitialImageProcessing(
-        util::TimeValue const &tv, cv::Mat const &frame,
-        cv::Mat const &frameGray, CameraParameters const &camParams) {
+        util::Timestamp const &tv, cv::Mat const &frameGray,
+        CameraParameters const &camParams) {
+        ScopedStageTimer timer(m_impl->metrics, MetricStage::BlobExtraction);
 
-        ImageOutputDataPtr ret(new ImageProcessingOutput);
+        /// Recycled from a retired frame, if there is one, so everything
+        /// below fills in storage that has already been allocated.
+        auto ret = m_impl->outputPool->acquire();
         ret->tv = tv;
-        ret->frame = frame;
+        ret->frame = LazyColorFrame{frameGray};
         ret->frameGray = frameGray;
-        ret->camParams = camParams.createUndistortedVariant();
-        auto rawMeasurements =
-            m_impl->blobExtractor->extractBlobs(ret->frameGray);
-        ret->ledMeasurements = undistortLeds(rawMeasurements, camParams);
+        ret->camParams.assignUndistortedVariant(camParams);
+        LedMeasurementVec const *rawMeasurements = nullptr;
+        {
+            ScopedStageTimer detection(m_impl->metrics,
+                                       MetricStage::BlobDetection);
+            rawMeasurements =
+                &m_impl->blobExtractor->extractBlobs(ret->frameGray);
+        }
+        undistortLeds(*rawMeasurements, camParams, ret->ledMeasurements);
+        m_impl->metrics.setGauge(
+            MetricGauge::LedMeasurements,
+            static_cast<std::int64_t>(ret->ledMeasurements.size()));
         return ret;
     }
 
     LedUpdateCount const &
     TrackingSystem::updateLedsFromVideoData(ImageOutputDataPtr &&imageData) {
+        ScopedStageTimer timer(m_impl->metrics, MetricStage::LedUpdate);
         /// Clear internal data, we're invalidating things here.
         m_updated.clear();
         auto &updateCount = m_impl->updateCount;
@@ -95,17 +163,24 @@ namespace uvbi {
 
         /// Update our frame cache, since we're taking ownership of the image
         /// data now.
-        m_impl->frame = imageData->frame;
-        m_impl->frameGray = imageData->frameGray;
-        m_impl->camParams = imageData->camParams;
-        m_impl->lastFrame = imageData->tv;
+        updateFrameCache(*imageData);
 
         /// Go through each target and try to process the measurements.
         forEachTarget(*this, [&](TrackedBodyTarget &target) {
             auto usedMeasurements =
                 target.processLedMeasurements(imageData->ledMeasurements);
+            if (m_params.poseAssistedIdentification) {
+                auto identified = target.identifyLedsFromPose(
+                    m_impl->camParams, m_impl->lastFrame);
+                if (usedMeasurements == 0) {
+                    /// A target with nothing but new blobs this frame still
+                    /// gets to use the ones just identified.
+                    usedMeasurements = identified;
+                }
+            }
             if (usedMeasurements != 0) {
-                updateCount[target.getQualifiedId()] = usedMeasurements;
+                updateCount.emplace_back(target.getQualifiedId(),
+                                         usedMeasurements);
             }
         });
         return updateCount;
@@ -113,14 +188,110 @@ namespace uvbi {
 
     BodyIndices const &
     TrackingSystem::updateBodiesFromVideoData(ImageOutputDataPtr &&imageData) {
+        /// The timing half of this stage is recorded by finishVideoUpdate().
+        ScopedAllocationCounter allocs(m_impl->metrics,
+                                       MetricStage::VideoUpdate);
+        auto start = TrackingMetrics::clock::now();
+
         /// Do the second phase of stuff
         updateLedsFromVideoData(std::move(imageData));
 
+        return finishVideoUpdate(start);
+    }
+
+    BodyIndices const &
+    TrackingSystem::updateBodiesFromVideoData(ImageOutputDataPtr &&imageData,
+                                              LedStateRecording &recording) {
+        ScopedAllocationCounter allocs(m_impl->metrics,
+                                       MetricStage::VideoUpdate);
+        auto start = TrackingMetrics::clock::now();
+        updateLedsFromVideoData(std::move(imageData));
+
+        RecordedLedFrame recorded;
+        TrackingSystem const &constThis = *this;
+        forEachTarget(constThis, [&](TrackedBodyTarget const &target) {
+            recorded.leds.push_back(target.leds());
+        });
+        recorded.updateCount = m_impl->updateCount;
+
+        auto &ret = finishVideoUpdate(start);
+        recorded.idsAfterPoseEstimation = getLedIds(*this);
+        recording.m_impl->frames.push_back(std::move(recorded));
+        return ret;
+    }
+
+    bool TrackingSystem::replayBodiesFromVideoData(
+        ImageOutputDataPtr &&imageData, LedStateRecording const &recording,
+        std::size_t frame) {
+        ScopedAllocationCounter allocs(m_impl->metrics,
+                                       MetricStage::VideoUpdate);
+        auto start = TrackingMetrics::clock::now();
+        auto const &recorded = recording.m_impl->frames.at(frame);
+        {
+            ScopedStageTimer timer(m_impl->metrics, MetricStage::LedUpdate);
+            m_updated.clear();
+            updateFrameCache(*imageData);
+            std::size_t targetIndex = 0;
+            forEachTarget(*this, [&](TrackedBodyTarget &target) {
+                if (targetIndex == recorded.leds.size()) {
+                    throw std::logic_error("Replaying a recording of LEDs on "
+                                           "a system with more targets than "
+                                           "the one that recorded it!");
+                }
+                target.restoreLeds(recorded.leds[targetIndex]);
+                ++targetIndex;
+            });
+            m_impl->updateCount = recorded.updateCount;
+        }
+
+        finishVideoUpdate(start);
+        return getLedIds(*this) == recorded.idsAfterPoseEstimation;
+    }
+
+    void
+    TrackingSystem::updateFrameCache(ImageProcessingOutput const &imageData) {
+        m_impl->frame = imageData.frame;
+        m_impl->frameGray = imageData.frameGray;
+        m_impl->camParams = imageData.camParams;
+        m_impl->rawLastFrame = imageData.tv;
+        m_impl->lastFrame = imageData.tv;
+        if (m_params.estimateCameraClockOffset) {
+            /// Put the frame on the IMU's timeline.
+            m_impl->lastFrame = m_impl->clockOffset.correct(imageData.tv);
+        }
+    }
+
+    BodyIndices const &TrackingSystem::finishVideoUpdate(
+        std::chrono::steady_clock::time_point start) {
+        auto &metrics = m_impl->metrics;
+
         /// Do the third phase of tracking.
-        updatePoseEstimates();
+        {
+            ScopedStageTimer timer(metrics, MetricStage::PoseEstimation);
+            updatePoseEstimates();
+        }
+
+        if (m_params.estimateCameraClockOffset) {
+            updateClockOffsetEstimate();
+        }
 
         /// Trigger debug display, if activated.
-        m_impl->triggerDebugDisplay(*this);
+        {
+            ScopedStageTimer timer(metrics, MetricStage::DebugDisplay);
+            m_impl->triggerDebugDisplay(*this);
+        }
+
+        metrics.record(MetricStage::VideoUpdate,
+                       TrackingMetrics::clock::now() - start);
+        /// Only meaningful for frames stamped by a live camera: recorded and
+        /// synthetic ones have a timeline of their own.
+        if (m_impl->lastFrame.domain() == util::ClockDomain::Steady) {
+            metrics.record(MetricStage::FrameLatency,
+                           util::time::getSteadyNow() - m_impl->lastFrame);
+        }
+        metrics.increment(MetricCounter::Frames);
+        metrics.setGauge(MetricGauge::BodiesUpdated,
+                         static_cast<std::int64_t>(m_updated.size()));
 
         return m_updated;
     }
@@ -153,7 +324,7 @@ namespace uvbi {
 
             /// @todo right now assumes one target per body here!
             auto &body = target.getBody();
-            util::TimeValue stateTime = {};
+            util::Timestamp stateTime = {};
             BodyState state;
             auto newTime = m_impl->lastFrame;
             auto validState =
@@ -183,6 +354,19 @@ namespace uvbi {
         }
     }
 
+    void TrackingSystem::updateClockOffsetEstimate() {
+        auto &clockOffset = m_impl->clockOffset;
+        clockOffset.finishFrame(m_impl->rawLastFrame);
+        auto &metrics = m_impl->metrics;
+        metrics.setGauge(MetricGauge::CameraClockCorrection,
+                         std::chrono::duration_cast<std::chrono::microseconds>(
+                             m_impl->lastFrame - m_impl->rawLastFrame)
+                             .count());
+        metrics.setGauge(
+            MetricGauge::CameraClockSkew,
+            static_cast<std::int64_t>(clockOffset.getSkew() * 1.e9));
+    }
+
     void TrackingSystem::calibrationVideoPhaseThree() {
         auto const &updateCount = m_impl->updateCount;
         for (auto &bodyTargetWithMeasurements : updateCount) {
@@ -211,7 +395,7 @@ namespace uvbi {
     }
 
     void TrackingSystem::calibrationHandleIMUData(
-        BodyId id, util::TimeValue const &tv, Eigen::Quaterniond const &quat) {
+        BodyId id, util::Timestamp const &tv, Eigen::Quaterniond const &quat) {
         m_impl->calib.processIMUData(*this, id, tv, quat);
         m_impl->calib.postCalibrationUpdate(*this);
     }
@@ -31,7 +31,7 @@
 // - none
 
 // Standard includes
-// - none
+#include <chrono>
 
 namespace videotracker {
 namespace uvbi {
@@ -39,10 +39,13 @@ namespace uvbi {
     TrackingSystem_Impl::TrackingSystem_Impl(ConfigParams const &params)
         : blobExtractor(
               makeBlobExtractor(params.blobParams, params.extractParams)),
+          outputPool(ImageProcessingOutputPool::create()),
           debugDisplay(new TrackingDebugDisplay(params)),
           calib(Eigen::Vector3d(params.cameraPosition), params.cameraIsForward),
           cameraPose(Eigen::Isometry3d::Identity()),
-          cameraPoseInv(Eigen::Isometry3d::Identity()) {}
+          cameraPoseInv(Eigen::Isometry3d::Identity()),
+          clockOffset(std::chrono::microseconds(
+              params.maxCameraClockCorrectionMicroseconds)) {}
 
     TrackingSystem_Impl::~TrackingSystem_Impl() {
         // out line to break circular dep with this and the debug display.
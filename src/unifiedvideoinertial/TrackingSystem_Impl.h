@@ -25,14 +25,17 @@
 #pragma once
 
 // Internal Includes
+#include "ClockOffsetEstimator.h"
 #include "RoomCalibration.h"
 #include "unifiedvideoinertial/ConfigParams.h"
+#include "unifiedvideoinertial/LazyColorFrame.h"
+#include "unifiedvideoinertial/TrackingMetrics.h"
 #include "unifiedvideoinertial/TrackingSystem.h"
 #include "videotrackershared/CameraParameters.h"
 #include "videotrackershared/GenericBlobExtractor.h"
 
 // Library/third-party includes
-#include "unifiedvideoinertial/TimeValue.h"
+#include "unifiedvideoinertial/Timestamp.h"
 #include <Eigen/Core>
 #include <Eigen/Geometry>
 #include <opencv2/core/core.hpp>
@@ -58,13 +61,17 @@ namespace uvbi {
 
         /// @name Cached data from the ImageProcessingOutput updated in phase 2
         /// @{
-        /// Cached copy of the last grey frame
-        cv::Mat frame;
+        /// Color version of the last frame, made only if the debug display
+        /// asks for it.
+        LazyColorFrame frame;
         /// Cached copy of the last grey frame
         cv::Mat frameGray;
         /// Cached copy of the last (undistorted) camera parameters to be used.
         CameraParameters camParams;
-        util::TimeValue lastFrame;
+        /// Time of the last frame, with any clock offset correction applied.
+        util::Timestamp lastFrame;
+        /// Time of the last frame as stamped.
+        util::Timestamp rawLastFrame;
         /// @}
         bool roomCalibCompleteCached = false;
 
@@ -76,7 +83,15 @@ namespace uvbi {
 
         LedUpdateCount updateCount;
         BlobExtractorPtr blobExtractor;
+        /// Outputs of performInitialImageProcessing(), reused once their
+        /// frames retire.
+        std::shared_ptr<ImageProcessingOutputPool> outputPool;
         std::unique_ptr<TrackingDebugDisplay> debugDisplay;
+
+        TrackingMetrics metrics;
+
+        /// Only used if estimateCameraClockOffset is set.
+        ClockOffsetEstimator clockOffset;
     };
 
 } // namespace uvbi
@@ -0,0 +1,102 @@
+/** @file
+    @brief Header for a wait-free single-producer, single-consumer "latest
+    value" slot.
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <array>
+#include <atomic>
+
+namespace videotracker {
+namespace uvbi {
+    /// Passes the most recent value of a T from one producer thread to one
+    /// consumer thread, without locks or waiting on either side.
+    ///
+    /// There are three buffers: the producer owns one ("back"), the consumer
+    /// owns one ("front"), and the third ("middle") holds the last value
+    /// published. Publishing and receiving each swap their buffer with the
+    /// middle one in a single atomic exchange, so both take constant time no
+    /// matter how many values were published in between: values the consumer
+    /// didn't get around to receiving are simply overwritten.
+    template <typename T> class TripleBuffer {
+      public:
+        TripleBuffer() = default;
+        TripleBuffer(TripleBuffer const &) = delete;
+        TripleBuffer &operator=(TripleBuffer const &) = delete;
+
+        /// @name Producer-thread methods
+        /// @{
+
+        /// The buffer to fill with the next value: remains owned by the
+        /// producer until publish().
+        T &writeBuffer() { return m_buffers[m_back]; }
+
+        /// Makes the contents of writeBuffer() the latest value, and gives the
+        /// producer a different buffer to write into next. (The new
+        /// writeBuffer() holds stale data: fill it in completely.)
+        void publish() {
+            m_back = m_middle.exchange(m_back | FreshFlag,
+                                       std::memory_order_acq_rel) &
+                     IndexMask;
+        }
+        /// @}
+
+        /// @name Consumer-thread methods
+        /// @{
+
+        /// If a value has been published since the last call, makes it
+        /// readBuffer() and returns true. Otherwise, returns false and leaves
+        /// readBuffer() alone.
+        bool receive() {
+            if ((m_middle.load(std::memory_order_relaxed) & FreshFlag) == 0) {
+                return false;
+            }
+            m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) &
+                      IndexMask;
+            return true;
+        }
+
+        /// The most recently received value: remains owned by the consumer
+        /// until the next successful receive().
+        T const &readBuffer() const { return m_buffers[m_front]; }
+        /// @}
+
+      private:
+        static const unsigned IndexMask = 0x3;
+        static const unsigned FreshFlag = 0x4;
+        std::array<T, 3> m_buffers;
+        /// Index of the middle buffer, plus FreshFlag if it has been published
+        /// and not yet received.
+        std::atomic<unsigned> m_middle{1};
+        /// @name Each only touched by one side.
+        /// @{
+        unsigned m_front = 0;
+        unsigned m_back = 2;
+        /// @}
+    };
+} // namespace uvbi
+} // namespace videotracker
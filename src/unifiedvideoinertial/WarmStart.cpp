@@ -0,0 +1,441 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "WarmStart.h"
+#include "ForEachTracked.h"
+#include "TrackedBodyIMU.h"
+#include "unifiedvideoinertial/ConfigParams.h"
+#include "unifiedvideoinertial/TrackedBody.h"
+#include "unifiedvideoinertial/TrackedBodyTarget.h"
+#include "unifiedvideoinertial/TrackingSystem.h"
+#include "videotrackershared/CameraParameters.h"
+
+// Library/third-party includes
+#include "unifiedvideoinertial/Angles.h"
+
+// Standard includes
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <type_traits>
+
+namespace videotracker {
+namespace uvbi {
+    namespace {
+        static const char Magic[8] = {'U', 'V', 'B', 'I', 'W', 'A', 'R', 'M'};
+
+        /// 64-bit FNV-1a, for both the fingerprints and the checksum.
+        class Hasher {
+          public:
+            void add(void const *data, std::size_t size) {
+                auto bytes = static_cast<unsigned char const *>(data);
+                for (std::size_t i = 0; i < size; ++i) {
+                    m_hash = (m_hash ^ bytes[i]) * 1099511628211ULL;
+                }
+            }
+            template <typename T> void add(T const &value) {
+                static_assert(std::is_arithmetic<T>::value,
+                              "Only hash plain numbers");
+                add(&value, sizeof(value));
+            }
+            std::uint64_t get() const { return m_hash; }
+
+          private:
+            std::uint64_t m_hash = 14695981039346656037ULL;
+        };
+
+        class PayloadWriter {
+          public:
+            explicit PayloadWriter(std::string &out) : m_out(out) {}
+            template <typename T> void put(T const &value) {
+                static_assert(std::is_arithmetic<T>::value,
+                              "Only write plain numbers");
+                m_out.append(reinterpret_cast<char const *>(&value),
+                             sizeof(value));
+            }
+            template <typename Derived>
+            void putMatrix(Eigen::MatrixBase<Derived> const &mat) {
+                for (Eigen::Index i = 0; i < mat.size(); ++i) {
+                    put(static_cast<double>(mat(i)));
+                }
+            }
+
+          private:
+            std::string &m_out;
+        };
+
+        /// Reads what PayloadWriter wrote, failing (once and for all) rather
+        /// than reading past the end.
+        class PayloadReader {
+          public:
+            PayloadReader(char const *data, std::size_t size)
+                : m_data(data), m_size(size) {}
+            template <typename T> bool get(T &value) {
+                static_assert(std::is_arithmetic<T>::value,
+                              "Only read plain numbers");
+                if (!m_ok || m_size - m_pos < sizeof(value)) {
+                    m_ok = false;
+                    return false;
+                }
+                std::memcpy(&value, m_data + m_pos, sizeof(value));
+                m_pos += sizeof(value);
+                return true;
+            }
+            template <typename Derived>
+            bool getMatrix(Eigen::MatrixBase<Derived> &mat) {
+                for (Eigen::Index i = 0; i < mat.size(); ++i) {
+                    if (!get(mat(i))) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+            /// For counts of things at least minBytes each in what's left:
+            /// anything more is corrupt, and we shouldn't try to allocate
+            /// for it.
+            bool getCount(std::uint32_t &count, std::size_t minBytes) {
+                if (!get(count) || count > (m_size - m_pos) / minBytes) {
+                    m_ok = false;
+                    return false;
+                }
+                return true;
+            }
+            bool atEnd() const { return m_ok && m_pos == m_size; }
+
+          private:
+            char const *m_data;
+            std::size_t m_size;
+            std::size_t m_pos = 0;
+            bool m_ok = true;
+        };
+
+        struct Header {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t reserved;
+            std::uint64_t payloadSize;
+            std::uint64_t checksum;
+        };
+
+        static const std::size_t BeaconBytes = 12 * sizeof(double);
+        static const std::size_t TargetMinBytes =
+            2 * sizeof(std::uint32_t) + sizeof(std::uint64_t) +
+            sizeof(std::uint32_t);
+        static const std::size_t ImuYawBytes =
+            sizeof(std::uint32_t) + sizeof(double);
+    } // namespace
+
+    std::uint64_t getCameraFingerprint(CameraParameters const &camParams) {
+        Hasher hasher;
+        for (int i = 0; i < 9; ++i) {
+            hasher.add(camParams.cameraMatrix.val[i]);
+        }
+        for (auto param : camParams.distortionParameters) {
+            hasher.add(param);
+        }
+        hasher.add(static_cast<std::int32_t>(camParams.imageSize.width));
+        hasher.add(static_cast<std::int32_t>(camParams.imageSize.height));
+        return hasher.get();
+    }
+
+    std::uint64_t getTargetFingerprint(TrackedBodyTarget const &target) {
+        Hasher hasher;
+        auto n = target.getNumBeacons();
+        hasher.add(static_cast<std::uint32_t>(n));
+        for (UnderlyingBeaconIdType i = 0; i < n; ++i) {
+            Eigen::Vector3d pos =
+                target.getBeaconInitialPosition(ZeroBasedBeaconId(i));
+            hasher.add(pos.x());
+            hasher.add(pos.y());
+            hasher.add(pos.z());
+        }
+        return hasher.get();
+    }
+
+    std::uint64_t getRoomFingerprint(ConfigParams const &params) {
+        Hasher hasher;
+        for (auto coord : params.cameraPosition) {
+            hasher.add(coord);
+        }
+        hasher.add(static_cast<std::uint8_t>(params.cameraIsForward));
+        return hasher.get();
+    }
+
+    WarmStartSnapshot captureWarmStart(TrackingSystem const &sys,
+                                       CameraParameters const &camParams) {
+        WarmStartSnapshot ret;
+        ret.cameraFingerprint = getCameraFingerprint(camParams);
+        forEachTarget(sys, [&](TrackedBodyTarget const &target) {
+            WarmStartSnapshot::Target saved;
+            saved.id = target.getQualifiedId();
+            saved.fingerprint = getTargetFingerprint(target);
+            auto n = target.getNumBeacons();
+            for (UnderlyingBeaconIdType i = 0; i < n; ++i) {
+                auto id = ZeroBasedBeaconId(i);
+                saved.beacons.push_back(WarmStartSnapshot::Beacon{
+                    target.getBeaconAutocalibPosition(id),
+                    target.getBeaconAutocalibCovariance(id)});
+            }
+            ret.targets.push_back(std::move(saved));
+        });
+
+        bool allYawsKnown = true;
+        forEachIMU(sys, [&](TrackedBodyIMU const &imu) {
+            if (!imu.calibrationYawKnown()) {
+                allYawsKnown = false;
+                return;
+            }
+            ret.imuYaws.emplace_back(
+                imu.getBody().getId(),
+                util::getRadians(imu.getCalibrationYaw()));
+        });
+        /// With no IMU, the camera pose comes straight from the config, so
+        /// there's nothing worth keeping.
+        if (sys.haveCameraPose() && allYawsKnown && !ret.imuYaws.empty()) {
+            ret.haveRoomCalibration = true;
+            ret.roomFingerprint = getRoomFingerprint(sys.getParams());
+            ret.cameraPosition = sys.getCameraPose().translation();
+            ret.cameraRotation = sys.getCameraPose().linear();
+        } else {
+            ret.imuYaws.clear();
+        }
+        return ret;
+    }
+
+    WarmStartRestoreResult restoreWarmStart(TrackingSystem &sys,
+                                            CameraParameters const &camParams,
+                                            WarmStartSnapshot const &snapshot,
+                                            bool restoreRoomCalibration) {
+        WarmStartRestoreResult ret;
+        if (snapshot.cameraFingerprint != getCameraFingerprint(camParams)) {
+            return ret;
+        }
+        ret.cameraMatched = true;
+
+        for (auto const &saved : snapshot.targets) {
+            auto target = sys.isValidBodyId(saved.id.first)
+                              ? sys.getTarget(saved.id)
+                              : nullptr;
+            if (!target || getTargetFingerprint(*target) != saved.fingerprint ||
+                saved.beacons.size() !=
+                    static_cast<std::size_t>(target->getNumBeacons())) {
+                ++ret.targetsMismatched;
+                continue;
+            }
+            auto n = target->getNumBeacons();
+            for (UnderlyingBeaconIdType i = 0; i < n; ++i) {
+                auto const &beacon = saved.beacons[i];
+                target->setBeaconAutocalib(ZeroBasedBeaconId(i),
+                                           beacon.position,
+                                           beacon.covariance);
+            }
+            ++ret.targetsRestored;
+        }
+
+        if (!restoreRoomCalibration || !snapshot.haveRoomCalibration ||
+            snapshot.roomFingerprint != getRoomFingerprint(sys.getParams())) {
+            return ret;
+        }
+        /// All or nothing: every IMU needs its yaw, or room calibration
+        /// would have to run anyway.
+        std::size_t numIMUs = 0;
+        bool allFound = true;
+        forEachIMU(sys, [&](TrackedBodyIMU const &imu) {
+            ++numIMUs;
+            auto id = imu.getBody().getId();
+            allFound = allFound &&
+                       std::any_of(snapshot.imuYaws.begin(),
+                                   snapshot.imuYaws.end(),
+                                   [&](std::pair<BodyId, double> const &yaw) {
+                                       return yaw.first == id;
+                                   });
+        });
+        if (numIMUs == 0 || !allFound) {
+            return ret;
+        }
+        Eigen::Isometry3d cameraPose = Eigen::Isometry3d::Identity();
+        cameraPose.translation() = snapshot.cameraPosition;
+        cameraPose.linear() = snapshot.cameraRotation;
+        sys.setCameraPose(cameraPose);
+        for (auto const &yaw : snapshot.imuYaws) {
+            if (sys.isValidBodyId(yaw.first) &&
+                sys.getBody(yaw.first).hasIMU()) {
+                sys.getBody(yaw.first).getIMU().setCalibrationYaw(
+                    util::AngleRadiansd(yaw.second));
+            }
+        }
+        ret.roomCalibrationRestored = true;
+        return ret;
+    }
+
+    std::string serializeWarmStart(WarmStartSnapshot const &snapshot) {
+        std::string payload;
+        PayloadWriter out(payload);
+        out.put(snapshot.cameraFingerprint);
+        out.put(static_cast<std::uint32_t>(snapshot.targets.size()));
+        for (auto const &target : snapshot.targets) {
+            out.put(static_cast<std::uint32_t>(target.id.first.value()));
+            out.put(static_cast<std::uint32_t>(target.id.second.value()));
+            out.put(target.fingerprint);
+            out.put(static_cast<std::uint32_t>(target.beacons.size()));
+            for (auto const &beacon : target.beacons) {
+                out.putMatrix(beacon.position);
+                out.putMatrix(beacon.covariance);
+            }
+        }
+        out.put(static_cast<std::uint8_t>(snapshot.haveRoomCalibration));
+        if (snapshot.haveRoomCalibration) {
+            out.put(snapshot.roomFingerprint);
+            out.putMatrix(snapshot.cameraPosition);
+            out.putMatrix(snapshot.cameraRotation);
+            out.put(static_cast<std::uint32_t>(snapshot.imuYaws.size()));
+            for (auto const &yaw : snapshot.imuYaws) {
+                out.put(static_cast<std::uint32_t>(yaw.first.value()));
+                out.put(yaw.second);
+            }
+        }
+
+        Header header;
+        std::memcpy(header.magic, Magic, sizeof(Magic));
+        header.version = WarmStartVersion;
+        header.reserved = 0;
+        header.payloadSize = payload.size();
+        Hasher checksum;
+        checksum.add(payload.data(), payload.size());
+        header.checksum = checksum.get();
+
+        std::string ret(reinterpret_cast<char const *>(&header),
+                        sizeof(header));
+        ret += payload;
+        return ret;
+    }
+
+    optional<WarmStartSnapshot> deserializeWarmStart(std::string const &data) {
+        Header header;
+        if (data.size() < sizeof(header)) {
+            return nullopt;
+        }
+        std::memcpy(&header, data.data(), sizeof(header));
+        if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 ||
+            header.version != WarmStartVersion || header.reserved != 0 ||
+            header.payloadSize != data.size() - sizeof(header)) {
+            return nullopt;
+        }
+        auto payload = data.data() + sizeof(header);
+        auto payloadSize = data.size() - sizeof(header);
+        Hasher checksum;
+        checksum.add(payload, payloadSize);
+        if (checksum.get() != header.checksum) {
+            return nullopt;
+        }
+
+        PayloadReader in(payload, payloadSize);
+        WarmStartSnapshot ret;
+        std::uint32_t numTargets = 0;
+        if (!in.get(ret.cameraFingerprint) ||
+            !in.getCount(numTargets, TargetMinBytes)) {
+            return nullopt;
+        }
+        for (std::uint32_t t = 0; t < numTargets; ++t) {
+            WarmStartSnapshot::Target target;
+            std::uint32_t body = 0;
+            std::uint32_t targetId = 0;
+            std::uint32_t numBeacons = 0;
+            if (!in.get(body) || !in.get(targetId) ||
+                !in.get(target.fingerprint) ||
+                !in.getCount(numBeacons, BeaconBytes)) {
+                return nullopt;
+            }
+            target.id = BodyTargetId(
+                BodyId(static_cast<BodyId::wrapped_type>(body)),
+                TargetId(static_cast<TargetId::wrapped_type>(targetId)));
+            target.beacons.resize(numBeacons);
+            for (auto &beacon : target.beacons) {
+                if (!in.getMatrix(beacon.position) ||
+                    !in.getMatrix(beacon.covariance)) {
+                    return nullopt;
+                }
+            }
+            ret.targets.push_back(std::move(target));
+        }
+        std::uint8_t haveRoomCalibration = 0;
+        if (!in.get(haveRoomCalibration)) {
+            return nullopt;
+        }
+        ret.haveRoomCalibration = haveRoomCalibration != 0;
+        if (ret.haveRoomCalibration) {
+            std::uint32_t numYaws = 0;
+            if (!in.get(ret.roomFingerprint) ||
+                !in.getMatrix(ret.cameraPosition) ||
+                !in.getMatrix(ret.cameraRotation) ||
+                !in.getCount(numYaws, ImuYawBytes)) {
+                return nullopt;
+            }
+            for (std::uint32_t i = 0; i < numYaws; ++i) {
+                std::uint32_t body = 0;
+                double yaw = 0;
+                if (!in.get(body) || !in.get(yaw)) {
+                    return nullopt;
+                }
+                ret.imuYaws.emplace_back(
+                    BodyId(static_cast<BodyId::wrapped_type>(body)), yaw);
+            }
+        }
+        if (!in.atEnd()) {
+            return nullopt;
+        }
+        return ret;
+    }
+
+    bool saveWarmStart(std::string const &filename,
+                       WarmStartSnapshot const &snapshot) {
+        auto data = serializeWarmStart(snapshot);
+        auto tempName = filename + ".tmp";
+        {
+            std::ofstream os(tempName, std::ios::binary | std::ios::trunc);
+            if (!os.write(data.data(), data.size()) || !os.flush()) {
+                return false;
+            }
+        }
+        if (std::rename(tempName.c_str(), filename.c_str()) != 0) {
+            /// Windows won't rename over an existing file.
+            std::remove(filename.c_str());
+            if (std::rename(tempName.c_str(), filename.c_str()) != 0) {
+                std::remove(tempName.c_str());
+                return false;
+            }
+        }
+        return true;
+    }
+
+    optional<WarmStartSnapshot> loadWarmStart(std::string const &filename) {
+        std::ifstream is(filename, std::ios::binary);
+        if (!is) {
+            return nullopt;
+        }
+        std::string data{std::istreambuf_iterator<char>(is),
+                         std::istreambuf_iterator<char>()};
+        return deserializeWarmStart(data);
+    }
+} // namespace uvbi
+} // namespace videotracker
@@ -0,0 +1,135 @@
+/** @file
+    @brief Header for saving the beacon autocalibration and room calibration
+    at the end of a run, and restoring them at the start of the next.
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+// Internal Includes
+#include "unifiedvideoinertial/BodyIdTypes.h"
+
+// Library/third-party includes
+#include "unifiedvideoinertial/nonstd/optional.hpp"
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+// Standard includes
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace videotracker {
+struct CameraParameters;
+namespace uvbi {
+    using nonstd::nullopt;
+    using nonstd::optional;
+    class TrackingSystem;
+    class TrackedBodyTarget;
+    struct ConfigParams;
+
+    /// Version of the warm start file format: files of other versions are
+    /// ignored.
+    static const std::uint32_t WarmStartVersion = 1;
+
+    /// Everything a warm start restores: what autocalibration and room
+    /// calibration learned, along with fingerprints of what it was learned
+    /// with so it's only restored if that hasn't changed.
+    struct WarmStartSnapshot {
+        struct Beacon {
+            /// As TrackedBodyTarget::getBeaconAutocalibPosition().
+            Eigen::Vector3d position;
+            Eigen::Matrix3d covariance;
+        };
+        struct Target {
+            BodyTargetId id;
+            /// Of the beacons' initial positions.
+            std::uint64_t fingerprint;
+            std::vector<Beacon> beacons;
+        };
+        /// Of the camera's intrinsics.
+        std::uint64_t cameraFingerprint = 0;
+        std::vector<Target> targets;
+
+        /// Whether the room calibration is included.
+        bool haveRoomCalibration = false;
+        /// Of the config the room calibration depends on.
+        std::uint64_t roomFingerprint = 0;
+        /// The camera pose, split up so nothing here needs aligning.
+        Eigen::Vector3d cameraPosition = Eigen::Vector3d::Zero();
+        Eigen::Matrix3d cameraRotation = Eigen::Matrix3d::Identity();
+        /// Calibration yaw, in radians, of the IMU on each body with one.
+        std::vector<std::pair<BodyId, double>> imuYaws;
+    };
+
+    /// @name Fingerprints
+    /// @brief Hashes of what calibration depends on: a mismatch means it no
+    /// longer applies.
+    /// @{
+    std::uint64_t getCameraFingerprint(CameraParameters const &camParams);
+    std::uint64_t getTargetFingerprint(TrackedBodyTarget const &target);
+    std::uint64_t getRoomFingerprint(ConfigParams const &params);
+    /// @}
+
+    /// Captures the current beacon autocalibration of every target, and the
+    /// room calibration if it's complete.
+    WarmStartSnapshot captureWarmStart(TrackingSystem const &sys,
+                                       CameraParameters const &camParams);
+
+    struct WarmStartRestoreResult {
+        /// Whether the camera matched: if not, nothing is restored.
+        bool cameraMatched = false;
+        std::size_t targetsRestored = 0;
+        std::size_t targetsMismatched = 0;
+        bool roomCalibrationRestored = false;
+    };
+
+    /// Restores what still applies from a snapshot: the beacons of each
+    /// target whose setup still matches, and the room calibration, if
+    /// wanted, when every IMU has its yaw in the snapshot.
+    ///
+    /// Call before tracking starts.
+    WarmStartRestoreResult restoreWarmStart(TrackingSystem &sys,
+                                            CameraParameters const &camParams,
+                                            WarmStartSnapshot const &snapshot,
+                                            bool restoreRoomCalibration);
+
+    /// @name Serialization
+    /// @brief A header with a magic number, the version, the payload size
+    /// and a checksum of the payload, then the payload, all in the native
+    /// byte order.
+    /// @{
+    std::string serializeWarmStart(WarmStartSnapshot const &snapshot);
+    /// @return empty if the data is corrupt, truncated, or from another
+    /// version.
+    optional<WarmStartSnapshot> deserializeWarmStart(std::string const &data);
+    /// @}
+
+    /// Writes the snapshot to a file, replacing any earlier one only once
+    /// it's been completely written.
+    ///
+    /// @return false if it couldn't be written.
+    bool saveWarmStart(std::string const &filename,
+                       WarmStartSnapshot const &snapshot);
+
+    /// @return empty if the file is missing or unusable.
+    optional<WarmStartSnapshot> loadWarmStart(std::string const &filename);
+} // namespace uvbi
+} // namespace videotracker
@@ -114,7 +114,10 @@ class UnifiedVideoInertialTracker {
     const std::int32_t m_angvelUsecOffset = 0;
     const bool m_continuousReporting;
     const bool m_debugData;
+    const bool m_latestPoseReporting;
     BodyReportingVector m_bodyReportingVector;
+    /// Reused on each update, filled in for all bodies at once.
+    std::vector<videotracker::uvbi::BodyReport> m_reports;
     std::unique_ptr<TrackerThread> m_trackerThreadManager;
     bool m_threadLoopStarted = false;
     std::thread m_trackerThread;
@@ -131,7 +134,8 @@ class UnifiedVideoInertialTracker {
           m_oriUsecOffset(params.imu.orientationMicrosecondsOffset),
           m_angvelUsecOffset(params.imu.angularVelocityMicrosecondsOffset),
           m_continuousReporting(params.continuousReporting),
-          m_debugData(params.streamBeaconDebugInfo) {
+          m_debugData(params.streamBeaconDebugInfo),
+          m_latestPoseReporting(params.latestPoseReporting) {
         if (params.numThreads > 0) {
             // Set the number of threads for OpenCV to use.
             cv::setNumThreads(params.numThreads);
@@ -159,7 +163,8 @@ class UnifiedVideoInertialTracker {
         m_dev.sendJsonDescriptor(createDeviceDescriptor());
 
         m_mainBody = &(m_trackingSystem->getBody(BodyId(0)));
-        if (m_mainBody->hasIMU()) {
+        /// The live IMU doesn't describe the motion in a replayed recording.
+        if (m_mainBody->hasIMU() && params.replayPath.empty()) {
             m_imu = &(m_mainBody->getIMU());
             /// Create our client interface and register a callback.
             if (KALMANFRAMEWORK_RETURN_FAILURE ==
@@ -223,9 +228,12 @@ class UnifiedVideoInertialTracker {
     void setupBodyReporting() {
         m_bodyReportingVector.clear();
         auto n = totalNumBodies();
+        auto mode = m_latestPoseReporting
+                        ? videotracker::uvbi::BodyReportingMode::LatestOnly
+                        : videotracker::uvbi::BodyReportingMode::Queue;
         for (decltype(n) i = 0; i < n; ++i) {
             m_bodyReportingVector.emplace_back(
-                videotracker::uvbi::BodyReporting::make());
+                videotracker::uvbi::BodyReporting::make(mode));
         }
     }
 
@@ -350,14 +358,14 @@ inline OSVR_ReturnCode UnifiedVideoInertialTracker::update() {
         return KALMANFRAMEWORK_RETURN_SUCCESS;
     }
     namespace ei = osvr::util::eigen_interop;
-    std::size_t numSensors = m_bodyReportingVector.size();
-    /// On each update pass, we go through and attempt to report for every body,
-    /// at the current time + additional prediction as requested.
+    /// On each update pass, we attempt to report for every body, all at the
+    /// same current time + additional prediction as requested.
+    videotracker::uvbi::getReports(m_bodyReportingVector, m_additionalPrediction,
+                                   m_reports);
+    std::size_t numSensors = m_reports.size();
     for (std::size_t i = 0; i < numSensors; ++i) {
-        videotracker::uvbi::BodyReport report;
-        auto gotReport =
-            m_bodyReportingVector[i]->getReport(m_additionalPrediction, report);
-        if (!gotReport) {
+        auto const &report = m_reports[i];
+        if (!report) {
             /// couldn't get a report for this sensor for one reason or another.
             // std::cout << "Couldn't get report for " << i << std::endl;
             continue;
@@ -400,18 +408,34 @@ class ConfiguredDeviceConstructor {
         // This is in a separate function/header for sharing and for clarity.
         auto config = videotracker::uvbi::parseConfigParams(root);
 
+        videotracker::uvbi::ImageSourcePtr cam;
+        if (!config.replayPath.empty()) {
+            /// Replaying a recorded session through the live pipeline.
+            videotracker::uvbi::ReplayOptions replayOpts;
+            if (config.replaySpeed <= 0) {
+                replayOpts.pacing = videotracker::uvbi::ReplayPacing::MaxSpeed;
+            } else if (config.replaySpeed != 1.) {
+                replayOpts.pacing = videotracker::uvbi::ReplayPacing::Scaled;
+                replayOpts.speed = config.replaySpeed;
+            }
+            /// On the same clock as the tracker's own timing, which assumes
+            /// live data.
+            replayOpts.steadyTimestamps = true;
+            cam = videotracker::uvbi::openRecording(config.replayPath,
+                                                    replayOpts);
+        } else {
 #ifdef _WIN32
-        auto cam = videotracker::uvbi::openHDKCameraDirectShow(config.highGain);
+            cam = videotracker::uvbi::openHDKCameraDirectShow(config.highGain);
 #else // !_WIN32
-      /// @todo This is rather crude, as we can't select the exact camera we
-      /// want, nor set the "50Hz" high-gain mode (and only works with HDK
-      /// camera firmware v7 and up). Presumably eventually use libuvc on
-      /// other platforms instead, at least for the HDK IR camera.
-
-        // auto cam = videotracker::uvbi::openOpenCVCamera(0);
-        auto cam = videotracker::uvbi::openHDKCameraUVC();
+            /// @todo This is rather crude, as we can't select the exact camera
+            /// we want, nor set the "50Hz" high-gain mode (and only works with
+            /// HDK camera firmware v7 and up). Presumably eventually use libuvc
+            /// on other platforms instead, at least for the HDK IR camera.
 
+            // cam = videotracker::uvbi::openOpenCVCamera(0);
+            cam = videotracker::uvbi::openHDKCameraUVC();
 #endif
+        }
 
         if (!cam || !cam->ok()) {
             std::cerr << "Could not access the tracking camera, skipping "
@@ -0,0 +1,147 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "videotrackershared/CoarseTileSearch.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <cassert>
+
+namespace videotracker {
+ImageRangeInfo CoarseTileSearch::pool(cv::Mat const &gray, int tileSize) {
+    assert(gray.type() == CV_8UC1 && "Only 8-bit gray images supported!");
+    assert(tileSize > 0 && "Tiles must be at least a pixel!");
+    imageSize_ = gray.size();
+    tileSize_ = tileSize;
+    const int rows = gray.rows;
+    const int cols = gray.cols;
+    const int tilesX = (cols + tileSize - 1) / tileSize;
+    const int tilesY = (rows + tileSize - 1) / tileSize;
+    pooled_.create(tilesY, tilesX, CV_8UC1);
+    if (rows == 0 || cols == 0) {
+        return ImageRangeInfo(0, 0);
+    }
+    unsigned char lowest = 255;
+    for (int y = 0; y < rows; ++y) {
+        auto row = gray.ptr<unsigned char>(y);
+        auto pooledRow = pooled_.ptr<unsigned char>(y / tileSize);
+        const bool firstRowOfTile = (y % tileSize) == 0;
+        for (int tileX = 0, x = 0; tileX < tilesX; ++tileX) {
+            const int end = std::min(x + tileSize, cols);
+            unsigned char tileMax = firstRowOfTile ? 0 : pooledRow[tileX];
+            for (; x < end; ++x) {
+                tileMax = std::max(tileMax, row[x]);
+                lowest = std::min(lowest, row[x]);
+            }
+            pooledRow[tileX] = tileMax;
+        }
+    }
+    unsigned char highest = 0;
+    for (int tileY = 0; tileY < tilesY; ++tileY) {
+        auto pooledRow = pooled_.ptr<unsigned char>(tileY);
+        highest = std::max(highest,
+                           *std::max_element(pooledRow, pooledRow + tilesX));
+    }
+    return ImageRangeInfo(lowest, highest);
+}
+
+std::vector<cv::Rect> const &CoarseTileSearch::findRegions(double threshold,
+                                                           int margin) {
+    regions_.clear();
+    const int tilesX = pooled_.cols;
+    const int tilesY = pooled_.rows;
+    const cv::Rect frame(cv::Point(), imageSize_);
+    auto isCandidate = [&](int tileX, int tileY) {
+        return pooled_.ptr<unsigned char>(tileY)[tileX] >= threshold;
+    };
+    /// Adds a region, first absorbing any it overlaps - which can make it
+    /// overlap others, so go around again until it doesn't.
+    auto addRegion = [&](cv::Rect region) {
+        bool merged = true;
+        while (merged) {
+            merged = false;
+            for (auto it = regions_.begin(); it != regions_.end(); ++it) {
+                if ((*it & region).area() > 0) {
+                    region |= *it;
+                    regions_.erase(it);
+                    merged = true;
+                    break;
+                }
+            }
+        }
+        regions_.push_back(region);
+    };
+
+    visited_.assign(tilesX * tilesY, 0);
+    for (int tileY = 0; tileY < tilesY; ++tileY) {
+        for (int tileX = 0; tileX < tilesX; ++tileX) {
+            if (visited_[tileY * tilesX + tileX] ||
+                !isCandidate(tileX, tileY)) {
+                continue;
+            }
+            /// Flood-fill this group of candidate tiles, finding its
+            /// bounding box.
+            cv::Point minTile(tileX, tileY);
+            cv::Point maxTile(tileX, tileY);
+            visited_[tileY * tilesX + tileX] = 1;
+            stack_.assign(1, minTile);
+            while (!stack_.empty()) {
+                auto tile = stack_.back();
+                stack_.pop_back();
+                minTile.x = std::min(minTile.x, tile.x);
+                minTile.y = std::min(minTile.y, tile.y);
+                maxTile.x = std::max(maxTile.x, tile.x);
+                maxTile.y = std::max(maxTile.y, tile.y);
+                for (int y = std::max(tile.y - 1, 0);
+                     y <= std::min(tile.y + 1, tilesY - 1); ++y) {
+                    for (int x = std::max(tile.x - 1, 0);
+                         x <= std::min(tile.x + 1, tilesX - 1); ++x) {
+                        auto &visited = visited_[y * tilesX + x];
+                        if (!visited && isCandidate(x, y)) {
+                            visited = 1;
+                            stack_.emplace_back(x, y);
+                        }
+                    }
+                }
+            }
+            auto region =
+                cv::Rect(minTile * tileSize_ - cv::Point(margin, margin),
+                         (maxTile + cv::Point(1, 1)) * tileSize_ +
+                             cv::Point(margin, margin)) &
+                frame;
+            addRegion(region);
+        }
+    }
+
+    int searchedArea = 0;
+    for (auto const &region : regions_) {
+        searchedArea += region.area();
+    }
+    if (searchedArea > frame.area() / 2) {
+        /// Not enough left to skip to be worth the trouble.
+        regions_.assign(1, frame);
+    }
+    return regions_;
+}
+} // namespace videotracker
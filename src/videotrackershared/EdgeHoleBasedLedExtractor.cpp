@@ -48,7 +48,7 @@ EdgeHoleParams::EdgeHoleParams()
     : preEdgeDetectionBlurSize(3), laplacianKSize(3), laplacianScale(5),
       edgeDetectErosion(false), erosionKernelValue(MAX_JPG_EDGEDETECT_NOISE),
       postEdgeDetectionBlur(true), postEdgeDetectionBlurSize(3),
-      postEdgeDetectionBlurThreshold(80) {}
+      postEdgeDetectionBlurThreshold(80), singlePassHoleLabelling(false) {}
 
 static const int EDGE_DETECT_DEST_DEPTH = CV_8U;
 
@@ -92,8 +92,11 @@ operator()(cv::Mat const &gray, BlobParams const &p, bool verboseBlobOutput) {
 
     gray.copyTo(gray_);
 
-    /// Set up the threshold parameters
-    auto rangeInfo = ImageRangeInfo(gray_);
+    /// Set up the threshold parameters: if we're searching coarse-to-fine,
+    /// we get the range along with the tiles.
+    const bool coarseToFine = p.coarseTileSize > 0;
+    auto rangeInfo = coarseToFine ? tileSearch_.pool(gray, p.coarseTileSize)
+                                  : ImageRangeInfo(gray_);
     if (rangeInfo.maxVal < p.absoluteMinThreshold) {
         /// Early out - empty image!
         return measurements_;
@@ -102,46 +105,93 @@ operator()(cv::Mat const &gray, BlobParams const &p, bool verboseBlobOutput) {
     auto thresholdInfo = ImageThresholdInfo(rangeInfo, p);
     minBeaconCenterVal_ = static_cast<std::uint8_t>(thresholdInfo.minThreshold);
 
+    /// The intermediates are full-frame, even if we only fill in some
+    /// regions of them.
+    const auto frame = cv::Rect(cv::Point(), gray_.size());
+    if (coarseToFine && edge_.size() == frame.size()) {
+        /// Clear what we left behind last time, so the intermediates don't
+        /// show stale regions.
+        for (auto const &region : searchedRegions_) {
+            edge_(region).setTo(cv::Scalar(0));
+            edgeBinary_(region).setTo(cv::Scalar(0));
+        }
+    } else if (coarseToFine) {
+        edge_ = MatType::zeros(frame.size(), CV_8UC1);
+        edgeBinary_ = MatType::zeros(frame.size(), CV_8UC1);
+    }
+    blurred_.create(frame.size(), gray_.type());
+    edge_.create(frame.size(), CV_8UC1);
+    edgeTemp_.create(frame.size(), CV_8UC1);
+    edgeBinary_.create(frame.size(), CV_8UC1);
+    binTemp_.create(frame.size(), CV_8UC1);
+
+    if (coarseToFine) {
+        searchedRegions_ =
+            tileSearch_.findRegions(minBeaconCenterVal_, p.coarseTileMargin);
+    } else {
+        searchedRegions_.assign(1, frame);
+    }
+    for (auto const &region : searchedRegions_) {
+        extractRegion(region, p);
+    }
+    return measurements_;
+}
+
+void EdgeHoleBasedLedExtractor::extractRegion(cv::Rect const &region,
+                                              BlobParams const &p) {
+    regionOffset_ = region.tl();
+    /// Each region is filtered as an image of its own, ignoring whatever is
+    /// in the buffers around it.
+    static const int border = cv::BORDER_DEFAULT | cv::BORDER_ISOLATED;
+    MatType gray = gray_(region);
+    MatType blurred = blurred_(region);
+    MatType edge = edge_(region);
+    MatType edgeTemp = edgeTemp_(region);
+    MatType edgeBinary = edgeBinary_(region);
+
     /// Used to do basic thresholding here first to reduce background noise,
     /// but turns out that actually produced worse results at the end of the
     /// process (presumably by producing very sharp edges)
     // MatType blurred;
 
-    cv::GaussianBlur(gray_, blurred_,
+    cv::GaussianBlur(gray, blurred,
                      cv::Size(extParams_.preEdgeDetectionBlurSize,
                               extParams_.preEdgeDetectionBlurSize),
-                     0, 0);
+                     0, 0, border);
 
 #ifdef UVBI_USE_REALTIME_LAPLACIAN
     /// Edge detection: re-apply our partially prepared laplacian to this
     /// frame now.
-    laplacianImpl_->apply(blurred_, edge_);
+    laplacianImpl_->apply(blurred, edge);
 #else
     /// Edge detection: apply a laplacian filter to this frame
-    cv::Laplacian(blurred_, edge_, CV_8U, extParams_.laplacianKSize,
-                  extParams_.laplacianScale);
+    cv::Laplacian(blurred, edge, CV_8U, extParams_.laplacianKSize,
+                  extParams_.laplacianScale, 0, border);
 #endif
 
     /// removal of mjpeg artifacts.
     if (extParams_.edgeDetectErosion) {
 #ifdef UVBI_OPENCV_2
-        compressionArtifactRemoval_->apply(edge_, edge_);
+        compressionArtifactRemoval_->apply(edge, edge, cv::Rect(0, 0, -1, -1),
+                                           cv::Point(), true);
 #else
-        cv::erode(edge_, edge_, compressionArtifactRemovalKernel_);
+        cv::erode(edge, edge, compressionArtifactRemovalKernel_,
+                  cv::Point(-1, -1), 1,
+                  cv::BORDER_CONSTANT | cv::BORDER_ISOLATED);
 #endif
     }
 
     // turn the edge detection into a binary image.
     if (extParams_.postEdgeDetectionBlur) {
-        cv::GaussianBlur(edge_, edgeTemp_,
+        cv::GaussianBlur(edge, edgeTemp,
                          cv::Size(extParams_.postEdgeDetectionBlurSize,
                                   extParams_.postEdgeDetectionBlurSize),
-                         0, 0);
-        cv::threshold(edgeTemp_, edgeBinary_,
+                         0, 0, border);
+        cv::threshold(edgeTemp, edgeBinary,
                       extParams_.postEdgeDetectionBlurThreshold, 255,
                       cv::THRESH_BINARY);
     } else {
-        cv::threshold(edge_, edgeBinary_,
+        cv::threshold(edge, edgeBinary,
                       extParams_.postEdgeDetectionBlurThreshold, 255,
                       cv::THRESH_BINARY);
     }
@@ -153,11 +203,22 @@ operator()(cv::Mat const &gray, BlobParams const &p, bool verboseBlobOutput) {
     // given. We examine it for suitability as an LED, and if it passes our
     // checks, add a derived measurement to our measurement vector and the
     // contour itself to our list of contours for debugging display.
-    edgeBinary_.copyTo(binTemp_);
+    if (extParams_.singlePassHoleLabelling) {
+        // The labeller doesn't modify its input, and measures each hole in
+        // the same sweep that finds it, so all that's left is the checks.
+        auto const &holes = holeLabeller_(externalMatGetter(edgeBinary),
+                                          externalMatGetter(gray));
+        const auto n = holes.size();
+        for (std::size_t i = 0; i < n; ++i) {
+            checkHole(i, p);
+        }
+        return;
+    }
+    MatType binTemp = binTemp_(region);
+    edgeBinary.copyTo(binTemp);
     consumeHolesOfConnectedComponents(
-        binTemp_, contoursTempStorage_, hierarchyTempStorage_,
+        binTemp, contoursTempStorage_, hierarchyTempStorage_,
         [&](ContourType &&contour) { checkBlob(std::move(contour), p); });
-    return measurements_;
 }
 /// out of line for unique_ptr-based pimpl.
 EdgeHoleBasedLedExtractor::~EdgeHoleBasedLedExtractor() = default;
@@ -168,10 +229,10 @@ void EdgeHoleBasedLedExtractor::reset() {
     rejectList_.clear();
     contourId_ = 0;
 }
-void EdgeHoleBasedLedExtractor::checkBlob(ContourType &&contour,
-                                          BlobParams const &p) {
-
-    auto data = getBlobDataFromContour(contour);
+template <typename F>
+bool EdgeHoleBasedLedExtractor::checkBlobData(BlobData const &data,
+                                              BlobParams const &p,
+                                              F &&getConvexity) {
     auto debugStream = [&] {
 #ifdef UVBI_DEBUG_CONTOUR_CONDITIONS
         return outputIf(std::cout, true);
@@ -191,7 +252,7 @@ void EdgeHoleBasedLedExtractor::checkBlob(ContourType &&contour,
                       << p.minArea << "\n";
 
         addToRejectList(myId, RejectReason::Area, data);
-        return;
+        return false;
     }
 
     {
@@ -206,7 +267,7 @@ void EdgeHoleBasedLedExtractor::checkBlob(ContourType &&contour,
                           << int(centerPointValue) << " < "
                           << int(minBeaconCenterVal_) << "\n";
             addToRejectList(myId, RejectReason::CenterPointValue, data);
-            return;
+            return false;
         }
     }
 
@@ -215,18 +276,18 @@ void EdgeHoleBasedLedExtractor::checkBlob(ContourType &&contour,
             debugStream() << "Reject based on circularity: " << data.circularity
                           << " < " << p.minCircularity << "\n";
             addToRejectList(myId, RejectReason::Circularity, data);
-            return;
+            return false;
         }
     }
     if (p.filterByConvexity) {
-        auto convexity = getConvexity(contour, data.area);
+        auto convexity = std::forward<F>(getConvexity)();
         debugStream() << " - convexity: " << convexity;
         if (convexity < p.minConvexity) {
             debugStream() << "Reject based on convexity: " << convexity << " < "
                           << p.minConvexity << "\n";
             addToRejectList(myId, RejectReason::Convexity, data);
 
-            return;
+            return false;
         }
     }
 
@@ -240,6 +301,42 @@ void EdgeHoleBasedLedExtractor::checkBlob(ContourType &&contour,
 
         measurements_.emplace_back(std::move(newMeas));
     }
-    contours_.emplace_back(std::move(contour));
+    return true;
+}
+
+void EdgeHoleBasedLedExtractor::checkBlob(ContourType &&contour,
+                                          BlobParams const &p) {
+    if (regionOffset_ != cv::Point()) {
+        for (auto &pt : contour) {
+            pt += regionOffset_;
+        }
+    }
+    auto data = getBlobDataFromContour(contour);
+    auto contourConvexity = [&] { return getConvexity(contour, data.area); };
+    if (checkBlobData(data, p, contourConvexity)) {
+        contours_.emplace_back(std::move(contour));
+    }
+}
+
+void EdgeHoleBasedLedExtractor::checkHole(std::size_t hole,
+                                          BlobParams const &p) {
+    auto data = holeLabeller_.getHoles()[hole].getBlobData();
+    data.center += cv::Point2d(regionOffset_);
+    data.bounds += regionOffset_;
+    /// The hull is only worth finding for holes that get that far.
+    ContourType hull;
+    auto hullConvexity = [&] {
+        holeLabeller_.getHull(hole, hull);
+        return data.area / cv::contourArea(hull);
+    };
+    if (checkBlobData(data, p, hullConvexity)) {
+        if (hull.empty()) {
+            holeLabeller_.getHull(hole, hull);
+        }
+        for (auto &pt : hull) {
+            pt += regionOffset_;
+        }
+        contours_.emplace_back(std::move(hull));
+    }
 }
 } // namespace videotracker
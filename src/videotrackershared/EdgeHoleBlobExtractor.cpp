@@ -47,8 +47,8 @@ cv::Mat EdgeHoleBlobExtractor::generateDebugBlobImage_() const {
                                      cv::Scalar(255, 0, 0));
 }
 
-LedMeasurementVec EdgeHoleBlobExtractor::extractBlobs_() {
-    return m_extractor(getLatestGrayImage(), m_params);
+void EdgeHoleBlobExtractor::extractBlobs_(LedMeasurementVec &measurements) {
+    measurements = m_extractor(getLatestGrayImage(), m_params);
 }
 
 BlobExtractorPtr makeEdgeHoleBlobExtractor(BlobParams const &blobParams,
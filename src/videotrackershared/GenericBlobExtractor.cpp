@@ -57,7 +57,7 @@ GenericBlobExtractor::extractBlobs(cv::Mat const &grayImage) {
 
     m_debugThresholdImageDirty = true;
     m_debugBlobImageDirty = true;
-    latestMeasurements_ = extractBlobs_();
+    extractBlobs_(latestMeasurements_);
     return latestMeasurements_;
 }
 
@@ -0,0 +1,383 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "videotrackershared/HoleLabeller.h"
+
+// Library/third-party includes
+#include <opencv2/imgproc/imgproc.hpp> // for convexHull
+
+// Standard includes
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace videotracker {
+void HoleStats::merge(HoleStats const &other) {
+    m00 += other.m00;
+    m10 += other.m10;
+    m01 += other.m01;
+    minX = std::min(minX, other.minX);
+    minY = std::min(minY, other.minY);
+    maxX = std::max(maxX, other.maxX);
+    maxY = std::max(maxY, other.maxY);
+    crackEdges += other.crackEdges;
+    crackX += other.crackX;
+    crackY += other.crackY;
+    convexCorners += other.convexCorners;
+    concaveCorners += other.concaveCorners;
+    cornerX24 += other.cornerX24;
+    cornerY24 += other.cornerY24;
+    intensity += other.intensity;
+    intensityX += other.intensityX;
+    intensityY += other.intensityY;
+}
+
+/// The contour polygon is the hole pixels, plus a half-pixel strip outside
+/// each crack edge, less a quarter pixel at each corner (see area()).
+/// Outward normals of the crack edges cancel out around a closed boundary,
+/// so each strip contributes as if centered on its pixel.
+cv::Point2d HoleStats::center() const {
+    auto a = area();
+    return cv::Point2d((m10 + crackX / 2. - cornerX24 / 96.) / a,
+                       (m01 + crackY / 2. - cornerY24 / 96.) / a);
+}
+
+cv::Point2d HoleStats::intensityCentroid() const {
+    if (intensity == 0) {
+        return center();
+    }
+    return cv::Point2d(double(intensityX) / intensity,
+                       double(intensityY) / intensity);
+}
+
+/// The contour runs through the centers of the pixels across each crack
+/// edge: half a pixel outside the hole all the way around, except that it
+/// cuts each convex corner diagonally (losing a quarter pixel of area) and
+/// that the strips along the edges meeting at a concave corner overlap by a
+/// quarter pixel.
+double HoleStats::area() const {
+    return m00 + crackEdges / 2. - (convexCorners + concaveCorners) / 4.;
+}
+
+/// Along a straight run of crack edges, the contour takes a unit step per
+/// edge. Each convex corner turns one of those into a diagonal step, and
+/// each concave corner takes one away, since the pixel across both edges
+/// there is the same one.
+double HoleStats::perimeter() const {
+    return crackEdges - concaveCorners + (std::sqrt(2.) - 1.) * convexCorners;
+}
+
+BlobData HoleStats::getBlobData() const {
+    BlobData ret;
+    ret.center = center();
+    ret.area = area();
+    auto perim = perimeter();
+    ret.circularity = 4 * CV_PI * ret.area / (perim * perim);
+    ret.diameter = 2 * std::sqrt(ret.area / CV_PI);
+    ret.bounds = bounds();
+    return ret;
+}
+
+const HoleLabeller::Label HoleLabeller::Outside;
+const HoleLabeller::Label HoleLabeller::NotZero;
+
+HoleLabeller::Label HoleLabeller::newLabel() {
+    auto ret = static_cast<Label>(parent_.size());
+    parent_.push_back(ret);
+    provisional_.emplace_back();
+    return ret;
+}
+
+HoleLabeller::Label HoleLabeller::find(Label label) {
+    while (parent_[label] != label) {
+        /// path halving
+        parent_[label] = parent_[parent_[label]];
+        label = parent_[label];
+    }
+    return label;
+}
+
+HoleLabeller::Label HoleLabeller::unite(Label a, Label b) {
+    a = find(a);
+    b = find(b);
+    /// The lower label always wins, so the outside stays its own root and a
+    /// root is always lower than the rest of its set.
+    if (a < b) {
+        parent_[b] = a;
+        return a;
+    }
+    parent_[a] = b;
+    return b;
+}
+
+namespace {
+    /// Bits for which pixels of a 2x2 window are zero.
+    enum {
+        TopLeft = 1,
+        TopRight = 2,
+        BottomLeft = 4,
+        BottomRight = 8,
+    };
+
+    inline void addPixel(HoleStats &s, int x, int y, std::uint8_t value) {
+        if (s.m00 == 0) {
+            s.minX = s.maxX = x;
+            s.minY = s.maxY = y;
+        } else {
+            s.minX = std::min(s.minX, x);
+            s.maxX = std::max(s.maxX, x);
+            s.maxY = y;
+        }
+        s.m00++;
+        s.m10 += x;
+        s.m01 += y;
+        s.intensity += value;
+        s.intensityX += value * x;
+        s.intensityY += value * y;
+    }
+
+    /// Adds an edge between the hole pixel (x, y) and a non-zero pixel.
+    inline void addCrackEdge(HoleStats &s, int x, int y) {
+        s.crackEdges++;
+        s.crackX += x;
+        s.crackY += y;
+    }
+
+    /// Adds a convex corner at (x - 1/2, y - 1/2), where (dx, dy) points
+    /// from the hole pixel to the corner. The triangles cut off there have
+    /// their centroid 1/12 of a pixel further along.
+    inline void addConvexCorner(HoleStats &s, int x, int y, int dx, int dy) {
+        s.convexCorners++;
+        s.cornerX24 += 24 * x - 12 + 2 * dx;
+        s.cornerY24 += 24 * y - 12 + 2 * dy;
+    }
+
+    /// Adds a concave corner at (x - 1/2, y - 1/2), where (dx, dy) points
+    /// from the corner to the non-zero pixel. The overlap of the strips
+    /// there is centered 1/4 of a pixel along.
+    inline void addConcaveCorner(HoleStats &s, int x, int y, int dx,
+                                 int dy) {
+        s.concaveCorners++;
+        s.cornerX24 += 24 * x - 12 + 6 * dx;
+        s.cornerY24 += 24 * y - 12 + 6 * dy;
+    }
+} // namespace
+
+std::vector<HoleStats> const &HoleLabeller::operator()(cv::Mat const &binary,
+                                                       cv::Mat const &gray) {
+    assert(binary.type() == CV_8UC1 && gray.type() == CV_8UC1);
+    assert(binary.size() == gray.size());
+    holes_.clear();
+    parent_.clear();
+    provisional_.clear();
+    const int rows = binary.rows;
+    const int cols = binary.cols;
+    if (rows < 3 || cols < 3) {
+        return holes_;
+    }
+    labels_.create(rows, cols, CV_32SC1);
+    newLabel(); // the outside
+    {
+        /// The border belongs to the outside, regardless of its values.
+        auto first = labels_.ptr<Label>(0);
+        auto last = labels_.ptr<Label>(rows - 1);
+        std::fill(first, first + cols, Outside);
+        std::fill(last, last + cols, Outside);
+    }
+    const int lastX = cols - 2;
+    const int lastY = rows - 2;
+    for (int y = 1; y <= lastY; ++y) {
+        auto bin = binary.ptr<std::uint8_t>(y);
+        auto g = gray.ptr<std::uint8_t>(y);
+        auto labelsAbove = labels_.ptr<Label>(y - 1);
+        auto labels = labels_.ptr<Label>(y);
+        labels[0] = Outside;
+        labels[cols - 1] = Outside;
+        for (int x = 1; x <= lastX; ++x) {
+            const Label topLeft = labelsAbove[x - 1];
+            const Label top = labelsAbove[x];
+            const Label left = labels[x - 1];
+            Label here = NotZero;
+            if (bin[x]) {
+                if (top == NotZero && left == NotZero && topLeft == NotZero) {
+                    /// Fast path: nothing around but more non-zero pixels.
+                    labels[x] = NotZero;
+                    continue;
+                }
+                /// Crack edges are counted for the zero side.
+                if (top != NotZero) {
+                    addCrackEdge(provisional_[top], x, y - 1);
+                }
+                if (left != NotZero) {
+                    addCrackEdge(provisional_[left], x - 1, y);
+                }
+            } else {
+                if (top == left && top == topLeft && top != NotZero) {
+                    /// Fast path: in the middle of a zero region, so there
+                    /// are no edges or corners to count.
+                    labels[x] = top;
+                    if (top != Outside) {
+                        addPixel(provisional_[top], x, y, g[x]);
+                    }
+                    continue;
+                }
+                if (top != NotZero) {
+                    here = top;
+                    if (left != NotZero && left != top) {
+                        here = unite(top, left);
+                    }
+                } else if (left != NotZero) {
+                    here = left;
+                } else {
+                    here = newLabel();
+                }
+                HoleStats &s = provisional_[here];
+                addPixel(s, x, y, g[x]);
+                if (top == NotZero) {
+                    addCrackEdge(s, x, y);
+                }
+                if (left == NotZero) {
+                    addCrackEdge(s, x, y);
+                }
+            }
+            labels[x] = here;
+
+            /// Corners, at the meeting point of this pixel and the three
+            /// above and to the left of it.
+            const int zeros = (topLeft != NotZero ? TopLeft : 0) |
+                              (top != NotZero ? TopRight : 0) |
+                              (left != NotZero ? BottomLeft : 0) |
+                              (here != NotZero ? BottomRight : 0);
+            switch (zeros) {
+            case TopLeft:
+                addConvexCorner(provisional_[topLeft], x, y, 1, 1);
+                break;
+            case TopRight:
+                addConvexCorner(provisional_[top], x, y, -1, 1);
+                break;
+            case BottomLeft:
+                addConvexCorner(provisional_[left], x, y, 1, -1);
+                break;
+            case BottomRight:
+                addConvexCorner(provisional_[here], x, y, -1, -1);
+                break;
+            case TopLeft | BottomRight:
+                addConvexCorner(provisional_[topLeft], x, y, 1, 1);
+                addConvexCorner(provisional_[here], x, y, -1, -1);
+                break;
+            case TopRight | BottomLeft:
+                addConvexCorner(provisional_[top], x, y, -1, 1);
+                addConvexCorner(provisional_[left], x, y, 1, -1);
+                break;
+            case TopRight | BottomLeft | BottomRight:
+                addConcaveCorner(provisional_[here], x, y, -1, -1);
+                break;
+            case TopLeft | BottomLeft | BottomRight:
+                addConcaveCorner(provisional_[here], x, y, 1, -1);
+                break;
+            case TopLeft | TopRight | BottomRight:
+                addConcaveCorner(provisional_[here], x, y, -1, 1);
+                break;
+            case TopLeft | TopRight | BottomLeft:
+                addConcaveCorner(provisional_[topLeft], x, y, 1, 1);
+                break;
+            default:
+                /// No pixels, a straight edge, or all four.
+                break;
+            }
+        }
+        /// Whatever is next to the right border is part of the outside...
+        if (labels[lastX] != NotZero) {
+            unite(labels[lastX], Outside);
+        }
+    }
+    {
+        /// ...as is whatever is next to the bottom border.
+        auto labels = labels_.ptr<Label>(lastY);
+        for (int x = 1; x <= lastX; ++x) {
+            if (labels[x] != NotZero) {
+                unite(labels[x], Outside);
+            }
+        }
+    }
+
+    /// Roots are lower than the rest of their set, so in one pass in label
+    /// order every root is final before anything merges into it.
+    const auto n = static_cast<Label>(parent_.size());
+    holeOfLabel_.assign(n, -1);
+    for (Label label = Outside + 1; label < n; ++label) {
+        auto root = find(label);
+        if (root == label) {
+            holeOfLabel_[label] = static_cast<std::int32_t>(holes_.size());
+            holes_.push_back(provisional_[label]);
+        } else {
+            holeOfLabel_[label] = holeOfLabel_[root];
+            if (root != Outside) {
+                holes_[holeOfLabel_[root]].merge(provisional_[label]);
+            }
+        }
+    }
+    return holes_;
+}
+
+void HoleLabeller::getHull(std::size_t hole, ContourType &hull) {
+    hull.clear();
+    if (hole >= holes_.size()) {
+        return;
+    }
+    HoleStats const &s = holes_[hole];
+    const auto id = static_cast<std::int32_t>(hole);
+    const int width = s.maxX - s.minX + 1;
+    colMin_.assign(width, std::numeric_limits<int>::max());
+    colMax_.assign(width, std::numeric_limits<int>::min());
+    hullPoints_.clear();
+    /// The contour is made of the pixels just across a crack edge from the
+    /// hole, so its hull is that of the pixels just past each end of every
+    /// row and column of the hole.
+    for (int y = s.minY; y <= s.maxY; ++y) {
+        auto labels = labels_.ptr<Label>(y);
+        int rowMin = std::numeric_limits<int>::max();
+        int rowMax = std::numeric_limits<int>::min();
+        for (int x = s.minX; x <= s.maxX; ++x) {
+            if (labels[x] == NotZero || holeOfLabel_[labels[x]] != id) {
+                continue;
+            }
+            rowMin = std::min(rowMin, x);
+            rowMax = x;
+            auto col = x - s.minX;
+            colMin_[col] = std::min(colMin_[col], y);
+            colMax_[col] = y;
+        }
+        if (rowMin <= rowMax) {
+            hullPoints_.emplace_back(rowMin - 1, y);
+            hullPoints_.emplace_back(rowMax + 1, y);
+        }
+    }
+    for (int col = 0; col < width; ++col) {
+        if (colMin_[col] <= colMax_[col]) {
+            hullPoints_.emplace_back(s.minX + col, colMin_[col] - 1);
+            hullPoints_.emplace_back(s.minX + col, colMax_[col] + 1);
+        }
+    }
+    cv::convexHull(hullPoints_, hull);
+}
+} // namespace videotracker
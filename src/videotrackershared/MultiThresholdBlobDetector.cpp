@@ -0,0 +1,238 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "videotrackershared/MultiThresholdBlobDetector.h"
+
+// Library/third-party includes
+#include <opencv2/imgproc/imgproc.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <functional>
+
+namespace videotracker {
+namespace {
+    class LevelsBody : public cv::ParallelLoopBody {
+      public:
+        explicit LevelsBody(std::function<void(int)> const &f) : m_f(f) {}
+        void operator()(cv::Range const &range) const override {
+            for (int i = range.start; i < range.end; ++i) {
+                m_f(i);
+            }
+        }
+
+      private:
+        std::function<void(int)> const &m_f;
+    };
+} // namespace
+
+void MultiThresholdBlobDetector::operator()(
+    cv::Mat const &gray, Params const &params,
+    std::vector<cv::KeyPoint> &keyPoints) {
+    keyPoints.clear();
+    /// Same thresholds as cv::SimpleBlobDetector, accumulated the same way.
+    numLevels_ = 0;
+    if (params.thresholdStep > 0) {
+        for (double thresh = params.minThreshold; thresh < params.maxThreshold;
+             thresh += params.thresholdStep) {
+            if (levels_.size() == numLevels_) {
+                levels_.emplace_back();
+            }
+            levels_[numLevels_].threshold = thresh;
+            ++numLevels_;
+        }
+    }
+
+    std::function<void(int)> findOne = [&](int i) {
+        findBlobs(gray, params, levels_[i]);
+    };
+    auto n = static_cast<int>(numLevels_);
+    if (parallel_ && n > 1) {
+        cv::parallel_for_(cv::Range(0, n), LevelsBody(findOne));
+    } else {
+        for (int i = 0; i < n; ++i) {
+            findOne(i);
+        }
+    }
+
+    /// Group the centers from each threshold in turn with any from lower
+    /// thresholds close enough to be the same blob, keeping each group
+    /// sorted by radius.
+    std::size_t numGroups = 0;
+    for (std::size_t i = 0; i < numLevels_; ++i) {
+        /// Centers from this threshold don't group with each other.
+        const auto groupsBefore = numGroups;
+        for (auto const &center : levels_[i].centers) {
+            bool isNew = true;
+            for (std::size_t j = 0; j < groupsBefore; ++j) {
+                auto &group = groups_[j];
+                auto const &median = group[group.size() / 2];
+                double dist = cv::norm(median.location - center.location);
+                isNew = dist >= params.minDistBetweenBlobs &&
+                        dist >= median.radius && dist >= center.radius;
+                if (!isNew) {
+                    group.push_back(center);
+                    auto k = group.size() - 1;
+                    while (k > 0 && center.radius < group[k - 1].radius) {
+                        group[k] = group[k - 1];
+                        k--;
+                    }
+                    group[k] = center;
+                    break;
+                }
+            }
+            if (isNew) {
+                if (groups_.size() == numGroups) {
+                    groups_.emplace_back();
+                }
+                groups_[numGroups].assign(1, center);
+                ++numGroups;
+            }
+        }
+    }
+
+    for (std::size_t i = 0; i < numGroups; ++i) {
+        auto const &group = groups_[i];
+        if (group.size() < params.minRepeatability) {
+            continue;
+        }
+        cv::Point2d sumPoint(0, 0);
+        double normalizer = 0;
+        for (auto const &center : group) {
+            sumPoint += center.confidence * center.location;
+            normalizer += center.confidence;
+        }
+        sumPoint *= (1. / normalizer);
+        keyPoints.emplace_back(
+            sumPoint,
+            static_cast<float>(group[group.size() / 2].radius) * 2.0f);
+    }
+}
+
+void MultiThresholdBlobDetector::findBlobs(cv::Mat const &gray,
+                                           Params const &params,
+                                           Level &level) {
+    level.centers.clear();
+    cv::threshold(gray, level.binary, level.threshold, 255,
+                  cv::THRESH_BINARY);
+    if (params.filterByColor) {
+        level.binary.copyTo(level.contourInput);
+    } else {
+        /// Nothing looks at the binary image after this, so findContours
+        /// may as well have it.
+        level.contourInput = level.binary;
+    }
+    cv::findContours(level.contourInput, level.contours, cv::RETR_LIST,
+                     cv::CHAIN_APPROX_NONE);
+    for (auto const &contour : level.contours) {
+        Center center;
+        center.confidence = 1;
+        cv::Moments moms = cv::moments(contour);
+        if (params.filterByArea) {
+            double area = moms.m00;
+            if (area < params.minArea || area >= params.maxArea) {
+                continue;
+            }
+        }
+
+        if (params.filterByCircularity) {
+            double area = moms.m00;
+            double perimeter = cv::arcLength(contour, true);
+            double ratio = 4 * CV_PI * area / (perimeter * perimeter);
+            if (ratio < params.minCircularity ||
+                ratio >= params.maxCircularity) {
+                continue;
+            }
+        }
+
+        if (params.filterByInertia) {
+            double denominator =
+                std::sqrt(std::pow(2 * moms.mu11, 2) +
+                          std::pow(moms.mu20 - moms.mu02, 2));
+            const double eps = 1e-2;
+            double ratio;
+            if (denominator > eps) {
+                double cosmin = (moms.mu20 - moms.mu02) / denominator;
+                double sinmin = 2 * moms.mu11 / denominator;
+                double cosmax = -cosmin;
+                double sinmax = -sinmin;
+
+                double imin = 0.5 * (moms.mu20 + moms.mu02) -
+                              0.5 * (moms.mu20 - moms.mu02) * cosmin -
+                              moms.mu11 * sinmin;
+                double imax = 0.5 * (moms.mu20 + moms.mu02) -
+                              0.5 * (moms.mu20 - moms.mu02) * cosmax -
+                              moms.mu11 * sinmax;
+                ratio = imin / imax;
+            } else {
+                ratio = 1;
+            }
+
+            if (ratio < params.minInertiaRatio ||
+                ratio >= params.maxInertiaRatio) {
+                continue;
+            }
+            center.confidence = ratio * ratio;
+        }
+
+        if (params.filterByConvexity) {
+            cv::convexHull(contour, level.hull);
+            double area = cv::contourArea(contour);
+            double hullArea = cv::contourArea(level.hull);
+            if (std::fabs(hullArea) < DBL_EPSILON) {
+                continue;
+            }
+            double ratio = area / hullArea;
+            if (ratio < params.minConvexity || ratio >= params.maxConvexity) {
+                continue;
+            }
+        }
+
+        if (moms.m00 == 0.0) {
+            continue;
+        }
+        center.location = cv::Point2d(moms.m10 / moms.m00, moms.m01 / moms.m00);
+
+        if (params.filterByColor) {
+            if (level.binary.at<unsigned char>(cvRound(center.location.y),
+                                       cvRound(center.location.x)) !=
+                params.blobColor) {
+                continue;
+            }
+        }
+
+        /// Radius: the median distance from the center to the contour.
+        level.dists.clear();
+        for (auto const &pt : contour) {
+            level.dists.push_back(
+                cv::norm(center.location - cv::Point2d(pt.x, pt.y)));
+        }
+        std::sort(level.dists.begin(), level.dists.end());
+        center.radius = (level.dists[(level.dists.size() - 1) / 2] +
+                         level.dists[level.dists.size() / 2]) /
+                        2.;
+
+        level.centers.push_back(center);
+    }
+}
+} // namespace videotracker
@@ -55,6 +55,56 @@ createSimpleBlobDetector(cv::SimpleBlobDetector::Params const &params) {
     return detector;
 }
 
+/// Runs the detector on each region of the frame, putting the keypoints
+/// found into frame coordinates.
+template <typename Detect>
+static void detectInRegions(Detect &&detect, cv::Mat const &grayImage,
+                            std::vector<cv::Rect> const &regions,
+                            std::vector<cv::KeyPoint> &keyPoints) {
+    std::vector<cv::KeyPoint> regionKeyPoints;
+    for (auto const &region : regions) {
+        detect(grayImage(region), regionKeyPoints);
+        for (auto &kp : regionKeyPoints) {
+            kp.pt.x += region.x;
+            kp.pt.y += region.y;
+            keyPoints.push_back(kp);
+        }
+    }
+}
+
+/// Finds the blobs in the frame - or only in the given regions of it, if
+/// not null - with the detector BlobParams::multiThresholdDetector picks: a
+/// cv::SimpleBlobDetector created for this frame, or the persistent one.
+static void detectKeypoints(BlobParams const &p,
+                            MultiThresholdBlobDetector &detector,
+                            cv::SimpleBlobDetector::Params const &params,
+                            cv::Mat const &grayImage,
+                            std::vector<cv::Rect> const *regions,
+                            std::vector<cv::KeyPoint> &keyPoints) {
+    if (p.multiThresholdDetector) {
+        auto detect = [&](cv::Mat const &image,
+                          std::vector<cv::KeyPoint> &found) {
+            detector(image, params, found);
+        };
+        if (regions) {
+            detectInRegions(detect, grayImage, *regions, keyPoints);
+        } else {
+            detect(grayImage, keyPoints);
+        }
+        return;
+    }
+    auto sbd = createSimpleBlobDetector(params);
+    if (regions) {
+        detectInRegions(
+            [&](cv::Mat const &image, std::vector<cv::KeyPoint> &found) {
+                sbd->detect(image, found);
+            },
+            grayImage, *regions, keyPoints);
+    } else {
+        sbd->detect(grayImage, keyPoints);
+    }
+}
+
 #if 0
     /// This class used to be the "keypoint enhancer" - it now is used to
     /// after-the-fact extract additional data per keypoint.
@@ -288,7 +338,10 @@ void SBDBlobExtractor::getKeypoints(cv::Mat const &grayImage) {
 
         // Construct a blob detector and find the blobs in the image.
         auto &p = m_params;
-        auto rangeInfo = ImageRangeInfo(grayImage);
+        const bool coarseToFine = p.coarseTileSize > 0;
+        auto rangeInfo = coarseToFine
+                             ? m_tileSearch.pool(grayImage, p.coarseTileSize)
+                             : ImageRangeInfo(grayImage);
         if (rangeInfo.maxVal < p.absoluteMinThreshold) {
             /// empty image, early out!
             return;
@@ -309,8 +362,12 @@ void SBDBlobExtractor::getKeypoints(cv::Mat const &grayImage) {
         /// @todo: Determine the maximum size of a trackable blob by seeing
         /// when we're so close that we can't view at least four in the
         /// camera.
-        auto detector = createSimpleBlobDetector(m_sbdParams);
-        detector->detect(grayImage, m_keyPoints);
+        detectKeypoints(p, m_detector, m_sbdParams, grayImage,
+                        coarseToFine ? &m_tileSearch.findRegions(
+                                           thresholdInfo.minThreshold,
+                                           p.coarseTileMargin)
+                                     : nullptr,
+                        m_keyPoints);
 
         // @todo: Consider computing the center of mass of a dilated
         // bounding
@@ -447,18 +504,16 @@ cv::Mat SBDGenericBlobExtractor::generateDebugBlobImage_() const {
     return ret;
 }
 
-LedMeasurementVec SBDGenericBlobExtractor::extractBlobs_() {
+void SBDGenericBlobExtractor::extractBlobs_(LedMeasurementVec &measurements) {
     getKeypoints(getLatestGrayImage());
     cv::Size sz = getLatestGrayImage().size();
     /// Use the LedMeasurement constructor to do the conversion from
     /// keypoint to measurement right now.
-    LedMeasurementVec ret;
-    ret.resize(m_keyPoints.size());
-    std::transform(begin(m_keyPoints), end(m_keyPoints), begin(ret),
+    measurements.resize(m_keyPoints.size());
+    std::transform(begin(m_keyPoints), end(m_keyPoints), begin(measurements),
                    [sz](cv::KeyPoint const &kp) {
                        return LedMeasurement{kp, sz};
                    });
-    return ret;
 }
 void SBDGenericBlobExtractor::getKeypoints(cv::Mat const &grayImage) {
     m_keyPoints.clear();
@@ -467,7 +522,10 @@ void SBDGenericBlobExtractor::getKeypoints(cv::Mat const &grayImage) {
 
     // Construct a blob detector and find the blobs in the image.
     auto &p = m_params;
-    auto rangeInfo = ImageRangeInfo(grayImage);
+    const bool coarseToFine = p.coarseTileSize > 0;
+    auto rangeInfo = coarseToFine
+                         ? m_tileSearch.pool(grayImage, p.coarseTileSize)
+                         : ImageRangeInfo(grayImage);
     if (rangeInfo.maxVal < p.absoluteMinThreshold) {
         /// empty image, early out!
         return;
@@ -485,8 +543,12 @@ void SBDGenericBlobExtractor::getKeypoints(cv::Mat const &grayImage) {
     /// @todo: Determine the maximum size of a trackable blob by seeing
     /// when we're so close that we can't view at least four in the
     /// camera.
-    auto detector = createSimpleBlobDetector(m_sbdParams);
-    detector->detect(grayImage, m_keyPoints);
+    detectKeypoints(p, m_detector, m_sbdParams, grayImage,
+                    coarseToFine
+                        ? &m_tileSearch.findRegions(thresholdInfo.minThreshold,
+                                                    p.coarseTileMargin)
+                        : nullptr,
+                    m_keyPoints);
 
     // @todo: Consider computing the center of mass of a dilated
     // bounding
@@ -0,0 +1,592 @@
+/** @file
+    @brief Implementation of a microbenchmark for the FlexKalman predict and
+    correct kernels, for each state/process model/measurement combination
+    the tracker uses, with CSV output and comparison against a baseline.
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "FlexKalman/AbsoluteOrientationMeasurement.h"
+#include "FlexKalman/AbsolutePositionMeasurement.h"
+#include "FlexKalman/AngularVelocityMeasurement.h"
+#include "FlexKalman/AugmentedProcessModel.h"
+#include "FlexKalman/AugmentedState.h"
+#include "FlexKalman/ConstantProcess.h"
+#include "FlexKalman/FlexibleKalmanFilter.h"
+#include "FlexKalman/FlexibleUnscentedCorrect.h"
+#include "FlexKalman/OrientationConstantVelocity.h"
+#include "FlexKalman/OrientationState.h"
+#include "FlexKalman/PoseConstantVelocity.h"
+#include "FlexKalman/PoseSeparatelyDampedConstantVelocity.h"
+#include "FlexKalman/PoseState.h"
+#include "FlexKalman/PoseStateExponentialMap.h"
+#include "FlexKalman/PureVectorState.h"
+#include "ImagePointMeasurement.h"
+#include "unifiedvideoinertial/MiniArgsHandling.h"
+
+// Library/third-party includes
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+// Standard includes
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+using PoseState = flexkalman::pose_externalized_rotation::State;
+using ExpMapState = flexkalman::pose_exp_map::State;
+using OrientState = flexkalman::orient_externalized_rotation::State;
+using BeaconState = flexkalman::PureVectorState<3>;
+using videotracker::uvbi::AugmentedStateWithBeacon;
+using videotracker::uvbi::CameraModel;
+using videotracker::uvbi::ImagePointMeasurement;
+
+/// Number of distinct measurement inputs each correction kernel cycles
+/// through, and number of kernel invocations per timed batch: the state is
+/// reset to the same starting point before every batch, so each batch does
+/// identical work.
+static const std::size_t InputCount = 64;
+
+static const double Dt = 0.01;
+
+struct BenchOptions {
+    std::size_t warmupBatches = 20;
+    std::size_t batches = 200;
+    std::string filter;
+};
+
+struct KernelResult {
+    std::string kernel;
+    std::size_t ops;
+    double medianNs;
+    double minNs;
+};
+
+/// Accumulates something from the state after every batch so the optimizer
+/// can't discard the work (and so a kernel that diverges is noticed).
+static volatile double g_sink = 0;
+
+/// Times a kernel: `reset()` restores the starting state (not timed), then
+/// `kernel(i)` is called for i in [0, InputCount) in a timed batch. Reports
+/// the median and minimum time per kernel invocation across batches.
+template <typename Reset, typename Kernel, typename Sink>
+KernelResult runKernel(std::string const &name, BenchOptions const &opts,
+                       Reset &&reset, Kernel &&kernel, Sink &&sink) {
+    using clock = std::chrono::steady_clock;
+    std::vector<double> perOp;
+    perOp.reserve(opts.batches);
+    for (std::size_t b = 0; b < opts.warmupBatches + opts.batches; ++b) {
+        reset();
+        auto start = clock::now();
+        for (std::size_t i = 0; i < InputCount; ++i) {
+            kernel(i);
+        }
+        auto elapsed = clock::now() - start;
+        auto check = sink();
+        if (!std::isfinite(check)) {
+            throw std::runtime_error("Kernel " + name +
+                                     " produced a non-finite state");
+        }
+        g_sink = g_sink + check;
+        if (b >= opts.warmupBatches) {
+            perOp.push_back(
+                std::chrono::duration<double, std::nano>(elapsed).count() /
+                InputCount);
+        }
+    }
+    std::sort(perOp.begin(), perOp.end());
+    return KernelResult{name, opts.batches * InputCount,
+                        perOp[perOp.size() / 2], perOp.front()};
+}
+
+/// Runs kernels whose names match the filter, collecting the results.
+struct KernelRunner {
+    BenchOptions const &opts;
+    std::vector<KernelResult> &results;
+
+    template <typename Reset, typename Kernel, typename Sink>
+    void operator()(std::string const &name, Reset &&reset, Kernel &&kernel,
+                    Sink &&sink) {
+        if (!opts.filter.empty() &&
+            name.find(opts.filter) == std::string::npos) {
+            return;
+        }
+        results.push_back(runKernel(name, opts, std::forward<Reset>(reset),
+                                    std::forward<Kernel>(kernel),
+                                    std::forward<Sink>(sink)));
+    }
+};
+
+/// Deterministic inputs, shared by all kernels.
+struct Inputs {
+    Inputs() {
+        std::mt19937 gen(0x4b616c6d);
+        std::normal_distribution<double> noise;
+        for (std::size_t i = 0; i < InputCount; ++i) {
+            Eigen::Vector3d rotVec(0.01 * noise(gen), 0.01 * noise(gen),
+                                   0.01 * noise(gen));
+            orientations.push_back(flexkalman::util::quat_exp(rotVec / 2.) *
+                                   baseOrientation());
+            positions.push_back(basePosition() +
+                                0.001 * randomVector(noise, gen));
+            angularVelocities.push_back(baseAngularVelocity() +
+                                        0.05 * randomVector(noise, gen));
+            /// Beacons scattered over a roughly 10cm target.
+            beacons.push_back(0.05 * randomVector(noise, gen));
+        }
+    }
+
+    template <typename Dist, typename Gen>
+    static Eigen::Vector3d randomVector(Dist &dist, Gen &gen) {
+        Eigen::Vector3d ret;
+        ret << dist(gen), dist(gen), dist(gen);
+        return ret;
+    }
+
+    static Eigen::Quaterniond baseOrientation() {
+        return Eigen::Quaterniond(
+            Eigen::AngleAxisd(0.3, Eigen::Vector3d(1, 2, 3).normalized()));
+    }
+    /// In camera space, half a meter in front of the camera.
+    static Eigen::Vector3d basePosition() {
+        return Eigen::Vector3d(0.02, -0.03, 0.5);
+    }
+    static Eigen::Vector3d baseVelocity() {
+        return Eigen::Vector3d(0.1, 0.05, -0.02);
+    }
+    static Eigen::Vector3d baseAngularVelocity() {
+        return Eigen::Vector3d(0.2, -0.4, 0.1);
+    }
+
+    std::vector<Eigen::Quaterniond,
+                Eigen::aligned_allocator<Eigen::Quaterniond>>
+        orientations;
+    std::vector<Eigen::Vector3d> positions;
+    std::vector<Eigen::Vector3d> angularVelocities;
+    std::vector<Eigen::Vector3d> beacons;
+};
+
+/// Starting states: moving, rotated, with a non-trivial covariance.
+PoseState makePoseState() {
+    PoseState state;
+    state.position() = Inputs::basePosition();
+    state.velocity() = Inputs::baseVelocity();
+    state.angularVelocity() = Inputs::baseAngularVelocity();
+    state.setQuaternion(Inputs::baseOrientation());
+    state.setErrorCovariance(
+        PoseState::StateSquareMatrix::Identity() * 0.01 +
+        PoseState::StateSquareMatrix::Constant(1.e-4));
+    return state;
+}
+
+ExpMapState makeExpMapState() {
+    ExpMapState state;
+    state.position() = Inputs::basePosition();
+    state.velocity() = Inputs::baseVelocity();
+    state.angularVelocity() = Inputs::baseAngularVelocity();
+    state.rotationVector() =
+        flexkalman::util::quat_ln(Inputs::baseOrientation()) * 2.;
+    state.setErrorCovariance(
+        ExpMapState::StateSquareMatrix::Identity() * 0.01 +
+        ExpMapState::StateSquareMatrix::Constant(1.e-4));
+    return state;
+}
+
+OrientState makeOrientState() {
+    OrientState state;
+    state.angularVelocity() = Inputs::baseAngularVelocity();
+    state.setQuaternion(Inputs::baseOrientation());
+    using Matrix = flexkalman::orient_externalized_rotation::StateSquareMatrix;
+    state.setErrorCovariance(Matrix::Identity() * 0.01 +
+                             Matrix::Constant(1.e-4));
+    return state;
+}
+
+std::vector<KernelResult> runAll(BenchOptions const &opts) {
+    Inputs const in;
+    std::vector<KernelResult> results;
+    KernelRunner run{opts, results};
+
+    auto const poseProto = makePoseState();
+    auto const expMapProto = makeExpMapState();
+    auto const orientProto = makeOrientState();
+    PoseState pose = poseProto;
+    ExpMapState expMap = expMapProto;
+    OrientState orient = orientProto;
+    auto resetPose = [&] { pose = poseProto; };
+    auto resetExpMap = [&] { expMap = expMapProto; };
+    auto resetOrient = [&] { orient = orientProto; };
+    auto sinkPose = [&] { return pose.stateVector().sum(); };
+    auto sinkExpMap = [&] { return expMap.stateVector().sum(); };
+    auto sinkOrient = [&] { return orient.stateVector().sum(); };
+
+    flexkalman::PoseConstantVelocityProcessModel poseCV;
+    flexkalman::PoseSeparatelyDampedConstantVelocityProcessModel<PoseState>
+        poseDamped;
+    flexkalman::pose_exp_map::ConstantVelocityProcessModel expMapCV;
+    flexkalman::OrientationConstantVelocityProcessModel orientCV;
+
+    /// @name Prediction
+    /// @{
+    run("predict/PoseState/ConstantVelocity", resetPose,
+        [&](std::size_t) { flexkalman::predict(pose, poseCV, Dt); }, sinkPose);
+    run("predict/PoseState/SeparatelyDamped", resetPose,
+        [&](std::size_t) { flexkalman::predict(pose, poseDamped, Dt); },
+        sinkPose);
+    run("predict/PoseStateExponentialMap/ConstantVelocity", resetExpMap,
+        [&](std::size_t) { flexkalman::predict(expMap, expMapCV, Dt); },
+        sinkExpMap);
+    run("predict/OrientationState/ConstantVelocity", resetOrient,
+        [&](std::size_t) { flexkalman::predict(orient, orientCV, Dt); },
+        sinkOrient);
+    /// @}
+
+    /// @name Extended (EKF) correction
+    /// @{
+    {
+        flexkalman::AbsoluteOrientationEKFMeasurement<PoseState> meas{
+            in.orientations[0], Eigen::Vector3d::Constant(1.e-5)};
+        run("ekf/PoseState/AbsoluteOrientation", resetPose,
+            [&](std::size_t i) {
+                meas.setMeasurement(in.orientations[i]);
+                flexkalman::correct(pose, poseDamped, meas);
+            },
+            sinkPose);
+    }
+    {
+        flexkalman::AbsolutePositionEKFMeasurement<PoseState> meas{
+            in.positions[0], Eigen::Vector3d::Constant(1.e-5)};
+        run("ekf/PoseState/AbsolutePosition", resetPose,
+            [&](std::size_t i) {
+                meas.setMeasurement(in.positions[i]);
+                flexkalman::correct(pose, poseDamped, meas);
+            },
+            sinkPose);
+    }
+    {
+        flexkalman::AngularVelocityEKFMeasurement<PoseState> meas{
+            in.angularVelocities[0], Eigen::Vector3d::Constant(1.e-3)};
+        run("ekf/PoseState/AngularVelocity", resetPose,
+            [&](std::size_t i) {
+                meas.setMeasurement(in.angularVelocities[i]);
+                flexkalman::correct(pose, poseDamped, meas);
+            },
+            sinkPose);
+    }
+    {
+        flexkalman::AngularVelocityEKFMeasurement<OrientState> meas{
+            in.angularVelocities[0], Eigen::Vector3d::Constant(1.e-3)};
+        run("ekf/OrientationState/AngularVelocity", resetOrient,
+            [&](std::size_t i) {
+                meas.setMeasurement(in.angularVelocities[i]);
+                flexkalman::correct(orient, orientCV, meas);
+            },
+            sinkOrient);
+    }
+    {
+        /// As in PoseEstimator_SCAATKalman: one beacon position state per
+        /// measurement, augmented onto the body state for the correction.
+        CameraModel cam;
+        cam.focalLength = 700.;
+        cam.principalPoint = Eigen::Vector2d(320, 240);
+        ImagePointMeasurement meas{cam, Eigen::Vector3d::Zero()};
+        meas.setVariance(2.);
+        flexkalman::ConstantProcess<BeaconState> beaconProcess;
+        auto model = flexkalman::makeAugmentedProcessModel(poseDamped,
+                                                           beaconProcess);
+        std::vector<BeaconState> beaconProtos;
+        std::vector<Eigen::Vector2d> pixels;
+        for (std::size_t i = 0; i < InputCount; ++i) {
+            beaconProtos.emplace_back(
+                in.beacons[i], BeaconState::SquareMatrix::Identity() * 1.e-6);
+            /// Where the beacon would appear from a slightly different pose,
+            /// so every correction has a residual to work with.
+            pixels.push_back(videotracker::projectPoint(
+                in.positions[i], in.orientations[i], cam.focalLength,
+                cam.principalPoint, in.beacons[i]));
+        }
+        auto beacons = beaconProtos;
+        run("ekf/AugmentedState/ImagePoint",
+            [&] {
+                pose = poseProto;
+                beacons = beaconProtos;
+            },
+            [&](std::size_t i) {
+                auto state = flexkalman::makeAugmentedState(pose, beacons[i]);
+                meas.setMeasurement(pixels[i]);
+                meas.updateFromState(state);
+                flexkalman::correct(state, model, meas);
+            },
+            sinkPose);
+    }
+    /// @}
+
+    /// @name Unscented correction
+    /// @{
+    {
+        flexkalman::AbsoluteOrientationMeasurement meas{
+            in.orientations[0], Eigen::Vector3d::Constant(1.e-5)};
+        run("ukf/PoseState/AbsoluteOrientation", resetPose,
+            [&](std::size_t i) {
+                meas.setMeasurement(in.orientations[i]);
+                flexkalman::correctUnscented(pose, meas);
+            },
+            sinkPose);
+        run("ukf/PoseStateExponentialMap/AbsoluteOrientation", resetExpMap,
+            [&](std::size_t i) {
+                meas.setMeasurement(in.orientations[i]);
+                flexkalman::correctUnscented(expMap, meas);
+            },
+            sinkExpMap);
+        run("ukf/OrientationState/AbsoluteOrientation", resetOrient,
+            [&](std::size_t i) {
+                meas.setMeasurement(in.orientations[i]);
+                flexkalman::correctUnscented(orient, meas);
+            },
+            sinkOrient);
+    }
+    {
+        flexkalman::AbsolutePositionMeasurement meas{
+            in.positions[0], Eigen::Vector3d::Constant(1.e-5)};
+        run("ukf/PoseState/AbsolutePosition", resetPose,
+            [&](std::size_t i) {
+                meas.setMeasurement(in.positions[i]);
+                flexkalman::correctUnscented(pose, meas);
+            },
+            sinkPose);
+        run("ukf/PoseStateExponentialMap/AbsolutePosition", resetExpMap,
+            [&](std::size_t i) {
+                meas.setMeasurement(in.positions[i]);
+                flexkalman::correctUnscented(expMap, meas);
+            },
+            sinkExpMap);
+    }
+    {
+        flexkalman::AngularVelocityMeasurement meas{
+            in.angularVelocities[0], Eigen::Vector3d::Constant(1.e-3)};
+        run("ukf/PoseState/AngularVelocity", resetPose,
+            [&](std::size_t i) {
+                meas.setMeasurement(in.angularVelocities[i]);
+                flexkalman::correctUnscented(pose, meas);
+            },
+            sinkPose);
+        run("ukf/OrientationState/AngularVelocity", resetOrient,
+            [&](std::size_t i) {
+                meas.setMeasurement(in.angularVelocities[i]);
+                flexkalman::correctUnscented(orient, meas);
+            },
+            sinkOrient);
+    }
+    /// @}
+    return results;
+}
+
+static const char CSV_HEADER[] = "kernel,ops,median_ns,min_ns";
+
+void writeCsv(std::ostream &os, std::vector<KernelResult> const &results) {
+    os << CSV_HEADER << "\n";
+    os << std::fixed << std::setprecision(1);
+    for (auto const &r : results) {
+        os << r.kernel << "," << r.ops << "," << r.medianNs << "," << r.minNs
+           << "\n";
+    }
+}
+
+/// Reads the median times from a file written by writeCsv().
+std::map<std::string, double> readBaseline(std::string const &fn) {
+    std::ifstream is(fn);
+    if (!is) {
+        throw std::runtime_error("Could not open baseline file " + fn);
+    }
+    std::map<std::string, double> ret;
+    std::string line;
+    if (!std::getline(is, line) || line != CSV_HEADER) {
+        throw std::runtime_error("Baseline file " + fn +
+                                 " does not start with the expected header");
+    }
+    while (std::getline(is, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream ls(line);
+        std::string kernel, ops, median;
+        if (!std::getline(ls, kernel, ',') || !std::getline(ls, ops, ',') ||
+            !std::getline(ls, median, ',')) {
+            throw std::runtime_error("Malformed line in baseline file " + fn +
+                                     ": " + line);
+        }
+        ret[kernel] = std::stod(median);
+    }
+    return ret;
+}
+
+/// Prints a comparison table: returns the number of kernels that got slower
+/// than the baseline by more than the tolerance (a fraction).
+std::size_t compareToBaseline(std::vector<KernelResult> const &results,
+                              std::map<std::string, double> const &baseline,
+                              double tolerance) {
+    std::size_t regressions = 0;
+    std::cout << std::left << std::setw(52) << "kernel" << std::right
+              << std::setw(12) << "baseline" << std::setw(12) << "now"
+              << std::setw(10) << "ratio" << "\n";
+    std::cout << std::fixed << std::setprecision(1);
+    for (auto const &r : results) {
+        std::cout << std::left << std::setw(52) << r.kernel << std::right;
+        auto it = baseline.find(r.kernel);
+        if (it == baseline.end()) {
+            std::cout << std::setw(12) << "-" << std::setw(12) << r.medianNs
+                      << std::setw(10) << "-"
+                      << "  (not in baseline)\n";
+            continue;
+        }
+        auto ratio = r.medianNs / it->second;
+        std::cout << std::setw(12) << it->second << std::setw(12)
+                  << r.medianNs << std::setw(10) << std::setprecision(2)
+                  << ratio << std::setprecision(1);
+        if (ratio > 1. + tolerance) {
+            ++regressions;
+            std::cout << "  REGRESSION";
+        }
+        std::cout << "\n";
+    }
+    for (auto const &entry : baseline) {
+        auto found = std::any_of(
+            results.begin(), results.end(),
+            [&](KernelResult const &r) { return r.kernel == entry.first; });
+        if (!found && !results.empty()) {
+            std::cout << "Note: baseline kernel " << entry.first
+                      << " was not run\n";
+        }
+    }
+    return regressions;
+}
+
+template <typename T> inline T parseValue(std::string const &arg) {
+    std::istringstream is(arg);
+    T val;
+    if (!(is >> val)) {
+        throw std::invalid_argument("Could not parse argument " + arg);
+    }
+    return val;
+}
+} // namespace
+
+static const char USAGE[] =
+    "Usage: KalmanBench [--batches N] [--warmup N] [--filter SUBSTRING]\n"
+    "                   [--csv FILE] [--baseline FILE] [--tolerance FRACTION]\n"
+    "                   [--quick]\n\n"
+    "Times the FlexKalman predict, EKF correct and unscented correct kernels\n"
+    "with fixed inputs, in batches of 64 calls from the same starting state,\n"
+    "and reports the median and minimum nanoseconds per call as CSV (to FILE,\n"
+    "or stdout). With --baseline, compares the medians against a CSV from a\n"
+    "previous run and exits non-zero if any kernel is slower by more than the\n"
+    "tolerance (default 0.5, i.e. 50%). --quick runs only a few batches, as a\n"
+    "smoke test.\n";
+
+int main(int argc, char *argv[]) {
+    using namespace videotracker::util::args;
+    BenchOptions opts;
+    std::string csvFile;
+    std::string baselineFile;
+    double tolerance = 0.5;
+    auto args = makeArgList(argc, argv);
+    try {
+        if (handle_has_any_switch_of(args, {"-h", "--help"})) {
+            std::cout << USAGE;
+            return 0;
+        }
+        if (handle_has_switch(args, "--quick")) {
+            opts.warmupBatches = 1;
+            opts.batches = 3;
+        }
+        handle_value_arg(args,
+                         [](std::string const &a) { return a == "--batches"; },
+                         [&](std::string const &a) {
+                             opts.batches = parseValue<std::size_t>(a);
+                         });
+        handle_value_arg(args,
+                         [](std::string const &a) { return a == "--warmup"; },
+                         [&](std::string const &a) {
+                             opts.warmupBatches = parseValue<std::size_t>(a);
+                         });
+        handle_value_arg(args,
+                         [](std::string const &a) { return a == "--filter"; },
+                         [&](std::string const &a) { opts.filter = a; });
+        handle_value_arg(args,
+                         [](std::string const &a) { return a == "--csv"; },
+                         [&](std::string const &a) { csvFile = a; });
+        handle_value_arg(
+            args, [](std::string const &a) { return a == "--baseline"; },
+            [&](std::string const &a) { baselineFile = a; });
+        handle_value_arg(
+            args, [](std::string const &a) { return a == "--tolerance"; },
+            [&](std::string const &a) { tolerance = parseValue<double>(a); });
+        if (!args.empty()) {
+            std::cerr << "Unrecognized arguments left after parsing command "
+                         "line!\n\n"
+                      << USAGE;
+            return -1;
+        }
+        if (opts.batches == 0) {
+            throw std::invalid_argument("Need at least one batch!");
+        }
+    } catch (std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+
+    try {
+        auto results = runAll(opts);
+        if (csvFile.empty()) {
+            writeCsv(std::cout, results);
+        } else {
+            std::ofstream os(csvFile);
+            if (!os) {
+                throw std::runtime_error("Could not open " + csvFile);
+            }
+            writeCsv(os, results);
+        }
+        if (!baselineFile.empty()) {
+            std::cout << "\n";
+            auto regressions = compareToBaseline(
+                results, readBaseline(baselineFile), tolerance);
+            if (regressions > 0) {
+                std::cout << "\n"
+                          << regressions << " kernel(s) regressed by more than "
+                          << tolerance * 100. << "%" << std::endl;
+                return 1;
+            }
+        }
+    } catch (std::exception &e) {
+        std::cerr << "Benchmark failed: " << e.what() << std::endl;
+        return -1;
+    }
+    return 0;
+}
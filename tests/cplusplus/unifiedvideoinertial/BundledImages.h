@@ -0,0 +1,72 @@
+/** @file
+    @brief Header: loading the test frames bundled with the source.
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+#include <opencv2/core/core.hpp>
+#include <opencv2/highgui/highgui.hpp> // for imread
+#include <opencv2/imgproc/imgproc.hpp>
+
+// Standard includes
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace videotracker {
+/// Appends frames 0001.tif through n of the bundled sequence in dir
+/// (relative to the source directory) to frames, in gray. Fails the test
+/// if one can't be loaded.
+inline void loadBundledSequence(std::string const &dir, int n,
+                                std::vector<cv::Mat> &frames) {
+    for (int i = 1; i <= n; ++i) {
+        std::ostringstream fn;
+        fn << UVBI_SOURCE_DIR << "/" << dir << "/" << std::setfill('0')
+           << std::setw(4) << i << ".tif";
+        cv::Mat color = cv::imread(fn.str(), cv::IMREAD_COLOR);
+        if (!color.data) {
+            FAIL("Could not load " << fn.str());
+        }
+        cv::Mat gray;
+        cv::cvtColor(color, gray, cv::COLOR_BGR2GRAY);
+        frames.push_back(gray);
+    }
+}
+
+/// The photos of a real HDK bundled with the source.
+inline std::vector<cv::Mat> loadBundledHDKImages() {
+    std::vector<cv::Mat> ret;
+    loadBundledSequence("HDK_random_images", 8, ret);
+    return ret;
+}
+
+/// All the frames bundled with the source: the HDK photos, then the
+/// simulated animation.
+inline std::vector<cv::Mat> loadBundledImages() {
+    auto ret = loadBundledHDKImages();
+    loadBundledSequence("simulated_images/animation_from_fake", 32, ret);
+    return ret;
+}
+} // namespace videotracker
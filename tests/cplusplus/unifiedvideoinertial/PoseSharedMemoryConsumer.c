@@ -0,0 +1,136 @@
+/** @file
+    @brief Reads poses from shared memory as a separate process would, for
+    TestPoseSharedMemory, using only the C reader API.
+
+    Usage: uvbi-pose-shm-consumer name body minSequence
+
+    Reads the body's newest pose and its history over and over, checking that
+    every pose read is one the test published whole, until it sees pose
+    minSequence. Exits 0 if all was well.
+
+    @date 2026
+*/
+
+/*
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+/* Internal Includes */
+#include "unifiedvideoinertial/PoseSharedMemoryC.h"
+
+/* Library/third-party includes */
+/* none */
+
+/* Standard includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Give up if the pose we're waiting for hasn't shown up by then. */
+#define TIMEOUT_SECONDS 20
+#define MAX_HISTORY 256
+
+/* The test fills every field of a pose from its sequence number and body,
+   so a pose pieced together from two writes shows up as inconsistent. */
+static int isConsistent(const UVBI_PoseSample *sample, uint32_t body) {
+    double seq = (double)sample->sequence;
+    return sample->sequence != 0 &&
+           sample->monotonicNanoseconds ==
+               (int64_t)sample->sequence * 1000 &&
+           sample->pose.translation.data[0] == seq &&
+           sample->pose.translation.data[1] == (double)body &&
+           sample->pose.rotation.data[0] == 1. &&
+           sample->linearVelocity.data[0] == seq &&
+           sample->angularVelocity.data[1] == seq &&
+           sample->positionVariance.data[2] == seq &&
+           sample->orientationVariance.data[2] == seq;
+}
+
+static int fail(UVBI_PoseReader reader, const char *message,
+                unsigned long long sequence) {
+    fprintf(stderr, "uvbi-pose-shm-consumer: %s (sequence %llu)\n", message,
+            sequence);
+    uvbiPoseReaderClose(reader);
+    return 1;
+}
+
+int main(int argc, char *argv[]) {
+    static UVBI_PoseSample history[MAX_HISTORY];
+    UVBI_PoseReader reader = NULL;
+    UVBI_PoseSample latest;
+    uint32_t body;
+    uint64_t minSequence;
+    uint64_t lastSeen = 0;
+    time_t deadline = time(NULL) + TIMEOUT_SECONDS;
+    if (argc != 4) {
+        fprintf(stderr, "Usage: %s name body minSequence\n", argv[0]);
+        return 2;
+    }
+    body = (uint32_t)strtoul(argv[2], NULL, 10);
+    minSequence = (uint64_t)strtoull(argv[3], NULL, 10);
+
+    while (!reader) {
+        if (time(NULL) > deadline) {
+            return fail(reader, "could not open the region", 0);
+        }
+        reader = uvbiPoseReaderOpen(argv[1]);
+    }
+    if (body >= uvbiPoseReaderGetBodyCount(reader) ||
+        uvbiPoseReaderGetHistoryLength(reader) > MAX_HISTORY) {
+        return fail(reader, "unexpected region layout", 0);
+    }
+
+    while (lastSeen < minSequence) {
+        size_t count;
+        size_t i;
+        if (time(NULL) > deadline) {
+            return fail(reader, "timed out waiting for poses", lastSeen);
+        }
+        switch (uvbiPoseReaderGetLatest(reader, body, &latest)) {
+        case 1:
+            if (!isConsistent(&latest, body)) {
+                return fail(reader, "torn newest pose", latest.sequence);
+            }
+            if (latest.sequence < lastSeen) {
+                return fail(reader, "newest pose went backwards",
+                            latest.sequence);
+            }
+            break;
+        case 0:
+            if (lastSeen != 0) {
+                return fail(reader, "newest pose disappeared", lastSeen);
+            }
+            continue;
+        default:
+            /* Kept overlapping writes: fine, just try again. */
+            continue;
+        }
+        count = uvbiPoseReaderGetHistory(reader, body, lastSeen, history,
+                                         MAX_HISTORY);
+        for (i = 0; i < count; ++i) {
+            if (!isConsistent(&history[i], body)) {
+                return fail(reader, "torn pose in history",
+                            history[i].sequence);
+            }
+            if (history[i].sequence <= lastSeen) {
+                return fail(reader, "history out of order",
+                            history[i].sequence);
+            }
+            lastSeen = history[i].sequence;
+        }
+    }
+    uvbiPoseReaderClose(reader);
+    return 0;
+}
@@ -0,0 +1,64 @@
+/** @file
+    @brief Header: the synthetic swaying HDK the end-to-end tests track.
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+// Internal Includes
+#include "unifiedvideoinertial/ConfigParams.h"
+#include "unifiedvideoinertial/MakeHDKTrackingSystem.h"
+#include "unifiedvideoinertial/SyntheticScene.h"
+#include "unifiedvideoinertial/TrackingSystem.h"
+
+// Library/third-party includes
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+// Standard includes
+#include <memory>
+
+namespace videotracker {
+namespace uvbi {
+    /// An HDK tracking system with the camera at the configured position,
+    /// ready to track a scene from addSwayingHDK().
+    inline std::unique_ptr<TrackingSystem>
+    makeSwayingHDKTrackingSystem(ConfigParams const &params) {
+        auto sys = makeHDKTrackingSystem(params);
+        sys->setCameraPose(Eigen::Isometry3d(
+            Eigen::Translation3d(Eigen::Vector3d::Map(params.cameraPosition))));
+        return sys;
+    }
+
+    /// Adds an HDK, set up as configured, swaying about a point a meter in
+    /// front of the camera: a few centimeters, turning by the given
+    /// amplitudes (radians) over each period (seconds).
+    inline BodyId addSwayingHDK(SyntheticScene &scene,
+                                ConfigParams const &params,
+                                Eigen::Vector3d const &angularAmplitude =
+                                    Eigen::Vector3d(0.2, 0.4, 0.1),
+                                double period = 4.) {
+        Eigen::Isometry3d center = Eigen::Isometry3d::Identity();
+        center.translation() = Eigen::Vector3d(0, 0, 1.);
+        return scene.addBody(
+            makeHDKTargetSetupData(params),
+            makeSwayTrajectory(center, Eigen::Vector3d(0.05, 0.05, 0.1),
+                               angularAmplitude, period));
+    }
+} // namespace uvbi
+} // namespace videotracker
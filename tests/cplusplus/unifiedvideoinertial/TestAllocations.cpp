@@ -0,0 +1,211 @@
+/** @file
+    @brief Implementation
+
+    Linked with the allocation hooks. In steady-state tracking, blob
+    extraction outside the blob extractor, LED update, and the rest of the
+    video update must not allocate. The stages that still do aren't
+    budgeted: the test tagged [alloc] is hidden, and fails if they allocate,
+    which is a goal rather than a guarantee, so run it on purpose with
+    `uvbi-test-allocations [alloc]`.
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "SwayingHDK.h"
+#include "unifiedvideoinertial/AllocationCounting.h"
+#include "unifiedvideoinertial/ConfigParams.h"
+#include "unifiedvideoinertial/SyntheticScene.h"
+#include "unifiedvideoinertial/TrackingMetrics.h"
+#include "unifiedvideoinertial/TrackingSystem.h"
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <vector>
+
+using namespace videotracker;
+using namespace videotracker::uvbi;
+
+/// Somewhere for allocations to go that the compiler can't optimize away.
+static std::vector<int> g_sink;
+
+TEST_CASE("Counting allocations per stage", "[metrics]") {
+    REQUIRE(allocationCountingEnabled());
+    TrackingMetrics metrics;
+    {
+        ScopedStageTimer outer(metrics, MetricStage::VideoUpdate);
+        {
+            ScopedStageTimer timer(metrics, MetricStage::LedUpdate);
+            g_sink.assign(1000, 1);
+        }
+        { ScopedStageTimer timer(metrics, MetricStage::PoseEstimation); }
+    }
+    auto snap = metrics.snapshot();
+
+    auto const &led = snap.getAllocations(MetricStage::LedUpdate);
+    REQUIRE(led.scopes == 1);
+    REQUIRE(led.total.allocations >= 1);
+    REQUIRE(led.total.bytes >= 1000 * sizeof(int));
+
+    auto const &pose = snap.getAllocations(MetricStage::PoseEstimation);
+    REQUIRE(pose.scopes == 1);
+    REQUIRE(pose.total.allocations == 0);
+    REQUIRE(pose.total.bytes == 0);
+
+    /// Nested scopes count everything within them.
+    auto const &video = snap.getAllocations(MetricStage::VideoUpdate);
+    REQUIRE(video.scopes == 1);
+    REQUIRE(video.total.allocations == led.total.allocations);
+    REQUIRE(video.total.bytes == led.total.bytes);
+
+    /// Stages that were never entered have nothing recorded.
+    REQUIRE(snap.getAllocations(MetricStage::ImuMessage).scopes == 0);
+
+    std::ostringstream os;
+    os << snap;
+    REQUIRE(os.str().find("ledUpdate_allocs:") != std::string::npos);
+    REQUIRE(os.str().find("imuMessage_allocs:") == std::string::npos);
+
+    metrics.reset();
+    REQUIRE(metrics.snapshot().getAllocations(MetricStage::LedUpdate).scopes ==
+            0);
+}
+
+namespace {
+    struct RenderedFrame {
+        cv::Mat gray;
+        util::Timestamp tv;
+    };
+} // namespace
+
+/// One period of the HDK's sway at the scene's frame rate: tracking for
+/// this long first means the frames measured show poses already seen, so
+/// the working storage has grown as large as they need.
+static const std::size_t WarmupFrames = 400;
+static const std::size_t MeasuredFrames = 100;
+
+/// Tracks a synthetic HDK for a while, then returns the metrics of the
+/// frames after that.
+static TrackingMetricsSnapshot trackSteadyState() {
+    ConfigParams params;
+    params.silent = true;
+    params.debug = false;
+    auto sys = makeSwayingHDKTrackingSystem(params);
+
+    SyntheticSceneParams sceneParams;
+    SyntheticScene scene(sceneParams);
+    addSwayingHDK(scene, params);
+    /// Rendered up front, so none of the scene's allocations are made while
+    /// tracking.
+    std::vector<RenderedFrame> rendered(WarmupFrames + MeasuredFrames);
+    for (std::size_t i = 0; i < rendered.size(); ++i) {
+        scene.renderFrame(i, rendered[i].gray, rendered[i].tv);
+    }
+
+    for (std::size_t i = 0; i < rendered.size(); ++i) {
+        if (i == WarmupFrames) {
+            sys->getMetrics().reset();
+        }
+        sys->processFrame(rendered[i].tv, rendered[i].gray,
+                          sceneParams.camParams);
+    }
+    return sys->getMetrics().snapshot();
+}
+
+static const MetricStage FrameStages[] = {
+    MetricStage::BlobExtraction, MetricStage::BlobDetection,
+    MetricStage::LedUpdate, MetricStage::PoseEstimation,
+    MetricStage::VideoUpdate};
+
+/// Allocations made within a stage's scopes but not within those of the
+/// stages nested in it.
+static std::uint64_t getOwnAllocations(TrackingMetricsSnapshot const &snap,
+                                       MetricStage stage) {
+    auto ret = snap.getAllocations(stage).total.allocations;
+    auto subtract = [&](MetricStage nested) {
+        ret -= snap.getAllocations(nested).total.allocations;
+    };
+    switch (stage) {
+    case MetricStage::BlobExtraction:
+        subtract(MetricStage::BlobDetection);
+        break;
+    case MetricStage::VideoUpdate:
+        subtract(MetricStage::LedUpdate);
+        subtract(MetricStage::PoseEstimation);
+        subtract(MetricStage::DebugDisplay);
+        break;
+    default:
+        break;
+    }
+    return ret;
+}
+
+TEST_CASE("Reporting allocations of steady-state tracking", "[metrics]") {
+    auto snap = trackSteadyState();
+    std::ostringstream os;
+    os << snap;
+    INFO(os.str());
+    REQUIRE(snap.get(MetricCounter::Frames) == MeasuredFrames);
+    for (auto stage : FrameStages) {
+        INFO(getMetricName(stage));
+        REQUIRE(snap.getAllocations(stage).scopes == MeasuredFrames);
+    }
+}
+
+/// The stages of a frame that don't allocate in steady state, apart from
+/// the stages nested in them. A ratchet: when a change stops one of those
+/// below from allocating, move it here.
+static const MetricStage AllocationFree[] = {MetricStage::BlobExtraction,
+                                             MetricStage::LedUpdate,
+                                             MetricStage::VideoUpdate};
+
+TEST_CASE("Allocation-free stages stay allocation-free", "[metrics]") {
+    auto snap = trackSteadyState();
+    std::ostringstream os;
+    os << snap;
+    INFO(os.str());
+    for (auto stage : AllocationFree) {
+        INFO(getMetricName(stage));
+        CHECK(getOwnAllocations(snap, stage) == 0);
+    }
+}
+
+/// The stages that still allocate in steady state. How much depends on the
+/// OpenCV version and build, so rather than budgeting a count that holds
+/// for just one, their counts are left to the metrics report.
+static const MetricStage StillAllocating[] = {
+    /// OpenCV allocates in its filtering and contour finding: temporary
+    /// matrices and filter objects on every call.
+    MetricStage::BlobDetection,
+    /// The RANSAC and Kalman pose estimators' working storage.
+    MetricStage::PoseEstimation};
+
+TEST_CASE("Steady-state tracking doesn't allocate", "[.][alloc]") {
+    auto snap = trackSteadyState();
+    std::ostringstream os;
+    os << snap;
+    INFO(os.str());
+    for (auto stage : StillAllocating) {
+        INFO(getMetricName(stage));
+        CHECK(getOwnAllocations(snap, stage) == 0);
+    }
+}
@@ -0,0 +1,174 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "ClockOffsetEstimator.h"
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <chrono>
+#include <random>
+
+using namespace videotracker;
+using namespace videotracker::uvbi;
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+
+namespace {
+static const int FramesPerSecond = 100;
+static const int BeaconsPerFrame = 8;
+
+util::Timestamp makeFrameTime(int frame) {
+    return util::Timestamp{util::ClockDomain::Offline,
+                           std::chrono::seconds(10) +
+                               microseconds(frame * (1000000 / FramesPerSecond))};
+}
+
+double seconds(ClockOffsetEstimator::duration d) {
+    return std::chrono::duration<double>(d).count();
+}
+
+/// Plays the tracker's part: residuals of beacons seen through a camera whose
+/// timestamps are off from the IMU's by a drifting amount, less whatever the
+/// estimator has corrected already.
+class SimulatedTracking {
+  public:
+    SimulatedTracking(double offset, double skew)
+        : m_offset(offset), m_skew(skew) {}
+
+    /// Proportion of the timing error the pose filter absorbs before it
+    /// shows in the residuals.
+    void setAbsorbed(double absorbed) { m_absorbed = absorbed; }
+
+    /// Peak image speed, in pixels per second, of the beacons.
+    void setImageSpeed(double speed) { m_speed = speed; }
+
+    double getTrueCorrection(int frame) const {
+        return m_offset +
+               m_skew * (static_cast<double>(frame) / FramesPerSecond);
+    }
+
+    bool feedFrame(ClockOffsetEstimator &estimator, int frame) {
+        auto rawTime = makeFrameTime(frame);
+        auto error = getTrueCorrection(frame) -
+                     seconds(estimator.getCorrection(rawTime));
+        std::uniform_real_distribution<double> velocity(-m_speed, m_speed);
+        std::normal_distribution<double> noise(0., 0.3);
+        for (int i = 0; i < BeaconsPerFrame; ++i) {
+            Eigen::Vector2d imageVelocity(velocity(m_rng), velocity(m_rng));
+            Eigen::Vector2d residual =
+                imageVelocity * error * (1. - m_absorbed) +
+                Eigen::Vector2d(noise(m_rng), noise(m_rng));
+            estimator.addResidual(residual, imageVelocity, 1.);
+        }
+        return estimator.finishFrame(rawTime);
+    }
+
+    void run(ClockOffsetEstimator &estimator, int numFrames) {
+        for (int i = 0; i < numFrames; ++i) {
+            feedFrame(estimator, m_frame++);
+        }
+    }
+
+    int getFrame() const { return m_frame; }
+
+  private:
+    double m_offset;
+    double m_skew;
+    double m_absorbed = 0.5;
+    double m_speed = 400.;
+    int m_frame = 0;
+    std::mt19937 m_rng{1234};
+};
+} // namespace
+
+TEST_CASE("Clock offset estimate of a constant offset", "[clockoffset]") {
+    ClockOffsetEstimator estimator(milliseconds(20));
+    SimulatedTracking tracking(0.008, 0.);
+    REQUIRE(estimator.getCorrection(makeFrameTime(0)).count() == 0);
+
+    tracking.run(estimator, 10 * FramesPerSecond);
+    auto frame = tracking.getFrame();
+    CAPTURE(seconds(estimator.getCorrection(makeFrameTime(frame))));
+    REQUIRE(seconds(estimator.getCorrection(makeFrameTime(frame))) ==
+            Approx(0.008).margin(0.0005));
+    REQUIRE(estimator.getFramesUsed() > 0);
+}
+
+TEST_CASE("Clock offset estimate of a drifting clock", "[clockoffset]") {
+    ClockOffsetEstimator estimator(milliseconds(20));
+    /// 100ppm: 6ms over the minute.
+    SimulatedTracking tracking(-0.002, 1.e-4);
+    tracking.run(estimator, 60 * FramesPerSecond);
+    auto frame = tracking.getFrame();
+    CAPTURE(estimator.getSkew());
+    REQUIRE(seconds(estimator.getCorrection(makeFrameTime(frame))) ==
+            Approx(tracking.getTrueCorrection(frame)).margin(0.0005));
+    REQUIRE(estimator.getSkew() == Approx(1.e-4).margin(3.e-5));
+}
+
+TEST_CASE("Clock offset estimate needs motion", "[clockoffset]") {
+    ClockOffsetEstimator estimator(milliseconds(20));
+    SimulatedTracking tracking(0.008, 0.);
+    tracking.setImageSpeed(1.);
+    REQUIRE_FALSE(tracking.feedFrame(estimator, 0));
+    tracking.run(estimator, FramesPerSecond);
+    REQUIRE(estimator.getFramesUsed() == 0);
+    REQUIRE(estimator.getCorrection(makeFrameTime(FramesPerSecond)).count() ==
+            0);
+}
+
+TEST_CASE("Clock offset corrections are bounded", "[clockoffset]") {
+    ClockOffsetEstimator estimator(milliseconds(20));
+    SimulatedTracking tracking(0.03, 0.);
+    tracking.setAbsorbed(0.);
+    auto previous = estimator.correct(makeFrameTime(0));
+    for (int i = 0; i < 5 * FramesPerSecond; ++i) {
+        tracking.feedFrame(estimator, i);
+        auto corrected = estimator.correct(makeFrameTime(i + 1));
+        /// Corrected frame times keep their order.
+        REQUIRE(previous < corrected);
+        previous = corrected;
+        REQUIRE(seconds(estimator.getCorrection(makeFrameTime(i + 1))) <=
+                0.020);
+    }
+    REQUIRE(seconds(estimator.getCorrection(makeFrameTime(500))) ==
+            Approx(0.020));
+}
+
+TEST_CASE("Clock offset estimate starts over for a new clock",
+          "[clockoffset]") {
+    ClockOffsetEstimator estimator(milliseconds(20));
+    SimulatedTracking tracking(0.008, 0.);
+    tracking.run(estimator, FramesPerSecond);
+    REQUIRE(estimator.getFramesUsed() > 0);
+
+    util::Timestamp steady{util::ClockDomain::Steady, std::chrono::seconds(5)};
+    REQUIRE(estimator.getCorrection(steady).count() != 0);
+    estimator.addResidual(Eigen::Vector2d::Zero(), Eigen::Vector2d(400, 400),
+                          1.);
+    estimator.addResidual(Eigen::Vector2d::Zero(), Eigen::Vector2d(-400, 400),
+                          1.);
+    REQUIRE(estimator.finishFrame(steady));
+    REQUIRE(estimator.getFramesUsed() == 1);
+    REQUIRE(seconds(estimator.getCorrection(steady)) == Approx(0.));
+}
@@ -0,0 +1,226 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "BundledImages.h"
+#include "videotrackershared/CoarseTileSearch.h"
+#include "videotrackershared/EdgeHoleBasedLedExtractor.h"
+#include "videotrackershared/SBDBlobExtractor.h"
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+using namespace videotracker;
+
+namespace {
+static const unsigned char Background = 5;
+
+/// Saturated discs, with a couple of pixels of falloff around the edge, on a
+/// dark background.
+cv::Mat makeLedFrame(cv::Size size, std::vector<cv::Point> const &centers,
+                     double radius = 4.) {
+    cv::Mat ret(size, CV_8UC1, cv::Scalar(Background));
+    const int reach = static_cast<int>(radius) + 3;
+    for (auto const &center : centers) {
+        for (int y = std::max(center.y - reach, 0);
+             y <= std::min(center.y + reach, size.height - 1); ++y) {
+            for (int x = std::max(center.x - reach, 0);
+                 x <= std::min(center.x + reach, size.width - 1); ++x) {
+                auto r = std::hypot(x - center.x, y - center.y);
+                auto falloff = std::min(std::max((r - radius) / 2., 0.), 1.);
+                auto val = 250. - (250. - Background) * falloff;
+                auto &pixel = ret.at<unsigned char>(y, x);
+                pixel = std::max(pixel, static_cast<unsigned char>(val));
+            }
+        }
+    }
+    return ret;
+}
+
+BlobParams coarseParams() {
+    BlobParams ret;
+    ret.coarseTileSize = 16;
+    ret.coarseTileMargin = 16;
+    return ret;
+}
+
+bool near(double a, double b, double tolerance = 1.e-3) {
+    return std::abs(a - b) <= tolerance * std::max(1., std::abs(a));
+}
+
+bool sameMeasurement(LedMeasurement const &a, LedMeasurement const &b) {
+    return near(a.loc.x, b.loc.x) && near(a.loc.y, b.loc.y) &&
+           near(a.diameter, b.diameter) && a.imageSize == b.imageSize;
+}
+
+/// How many of the measurements in a have a match in b.
+std::size_t countMatches(LedMeasurementVec const &a,
+                         LedMeasurementVec const &b) {
+    auto hasMatch = [&](LedMeasurement const &meas) {
+        return std::any_of(b.begin(), b.end(),
+                           [&](LedMeasurement const &other) {
+                               return sameMeasurement(meas, other);
+                           });
+    };
+    return std::count_if(a.begin(), a.end(), hasMatch);
+}
+} // namespace
+
+TEST_CASE("coarse tile search pooling", "[coarsetiles]") {
+    /// Not a multiple of the tile size either way.
+    cv::Mat gray(cv::Size(50, 35), CV_8UC1, cv::Scalar(30));
+    gray.at<unsigned char>(3, 4) = 20;
+    gray.at<unsigned char>(17, 33) = 200;
+    gray.at<unsigned char>(34, 49) = 90;
+    CoarseTileSearch search;
+    auto range = search.pool(gray, 16);
+    REQUIRE(range.minVal == 20);
+    REQUIRE(range.maxVal == 200);
+    auto const &pooled = search.getPooledImage();
+    REQUIRE(pooled.size() == cv::Size(4, 3));
+    REQUIRE(pooled.at<unsigned char>(0, 0) == 30);
+    REQUIRE(pooled.at<unsigned char>(1, 2) == 200);
+    REQUIRE(pooled.at<unsigned char>(2, 3) == 90);
+}
+
+TEST_CASE("coarse tile search regions", "[coarsetiles]") {
+    const cv::Size size(640, 480);
+    CoarseTileSearch search;
+    SECTION("nothing bright, nothing to search") {
+        search.pool(makeLedFrame(size, {}), 32);
+        REQUIRE(search.findRegions(50, 8).empty());
+    }
+    SECTION("separate regions, padded and clipped") {
+        search.pool(makeLedFrame(size, {{100, 100}, {500, 300}, {2, 470}}),
+                    32);
+        auto const &regions = search.findRegions(50, 8);
+        REQUIRE(regions.size() == 3);
+        /// Both the tiles it's in.
+        REQUIRE(std::count(regions.begin(), regions.end(),
+                           cv::Rect(64 - 8, 64 - 8, 64 + 16, 64 + 16)) == 1);
+        REQUIRE(std::count(regions.begin(), regions.end(),
+                           cv::Rect(0, 448 - 8, 32 + 8, 32 + 8)) == 1);
+    }
+    SECTION("overlapping regions merge") {
+        search.pool(makeLedFrame(size, {{100, 100}, {180, 100}}), 32);
+        /// A column of tiles apart, but not once padded.
+        auto const &regions = search.findRegions(50, 24);
+        REQUIRE(regions.size() == 1);
+        REQUIRE(regions.front() == cv::Rect(64 - 24, 64 - 24, 176, 112));
+    }
+    SECTION("no point skipping only a little") {
+        cv::Mat gray(size, CV_8UC1, cv::Scalar(100));
+        search.pool(gray, 32);
+        auto const &regions = search.findRegions(50, 8);
+        REQUIRE(regions.size() == 1);
+        REQUIRE(regions.front() == cv::Rect(cv::Point(), size));
+    }
+}
+
+TEST_CASE("coarse-to-fine search finds the same blobs in a large frame",
+          "[coarsetiles]") {
+    std::vector<cv::Point> leds;
+    for (int i = 0; i < 12; ++i) {
+        leds.emplace_back(200 + 301 * (i % 6), 400 + 517 * (i / 6));
+    }
+    auto gray = makeLedFrame(cv::Size(2048, 1536), leds);
+    BlobParams full;
+    auto coarse = coarseParams();
+
+    CoarseTileSearch search;
+    search.pool(gray, coarse.coarseTileSize);
+    std::size_t searched = 0;
+    for (auto const &region : search.findRegions(full.absoluteMinThreshold,
+                                                 coarse.coarseTileMargin)) {
+        searched += region.area();
+    }
+    /// Each LED is in a couple of tiles.
+    REQUIRE(searched < gray.total() / 50);
+
+    SECTION("edge hole extractor, with either backend") {
+        for (bool labelling : {false, true}) {
+            EdgeHoleParams extParams;
+            extParams.singlePassHoleLabelling = labelling;
+            EdgeHoleBasedLedExtractor extractor{extParams};
+            auto fullMeasurements = extractor(gray, full);
+            auto coarseMeasurements = extractor(gray, coarse);
+            REQUIRE(fullMeasurements.size() == leds.size());
+            REQUIRE(coarseMeasurements.size() == fullMeasurements.size());
+            REQUIRE(countMatches(coarseMeasurements, fullMeasurements) ==
+                    fullMeasurements.size());
+            REQUIRE(extractor.getContours().size() ==
+                    coarseMeasurements.size());
+        }
+    }
+    SECTION("simple blob detector") {
+        SBDBlobExtractor fullExtractor{full};
+        SBDBlobExtractor coarseExtractor{coarse};
+        auto fullMeasurements = fullExtractor.extractBlobs(gray);
+        auto coarseMeasurements = coarseExtractor.extractBlobs(gray);
+        REQUIRE(fullMeasurements.size() == leds.size());
+        REQUIRE(coarseMeasurements.size() == fullMeasurements.size());
+        REQUIRE(countMatches(coarseMeasurements, fullMeasurements) ==
+                fullMeasurements.size());
+    }
+}
+
+TEST_CASE("coarse-to-fine search on the bundled images", "[coarsetiles]") {
+    auto images = loadBundledHDKImages();
+    BlobParams full;
+    auto coarse = coarseParams();
+    std::size_t fullCount = 0;
+    std::size_t coarseCount = 0;
+    std::size_t matched = 0;
+    auto compare = [&](LedMeasurementVec const &fullMeasurements,
+                       LedMeasurementVec const &coarseMeasurements) {
+        fullCount += fullMeasurements.size();
+        coarseCount += coarseMeasurements.size();
+        matched += countMatches(coarseMeasurements, fullMeasurements);
+    };
+    SECTION("edge hole extractor") {
+        EdgeHoleBasedLedExtractor extractor;
+        for (auto const &gray : images) {
+            auto fullMeasurements = extractor(gray, full);
+            compare(fullMeasurements, extractor(gray, coarse));
+        }
+    }
+    SECTION("simple blob detector") {
+        SBDBlobExtractor fullExtractor{full};
+        SBDBlobExtractor coarseExtractor{coarse};
+        for (auto const &gray : images) {
+            compare(fullExtractor.extractBlobs(gray),
+                    coarseExtractor.extractBlobs(gray));
+        }
+    }
+    INFO(fullCount << " measurements searching the whole frame, "
+                   << coarseCount << " coarse-to-fine, " << matched
+                   << " matching");
+    REQUIRE(fullCount > 0);
+    /// Only a blob cut by the edge of a region may differ.
+    REQUIRE(matched >= 0.95 * fullCount);
+    REQUIRE(matched >= 0.95 * coarseCount);
+}
@@ -0,0 +1,83 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "ImageSources/DK2Unscramble.h"
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace videotracker::oculus_dk2;
+using Bytes = std::vector<std::uint8_t>;
+
+static Bytes unscrambled(Bytes const &bgr, bool scalar) {
+    /// One extra byte, to catch writing past the end.
+    Bytes gray(bgr.size() / 3 * 2 + 1, 0xaa);
+    if (scalar) {
+        unscrambleRowScalar(bgr.data(), gray.data(), bgr.size() / 3);
+    } else {
+        unscrambleRow(bgr.data(), gray.data(), bgr.size() / 3);
+    }
+    return gray;
+}
+
+TEST_CASE("unscrambled pixels have the luma of their source, twice",
+          "[dk2]") {
+    /// Black, white, blue, green, red: values from OpenCV's BGR2YCrCb.
+    Bytes bgr = {0, 0, 0, 255, 255, 255, 255, 0, 0, 0, 255, 0, 0, 0, 255};
+    Bytes expected = {0, 0, 255, 255, 29, 29, 150, 150, 76, 76, 0xaa};
+    REQUIRE(unscrambled(bgr, true) == expected);
+    REQUIRE(unscrambled(bgr, false) == expected);
+}
+
+TEST_CASE("vectorized unscrambling matches the scalar version", "[dk2]") {
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int> byteDist(0, 255);
+    /// Lengths around the vector width, and a real DK2 row.
+    for (std::size_t pixels : {0, 1, 15, 16, 17, 31, 32, 33, 47, 376}) {
+        CAPTURE(pixels);
+        Bytes bgr(pixels * 3);
+        for (auto &v : bgr) {
+            v = static_cast<std::uint8_t>(byteDist(rng));
+        }
+        REQUIRE(unscrambled(bgr, false) == unscrambled(bgr, true));
+    }
+}
+
+TEST_CASE("unscrambling a frame doubles its width", "[dk2]") {
+    cv::Mat bgr(4, 20, CV_8UC3, cv::Scalar(255, 255, 255));
+    cv::Mat gray;
+    unscrambleImage(bgr, gray);
+    REQUIRE(gray.type() == CV_8UC1);
+    REQUIRE(gray.rows == 4);
+    REQUIRE(gray.cols == 40);
+    REQUIRE(cv::countNonZero(gray == 255) == 4 * 40);
+
+    SECTION("reusing the output buffer doesn't reallocate") {
+        auto data = gray.data;
+        unscrambleImage(bgr, gray);
+        REQUIRE(gray.data == data);
+    }
+}
@@ -0,0 +1,235 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "GuidedRansacPnP.h"
+#include "PoseEstimator_RANSAC.h"
+
+// Library/third-party includes
+#include <Eigen/Geometry>
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <random>
+
+using namespace videotracker;
+using namespace videotracker::uvbi;
+
+namespace {
+PnPPose makePose(Eigen::Vector3d const &axis, double angle,
+                 Eigen::Vector3d const &translation) {
+    PnPPose ret;
+    ret.rotation = Eigen::AngleAxisd(angle, axis.normalized()).matrix();
+    ret.translation = translation;
+    return ret;
+}
+
+Eigen::Vector2d project(PnPPose const &pose, Eigen::Vector3d const &pt) {
+    Eigen::Vector3d p = pose.rotation * pt + pose.translation;
+    return p.head<2>() / p.z();
+}
+
+bool posesMatch(PnPPose const &a, PnPPose const &b, double tolerance) {
+    return (a.rotation - b.rotation).norm() < tolerance &&
+           (a.translation - b.translation).norm() < tolerance;
+}
+
+/// Points scattered over a roughly HDK-sized target, in meters.
+std::vector<Eigen::Vector3d> makeModel(std::size_t n, std::mt19937 &rng) {
+    std::uniform_real_distribution<double> xy(-0.08, 0.08);
+    std::uniform_real_distribution<double> z(-0.03, 0.03);
+    std::vector<Eigen::Vector3d> ret;
+    for (std::size_t i = 0; i < n; ++i) {
+        ret.emplace_back(xy(rng), xy(rng), z(rng));
+    }
+    return ret;
+}
+
+const PnPPose truePose = makePose(Eigen::Vector3d(0.2, 1., 0.1), 0.6,
+                                  Eigen::Vector3d(0.1, -0.05, 0.9));
+} // namespace
+
+TEST_CASE("P3P recovers the pose among its solutions", "[pnp]") {
+    std::mt19937 rng(1);
+    auto model = makeModel(3, rng);
+    std::array<Eigen::Vector3d, 3> bearings;
+    std::array<Eigen::Vector3d, 3> points;
+    for (int i = 0; i < 3; ++i) {
+        points[i] = model[i];
+        bearings[i] = project(truePose, model[i]).homogeneous().normalized();
+    }
+    std::vector<PnPPose> poses;
+    auto n = solveP3P(bearings, points, poses);
+    REQUIRE(n >= 1);
+    REQUIRE(n <= 4);
+    REQUIRE(poses.size() == n);
+    bool found = false;
+    for (auto const &pose : poses) {
+        found = found || posesMatch(pose, truePose, 1.e-6);
+    }
+    REQUIRE(found);
+}
+
+TEST_CASE("P3P rejects collinear points", "[pnp]") {
+    std::array<Eigen::Vector3d, 3> points = {
+        {Eigen::Vector3d(0, 0, 0), Eigen::Vector3d(0.05, 0, 0),
+         Eigen::Vector3d(0.1, 0, 0)}};
+    std::array<Eigen::Vector3d, 3> bearings;
+    for (int i = 0; i < 3; ++i) {
+        bearings[i] = project(truePose, points[i]).homogeneous().normalized();
+    }
+    std::vector<PnPPose> poses;
+    REQUIRE(solveP3P(bearings, points, poses) == 0);
+    REQUIRE(poses.empty());
+}
+
+TEST_CASE("guided RANSAC PnP", "[pnp]") {
+    std::mt19937 rng(2);
+    static const std::size_t NumPoints = 16;
+    auto model = makeModel(NumPoints, rng);
+    PnPCorrespondenceVec corrs(NumPoints);
+    for (std::size_t i = 0; i < NumPoints; ++i) {
+        corrs[i].objectPoint = model[i];
+        corrs[i].imagePoint = project(truePose, model[i]);
+        corrs[i].priority = 1.;
+    }
+    /// Some misidentified beacons: observed somewhere else entirely.
+    std::vector<std::size_t> outliers = {1, 6, 11};
+    for (auto i : outliers) {
+        corrs[i].imagePoint += Eigen::Vector2d(0.05, -0.04);
+    }
+    GuidedRansacPnPResult result;
+
+    SECTION("finds the pose and exactly the inliers") {
+        GuidedRansacPnP ransac;
+        REQUIRE(ransac(corrs, 4, nullptr, result));
+        REQUIRE(posesMatch(result.pose, truePose, 1.e-5));
+        REQUIRE(result.inliers.size() == NumPoints - outliers.size());
+        for (auto i : outliers) {
+            REQUIRE(std::find(result.inliers.begin(), result.inliers.end(),
+                              i) == result.inliers.end());
+        }
+        REQUIRE_FALSE(result.fromPrior);
+        REQUIRE(result.samples > 0);
+        REQUIRE(result.samples <= ransac.getOptions().maxSamples);
+    }
+
+    SECTION("stops early when the priorities are right") {
+        for (auto i : outliers) {
+            corrs[i].priority = 0.;
+        }
+        GuidedRansacPnP ransac;
+        REQUIRE(ransac(corrs, 4, nullptr, result));
+        REQUIRE(posesMatch(result.pose, truePose, 1.e-5));
+        /// All inliers among the first few: one batch does.
+        REQUIRE(result.samples == ransac.getOptions().samplesPerBatch);
+    }
+
+    SECTION("a good prior needs no sampling") {
+        for (auto i : outliers) {
+            corrs[i].imagePoint = project(truePose, model[i]);
+        }
+        GuidedRansacPnP ransac;
+        REQUIRE(ransac(corrs, 4, &truePose, result));
+        REQUIRE(result.fromPrior);
+        REQUIRE(result.samples == 0);
+        REQUIRE(result.inliers.size() == NumPoints);
+    }
+
+    SECTION("a bad prior is replaced") {
+        auto badPrior = makePose(Eigen::Vector3d::UnitY(), -0.4,
+                                 Eigen::Vector3d(0, 0, 1.5));
+        GuidedRansacPnP ransac;
+        REQUIRE(ransac(corrs, 4, &badPrior, result));
+        REQUIRE_FALSE(result.fromPrior);
+        REQUIRE(posesMatch(result.pose, truePose, 1.e-5));
+    }
+
+    SECTION("parallel scoring finds the same pose") {
+        GuidedRansacPnPOptions opts;
+        opts.parallel = true;
+        GuidedRansacPnP parallel(opts);
+        GuidedRansacPnP serial;
+        GuidedRansacPnPResult serialResult;
+        REQUIRE(parallel(corrs, 4, nullptr, result));
+        REQUIRE(serial(corrs, 4, nullptr, serialResult));
+        REQUIRE(result.inliers == serialResult.inliers);
+        REQUIRE(result.samples == serialResult.samples);
+        REQUIRE(posesMatch(result.pose, serialResult.pose, 1.e-12));
+    }
+
+    SECTION("fails with too few correspondences") {
+        corrs.resize(3);
+        GuidedRansacPnP ransac;
+        REQUIRE_FALSE(ransac(corrs, 4, nullptr, result));
+    }
+}
+
+TEST_CASE("RANSAC prior from the body state", "[pnp]") {
+    CameraParameters camParams;
+    BeaconStateVec beacons;
+    std::vector<double> variance;
+    std::vector<bool> fixed;
+    Vec3Vector emission;
+    std::vector<BeaconData> beaconDebug;
+    BodyProcessModel processModel;
+    BodyState state;
+    state.position() = Eigen::Vector3d(0, 0, 1);
+    state.velocity() = Eigen::Vector3d(0.2, 0, 0);
+    auto stateTime = util::Timestamp{util::ClockDomain::Offline,
+                                     std::chrono::seconds(5)};
+    auto frameTime = stateTime + std::chrono::milliseconds(50);
+    auto params = EstimatorInOutParams{camParams,
+                                       beacons,
+                                       variance,
+                                       fixed,
+                                       emission,
+                                       stateTime,
+                                       state,
+                                       processModel,
+                                       beaconDebug,
+                                       Eigen::Vector3d::Zero(),
+                                       nullptr,
+                                       true};
+    PnPPose prior;
+
+    SECTION("predicted to the frame time") {
+        REQUIRE(RANSACPoseEstimator::predictPrior(params, frameTime, prior));
+        REQUIRE(prior.translation.x() == Approx(0.01));
+        REQUIRE(prior.translation.z() == Approx(1.));
+        REQUIRE(prior.rotation.isIdentity());
+        /// The body state itself is left alone.
+        REQUIRE(state.position().x() == 0);
+    }
+
+    SECTION("not without a valid state") {
+        params.stateValid = false;
+        REQUIRE_FALSE(
+            RANSACPoseEstimator::predictPrior(params, frameTime, prior));
+    }
+
+    SECTION("not for a body that hasn't been seen") {
+        state.position() = Eigen::Vector3d::Zero();
+        state.velocity() = Eigen::Vector3d::Zero();
+        REQUIRE_FALSE(
+            RANSACPoseEstimator::predictPrior(params, frameTime, prior));
+    }
+}
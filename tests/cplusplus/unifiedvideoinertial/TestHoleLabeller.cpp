@@ -0,0 +1,301 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "BundledImages.h"
+#include "videotrackershared/EdgeHoleBasedLedExtractor.h"
+#include "videotrackershared/HoleLabeller.h"
+#include "videotrackershared/cvUtils.h"
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace videotracker;
+
+namespace {
+/// All non-zero, except for the given holes.
+cv::Mat makeBinary(cv::Size size, std::vector<cv::Rect> const &holes) {
+    cv::Mat ret(size, CV_8UC1, cv::Scalar(255));
+    for (auto const &hole : holes) {
+        ret(hole).setTo(cv::Scalar(0));
+    }
+    return ret;
+}
+
+EdgeHoleParams labellingParams() {
+    EdgeHoleParams ret;
+    ret.singlePassHoleLabelling = true;
+    return ret;
+}
+
+bool near(double a, double b, double tolerance = 1.e-3) {
+    return std::abs(a - b) <= tolerance * std::max(1., std::abs(a));
+}
+
+bool sameMeasurement(LedMeasurement const &a, LedMeasurement const &b) {
+    return near(a.loc.x, b.loc.x) && near(a.loc.y, b.loc.y) &&
+           near(a.area, b.area) && near(a.diameter, b.diameter) &&
+           near(a.circularity, b.circularity) &&
+           a.boundingBoxSize() == b.boundingBoxSize();
+}
+
+bool sameBlobData(BlobData const &a, BlobData const &b) {
+    return near(a.center.x, b.center.x) && near(a.center.y, b.center.y) &&
+           near(a.area, b.area) && near(a.circularity, b.circularity) &&
+           a.bounds == b.bounds;
+}
+
+bool sameReject(EdgeHoleBasedLedExtractor::RejectType const &a,
+                EdgeHoleBasedLedExtractor::RejectType const &b) {
+    return std::get<1>(a) == std::get<1>(b) &&
+           near(std::get<2>(a).x, std::get<2>(b).x) &&
+           near(std::get<2>(a).y, std::get<2>(b).y);
+}
+
+/// How many of the elements of a have a match in b.
+template <typename T, typename F>
+std::size_t countMatches(std::vector<T> const &a, std::vector<T> const &b,
+                         F &&same) {
+    std::size_t ret = 0;
+    for (auto const &elt : a) {
+        for (auto const &other : b) {
+            if (same(elt, other)) {
+                ++ret;
+                break;
+            }
+        }
+    }
+    return ret;
+}
+} // namespace
+
+TEST_CASE("hole labeller measures a hole like its traced contour",
+          "[holelabeller]") {
+    /// The contour around a 5x3 hole at (4, 6) runs through the pixels
+    /// around it, cutting the corners: a 7x5 box less four half-pixel
+    /// triangles.
+    auto binary = makeBinary(cv::Size(20, 16), {cv::Rect(4, 6, 5, 3)});
+    cv::Mat gray(binary.size(), CV_8UC1, cv::Scalar(0));
+    gray.at<unsigned char>(7, 8) = 200;
+    HoleLabeller labeller;
+    auto const &holes = labeller(binary, gray);
+    REQUIRE(holes.size() == 1);
+    auto const &hole = holes.front();
+    REQUIRE(hole.m00 == 15);
+    REQUIRE(hole.area() == Approx(6 * 4 - 2));
+    REQUIRE(hole.perimeter() == Approx(2 * 4 + 2 * 2 + 4 * std::sqrt(2.)));
+    REQUIRE(hole.center().x == Approx(6));
+    REQUIRE(hole.center().y == Approx(7));
+    REQUIRE(hole.bounds() == cv::Rect(3, 5, 7, 5));
+    REQUIRE(hole.intensityCentroid().x == Approx(8));
+    REQUIRE(hole.intensityCentroid().y == Approx(7));
+
+    ContourType hull;
+    labeller.getHull(0, hull);
+    REQUIRE(cv::contourArea(hull) == Approx(hole.area()));
+}
+
+TEST_CASE("hole labeller connectivity", "[holelabeller]") {
+    HoleLabeller labeller;
+    cv::Mat gray(cv::Size(12, 12), CV_8UC1, cv::Scalar(0));
+    SECTION("zero regions reaching the border aren't holes") {
+        auto binary = makeBinary(
+            gray.size(), {cv::Rect(0, 3, 3, 2), cv::Rect(8, 8, 3, 2),
+                          cv::Rect(5, 10, 2, 1), cv::Rect(4, 4, 2, 2)});
+        auto const &holes = labeller(binary, gray);
+        REQUIRE(holes.size() == 1);
+        REQUIRE(holes.front().m00 == 4);
+    }
+    SECTION("nor is a non-zero border") {
+        auto binary = makeBinary(gray.size(), {cv::Rect(1, 1, 10, 10)});
+        REQUIRE(labeller(binary, gray).empty());
+    }
+    SECTION("holes touching diagonally are separate") {
+        auto binary = makeBinary(gray.size(),
+                                 {cv::Rect(3, 3, 1, 1), cv::Rect(4, 4, 1, 1)});
+        auto const &holes = labeller(binary, gray);
+        REQUIRE(holes.size() == 2);
+        for (auto const &hole : holes) {
+            REQUIRE(hole.m00 == 1);
+            REQUIRE(hole.area() == Approx(2));
+        }
+    }
+    SECTION("a U-shaped hole is a single hole") {
+        auto binary = makeBinary(gray.size(),
+                                 {cv::Rect(2, 2, 1, 6), cv::Rect(2, 7, 6, 1),
+                                  cv::Rect(7, 2, 1, 6)});
+        auto const &holes = labeller(binary, gray);
+        REQUIRE(holes.size() == 1);
+        REQUIRE(holes.front().m00 == 16);
+        REQUIRE(holes.front().bounds() == cv::Rect(1, 1, 8, 8));
+    }
+}
+
+TEST_CASE("hole labeller counts islands", "[holelabeller]") {
+    HoleLabeller labeller;
+    cv::Mat gray(cv::Size(16, 16), CV_8UC1, cv::Scalar(0));
+    auto binary = makeBinary(gray.size(), {cv::Rect(2, 2, 12, 12)});
+    SECTION("none") {
+        auto const &holes = labeller(binary, gray);
+        REQUIRE(holes.size() == 1);
+        REQUIRE(holes.front().islands() == 0);
+    }
+    SECTION("none, with non-zero pixels joined to the outside diagonally") {
+        binary.at<unsigned char>(2, 2) = 255;
+        binary.at<unsigned char>(3, 3) = 255;
+        auto const &holes = labeller(binary, gray);
+        REQUIRE(holes.size() == 1);
+        REQUIRE(holes.front().islands() == 0);
+    }
+    SECTION("two, one of them with a hole of its own") {
+        binary(cv::Rect(4, 4, 2, 3)).setTo(cv::Scalar(255));
+        binary(cv::Rect(8, 8, 4, 4)).setTo(cv::Scalar(255));
+        binary.at<unsigned char>(9, 9) = 0;
+        auto const &holes = labeller(binary, gray);
+        REQUIRE(holes.size() == 2);
+        REQUIRE(holes[0].islands() == 2);
+        REQUIRE(holes[1].islands() == 0);
+    }
+}
+
+TEST_CASE("hole labeller measures the holes in the bundled images exactly",
+          "[holelabeller]") {
+    auto images = loadBundledImages();
+    BlobParams p;
+    EdgeHoleBasedLedExtractor extractor;
+    HoleLabeller labeller;
+    std::vector<BlobData> traced;
+    std::size_t holes = 0;
+    std::size_t holesWithIslands = 0;
+    for (std::size_t i = 0; i < images.size(); ++i) {
+        CAPTURE(i);
+        extractor(images[i], p);
+        cv::Mat binary = extractor.getEdgeDetectedBinarizedImage().clone();
+        auto const &labelled = labeller(binary, images[i]);
+        traced.clear();
+        consumeHolesOfConnectedComponents(binary, [&](ContourType &&contour) {
+            traced.push_back(getBlobDataFromContour(contour));
+        });
+        REQUIRE(labelled.size() == traced.size());
+        for (auto const &hole : labelled) {
+            auto data = hole.getBlobData();
+            CAPTURE(data.center);
+            auto matched = std::any_of(
+                traced.begin(), traced.end(),
+                [&](BlobData const &other) { return sameBlobData(data, other); });
+            /// Only a hole with islands may be measured differently.
+            if (hole.islands() > 0) {
+                ++holesWithIslands;
+            } else {
+                REQUIRE(matched);
+            }
+        }
+        holes += labelled.size();
+    }
+    INFO(holes << " holes, " << holesWithIslands << " with islands");
+    REQUIRE(holes > 0);
+    REQUIRE(holesWithIslands < holes);
+}
+
+TEST_CASE("edge hole extractor backends agree on the bundled images",
+          "[holelabeller]") {
+    auto images = loadBundledImages();
+    BlobParams p;
+    EdgeHoleBasedLedExtractor contours;
+    EdgeHoleBasedLedExtractor labelling{labellingParams()};
+    HoleLabeller labeller;
+    std::size_t measurements = 0;
+    for (std::size_t i = 0; i < images.size(); ++i) {
+        CAPTURE(i);
+        contours(images[i], p);
+        labelling(images[i], p);
+        REQUIRE(labelling.getContours().size() ==
+                labelling.getMeasurements().size());
+        /// Every hole ends up either measured or rejected, and only those
+        /// with islands may end up differently.
+        auto const &holes =
+            labeller(labelling.getEdgeDetectedBinarizedImage(), images[i]);
+        std::size_t holesWithIslands = 0;
+        for (auto const &hole : holes) {
+            if (hole.islands() > 0) {
+                ++holesWithIslands;
+            }
+        }
+        auto const &measured = contours.getMeasurements();
+        auto const &labelledMeasured = labelling.getMeasurements();
+        auto const &rejected = contours.getRejectList();
+        auto const &labelledRejected = labelling.getRejectList();
+        REQUIRE(measured.size() + rejected.size() == holes.size());
+        REQUIRE(labelledMeasured.size() + labelledRejected.size() ==
+                holes.size());
+        auto matched =
+            countMatches(measured, labelledMeasured, sameMeasurement) +
+            countMatches(rejected, labelledRejected, sameReject);
+        auto labelledMatched =
+            countMatches(labelledMeasured, measured, sameMeasurement) +
+            countMatches(labelledRejected, rejected, sameReject);
+        REQUIRE(matched + holesWithIslands >= holes.size());
+        REQUIRE(labelledMatched + holesWithIslands >= holes.size());
+        measurements += measured.size();
+    }
+    REQUIRE(measurements > 0);
+}
+
+/// Not run by default: run the test executable with "[.benchmark]".
+TEST_CASE("edge hole extractor backend timing", "[.benchmark]") {
+    auto images = loadBundledImages();
+    static const int Passes = 20;
+    BlobParams p;
+    auto time = [&](EdgeHoleBasedLedExtractor &extractor) {
+        using clock = std::chrono::steady_clock;
+        /// One untimed pass to warm up.
+        for (auto const &gray : images) {
+            extractor(gray, p);
+        }
+        auto start = clock::now();
+        for (int i = 0; i < Passes; ++i) {
+            for (auto const &gray : images) {
+                extractor(gray, p);
+            }
+        }
+        std::chrono::duration<double, std::milli> elapsed =
+            clock::now() - start;
+        return elapsed.count() / (Passes * images.size());
+    };
+    EdgeHoleBasedLedExtractor contours;
+    EdgeHoleBasedLedExtractor labelling{labellingParams()};
+    auto contoursTime = time(contours);
+    auto labellingTime = time(labelling);
+    std::cout << "Edge hole extraction, mean ms per frame over "
+              << images.size() << " frames:\n"
+              << "  findContours:             " << contoursTime << "\n"
+              << "  single-pass labelling:    " << labellingTime << "\n";
+    REQUIRE(contoursTime > 0);
+}
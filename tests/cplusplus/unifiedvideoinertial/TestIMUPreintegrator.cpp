@@ -0,0 +1,206 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "IMUPreintegrator.h"
+#include "unifiedvideoinertial/IMUStateMeasurements.h"
+#include "unifiedvideoinertial/ModelTypes.h"
+
+// Library/third-party includes
+#include "FlexKalman/FlexibleKalmanFilter.h"
+#include "FlexKalman/FlexibleUnscentedCorrect.h"
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <chrono>
+
+using namespace videotracker;
+using namespace videotracker::uvbi;
+using Eigen::Vector3d;
+
+namespace {
+static const double AngVelVariance = 1.0e-1;
+
+CannedIMUMeasurement makeAngVel(Vector3d const &angVel) {
+    auto ret = CannedIMUMeasurement{};
+    ret.setAngVel(angVel, Vector3d::Constant(AngVelVariance));
+    return ret;
+}
+
+CannedIMUMeasurement makeOrientation(Eigen::Quaterniond const &quat,
+                                     double variance) {
+    auto ret = CannedIMUMeasurement{};
+    ret.setOrientation(quat, Vector3d::Constant(variance));
+    return ret;
+}
+
+util::Timestamp makeTime(int milliseconds) {
+    return util::Timestamp{util::ClockDomain::Offline,
+                           std::chrono::seconds(100) +
+                               std::chrono::milliseconds(milliseconds)};
+}
+
+Vector3d getAngVel(CannedIMUMeasurement const &meas) {
+    Vector3d ret;
+    meas.restoreAngVel(ret);
+    return ret;
+}
+
+Vector3d getAngVelVariance(CannedIMUMeasurement const &meas) {
+    Vector3d ret;
+    meas.restoreAngVelVariance(ret);
+    return ret;
+}
+
+/// Same correction as ApplyIMUToState makes for angular velocity.
+void correctAngVel(BodyState &state, BodyProcessModel &processModel,
+                   util::Timestamp const &from, util::Timestamp const &to,
+                   CannedIMUMeasurement const &meas) {
+    flexkalman::predict(state, processModel, util::time::duration(to, from));
+    flexkalman::IMUAngVelMeasurement kalmanMeas{getAngVel(meas),
+                                                getAngVelVariance(meas)};
+    auto correction = flexkalman::beginUnscentedCorrection(state, kalmanMeas);
+    REQUIRE(correction.stateCorrectionFinite);
+    REQUIRE(correction.finishCorrection(true));
+}
+} // namespace
+
+TEST_CASE("IMU preintegration of a single sample", "[imu][preintegration]") {
+    IMUPreintegrator preintegrator;
+    preintegrator.begin(makeTime(0));
+    REQUIRE(preintegrator.empty());
+    Vector3d angVel(0.5, -1., 2.);
+    preintegrator.add(makeTime(1), makeAngVel(angVel));
+    REQUIRE(preintegrator.size() == 1);
+    REQUIRE(preintegrator.getSpan() == Approx(0.001));
+    REQUIRE(preintegrator.getNewestTime() == makeTime(1));
+    auto meas = preintegrator.getMeasurement();
+    REQUIRE_FALSE(meas.orientationValid());
+    REQUIRE(meas.angVelValid());
+    REQUIRE(getAngVel(meas).isApprox(angVel));
+    REQUIRE(getAngVelVariance(meas).isApprox(
+        Vector3d::Constant(AngVelVariance)));
+}
+
+TEST_CASE("IMU preintegration of angular velocity", "[imu][preintegration]") {
+    IMUPreintegrator preintegrator;
+    preintegrator.begin(makeTime(0));
+    static const int NumSamples = 10;
+
+    SECTION("constant rate: same rate, variance shrinks with the count") {
+        Vector3d angVel(0.5, -1., 2.);
+        for (int i = 1; i <= NumSamples; ++i) {
+            preintegrator.add(makeTime(i), makeAngVel(angVel));
+        }
+        auto meas = preintegrator.getMeasurement();
+        REQUIRE(getAngVel(meas).isApprox(angVel));
+        REQUIRE(getAngVelVariance(meas).isApprox(
+            Vector3d::Constant(AngVelVariance / NumSamples)));
+    }
+
+    SECTION("changing rate: mean rate, spread adds variance") {
+        for (int i = 1; i <= NumSamples; ++i) {
+            preintegrator.add(makeTime(i),
+                              makeAngVel(Vector3d(0, 0, i % 2 ? 1. : 3.)));
+        }
+        auto meas = preintegrator.getMeasurement();
+        REQUIRE(getAngVel(meas).z() == Approx(2.));
+        REQUIRE(getAngVel(meas).x() == Approx(0.).margin(1e-12));
+        Vector3d var = getAngVelVariance(meas);
+        REQUIRE(var.x() == Approx(AngVelVariance / NumSamples));
+        REQUIRE(var.z() == Approx(AngVelVariance / NumSamples + 1.));
+    }
+
+    SECTION("uneven spacing weights by the time each sample covers") {
+        preintegrator.add(makeTime(3), makeAngVel(Vector3d(1, 0, 0)));
+        preintegrator.add(makeTime(4), makeAngVel(Vector3d(5, 0, 0)));
+        auto meas = preintegrator.getMeasurement();
+        REQUIRE(getAngVel(meas).x() == Approx(2.));
+    }
+
+    SECTION("samples sharing the window's start time pass through") {
+        preintegrator.add(makeTime(0), makeAngVel(Vector3d(1, 0, 0)));
+        REQUIRE(preintegrator.getSpan() == 0.);
+        REQUIRE(getAngVel(preintegrator.getMeasurement())
+                    .isApprox(Vector3d(1, 0, 0)));
+        preintegrator.add(makeTime(2), makeAngVel(Vector3d(3, 0, 0)));
+        REQUIRE(getAngVel(preintegrator.getMeasurement())
+                    .isApprox(Vector3d(3, 0, 0)));
+    }
+
+    SECTION("begin() starts over") {
+        preintegrator.add(makeTime(1), makeAngVel(Vector3d(1, 0, 0)));
+        preintegrator.begin(makeTime(5));
+        REQUIRE(preintegrator.empty());
+        preintegrator.add(makeTime(6), makeAngVel(Vector3d(0, 1, 0)));
+        REQUIRE(getAngVel(preintegrator.getMeasurement())
+                    .isApprox(Vector3d(0, 1, 0)));
+    }
+}
+
+TEST_CASE("IMU preintegration of orientation", "[imu][preintegration]") {
+    IMUPreintegrator preintegrator;
+    preintegrator.begin(makeTime(0));
+    Eigen::Quaterniond first(Eigen::AngleAxisd(0.1, Vector3d::UnitY()));
+    Eigen::Quaterniond newest(Eigen::AngleAxisd(0.2, Vector3d::UnitY()));
+    preintegrator.add(makeTime(1), makeOrientation(first, 1.e-7));
+    preintegrator.add(makeTime(2), makeAngVel(Vector3d(0, 1, 0)));
+    preintegrator.add(makeTime(3), makeOrientation(newest, 2.e-7));
+
+    auto meas = preintegrator.getMeasurement();
+    REQUIRE(preintegrator.size() == 3);
+    REQUIRE(meas.orientationValid());
+    Eigen::Quaterniond quat;
+    meas.restoreQuat(quat);
+    REQUIRE(quat.isApprox(newest));
+    Vector3d var;
+    meas.restoreQuatVariance(var);
+    REQUIRE(var.isApprox(Vector3d::Constant(2.e-7)));
+    /// The angular velocity sample covered the first 2ms.
+    REQUIRE(meas.angVelValid());
+    REQUIRE(getAngVel(meas).isApprox(Vector3d(0, 1, 0)));
+}
+
+TEST_CASE("Preintegrated angular velocity corrects the filter like the "
+          "samples it stands for",
+          "[imu][preintegration]") {
+    static const int NumSamples = 20;
+    Vector3d angVel(0, 0.3, 0);
+    BodyProcessModel processModel;
+    BodyState individual;
+    BodyState preintegrated;
+    IMUPreintegrator preintegrator;
+    preintegrator.begin(makeTime(0));
+    for (int i = 1; i <= NumSamples; ++i) {
+        auto meas = makeAngVel(angVel);
+        correctAngVel(individual, processModel, makeTime(i - 1), makeTime(i),
+                      meas);
+        preintegrator.add(makeTime(i), meas);
+    }
+    correctAngVel(preintegrated, processModel, makeTime(0),
+                  preintegrator.getNewestTime(),
+                  preintegrator.getMeasurement());
+
+    CAPTURE(individual.angularVelocity().transpose());
+    CAPTURE(preintegrated.angularVelocity().transpose());
+    REQUIRE(preintegrated.angularVelocity().y() ==
+            Approx(individual.angularVelocity().y()).epsilon(0.05));
+    REQUIRE(preintegrated.angularVelocity().y() > 0.25);
+}
@@ -0,0 +1,101 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "unifiedvideoinertial/ImageProcessing.h"
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+using namespace videotracker;
+using namespace videotracker::uvbi;
+
+static void fill(ImageProcessingOutput &output, std::size_t measurements) {
+    output.ledMeasurements.assign(
+        measurements, LedMeasurement(1.f, 2.f, 3.f, cv::Size(640, 480)));
+    output.frameGray = cv::Mat(4, 6, CV_8UC1, cv::Scalar(1));
+    output.frame = LazyColorFrame{output.frameGray};
+}
+
+TEST_CASE("Recycling image processing outputs", "[pool]") {
+    auto pool = ImageProcessingOutputPool::create();
+    REQUIRE(pool->idle() == 0);
+
+    auto output = pool->acquire();
+    REQUIRE(output);
+    fill(*output, 20);
+    auto const *address = output.get();
+    auto capacity = output->ledMeasurements.capacity();
+
+    SECTION("retiring a frame puts its output back") {
+        output.reset();
+        REQUIRE(pool->idle() == 1);
+
+        auto reused = pool->acquire();
+        REQUIRE(pool->idle() == 0);
+        REQUIRE(reused.get() == address);
+        REQUIRE(reused->ledMeasurements.empty());
+        REQUIRE(reused->ledMeasurements.capacity() == capacity);
+        REQUIRE(reused->frameGray.empty());
+        REQUIRE(reused->frame.empty());
+    }
+
+    SECTION("outputs in flight aren't handed out again") {
+        auto other = pool->acquire();
+        REQUIRE(other.get() != address);
+        REQUIRE(other->ledMeasurements.empty());
+    }
+
+    SECTION("outputs can be retired on another thread") {
+        std::thread retire([&] { output.reset(); });
+        retire.join();
+        REQUIRE(pool->idle() == 1);
+        REQUIRE(pool->acquire().get() == address);
+    }
+
+    SECTION("outputs keep the pool alive") {
+        pool.reset();
+        fill(*output, 5);
+        output.reset();
+    }
+}
+
+TEST_CASE("Only a few idle outputs are kept", "[pool]") {
+    auto pool = ImageProcessingOutputPool::create();
+    std::vector<ImageOutputDataPtr> outputs;
+    for (std::size_t i = 0; i < ImageProcessingOutputPool::MaxIdleOutputs + 2;
+         ++i) {
+        outputs.push_back(pool->acquire());
+    }
+    outputs.clear();
+    REQUIRE(pool->idle() == ImageProcessingOutputPool::MaxIdleOutputs);
+}
+
+TEST_CASE("Outputs made without a pool are just deleted", "[pool]") {
+    ImageOutputDataPtr output(new ImageProcessingOutput);
+    fill(*output, 3);
+    output.reset();
+    REQUIRE_FALSE(output);
+}
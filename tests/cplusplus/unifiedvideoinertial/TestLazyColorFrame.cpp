@@ -0,0 +1,91 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "SwayingHDK.h"
+#include "unifiedvideoinertial/ConfigParams.h"
+#include "unifiedvideoinertial/LazyColorFrame.h"
+#include "unifiedvideoinertial/SyntheticScene.h"
+#include "unifiedvideoinertial/TrackingSystem.h"
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <cstddef>
+
+using namespace videotracker;
+using namespace videotracker::uvbi;
+
+TEST_CASE("color frames are only made when asked for", "[lazycolor]") {
+    cv::Mat gray(4, 6, CV_8UC1, cv::Scalar(42));
+    auto before = LazyColorFrame::getConversionCount();
+
+    LazyColorFrame frame{gray};
+    REQUIRE_FALSE(frame.empty());
+    REQUIRE_FALSE(frame.materialized());
+    REQUIRE(LazyColorFrame::getConversionCount() == before);
+
+    auto const &color = frame.get();
+    REQUIRE(frame.materialized());
+    REQUIRE(color.type() == CV_8UC3);
+    REQUIRE(color.size() == gray.size());
+    REQUIRE(LazyColorFrame::getConversionCount() == before + 1);
+
+    SECTION("asking again doesn't convert again") {
+        frame.get();
+        REQUIRE(LazyColorFrame::getConversionCount() == before + 1);
+    }
+    SECTION("copies share the converted image") {
+        auto copy = frame;
+        REQUIRE(copy.get().data == color.data);
+        REQUIRE(LazyColorFrame::getConversionCount() == before + 1);
+    }
+}
+
+TEST_CASE("color frames supplied directly are never converted",
+          "[lazycolor]") {
+    cv::Mat color(4, 6, CV_8UC3, cv::Scalar(1, 2, 3));
+    auto before = LazyColorFrame::getConversionCount();
+    auto frame = LazyColorFrame::fromColor(color);
+    REQUIRE(frame.materialized());
+    REQUIRE(frame.get().data == color.data);
+    REQUIRE(LazyColorFrame::getConversionCount() == before);
+}
+
+TEST_CASE("headless tracking makes no color frames", "[lazycolor]") {
+    ConfigParams params;
+    params.silent = true;
+    params.debug = false;
+    auto sys = makeSwayingHDKTrackingSystem(params);
+
+    SyntheticSceneParams sceneParams;
+    SyntheticScene scene(sceneParams);
+    addSwayingHDK(scene, params, Eigen::Vector3d(0.2, 0.3, 0.15), 8.);
+
+    auto before = LazyColorFrame::getConversionCount();
+    cv::Mat gray;
+    util::Timestamp tv;
+    for (std::size_t frame = 0; frame < 20; ++frame) {
+        scene.renderFrame(frame, gray, tv);
+        sys->processFrame(tv, gray, sceneParams.camParams);
+    }
+    REQUIRE(LazyColorFrame::getConversionCount() == before);
+}
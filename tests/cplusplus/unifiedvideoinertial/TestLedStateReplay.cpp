@@ -0,0 +1,164 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "SwayingHDK.h"
+#include "unifiedvideoinertial/ConfigParams.h"
+#include "unifiedvideoinertial/SyntheticScene.h"
+#include "unifiedvideoinertial/TrackedBody.h"
+#include "unifiedvideoinertial/TrackingSystem.h"
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <cstddef>
+#include <vector>
+
+using namespace videotracker;
+using namespace videotracker::uvbi;
+
+TEST_CASE("Classifying parameters by pipeline stage", "[replay]") {
+    ConfigParams a;
+    ConfigParams b;
+    REQUIRE(haveSameBlobExtractionParams(a, b));
+    REQUIRE(haveSameLedIdentificationParams(a, b));
+
+    SECTION("pose estimation parameters") {
+        b.processNoiseAutocorrelation[0] *= 2.;
+        b.linearVelocityDecayCoefficient /= 2.;
+        b.highResidualVariancePenalty += 1.;
+        b.brightLedVariancePenalty += 1.;
+        b.measurementVarianceScaleFactor *= 2.;
+        b.tuning.noveltyPenaltyBase += 1.;
+        REQUIRE(haveSameLedIdentificationParams(a, b));
+    }
+    SECTION("LED identification parameters") {
+        b.blobMoveThreshold += 1.;
+        REQUIRE(haveSameBlobExtractionParams(a, b));
+        REQUIRE_FALSE(haveSameLedIdentificationParams(a, b));
+    }
+    SECTION("target setup") {
+        b.includeRearPanel = !b.includeRearPanel;
+        REQUIRE_FALSE(haveSameLedIdentificationParams(a, b));
+    }
+    SECTION("blob extraction parameters") {
+        b.blobParams.minArea += 1.f;
+        REQUIRE_FALSE(haveSameBlobExtractionParams(a, b));
+        REQUIRE_FALSE(haveSameLedIdentificationParams(a, b));
+    }
+    SECTION("pose-assisted identification") {
+        a.poseAssistedIdentification = b.poseAssistedIdentification = true;
+        REQUIRE_FALSE(haveSameLedIdentificationParams(a, b));
+    }
+}
+
+namespace {
+    struct RenderedFrame {
+        cv::Mat gray;
+        util::Timestamp tv;
+    };
+    struct FramePose {
+        bool havePose = false;
+        Eigen::Vector3d position = Eigen::Vector3d::Zero();
+        Eigen::Vector4d orientation = Eigen::Vector4d::Zero();
+    };
+} // namespace
+
+static FramePose getPose(TrackingSystem &sys) {
+    FramePose ret;
+    auto &body = sys.getBody(BodyId(0));
+    ret.havePose = body.hasPoseEstimate();
+    if (ret.havePose) {
+        ret.position = body.getState().position();
+        ret.orientation = body.getState().getQuaternion().coeffs();
+    }
+    return ret;
+}
+
+TEST_CASE("Replaying recorded LEDs", "[replay]") {
+    ConfigParams recordedParams;
+    recordedParams.silent = true;
+    recordedParams.debug = false;
+
+    SyntheticSceneParams sceneParams;
+    SyntheticScene scene(sceneParams);
+    addSwayingHDK(scene, recordedParams);
+    std::vector<RenderedFrame> frames(300);
+    for (std::size_t i = 0; i < frames.size(); ++i) {
+        scene.renderFrame(i, frames[i].gray, frames[i].tv);
+    }
+
+    LedStateRecording recording;
+    {
+        auto sys = makeSwayingHDKTrackingSystem(recordedParams);
+        for (auto &frame : frames) {
+            sys->updateBodiesFromVideoData(
+                sys->performInitialImageProcessing(frame.tv, frame.gray,
+                                                   sceneParams.camParams),
+                recording);
+        }
+    }
+    REQUIRE(recording.size() == frames.size());
+
+    /// Only pose estimation parameters differ from the recorded run.
+    ConfigParams params = recordedParams;
+    params.processNoiseAutocorrelation[0] *= 3.;
+    params.processNoiseAutocorrelation[3] /= 2.;
+    params.linearVelocityDecayCoefficient /= 2.;
+    params.measurementVarianceScaleFactor *= 2.;
+    REQUIRE(haveSameLedIdentificationParams(params, recordedParams));
+
+    std::vector<FramePose> expected;
+    {
+        auto sys = makeSwayingHDKTrackingSystem(params);
+        for (auto &frame : frames) {
+            sys->processFrame(frame.tv, frame.gray, sceneParams.camParams);
+            expected.push_back(getPose(*sys));
+        }
+    }
+
+    auto sys = makeSwayingHDKTrackingSystem(params);
+    bool replaying = true;
+    std::size_t replayed = 0;
+    std::size_t posesCompared = 0;
+    for (std::size_t i = 0; i < frames.size(); ++i) {
+        auto imageData = sys->performInitialImageProcessing(
+            frames[i].tv, frames[i].gray, sceneParams.camParams);
+        if (replaying) {
+            replaying = sys->replayBodiesFromVideoData(std::move(imageData),
+                                                       recording, i);
+            replayed++;
+        } else {
+            sys->updateBodiesFromVideoData(std::move(imageData));
+        }
+        INFO("Frame " << i);
+        auto pose = getPose(*sys);
+        REQUIRE(pose.havePose == expected[i].havePose);
+        if (pose.havePose) {
+            REQUIRE(pose.position == expected[i].position);
+            REQUIRE(pose.orientation == expected[i].orientation);
+            posesCompared++;
+        }
+    }
+    INFO(replayed << " frames replayed");
+    REQUIRE(replayed > 0);
+    REQUIRE(posesCompared > 0);
+}
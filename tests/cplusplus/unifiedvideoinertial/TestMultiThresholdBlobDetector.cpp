@@ -0,0 +1,218 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "BundledImages.h"
+#include "videotrackershared/BlobExtractor.h"
+#include "videotrackershared/MultiThresholdBlobDetector.h"
+#include "videotrackershared/SBDBlobExtractor.h"
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+#include <opencv2/features2d/features2d.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace videotracker;
+
+namespace {
+/// The parameters SBDBlobExtractor would use for this frame.
+MultiThresholdBlobDetector::Params makeParams(cv::Mat const &gray,
+                                              BlobParams const &p) {
+    MultiThresholdBlobDetector::Params ret;
+    ret.minDistBetweenBlobs = p.minDistBetweenBlobs;
+    ret.minArea = p.minArea;
+    ret.filterByColor = false;
+    ret.filterByInertia = false;
+    ret.filterByCircularity = p.filterByCircularity;
+    ret.minCircularity = p.minCircularity;
+    ret.filterByConvexity = p.filterByConvexity;
+    ret.minConvexity = p.minConvexity;
+    auto thresholdInfo = ImageThresholdInfo(gray, p);
+    ret.minThreshold = static_cast<float>(thresholdInfo.minThreshold);
+    ret.maxThreshold = static_cast<float>(thresholdInfo.maxThreshold);
+    ret.thresholdStep = static_cast<float>(thresholdInfo.thresholdStep);
+    return ret;
+}
+
+/// Whether the frame is bright enough for SBDBlobExtractor to look at.
+bool worthDetecting(cv::Mat const &gray, BlobParams const &p) {
+    auto thresholdInfo = ImageThresholdInfo(gray, p);
+    return ImageRangeInfo(gray).maxVal >= p.absoluteMinThreshold &&
+           thresholdInfo.thresholdStep > 0;
+}
+
+std::vector<cv::KeyPoint>
+detectWithOpenCV(cv::Mat const &gray,
+                 MultiThresholdBlobDetector::Params const &params) {
+    std::vector<cv::KeyPoint> ret;
+#if CV_MAJOR_VERSION == 2
+    cv::SimpleBlobDetector detector(params);
+    detector.detect(gray, ret);
+#else
+    cv::SimpleBlobDetector::create(params)->detect(gray, ret);
+#endif
+    return ret;
+}
+
+bool sameKeyPoints(std::vector<cv::KeyPoint> const &a,
+                   std::vector<cv::KeyPoint> const &b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i].pt != b[i].pt || a[i].size != b[i].size) {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+TEST_CASE("multi-threshold blob detector matches SimpleBlobDetector",
+          "[multithreshold]") {
+    auto images = loadBundledImages();
+    auto thresholdSteps = GENERATE(2, 4, 8);
+    auto parallel = GENERATE(false, true);
+    CAPTURE(thresholdSteps);
+    CAPTURE(parallel);
+    BlobParams p;
+    p.thresholdSteps = thresholdSteps;
+    MultiThresholdBlobDetector detector{parallel};
+    std::vector<cv::KeyPoint> keyPoints;
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < images.size(); ++i) {
+        auto const &gray = images[i];
+        if (!worthDetecting(gray, p)) {
+            continue;
+        }
+        CAPTURE(i);
+        auto params = makeParams(gray, p);
+        detector(gray, params, keyPoints);
+        auto expected = detectWithOpenCV(gray, params);
+        REQUIRE(sameKeyPoints(keyPoints, expected));
+        total += keyPoints.size();
+    }
+    REQUIRE(total > 0);
+}
+
+TEST_CASE("blob extractor finds the same blobs with either detector",
+          "[multithreshold]") {
+    auto images = loadBundledImages();
+    auto coarseTileSize = GENERATE(0, 16);
+    CAPTURE(coarseTileSize);
+    BlobParams p;
+    p.coarseTileSize = coarseTileSize;
+    REQUIRE_FALSE(p.multiThresholdDetector);
+    auto openCV = makeBlobExtractor(p);
+    p.multiThresholdDetector = true;
+    auto multiThreshold = makeBlobExtractor(p);
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < images.size(); ++i) {
+        CAPTURE(i);
+        auto const &expected = openCV->extractBlobs(images[i]);
+        auto const &blobs = multiThreshold->extractBlobs(images[i]);
+        REQUIRE(blobs.size() == expected.size());
+        for (std::size_t j = 0; j < blobs.size(); ++j) {
+            REQUIRE(blobs[j].loc == expected[j].loc);
+            REQUIRE(blobs[j].diameter == expected[j].diameter);
+        }
+        total += blobs.size();
+    }
+    REQUIRE(total > 0);
+}
+
+TEST_CASE("multi-threshold blob detector with nothing to do",
+          "[multithreshold]") {
+    cv::Mat gray(cv::Size(64, 48), CV_8UC1, cv::Scalar(60));
+    MultiThresholdBlobDetector::Params params;
+    params.minThreshold = 50;
+    params.maxThreshold = 50;
+    params.thresholdStep = 0;
+    MultiThresholdBlobDetector detector;
+    std::vector<cv::KeyPoint> keyPoints(3);
+    detector(gray, params, keyPoints);
+    REQUIRE(keyPoints.empty());
+    REQUIRE(detector.getNumThresholds() == 0);
+}
+
+/// Not run by default: run the test executable with "[.benchmark]".
+TEST_CASE("multi-threshold blob detector timing", "[.benchmark]") {
+    auto images = loadBundledImages();
+    images.erase(std::remove_if(images.begin(), images.end(),
+                                [](cv::Mat const &gray) {
+                                    return !worthDetecting(gray, BlobParams());
+                                }),
+                 images.end());
+    static const int Passes = 10;
+    using clock = std::chrono::steady_clock;
+    std::cout << "Blob detection, mean ms per frame over " << images.size()
+              << " frames:\n"
+              << "  steps  SimpleBlobDetector  in-tree serial  "
+                 "in-tree parallel  speedup\n";
+    for (int thresholdSteps : {2, 4, 8, 16}) {
+        BlobParams p;
+        p.thresholdSteps = thresholdSteps;
+        std::vector<MultiThresholdBlobDetector::Params> params;
+        for (auto const &gray : images) {
+            params.push_back(makeParams(gray, p));
+        }
+        std::vector<cv::KeyPoint> keyPoints;
+        auto time = [&](std::function<void(std::size_t)> const &detect) {
+            /// One untimed pass to warm up.
+            for (std::size_t i = 0; i < images.size(); ++i) {
+                detect(i);
+            }
+            auto start = clock::now();
+            for (int pass = 0; pass < Passes; ++pass) {
+                for (std::size_t i = 0; i < images.size(); ++i) {
+                    detect(i);
+                }
+            }
+            std::chrono::duration<double, std::milli> elapsed =
+                clock::now() - start;
+            return elapsed.count() / (Passes * images.size());
+        };
+        /// As SBDBlobExtractor used to: a new detector per frame.
+        auto openCVTime = time([&](std::size_t i) {
+            keyPoints = detectWithOpenCV(images[i], params[i]);
+        });
+        MultiThresholdBlobDetector serial{false};
+        auto serialTime = time(
+            [&](std::size_t i) { serial(images[i], params[i], keyPoints); });
+        MultiThresholdBlobDetector parallel{true};
+        auto parallelTime = time(
+            [&](std::size_t i) { parallel(images[i], params[i], keyPoints); });
+        std::cout << "  " << std::setw(5) << thresholdSteps << "  "
+                  << std::setw(18) << openCVTime << "  " << std::setw(14)
+                  << serialTime << "  " << std::setw(16) << parallelTime
+                  << "  " << std::setw(7) << openCVTime / parallelTime
+                  << "x\n";
+        REQUIRE(openCVTime > 0);
+    }
+}
@@ -0,0 +1,158 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "HDKLedIdentifier.h"
+#include "LED.h"
+#include "SwayingHDK.h"
+#include "unifiedvideoinertial/ConfigParams.h"
+#include "unifiedvideoinertial/SyntheticScene.h"
+#include "unifiedvideoinertial/TrackingMetrics.h"
+#include "unifiedvideoinertial/TrackingSystem.h"
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+using namespace videotracker;
+using namespace videotracker::uvbi;
+
+using Id = ZeroBasedBeaconId;
+
+static LedMeasurement makeMeasurement(char bit) {
+    return LedMeasurement(cv::Point2f(100, 100), bit == '*' ? 4.f : 2.f,
+                          cv::Size(640, 480));
+}
+
+TEST_CASE("Provisional beacon IDs", "[poseassist]") {
+    OsvrHdkLedIdentifier identifier(PatternStringList{"**..", "*.*."});
+    /// The first pattern, from its first bit.
+    const std::string first = "**..";
+    const bool blobsKeepId = GENERATE(false, true);
+    INFO("blobsKeepId: " << blobsKeepId);
+
+    Led led(&identifier, makeMeasurement(first[0]));
+    REQUIRE_FALSE(led.identified());
+    REQUIRE(led.framesSeen() == 1);
+
+    SECTION("are kept until the blink code is seen in full, then confirmed") {
+        led.setProvisionalId(Id(0));
+        REQUIRE(led.identified());
+        REQUIRE(led.provisional());
+        REQUIRE(led.novelty() == Led::MAX_NOVELTY);
+        for (std::size_t i = 1; i < first.size() - 1; ++i) {
+            led.addMeasurement(makeMeasurement(first[i]), blobsKeepId);
+            REQUIRE(led.provisional());
+            REQUIRE(led.getID() == Id(0));
+        }
+        led.addMeasurement(makeMeasurement(first.back()), blobsKeepId);
+        REQUIRE_FALSE(led.provisional());
+        REQUIRE(led.getID() == Id(0));
+        REQUIRE(led.framesSeen() == first.size());
+        /// Confirming isn't a new identification.
+        REQUIRE(led.novelty() < Led::MAX_NOVELTY);
+    }
+
+    SECTION("are replaced by a blink code that disagrees") {
+        led.setProvisionalId(Id(1));
+        for (std::size_t i = 1; i < first.size(); ++i) {
+            led.addMeasurement(makeMeasurement(first[i]), blobsKeepId);
+        }
+        REQUIRE_FALSE(led.provisional());
+        REQUIRE(led.getID() == Id(0));
+        REQUIRE(led.novelty() == Led::MAX_NOVELTY);
+    }
+
+    SECTION("are dropped for a blob that turns out not to blink") {
+        led.setProvisionalId(Id(0));
+        for (std::size_t i = 1; i < first.size(); ++i) {
+            led.addMeasurement(makeMeasurement('*'), blobsKeepId);
+        }
+        REQUIRE_FALSE(led.provisional());
+        REQUIRE_FALSE(led.identified());
+    }
+
+    SECTION("are dropped when marked misidentified") {
+        led.setProvisionalId(Id(0));
+        led.markMisidentified();
+        REQUIRE_FALSE(led.provisional());
+        REQUIRE_FALSE(led.identified());
+    }
+}
+
+namespace {
+    struct IdentificationStats {
+        double meanFrames = 0;
+        std::uint64_t provisional = 0;
+        std::uint64_t refuted = 0;
+    };
+} // namespace
+
+static IdentificationStats runSwayingHDK(bool poseAssisted) {
+    ConfigParams params;
+    params.silent = true;
+    params.debug = false;
+    params.poseAssistedIdentification = poseAssisted;
+    auto sys = makeSwayingHDKTrackingSystem(params);
+
+    /// Turning far enough that beacons keep going out of and coming back
+    /// into view.
+    SyntheticSceneParams sceneParams;
+    SyntheticScene scene(sceneParams);
+    addSwayingHDK(scene, params, Eigen::Vector3d(0.3, 0.6, 0.15));
+
+    cv::Mat gray;
+    util::Timestamp tv;
+    for (std::size_t frame = 0; frame < 800; ++frame) {
+        scene.renderFrame(frame, gray, tv);
+        sys->processFrame(tv, gray, sceneParams.camParams);
+    }
+    auto metrics = sys->getMetrics().snapshot();
+    IdentificationStats ret;
+    auto identified = metrics.get(MetricCounter::BeaconIdentifications);
+    REQUIRE(identified > 0);
+    ret.meanFrames = static_cast<double>(metrics.get(
+                         MetricCounter::BeaconIdentificationFrames)) /
+                     identified;
+    ret.provisional = metrics.get(MetricCounter::ProvisionalBeaconIds);
+    ret.refuted = metrics.get(MetricCounter::ProvisionalBeaconIdsRefuted);
+    return ret;
+}
+
+TEST_CASE("Pose-assisted identification of synthetic beacons",
+          "[poseassist]") {
+    auto blinkOnly = runSwayingHDK(false);
+    auto assisted = runSwayingHDK(true);
+    INFO("Mean frames to identification: " << blinkOnly.meanFrames
+                                            << " with the blink code only, "
+                                            << assisted.meanFrames
+                                            << " with pose assistance");
+    INFO(assisted.provisional << " provisional IDs, " << assisted.refuted
+                              << " refuted");
+    REQUIRE(blinkOnly.provisional == 0);
+    REQUIRE(assisted.provisional > 0);
+    REQUIRE(assisted.meanFrames < blinkOnly.meanFrames);
+    /// The gating should keep wrong guesses rare.
+    REQUIRE(assisted.refuted * 10 <= assisted.provisional);
+}
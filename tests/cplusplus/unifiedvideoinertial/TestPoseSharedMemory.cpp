@@ -0,0 +1,248 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "PoseSharedMemoryWriter.h"
+#include "unifiedvideoinertial/PoseSharedMemoryC.h"
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace videotracker::uvbi;
+using videotracker::util::ClockDomain;
+using videotracker::util::Timestamp;
+
+static const std::size_t NumBodies = 3;
+static const std::size_t HistoryLength = 16;
+
+/// So concurrent runs of the test don't trample each other's regions.
+static std::string makeRegionName() {
+    std::random_device rd;
+    return "uvbi-test-poses-" + std::to_string(rd()) + "-" +
+           std::to_string(rd());
+}
+
+/// Fills every field from the sequence number and body, the way
+/// PoseSharedMemoryConsumer.c checks them.
+static UVBI_PoseSample makeSample(std::uint64_t sequence, std::size_t body) {
+    auto seq = static_cast<double>(sequence);
+    UVBI_PoseSample ret = {};
+    ret.monotonicNanoseconds = static_cast<std::int64_t>(sequence) * 1000;
+    ret.pose.translation.data[0] = seq;
+    ret.pose.translation.data[1] = static_cast<double>(body);
+    ret.pose.rotation.data[0] = 1.;
+    ret.linearVelocity.data[0] = seq;
+    ret.angularVelocity.data[1] = seq;
+    ret.positionVariance.data[2] = seq;
+    ret.orientationVariance.data[2] = seq;
+    return ret;
+}
+
+static void checkSample(UVBI_PoseSample const &sample, std::uint64_t sequence,
+                        std::size_t body) {
+    REQUIRE(sample.sequence == sequence);
+    auto expected = makeSample(sequence, body);
+    REQUIRE(sample.monotonicNanoseconds == expected.monotonicNanoseconds);
+    REQUIRE(sample.pose.translation.data[0] ==
+            expected.pose.translation.data[0]);
+    REQUIRE(sample.pose.translation.data[1] ==
+            expected.pose.translation.data[1]);
+    REQUIRE(sample.orientationVariance.data[2] ==
+            expected.orientationVariance.data[2]);
+}
+
+TEST_CASE("Reading published poses through the C API") {
+    auto name = makeRegionName();
+    REQUIRE(uvbiPoseReaderOpen(name.c_str()) == nullptr);
+
+    auto writer =
+        PoseSharedMemoryWriter::make(name, NumBodies, HistoryLength);
+    REQUIRE(writer);
+    auto reader = uvbiPoseReaderOpen(name.c_str());
+    REQUIRE(reader != nullptr);
+    REQUIRE(uvbiPoseReaderIsPublishing(reader) == 1);
+    REQUIRE(uvbiPoseReaderGetBodyCount(reader) == NumBodies);
+    REQUIRE(uvbiPoseReaderGetHistoryLength(reader) == HistoryLength);
+
+    UVBI_PoseSample latest;
+    std::vector<UVBI_PoseSample> history(HistoryLength * 2);
+
+    SECTION("Nothing published yet") {
+        REQUIRE(uvbiPoseReaderGetLatest(reader, 0, &latest) == 0);
+        REQUIRE(uvbiPoseReaderGetHistory(reader, 0, 0, history.data(),
+                                         history.size()) == 0);
+    }
+
+    SECTION("Out of range body") {
+        writer->publish(0, makeSample(1, 0));
+        REQUIRE(uvbiPoseReaderGetLatest(reader, NumBodies, &latest) == 0);
+        REQUIRE(uvbiPoseReaderGetHistory(reader, NumBodies, 0,
+                                         history.data(),
+                                         history.size()) == 0);
+    }
+
+    SECTION("A few poses") {
+        for (std::uint64_t seq = 1; seq <= 5; ++seq) {
+            writer->publish(1, makeSample(seq, 1));
+        }
+        REQUIRE(uvbiPoseReaderGetLatest(reader, 1, &latest) == 1);
+        checkSample(latest, 5, 1);
+        /// Other bodies are untouched.
+        REQUIRE(uvbiPoseReaderGetLatest(reader, 0, &latest) == 0);
+        REQUIRE(uvbiPoseReaderGetLatest(reader, 2, &latest) == 0);
+
+        auto count = uvbiPoseReaderGetHistory(reader, 1, 0, history.data(),
+                                              history.size());
+        REQUIRE(count == 5);
+        for (std::size_t i = 0; i < count; ++i) {
+            checkSample(history[i], i + 1, 1);
+        }
+
+        /// Only the ones after what we've seen.
+        count = uvbiPoseReaderGetHistory(reader, 1, 3, history.data(),
+                                         history.size());
+        REQUIRE(count == 2);
+        checkSample(history[0], 4, 1);
+        checkSample(history[1], 5, 1);
+        REQUIRE(uvbiPoseReaderGetHistory(reader, 1, 5, history.data(),
+                                         history.size()) == 0);
+
+        /// Limited to the newest that fit.
+        count = uvbiPoseReaderGetHistory(reader, 1, 0, history.data(), 2);
+        REQUIRE(count == 2);
+        checkSample(history[0], 4, 1);
+        checkSample(history[1], 5, 1);
+    }
+
+    SECTION("The ring wraps around") {
+        const std::uint64_t total = HistoryLength * 3 + 5;
+        for (std::uint64_t seq = 1; seq <= total; ++seq) {
+            writer->publish(2, makeSample(seq, 2));
+        }
+        REQUIRE(uvbiPoseReaderGetLatest(reader, 2, &latest) == 1);
+        checkSample(latest, total, 2);
+
+        auto count = uvbiPoseReaderGetHistory(reader, 2, 0, history.data(),
+                                              history.size());
+        REQUIRE(count == HistoryLength);
+        for (std::size_t i = 0; i < count; ++i) {
+            checkSample(history[i], total - HistoryLength + 1 + i, 2);
+        }
+    }
+
+    SECTION("Readers see the writer go away") {
+        writer.reset();
+        REQUIRE(uvbiPoseReaderIsPublishing(reader) == 0);
+        REQUIRE(uvbiPoseReaderOpen(name.c_str()) == nullptr);
+    }
+
+    uvbiPoseReaderClose(reader);
+}
+
+TEST_CASE("Another process reading poses while they're published") {
+    auto name = makeRegionName();
+    auto writer =
+        PoseSharedMemoryWriter::make(name, NumBodies, HistoryLength);
+    REQUIRE(writer);
+
+    /// Enough that the consumer is reading while we write, however long it
+    /// takes to start.
+    const std::uint64_t minSequence = 20000;
+    const std::size_t body = 1;
+    std::atomic<bool> done(false);
+    std::atomic<std::uint64_t> published(0);
+    std::thread writerThread([&] {
+        std::uint64_t seq = 0;
+        while (!done) {
+            ++seq;
+            writer->publish(body, makeSample(seq, body));
+            published = seq;
+            if (seq >= minSequence) {
+                /// Keep the newest pose changing, but don't hog the CPU the
+                /// consumer needs.
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            } else if (seq % 64 == 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    auto command = std::string("\"") + UVBI_POSE_SHM_CONSUMER + "\" " +
+                   name + " " + std::to_string(body) + " " +
+                   std::to_string(minSequence);
+    auto result = std::system(command.c_str());
+    done = true;
+    writerThread.join();
+    INFO("Ran " << command);
+    REQUIRE(published >= minSequence);
+    REQUIRE(result == 0);
+}
+
+TEST_CASE("Making a room-space pose sample from a body state") {
+    BodyState state;
+    state.position() = Eigen::Vector3d(1, 2, 3);
+    state.setQuaternion(
+        Eigen::Quaterniond(Eigen::AngleAxisd(EIGEN_PI / 2,
+                                             Eigen::Vector3d::UnitZ())));
+    state.velocity() = Eigen::Vector3d(0.5, 0, 0);
+    state.angularVelocity() = Eigen::Vector3d(0, 0, 1);
+    BodyState::StateSquareMatrix covariance =
+        BodyState::StateSquareMatrix::Zero();
+    covariance.diagonal().head<3>() = Eigen::Vector3d(1e-4, 2e-4, 3e-4);
+    covariance.diagonal().segment<3>(3) = Eigen::Vector3d(1e-3, 2e-3, 3e-3);
+    state.setErrorCovariance(covariance);
+
+    /// Room is the tracker space turned a quarter about x, and raised 1m.
+    Eigen::Isometry3d trackerToRoom =
+        Eigen::Translation3d(0, 0, 1) *
+        Eigen::AngleAxisd(EIGEN_PI / 2, Eigen::Vector3d::UnitX());
+
+    Timestamp tv{ClockDomain::Steady, std::chrono::seconds(5)};
+    auto sample = makePoseSample(tv, state, trackerToRoom);
+    REQUIRE(sample.sequence == 0);
+    REQUIRE(sample.monotonicNanoseconds == 5000000000LL);
+    REQUIRE(sample.clockDomain ==
+            static_cast<std::uint32_t>(ClockDomain::Steady));
+
+    /// (x, y, z) in tracker space is (x, -z, y + 1) in room space.
+    REQUIRE(sample.pose.translation.data[0] == Approx(1));
+    REQUIRE(sample.pose.translation.data[1] == Approx(-3));
+    REQUIRE(sample.pose.translation.data[2] == Approx(3));
+    REQUIRE(sample.linearVelocity.data[0] == Approx(0.5));
+    REQUIRE(sample.linearVelocity.data[1] == Approx(0).margin(1e-12));
+    /// Body z is tracker z, is room -y.
+    REQUIRE(sample.angularVelocity.data[0] == Approx(0).margin(1e-12));
+    REQUIRE(sample.angularVelocity.data[1] == Approx(-1));
+    REQUIRE(sample.angularVelocity.data[2] == Approx(0).margin(1e-12));
+    /// Variances are swapped between y and z along with the axes.
+    REQUIRE(sample.positionVariance.data[0] == Approx(1e-4));
+    REQUIRE(sample.positionVariance.data[1] == Approx(3e-4));
+    REQUIRE(sample.positionVariance.data[2] == Approx(2e-4));
+    REQUIRE(sample.orientationVariance.data[1] == Approx(3e-3));
+}
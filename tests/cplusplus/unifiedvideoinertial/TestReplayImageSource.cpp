@@ -0,0 +1,196 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "unifiedvideoinertial/ImageSources/ImageSourceFactories.h"
+#include "unifiedvideoinertial/ImageSources/RawFrameFile.h"
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <cstdio>
+#include <string>
+
+using namespace videotracker;
+using namespace videotracker::uvbi;
+
+static const int FrameCount = 5;
+static const cv::Size FrameSize(8, 6);
+
+/// Frame i is filled with the value 10 * (i + 1), and recorded 10ms after the
+/// one before it, starting at 100 seconds.
+static void writeRecording(std::string const &filename) {
+    RawFrameWriter writer(filename);
+    for (int i = 0; i < FrameCount; ++i) {
+        util::TimeValue tv;
+        tv.seconds = 100;
+        tv.microseconds = i * 10000;
+        writer.write(cv::Mat(FrameSize, CV_8UC1, cv::Scalar(10 * (i + 1))),
+                     tv);
+    }
+    REQUIRE(writer.getFrameCount() == FrameCount);
+}
+
+static bool isFilledWith(cv::Mat const &gray, int value) {
+    return gray.size() == FrameSize && gray.type() == CV_8UC1 &&
+           cv::countNonZero(gray != value) == 0;
+}
+
+TEST_CASE("Raw frame files round-trip", "[replay]") {
+    std::string filename = std::string("uvbi-test-replay") +
+                           RAW_FRAME_FILE_EXTENSION;
+    writeRecording(filename);
+
+    SECTION("read back directly") {
+        RawFrameReader reader(filename);
+        REQUIRE(reader.size() == FrameSize);
+        REQUIRE(reader.type() == CV_8UC1);
+        cv::Mat frame;
+        util::TimeValue tv;
+        for (int i = 0; i < FrameCount; ++i) {
+            REQUIRE(reader.read(frame, tv));
+            REQUIRE(isFilledWith(frame, 10 * (i + 1)));
+            REQUIRE(tv.seconds == 100);
+            REQUIRE(tv.microseconds == i * 10000);
+        }
+        REQUIRE_FALSE(reader.read(frame, tv));
+        reader.rewind();
+        REQUIRE(reader.read(frame, tv));
+        REQUIRE(isFilledWith(frame, 10));
+    }
+
+    ReplayOptions opts;
+    opts.pacing = ReplayPacing::MaxSpeed;
+    /// Less than a pass, so the prefetch thread has to wait for room.
+    opts.prefetchFrames = 2;
+
+    SECTION("replayed to the end") {
+        auto source = openReplay(filename, opts);
+        REQUIRE(source);
+        REQUIRE(source->resolution() == FrameSize);
+        cv::Mat gray;
+        util::Timestamp ts;
+        for (int i = 0; i < FrameCount; ++i) {
+            INFO("Frame " << i);
+            REQUIRE(source->grab());
+            source->retrieveGray(gray, ts);
+            REQUIRE(isFilledWith(gray, 10 * (i + 1)));
+            REQUIRE(ts.domain() == util::ClockDomain::Offline);
+            REQUIRE(ts.toTimeValue().seconds == 100);
+            REQUIRE(ts.toTimeValue().microseconds == i * 10000);
+        }
+        REQUIRE_FALSE(source->grab());
+        REQUIRE_FALSE(source->ok());
+    }
+
+    SECTION("replayed in a loop") {
+        opts.loop = true;
+        auto source = openReplay(filename, opts);
+        REQUIRE(source);
+        cv::Mat color;
+        cv::Mat gray;
+        util::Timestamp ts;
+        util::Timestamp last;
+        for (int i = 0; i < 3 * FrameCount; ++i) {
+            INFO("Frame " << i);
+            REQUIRE(source->grab());
+            source->retrieve(color, gray, ts);
+            REQUIRE(isFilledWith(gray, 10 * (i % FrameCount + 1)));
+            REQUIRE(color.type() == CV_8UC3);
+            REQUIRE(color.size() == FrameSize);
+            if (i > 0) {
+                /// Keeps the recorded spacing across the loop, too.
+                REQUIRE(ts > last);
+                REQUIRE(util::time::duration(ts, last) ==
+                        Approx(0.01).margin(1e-9));
+            }
+            last = ts;
+        }
+        REQUIRE(source->ok());
+    }
+
+    SECTION("replayed on the steady clock as fast as possible") {
+        opts.steadyTimestamps = true;
+        auto source = openReplay(filename, opts);
+        REQUIRE(source);
+        cv::Mat gray;
+        util::Timestamp ts;
+        util::Timestamp last;
+        for (int i = 0; i < FrameCount; ++i) {
+            INFO("Frame " << i);
+            auto before = util::Timestamp::now(util::ClockDomain::Steady);
+            REQUIRE(source->grab());
+            source->retrieveGray(gray, ts);
+            /// Stamped when delivered, not at the recorded spacing.
+            REQUIRE(ts.domain() == util::ClockDomain::Steady);
+            REQUIRE(ts >= before);
+            REQUIRE(ts <= util::Timestamp::now());
+            if (i > 0) {
+                REQUIRE(ts >= last);
+            }
+            last = ts;
+        }
+    }
+
+    SECTION("replayed on the steady clock at a scaled speed") {
+        static const double Speed = 4.;
+        opts.pacing = ReplayPacing::Scaled;
+        opts.speed = Speed;
+        opts.steadyTimestamps = true;
+        auto before = util::Timestamp::now(util::ClockDomain::Steady);
+        auto source = openReplay(filename, opts);
+        REQUIRE(source);
+        cv::Mat gray;
+        util::Timestamp first;
+        util::Timestamp ts;
+        for (int i = 0; i < FrameCount; ++i) {
+            INFO("Frame " << i);
+            REQUIRE(source->grab());
+            source->retrieveGray(gray, ts);
+            REQUIRE(ts.domain() == util::ClockDomain::Steady);
+            if (i == 0) {
+                first = ts;
+                REQUIRE(first >= before);
+            }
+            /// The recorded spacing, divided by the speed...
+            REQUIRE(util::time::duration(ts, first) ==
+                    Approx(0.01 * i / Speed).margin(1e-9));
+            /// ...which is also when the frame was delivered.
+            REQUIRE(ts <= util::Timestamp::now());
+        }
+    }
+
+    std::remove(filename.c_str());
+}
+
+TEST_CASE("Replaying a missing or invalid file fails to open", "[replay]") {
+    std::string filename = std::string("uvbi-test-replay-invalid") +
+                           RAW_FRAME_FILE_EXTENSION;
+    REQUIRE_FALSE(openReplay(filename));
+    {
+        std::FILE *f = std::fopen(filename.c_str(), "wb");
+        REQUIRE(f);
+        std::fputs("not a raw frame file", f);
+        std::fclose(f);
+    }
+    REQUIRE_FALSE(openReplay(filename));
+    std::remove(filename.c_str());
+}
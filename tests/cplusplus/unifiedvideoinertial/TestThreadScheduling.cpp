@@ -0,0 +1,121 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "ThreadScheduling.h"
+#include "unifiedvideoinertial/ConfigParams.h"
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace videotracker::uvbi;
+
+/// Runs the function on a thread of its own, so the test's own thread keeps
+/// its scheduling.
+template <typename F> static void onNewThread(F &&f) {
+    std::thread t(std::forward<F>(f));
+    t.join();
+}
+
+TEST_CASE("Thread scheduling from the config") {
+    ConfigParams params;
+    REQUIRE(getTrackerThreadScheduling(params).isDefault());
+    REQUIRE(getImageThreadScheduling(params).isDefault());
+
+    params.trackerThreadCpus = {1, 2};
+    params.imageThreadCpus = {3};
+    params.threadNiceness = -5;
+    auto tracker = getTrackerThreadScheduling(params);
+    auto image = getImageThreadScheduling(params);
+    REQUIRE(tracker.cpus == std::vector<int>({1, 2}));
+    REQUIRE(image.cpus == std::vector<int>({3}));
+    REQUIRE(tracker.niceness == -5);
+    REQUIRE(image.niceness == -5);
+    REQUIRE_FALSE(tracker.isDefault());
+}
+
+TEST_CASE("Default thread scheduling changes nothing") {
+    std::vector<std::string> failures;
+    onNewThread([&] { failures = applyToCurrentThread(ThreadScheduling{}); });
+    REQUIRE(failures.empty());
+}
+
+#ifdef __linux__
+TEST_CASE("Pinning a thread to a CPU") {
+    cpu_set_t allowed;
+    REQUIRE(sched_getaffinity(0, sizeof(allowed), &allowed) == 0);
+    int cpu = 0;
+    while (!CPU_ISSET(cpu, &allowed)) {
+        ++cpu;
+    }
+
+    ThreadScheduling scheduling;
+    scheduling.cpus = {cpu};
+    std::vector<std::string> failures;
+    cpu_set_t pinned;
+    cpu_set_t inherited;
+    onNewThread([&] {
+        failures = applyToCurrentThread(scheduling);
+        sched_getaffinity(0, sizeof(pinned), &pinned);
+        /// Threads it starts get the same placement.
+        onNewThread(
+            [&] { sched_getaffinity(0, sizeof(inherited), &inherited); });
+    });
+    REQUIRE(failures.empty());
+    REQUIRE(CPU_COUNT(&pinned) == 1);
+    REQUIRE(CPU_ISSET(cpu, &pinned));
+    REQUIRE(CPU_EQUAL(&pinned, &inherited));
+}
+
+TEST_CASE("Nonexistent CPUs are refused") {
+    ThreadScheduling scheduling;
+    scheduling.cpus = {-1};
+    std::vector<std::string> failures;
+    onNewThread([&] { failures = applyToCurrentThread(scheduling); });
+    REQUIRE(failures.size() == 1);
+}
+
+TEST_CASE("Setting a thread's nice value") {
+    /// Any process may lower its own priority.
+    ThreadScheduling scheduling;
+    scheduling.niceness = 5;
+    std::vector<std::string> failures;
+    int niceness = 0;
+    onNewThread([&] {
+        failures = applyToCurrentThread(scheduling);
+        niceness = getpriority(PRIO_PROCESS,
+                               static_cast<id_t>(syscall(SYS_gettid)));
+    });
+    REQUIRE(failures.empty());
+    REQUIRE(niceness == 5);
+}
+#endif
@@ -0,0 +1,140 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "HistoryContainer.h"
+#include "unifiedvideoinertial/Timestamp.h"
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <chrono>
+#include <cstdlib>
+
+using namespace videotracker;
+using util::ClockDomain;
+using util::Timestamp;
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+using std::chrono::nanoseconds;
+using std::chrono::seconds;
+
+namespace {
+Timestamp makeOffline(std::int64_t ns) {
+    return Timestamp{ClockDomain::Offline, nanoseconds(ns)};
+}
+} // namespace
+
+TEST_CASE("Timestamp arithmetic and comparison", "[timestamp]") {
+    auto a = makeOffline(1500000000);
+    auto b = a + milliseconds(250);
+    REQUIRE(b.count() == 1750000000);
+    REQUIRE(b.domain() == ClockDomain::Offline);
+    REQUIRE(a < b);
+    REQUIRE(b > a);
+    REQUIRE(a <= a);
+    REQUIRE(a != b);
+    REQUIRE(b - a == milliseconds(250));
+    REQUIRE(util::time::duration(a, b) == Approx(-0.25));
+    REQUIRE(b - milliseconds(250) == a);
+    REQUIRE(a + std::chrono::duration<double>(0.5) == makeOffline(2000000000));
+}
+
+TEST_CASE("Timestamp to and from TimeValue", "[timestamp]") {
+    SECTION("whole microseconds round-trip") {
+        util::TimeValue tv = {12, 345678};
+        auto ts = Timestamp::fromTimeValue(tv, ClockDomain::System);
+        REQUIRE(ts.count() == 12345678000);
+        REQUIRE(ts.domain() == ClockDomain::System);
+        auto back = ts.toTimeValue();
+        REQUIRE(back.seconds == 12);
+        REQUIRE(back.microseconds == 345678);
+    }
+    SECTION("un-normalized TimeValues are taken as they are") {
+        util::TimeValue tv = {1, -250000};
+        auto ts = Timestamp::fromTimeValue(tv, ClockDomain::Offline);
+        REQUIRE(ts == makeOffline(750000000));
+        auto back = ts.toTimeValue();
+        REQUIRE(back.seconds == 0);
+        REQUIRE(back.microseconds == 750000);
+    }
+    SECTION("negative times come back normalized") {
+        auto back = makeOffline(-1500000000).toTimeValue();
+        REQUIRE(back.seconds == -1);
+        REQUIRE(back.microseconds == -500000);
+    }
+    SECTION("sub-microsecond parts are truncated") {
+        auto back = makeOffline(2000000999).toTimeValue();
+        REQUIRE(back.seconds == 2);
+        REQUIRE(back.microseconds == 0);
+    }
+}
+
+TEST_CASE("Timestamp clock domains", "[timestamp]") {
+    SECTION("the zero timestamp is comparable with every domain") {
+        Timestamp zero;
+        REQUIRE(zero.comparableWith(makeOffline(5)));
+        REQUIRE(zero.comparableWith(Timestamp::now(ClockDomain::System)));
+        REQUIRE(zero < makeOffline(5));
+    }
+    SECTION("different domains aren't comparable") {
+        REQUIRE_FALSE(makeOffline(5).comparableWith(
+            Timestamp{ClockDomain::Steady, nanoseconds(5)}));
+    }
+    SECTION("the steady clock doesn't go backwards") {
+        auto first = util::time::getSteadyNow();
+        auto second = util::time::getSteadyNow();
+        REQUIRE(first.domain() == ClockDomain::Steady);
+        REQUIRE_FALSE(second < first);
+    }
+    SECTION("wall-clock times move to the steady domain by their age") {
+        auto wall = Timestamp::now(ClockDomain::System) - milliseconds(100);
+        auto steady = util::time::toSteady(wall);
+        REQUIRE(steady.domain() == ClockDomain::Steady);
+        auto age = util::time::getSteadyNow() - steady;
+        REQUIRE(age >= milliseconds(100));
+        REQUIRE(age < milliseconds(200));
+        auto roundTrip = util::time::toSystem(steady);
+        REQUIRE(roundTrip.domain() == ClockDomain::System);
+        REQUIRE(std::abs((roundTrip - wall).count()) <
+                nanoseconds(milliseconds(10)).count());
+    }
+    SECTION("offline timestamps stay as they are") {
+        auto ts = makeOffline(42);
+        REQUIRE(util::time::toSteady(ts) == ts);
+        REQUIRE(util::time::toSystem(ts) == ts);
+        REQUIRE(util::time::toApiTimeValue(ts).microseconds == 0);
+    }
+}
+
+TEST_CASE("HistoryContainer keyed by Timestamp", "[timestamp][history]") {
+    uvbi::history::HistoryContainer<int> history;
+    for (int i = 0; i < 5; ++i) {
+        history.push_newest(makeOffline(0) + microseconds(10 * i), i);
+    }
+    /// Times closer together than a TimeValue could tell apart.
+    history.push_newest(makeOffline(40001), 5);
+    REQUIRE(history.size() == 6);
+    REQUIRE(history.closest_not_newer(makeOffline(40000))->second == 4);
+    REQUIRE(history.closest_not_newer(makeOffline(40001))->second == 5);
+    REQUIRE(history.pop_before(makeOffline(20000)) == 2);
+    REQUIRE(history.oldest_timestamp() == makeOffline(20000));
+}
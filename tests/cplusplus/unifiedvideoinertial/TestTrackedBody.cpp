@@ -0,0 +1,246 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "DeferredReports.h"
+#include "TrackedBodyIMU.h"
+#include "unifiedvideoinertial/MakeHDKTrackingSystem.h"
+#include "unifiedvideoinertial/TrackedBody.h"
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <chrono>
+#include <memory>
+
+using namespace videotracker;
+using namespace videotracker::uvbi;
+
+namespace {
+/// Turning rate about the vertical reported by the IMU, in radians per
+/// second.
+static const double TurnRate = 2.;
+static const int ImuPeriodMs = 10;
+
+util::Timestamp makeTime(int milliseconds) {
+    return util::Timestamp{util::ClockDomain::Offline,
+                           std::chrono::seconds(100) +
+                               std::chrono::milliseconds(milliseconds)};
+}
+
+/// The first body of an HDK tracking system, with the room calibration done.
+/// With no video tracking, IMU measurements just go into the history, so
+/// they're applied when replayed after a video update.
+class BodyUnderTest {
+  public:
+    explicit BodyUnderTest(ConfigParams const &params)
+        : m_system(makeHDKTrackingSystem(params)),
+          m_body(m_system->getBody(BodyId(0))) {
+        m_system->setCameraPose(Eigen::Isometry3d::Identity());
+        m_body.getIMU().setCalibrationYaw(util::AngleRadiansd(0));
+        REQUIRE(m_system->isRoomCalibrationComplete());
+    }
+
+    TrackingSystem &system() { return *m_system; }
+    TrackedBody &body() { return m_body; }
+
+    /// Reports the angular velocity for the IMU period ending at the given
+    /// time.
+    void imuAt(int milliseconds) {
+        double dt = ImuPeriodMs / 1000.;
+        Eigen::Quaterniond deltaquat(
+            Eigen::AngleAxisd(TurnRate * dt, Eigen::Vector3d::UnitY()));
+        m_body.getIMU().updatePoseFromAngularVelocity(makeTime(milliseconds),
+                                                      deltaquat, dt);
+    }
+
+    /// Reports the angular velocity for each IMU period up to the given
+    /// time.
+    void imuThrough(int milliseconds) {
+        for (int ms = ImuPeriodMs; ms <= milliseconds; ms += ImuPeriodMs) {
+            imuAt(ms);
+        }
+    }
+
+    /// Starting state from video at time 0.
+    void startAtZero() {
+        BodyState state = m_body.getState();
+        state.position() = Eigen::Vector3d(0, 0, 1);
+        m_body.replaceStateSnapshot(makeTime(0), makeTime(0), state);
+    }
+
+    /// Gets the state for a frame at the given time.
+    util::Timestamp stateFor(int milliseconds, BodyState &state) {
+        util::Timestamp stateTime;
+        REQUIRE(m_body.getStateAtOrBefore(makeTime(milliseconds), stateTime,
+                                          state));
+        return stateTime;
+    }
+
+    /// Does what a video update finding the body right where it was
+    /// predicted would: takes the state for the frame and puts it back.
+    util::Timestamp videoAt(int milliseconds, BodyState &state) {
+        auto stateTime = stateFor(milliseconds, state);
+        m_body.replaceStateSnapshot(stateTime, makeTime(milliseconds), state);
+        return stateTime;
+    }
+
+  private:
+    std::unique_ptr<TrackingSystem> m_system;
+    TrackedBody &m_body;
+};
+
+void checkSameState(BodyState const &a, BodyState const &b) {
+    REQUIRE(a.getQuaternion().angularDistance(b.getQuaternion()) ==
+            Approx(0).margin(1e-3));
+    REQUIRE((a.angularVelocity() - b.angularVelocity()).norm() ==
+            Approx(0).margin(0.1));
+    REQUIRE((a.position() - b.position()).norm() == Approx(0).margin(1e-6));
+}
+
+void checkIdenticalState(BodyState const &a, BodyState const &b) {
+    REQUIRE(a.stateVector() == b.stateVector());
+    REQUIRE(a.errorCovariance() == b.errorCovariance());
+}
+} // namespace
+
+TEST_CASE("Video updates with preintegrated IMU measurements",
+          "[TrackedBody]") {
+    ConfigParams params;
+    params.imu.path = "/me/head";
+    BodyUnderTest perSample(params);
+    /// Windows of three measurements, so video frames can fall inside them.
+    params.imu.preintegrationSeconds = 0.025;
+    BodyUnderTest windowed(params);
+
+    for (auto *test : {&perSample, &windowed}) {
+        test->imuThrough(80);
+        test->startAtZero();
+    }
+    REQUIRE(windowed.body().getState().angularVelocity().y() > 0);
+    BodyState perSampleState;
+    BodyState windowedState;
+
+    /// The state for a frame has seen every measurement up to it, even
+    /// those in a window ending after it...
+    REQUIRE(perSample.videoAt(52, perSampleState) == makeTime(50));
+    REQUIRE(windowed.videoAt(52, windowedState) == makeTime(50));
+    checkSameState(windowedState, perSampleState);
+
+    REQUIRE(perSample.videoAt(73, perSampleState) == makeTime(70));
+    REQUIRE(windowed.videoAt(73, windowedState) == makeTime(70));
+    checkSameState(windowedState, perSampleState);
+
+    /// ...or in one still open.
+    REQUIRE(perSample.stateFor(80, perSampleState) == makeTime(80));
+    REQUIRE(windowed.stateFor(80, windowedState) == makeTime(80));
+    checkSameState(windowedState, perSampleState);
+}
+
+TEST_CASE("Lazy replay ends up where eager replay does", "[TrackedBody]") {
+    ConfigParams params;
+    params.imu.path = "/me/head";
+    SECTION("applying measurements one at a time") {}
+    SECTION("preintegrating measurements") {
+        params.imu.preintegrationSeconds = 0.025;
+    }
+    params.lazyReplay = false;
+    BodyUnderTest eager(params);
+    params.lazyReplay = true;
+    BodyUnderTest lazy(params);
+
+    for (auto *test : {&eager, &lazy}) {
+        test->imuThrough(80);
+        test->startAtZero();
+    }
+    REQUIRE_FALSE(eager.body().hasPendingReplay());
+    REQUIRE(lazy.body().hasPendingReplay());
+    REQUIRE(lazy.body().getStateTime() == makeTime(0));
+    /// Catching up a little in idle time.
+    REQUIRE_FALSE(lazy.body().replayPendingIMU(2));
+
+    BodyState eagerState;
+    BodyState lazyState;
+    for (int frame : {52, 73}) {
+        INFO("Frame at " << frame << "ms");
+        REQUIRE(lazy.videoAt(frame, lazyState) ==
+                eager.videoAt(frame, eagerState));
+        checkIdenticalState(lazyState, eagerState);
+        REQUIRE(lazy.body().hasPendingReplay());
+    }
+
+    lazy.body().finishPendingReplay();
+    REQUIRE_FALSE(lazy.body().hasPendingReplay());
+    REQUIRE(lazy.body().getStateTime() == eager.body().getStateTime());
+    checkIdenticalState(lazy.body().getState(), eager.body().getState());
+}
+
+TEST_CASE("Deferred reports wait while the replay is spread over idle batches",
+          "[TrackedBody]") {
+    ConfigParams params;
+    params.imu.path = "/me/head";
+    params.lazyReplay = true;
+    BodyUnderTest lazy(params);
+    DeferredReports deferred(lazy.system());
+    auto const bodyId = lazy.body().getId();
+
+    int now = 80;
+    lazy.imuThrough(now);
+    lazy.startAtZero();
+    /// The report for the video update is held back...
+    REQUIRE(deferred.defer(bodyId));
+
+    /// ...as are those for IMU messages arriving while the thread replays a
+    /// couple of measurements at a time between them.
+    int batches = 0;
+    bool reported = false;
+    while (!reported) {
+        now += ImuPeriodMs;
+        INFO("IMU message at " << now << "ms");
+        REQUIRE(now < 1000);
+        lazy.imuAt(now);
+        REQUIRE(deferred.defer(bodyId));
+        REQUIRE(lazy.body().hasPendingReplay());
+        REQUIRE(lazy.body().getStateTime() < makeTime(now));
+
+        ++batches;
+        auto morePending = deferred.replayBatch(2, [&](BodyId const caughtUp) {
+            REQUIRE(caughtUp == bodyId);
+            reported = true;
+        });
+        REQUIRE(morePending != reported);
+    }
+    REQUIRE(batches > 2);
+    REQUIRE(deferred.empty());
+    REQUIRE_FALSE(lazy.body().hasPendingReplay());
+
+    /// Having replayed just what an eager one would have in one go.
+    params.lazyReplay = false;
+    BodyUnderTest eager(params);
+    eager.imuThrough(now);
+    eager.startAtZero();
+    REQUIRE(lazy.body().getStateTime() == makeTime(now));
+    REQUIRE(lazy.body().getStateTime() == eager.body().getStateTime());
+    checkIdenticalState(lazy.body().getState(), eager.body().getState());
+
+    /// Nothing to hold back once caught up.
+    REQUIRE_FALSE(deferred.defer(bodyId));
+}
@@ -0,0 +1,92 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "unifiedvideoinertial/TrackingMetrics.h"
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace videotracker::uvbi;
+using std::chrono::microseconds;
+using std::chrono::nanoseconds;
+
+TEST_CASE("histogram buckets contain their values", "[metrics]") {
+    using Snap = LatencyHistogramSnapshot;
+    for (std::uint64_t value :
+         {std::uint64_t(0), std::uint64_t(1), std::uint64_t(15),
+          std::uint64_t(16), std::uint64_t(17), std::uint64_t(1000),
+          std::uint64_t(123456789), ~std::uint64_t(0)}) {
+        CAPTURE(value);
+        auto idx = Snap::bucketIndex(value);
+        REQUIRE(idx < Snap::BucketCount);
+        REQUIRE(Snap::bucketLowerBound(idx) <= value);
+        REQUIRE(value <= Snap::bucketUpperBound(idx));
+    }
+}
+
+TEST_CASE("histogram percentiles are within bucket precision", "[metrics]") {
+    LatencyHistogram hist;
+    for (int i = 1; i <= 1000; ++i) {
+        hist.record(microseconds(i));
+    }
+    auto snap = hist.snapshot();
+    REQUIRE(snap.count() == 1000);
+    REQUIRE(snap.max() == microseconds(1000));
+    auto p50 = static_cast<double>(snap.percentile(50).count());
+    REQUIRE(p50 >= 500000.);
+    REQUIRE(p50 <= 500000. * (1. + 1. / 16.));
+    REQUIRE(snap.percentile(100) == microseconds(1000));
+}
+
+TEST_CASE("metrics may be recorded concurrently", "[metrics]") {
+    TrackingMetrics metrics;
+    static const int NumThreads = 4;
+    static const int PerThread = 10000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NumThreads; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < PerThread; ++i) {
+                metrics.record(MetricStage::LedUpdate, nanoseconds(i));
+                metrics.increment(MetricCounter::Frames);
+                metrics.raiseGauge(MetricGauge::StateHistoryHighWaterMark, i);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    auto snap = metrics.snapshot();
+    REQUIRE(snap.get(MetricStage::LedUpdate).count() ==
+            NumThreads * PerThread);
+    REQUIRE(snap.get(MetricCounter::Frames) == NumThreads * PerThread);
+    REQUIRE(snap.get(MetricGauge::StateHistoryHighWaterMark) ==
+            PerThread - 1);
+    REQUIRE(snap.get(MetricStage::PoseEstimation).empty());
+
+    metrics.reset();
+    REQUIRE(metrics.snapshot().get(MetricCounter::Frames) == 0);
+}
@@ -0,0 +1,112 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "TripleBuffer.h"
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+using namespace videotracker::uvbi;
+
+namespace {
+/// Every element holds the same value, so a torn read would show up as a
+/// mismatch.
+using Payload = std::array<std::uint64_t, 13>;
+
+void fill(Payload &p, std::uint64_t value) { p.fill(value); }
+
+bool consistent(Payload const &p) {
+    for (auto v : p) {
+        if (v != p[0]) {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+TEST_CASE("nothing to receive before the first publish", "[triplebuffer]") {
+    TripleBuffer<Payload> buf;
+    REQUIRE_FALSE(buf.receive());
+}
+
+TEST_CASE("receive gets only the newest value", "[triplebuffer]") {
+    TripleBuffer<Payload> buf;
+    for (std::uint64_t i = 1; i <= 5; ++i) {
+        fill(buf.writeBuffer(), i);
+        buf.publish();
+    }
+    REQUIRE(buf.receive());
+    REQUIRE(buf.readBuffer()[0] == 5);
+    REQUIRE(consistent(buf.readBuffer()));
+    SECTION("and doesn't receive it again") {
+        REQUIRE_FALSE(buf.receive());
+        REQUIRE(buf.readBuffer()[0] == 5);
+    }
+    SECTION("then the next one published") {
+        fill(buf.writeBuffer(), 6);
+        buf.publish();
+        REQUIRE(buf.receive());
+        REQUIRE(buf.readBuffer()[0] == 6);
+    }
+}
+
+TEST_CASE("values cross threads whole and in order", "[triplebuffer]") {
+    static const std::uint64_t NumValues = 200000;
+    TripleBuffer<Payload> buf;
+    std::atomic<bool> done{false};
+    std::thread producer([&] {
+        for (std::uint64_t i = 1; i <= NumValues; ++i) {
+            fill(buf.writeBuffer(), i);
+            buf.publish();
+        }
+        done = true;
+    });
+    std::uint64_t last = 0;
+    std::uint64_t received = 0;
+    bool allConsistent = true;
+    bool inOrder = true;
+    while (last != NumValues) {
+        bool wasDone = done;
+        if (buf.receive()) {
+            auto const &val = buf.readBuffer();
+            allConsistent = allConsistent && consistent(val);
+            inOrder = inOrder && val[0] > last;
+            last = val[0];
+            ++received;
+        } else if (wasDone) {
+            /// The producer finished before we looked, so its last value
+            /// should have been there.
+            break;
+        }
+    }
+    producer.join();
+    REQUIRE(allConsistent);
+    REQUIRE(inOrder);
+    REQUIRE(last == NumValues);
+    REQUIRE(received > 0);
+}
@@ -0,0 +1,135 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "unifiedvideoinertial/ImageSources/VideoFileImageSource.h"
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+#include <opencv2/videoio/videoio.hpp>
+
+// Standard includes
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <string>
+
+using namespace videotracker;
+using namespace videotracker::uvbi;
+
+static const int FrameCount = 6;
+static const cv::Size FrameSize(32, 24);
+static const std::string VideoFilename = "uvbi-test-video-file.avi";
+static const std::string TimestampFilename =
+    VideoFilename + ".timestamps.txt";
+
+/// Frame i is a flat gray of brightness 30 * (i + 1), so the order survives
+/// lossy compression, recorded 20ms after the one before it.
+static int expectedBrightness(int i) { return 30 * (i % FrameCount + 1); }
+
+static void writeVideo() {
+    cv::VideoWriter writer(VideoFilename,
+                           cv::VideoWriter::fourcc('M', 'J', 'P', 'G'), 50,
+                           FrameSize, true);
+    REQUIRE(writer.isOpened());
+    std::ofstream timestamps(TimestampFilename);
+    timestamps << "# capture times\n";
+    for (int i = 0; i < FrameCount; ++i) {
+        auto value = expectedBrightness(i);
+        writer.write(
+            cv::Mat(FrameSize, CV_8UC3, cv::Scalar(value, value, value)));
+        timestamps << "7." << std::setfill('0') << std::setw(3) << 20 * i
+                   << "\n";
+    }
+}
+
+static void checkFrame(cv::Mat const &color, int i) {
+    REQUIRE(color.size() == FrameSize);
+    REQUIRE(color.type() == CV_8UC3);
+    REQUIRE(cv::mean(color)[0] == Approx(expectedBrightness(i)).margin(5));
+}
+
+TEST_CASE("Decode-ahead video file playback", "[replay]") {
+    writeVideo();
+
+    ReplayOptions opts;
+    opts.pacing = ReplayPacing::MaxSpeed;
+    /// Fewer pool frames than the video has, so the decoder has to wait for
+    /// the consumer to hand frames back.
+    opts.prefetchFrames = 2;
+    cv::Mat color;
+    util::Timestamp ts;
+
+    SECTION("played to the end") {
+        auto source = openVideoFile(VideoFilename, opts);
+        REQUIRE(source);
+        REQUIRE(source->resolution() == FrameSize);
+
+        /// Nothing to retrieve yet.
+        source->retrieveColor(color, ts);
+        REQUIRE(color.empty());
+
+        for (int i = 0; i < FrameCount; ++i) {
+            INFO("Frame " << i);
+            REQUIRE(source->grab());
+            source->retrieveColor(color, ts);
+            checkFrame(color, i);
+            REQUIRE(ts.domain() == util::ClockDomain::Offline);
+            REQUIRE(ts.toTimeValue().seconds == 7);
+            REQUIRE(ts.toTimeValue().microseconds == 20000 * i);
+        }
+        REQUIRE_FALSE(source->grab());
+        REQUIRE_FALSE(source->ok());
+        REQUIRE_FALSE(source->grab());
+        source->retrieveColor(color, ts);
+        REQUIRE(color.empty());
+
+        auto stats = source->getDecodeStats();
+        REQUIRE(stats.poolFrames == 2);
+        REQUIRE(stats.framesDecoded == FrameCount);
+        REQUIRE(stats.framesDelivered == FrameCount);
+    }
+
+    SECTION("played in a loop") {
+        opts.loop = true;
+        auto source = openVideoFile(VideoFilename, opts);
+        REQUIRE(source);
+        util::Timestamp last;
+        for (int i = 0; i < 2 * FrameCount + 1; ++i) {
+            INFO("Frame " << i);
+            REQUIRE(source->grab());
+            source->retrieveColor(color, ts);
+            checkFrame(color, i);
+            if (i > 0) {
+                REQUIRE(ts > last);
+                REQUIRE(util::time::duration(ts, last) ==
+                        Approx(0.02).margin(1e-9));
+            }
+            last = ts;
+        }
+    }
+
+    std::remove(VideoFilename.c_str());
+    std::remove(TimestampFilename.c_str());
+}
+
+TEST_CASE("Missing video files fail to open", "[replay]") {
+    REQUIRE_FALSE(openVideoFile("uvbi-test-no-such-video.avi"));
+}
@@ -0,0 +1,232 @@
+/** @file
+    @brief Implementation
+
+    @date 2026
+*/
+
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "TrackedBodyIMU.h"
+#include "WarmStart.h"
+#include "unifiedvideoinertial/MakeHDKTrackingSystem.h"
+#include "unifiedvideoinertial/TrackedBodyTarget.h"
+
+// Library/third-party includes
+#include <catch2/catch.hpp>
+
+// Standard includes
+#include <cstdio>
+#include <string>
+
+using namespace videotracker;
+using namespace videotracker::uvbi;
+
+static WarmStartSnapshot makeSnapshot() {
+    WarmStartSnapshot ret;
+    ret.cameraFingerprint = 0x0123456789abcdefULL;
+    for (int t = 0; t < 2; ++t) {
+        WarmStartSnapshot::Target target;
+        target.id = BodyTargetId(BodyId(t), TargetId(0));
+        target.fingerprint = 1000 + t;
+        for (int i = 0; i < 5; ++i) {
+            target.beacons.push_back(WarmStartSnapshot::Beacon{
+                Eigen::Vector3d(i, -i, 0.5 * t),
+                Eigen::Matrix3d::Identity() * (1e-6 * (i + 1))});
+        }
+        ret.targets.push_back(target);
+    }
+    ret.haveRoomCalibration = true;
+    ret.roomFingerprint = 42;
+    ret.cameraPosition = Eigen::Vector3d(0, 1.2, -0.5);
+    ret.cameraRotation =
+        Eigen::AngleAxisd(0.3, Eigen::Vector3d::UnitY()).toRotationMatrix();
+    ret.imuYaws.emplace_back(BodyId(0), -0.25);
+    return ret;
+}
+
+static void checkSame(WarmStartSnapshot const &a, WarmStartSnapshot const &b) {
+    REQUIRE(a.cameraFingerprint == b.cameraFingerprint);
+    REQUIRE(a.targets.size() == b.targets.size());
+    for (std::size_t t = 0; t < a.targets.size(); ++t) {
+        REQUIRE(a.targets[t].id == b.targets[t].id);
+        REQUIRE(a.targets[t].fingerprint == b.targets[t].fingerprint);
+        REQUIRE(a.targets[t].beacons.size() == b.targets[t].beacons.size());
+        for (std::size_t i = 0; i < a.targets[t].beacons.size(); ++i) {
+            REQUIRE(a.targets[t].beacons[i].position ==
+                    b.targets[t].beacons[i].position);
+            REQUIRE(a.targets[t].beacons[i].covariance ==
+                    b.targets[t].beacons[i].covariance);
+        }
+    }
+    REQUIRE(a.haveRoomCalibration == b.haveRoomCalibration);
+    REQUIRE(a.roomFingerprint == b.roomFingerprint);
+    REQUIRE(a.cameraPosition == b.cameraPosition);
+    REQUIRE(a.cameraRotation == b.cameraRotation);
+    REQUIRE(a.imuYaws == b.imuYaws);
+}
+
+TEST_CASE("Warm start serialization") {
+    auto snapshot = makeSnapshot();
+    auto data = serializeWarmStart(snapshot);
+
+    SECTION("Round trip") {
+        auto restored = deserializeWarmStart(data);
+        REQUIRE(restored);
+        checkSame(snapshot, *restored);
+    }
+
+    SECTION("Round trip without room calibration") {
+        /// Nothing else about the room is kept without it.
+        snapshot.haveRoomCalibration = false;
+        snapshot.roomFingerprint = 0;
+        snapshot.cameraPosition = Eigen::Vector3d::Zero();
+        snapshot.cameraRotation = Eigen::Matrix3d::Identity();
+        snapshot.imuYaws.clear();
+        auto restored = deserializeWarmStart(serializeWarmStart(snapshot));
+        REQUIRE(restored);
+        checkSame(snapshot, *restored);
+    }
+
+    SECTION("Any flipped byte is caught") {
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            auto corrupt = data;
+            corrupt[i] = static_cast<char>(corrupt[i] ^ 0x10);
+            INFO("Flipped byte " << i);
+            REQUIRE_FALSE(deserializeWarmStart(corrupt));
+        }
+    }
+
+    SECTION("Truncated or extended data is caught") {
+        REQUIRE_FALSE(deserializeWarmStart(std::string()));
+        REQUIRE_FALSE(deserializeWarmStart(data.substr(0, 10)));
+        REQUIRE_FALSE(deserializeWarmStart(data.substr(0, data.size() - 1)));
+        REQUIRE_FALSE(deserializeWarmStart(data + '\0'));
+    }
+
+    SECTION("Saving and loading a file") {
+        std::string filename = "uvbi-test-warm-start.bin";
+        REQUIRE(saveWarmStart(filename, snapshot));
+        /// Replaces an earlier file.
+        snapshot.roomFingerprint = 43;
+        REQUIRE(saveWarmStart(filename, snapshot));
+        auto loaded = loadWarmStart(filename);
+        std::remove(filename.c_str());
+        REQUIRE(loaded);
+        checkSame(snapshot, *loaded);
+        REQUIRE_FALSE(loadWarmStart(filename));
+    }
+}
+
+TEST_CASE("Camera fingerprints") {
+    auto camParams = getHDKCameraParameters();
+    REQUIRE(getCameraFingerprint(camParams) ==
+            getCameraFingerprint(getHDKCameraParameters()));
+    auto other = camParams;
+    other.cameraMatrix(0, 0) += 1;
+    REQUIRE(getCameraFingerprint(camParams) != getCameraFingerprint(other));
+    REQUIRE(getCameraFingerprint(camParams) !=
+            getCameraFingerprint(camParams.createUndistortedVariant()));
+}
+
+TEST_CASE("Warm start of a tracking system") {
+    ConfigParams params;
+    params.imu.path = "/me/head";
+    auto camParams = getHDKCameraParameters();
+    auto beacon = ZeroBasedBeaconId(3);
+    const Eigen::Vector3d nudge(0.001, -0.002, 0.0005);
+    const Eigen::Matrix3d covariance = Eigen::Matrix3d::Identity() * 1e-7;
+
+    WarmStartSnapshot snapshot;
+    Eigen::Isometry3d cameraPose = Eigen::Isometry3d::Identity();
+    Eigen::Vector3d autocalibrated;
+    {
+        auto sys = makeHDKTrackingSystem(params);
+        auto &target = *sys->getTarget(BodyTargetId(BodyId(0), TargetId(0)));
+        autocalibrated = target.getBeaconAutocalibPosition(beacon) + nudge;
+        target.setBeaconAutocalib(beacon, autocalibrated, covariance);
+
+        SECTION("Without room calibration") {
+            snapshot = captureWarmStart(*sys, camParams);
+            REQUIRE_FALSE(snapshot.haveRoomCalibration);
+        }
+        SECTION("With room calibration") {
+            cameraPose.translation() = Eigen::Vector3d(0, 1.2, -0.5);
+            sys->setCameraPose(cameraPose);
+            sys->getBody(BodyId(0)).getIMU().setCalibrationYaw(
+                util::AngleRadiansd(0.5));
+            snapshot = captureWarmStart(*sys, camParams);
+            REQUIRE(snapshot.haveRoomCalibration);
+        }
+        REQUIRE(snapshot.targets.size() == 1);
+    }
+
+    auto restored = deserializeWarmStart(serializeWarmStart(snapshot));
+    REQUIRE(restored);
+
+    SECTION("Restores into a matching system") {
+        auto sys = makeHDKTrackingSystem(params);
+        auto &target = *sys->getTarget(BodyTargetId(BodyId(0), TargetId(0)));
+        REQUIRE_FALSE(target.getBeaconAutocalibPosition(beacon)
+                          .isApprox(autocalibrated));
+        auto result = restoreWarmStart(*sys, camParams, *restored, true);
+        REQUIRE(result.cameraMatched);
+        REQUIRE(result.targetsRestored == 1);
+        REQUIRE(result.targetsMismatched == 0);
+        REQUIRE(target.getBeaconAutocalibPosition(beacon).isApprox(
+            autocalibrated));
+        REQUIRE(target.getBeaconAutocalibCovariance(beacon) == covariance);
+        REQUIRE(result.roomCalibrationRestored ==
+                snapshot.haveRoomCalibration);
+        REQUIRE(sys->isRoomCalibrationComplete() ==
+                snapshot.haveRoomCalibration);
+        if (snapshot.haveRoomCalibration) {
+            REQUIRE(sys->getCameraPose().isApprox(cameraPose));
+            REQUIRE(util::getRadians(
+                        sys->getBody(BodyId(0)).getIMU().getCalibrationYaw()) ==
+                    Approx(0.5));
+        }
+    }
+
+    SECTION("Room calibration can be left out") {
+        /// As it is by default, since the IMU yaw may not survive a restart.
+        REQUIRE_FALSE(params.warmStartRoomCalibration);
+        auto sys = makeHDKTrackingSystem(params);
+        auto result = restoreWarmStart(*sys, camParams, *restored,
+                                       params.warmStartRoomCalibration);
+        REQUIRE(result.targetsRestored == 1);
+        REQUIRE_FALSE(result.roomCalibrationRestored);
+        REQUIRE_FALSE(sys->isRoomCalibrationComplete());
+    }
+
+    SECTION("Nothing restores with a different camera") {
+        auto sys = makeHDKTrackingSystem(params);
+        auto result = restoreWarmStart(
+            *sys, camParams.createUndistortedVariant(), *restored, true);
+        REQUIRE_FALSE(result.cameraMatched);
+        REQUIRE(result.targetsRestored == 0);
+        REQUIRE_FALSE(result.roomCalibrationRestored);
+    }
+
+    SECTION("A different target isn't restored") {
+        auto otherParams = params;
+        otherParams.includeRearPanel = !params.includeRearPanel;
+        auto sys = makeHDKTrackingSystem(otherParams);
+        auto result = restoreWarmStart(*sys, camParams, *restored, true);
+        REQUIRE(result.cameraMatched);
+        REQUIRE(result.targetsRestored == 0);
+        REQUIRE(result.targetsMismatched == 1);
+    }
+}